@@ -0,0 +1,632 @@
+#include "AssetIndexer.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#ifdef __linux__
+#	include <poll.h>
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#endif
+
+namespace LaphriaEditor
+{
+namespace
+{
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+constexpr int                       kIndexFormatVersion = 1;
+constexpr std::chrono::milliseconds kPersistInterval{2000};
+[[maybe_unused]] constexpr std::chrono::milliseconds kPollInterval{2000};
+[[maybe_unused]] constexpr int                       kWatchTimeoutMs = 250;
+constexpr uint32_t                  kGlbMagic = 0x46546C67;            // "glTF"
+constexpr uint32_t                  kGlbJsonChunkType = 0x4E4F534A;        // "JSON"
+
+void setError(std::string *errorMessage, const std::string &text)
+{
+	if (errorMessage)
+	{
+		*errorMessage = text;
+	}
+}
+
+std::string lowerExtension(const fs::path &path)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char ch) {
+		return static_cast<char>(std::tolower(ch));
+	});
+	return extension;
+}
+
+bool hashFile(const fs::path &path, uint64_t &outHash)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	uint64_t                    hash = 14695981039346656037ull;
+	std::array<char, 64 * 1024> buffer{};
+	while (stream)
+	{
+		stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		const auto count = static_cast<size_t>(stream.gcount());
+		for (size_t i = 0; i < count; ++i)
+		{
+			hash ^= static_cast<unsigned char>(buffer[i]);
+			hash *= 1099511628211ull;
+		}
+	}
+	outHash = hash;
+	return true;
+}
+
+// Reads only the glTF JSON (the first chunk of a .glb) and counts its top-level arrays.
+bool summarizeGltf(const fs::path &path, AssetRecord &record)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	json document;
+	if (lowerExtension(path) == ".glb")
+	{
+		std::array<uint32_t, 5> header{};        // magic, version, length, chunk length, chunk type
+		if (!stream.read(reinterpret_cast<char *>(header.data()), sizeof(header)) || header[0] != kGlbMagic || header[4] != kGlbJsonChunkType)
+		{
+			return false;
+		}
+		// The lengths come from the file: a truncated or corrupt one must not size the allocation below.
+		std::error_code ec;
+		const auto      fileSize = fs::file_size(path, ec);
+		if (ec || header[2] < 20 || header[2] > fileSize || header[3] > header[2] - 20)
+		{
+			return false;
+		}
+		std::string text(header[3], '\0');
+		if (!stream.read(text.data(), static_cast<std::streamsize>(text.size())))
+		{
+			return false;
+		}
+		document = json::parse(text, nullptr, false);
+	}
+	else
+	{
+		document = json::parse(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>(), nullptr, false);
+	}
+	if (document.is_discarded() || !document.is_object())
+	{
+		return false;
+	}
+
+	const auto count = [&](const char *key) {
+		const auto it = document.find(key);
+		return it != document.end() && it->is_array() ? static_cast<uint32_t>(it->size()) : 0u;
+	};
+	record.meshCount = count("meshes");
+	record.textureCount = count("textures");
+	record.animationCount = count("animations");
+	return true;
+}
+
+// Removes path and, if it was a directory, everything recorded below it.
+bool eraseRecords(std::map<std::string, AssetRecord> &records, const std::string &path)
+{
+	bool changed = records.erase(path) > 0;
+	const std::string prefix = path + static_cast<char>(fs::path::preferred_separator);
+	for (auto it = records.lower_bound(prefix); it != records.end() && it->first.starts_with(prefix);)
+	{
+		it = records.erase(it);
+		changed = true;
+	}
+	return changed;
+}
+
+#ifdef __linux__
+// inotify watches for every directory below the roots. New directories are added as they appear; directory
+// moves and queue overflows ask the caller for a full rescan, which rebuilds the watches.
+class DirectoryWatch
+{
+  public:
+	DirectoryWatch() = default;
+	~DirectoryWatch()
+	{
+		closeWatch();
+	}
+	DirectoryWatch(const DirectoryWatch &) = delete;
+	DirectoryWatch &operator=(const DirectoryWatch &) = delete;
+
+	bool reset(const std::vector<fs::path> &roots)
+	{
+		closeWatch();
+		fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (fd < 0)
+		{
+			return false;
+		}
+		for (const auto &root : roots)
+		{
+			addTree(root);
+		}
+		return true;
+	}
+
+	void addTree(const fs::path &directory)
+	{
+		add(directory);
+		std::error_code ec;
+		for (auto it = fs::recursive_directory_iterator(directory, fs::directory_options::skip_permission_denied, ec);
+		     !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+		{
+			if (it->is_directory(ec))
+			{
+				add(it->path());
+			}
+		}
+	}
+
+	// Waits up to timeoutMs for events and appends the paths they name. Returns false if the watch is unusable.
+	bool read(int timeoutMs, std::vector<fs::path> &touched, bool &needScan)
+	{
+		if (fd < 0)
+		{
+			return false;
+		}
+		pollfd descriptor{fd, POLLIN, 0};
+		if (poll(&descriptor, 1, timeoutMs) <= 0)
+		{
+			return true;
+		}
+
+		alignas(inotify_event) std::array<char, 64 * 1024> buffer{};
+		for (;;)
+		{
+			const ssize_t length = ::read(fd, buffer.data(), buffer.size());
+			if (length <= 0)
+			{
+				break;        // EAGAIN once the queue is drained
+			}
+			for (ssize_t offset = 0; offset < length;)
+			{
+				inotify_event event{};
+				std::memcpy(&event, buffer.data() + offset, sizeof(event));
+				const char *name = buffer.data() + offset + sizeof(inotify_event);
+				offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+
+				if (event.mask & IN_Q_OVERFLOW)
+				{
+					needScan = true;
+					continue;
+				}
+				const auto directory = directories.find(event.wd);
+				if (directory == directories.end())
+				{
+					continue;
+				}
+				if (event.mask & IN_IGNORED)
+				{
+					directories.erase(directory);
+				}
+				else if ((event.mask & IN_ISDIR) && (event.mask & (IN_MOVED_FROM | IN_MOVED_TO)))
+				{
+					needScan = true;        // watches below a moved directory still carry the old path
+				}
+				else if (event.len > 0)
+				{
+					touched.push_back(directory->second / name);
+				}
+			}
+		}
+		return true;
+	}
+
+  private:
+	static constexpr uint32_t kMask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
+
+	void add(const fs::path &directory)
+	{
+		const int wd = inotify_add_watch(fd, directory.c_str(), kMask);
+		if (wd >= 0)
+		{
+			directories[wd] = directory;
+		}
+	}
+
+	void closeWatch()
+	{
+		if (fd >= 0)
+		{
+			::close(fd);
+		}
+		fd = -1;
+		directories.clear();
+	}
+
+	int                               fd = -1;
+	std::unordered_map<int, fs::path> directories;
+};
+#endif
+}        // namespace
+
+AssetIndexer::~AssetIndexer()
+{
+	stop();
+}
+
+void AssetIndexer::start(std::vector<fs::path> newRoots, fs::path newIndexPath)
+{
+	stop();
+	roots = std::move(newRoots);
+	indexPath = std::move(newIndexPath);
+	stopRequested = false;
+	rescanRequested = false;
+	worker = std::thread(&AssetIndexer::run, this);
+}
+
+void AssetIndexer::stop()
+{
+	if (!worker.joinable())
+	{
+		return;
+	}
+	{
+		std::lock_guard lock(mutex);
+		stopRequested = true;
+	}
+	wake.notify_all();
+	worker.join();
+}
+
+void AssetIndexer::requestRescan()
+{
+	{
+		std::lock_guard lock(mutex);
+		rescanRequested = true;
+	}
+	wake.notify_all();
+}
+
+AssetIndexer::Snapshot AssetIndexer::getSnapshot() const
+{
+	std::lock_guard lock(mutex);
+	return snapshot;
+}
+
+bool AssetIndexer::isIndexedAsset(const fs::path &path)
+{
+	const std::string extension = lowerExtension(path);
+	return extension == ".gltf" || extension == ".glb";
+}
+
+std::optional<AssetRecord> AssetIndexer::describeFile(const fs::path &path, const AssetRecord *previous)
+{
+	std::error_code ec;
+	const auto size = fs::file_size(path, ec);
+	if (ec)
+	{
+		return std::nullopt;
+	}
+	const auto modified = fs::last_write_time(path, ec);
+	if (ec)
+	{
+		return std::nullopt;
+	}
+
+	AssetRecord record;
+	record.path = path.lexically_normal().string();
+	record.size = size;
+	record.modifiedTime = static_cast<int64_t>(modified.time_since_epoch().count());
+	if (previous && previous->size == record.size && previous->modifiedTime == record.modifiedTime)
+	{
+		AssetRecord reused = *previous;
+		reused.path = std::move(record.path);
+		return reused;
+	}
+
+	if (!hashFile(path, record.contentHash))
+	{
+		return std::nullopt;
+	}
+	// A malformed asset is skipped rather than ending the indexer thread.
+	try
+	{
+		record.summaryValid = summarizeGltf(path, record);
+	}
+	catch (const std::exception &)
+	{
+		return std::nullopt;
+	}
+	return record;
+}
+
+bool AssetIndexer::readIndexFile(const fs::path &indexPath, std::vector<AssetRecord> &outRecords, std::string *errorMessage)
+{
+	std::ifstream stream(indexPath);
+	if (!stream.is_open())
+	{
+		setError(errorMessage, "Failed to open asset index: " + indexPath.string());
+		return false;
+	}
+
+	const json payload = json::parse(stream, nullptr, false);
+	if (payload.is_discarded() || !payload.is_object() || payload.value("version", 0) != kIndexFormatVersion)
+	{
+		setError(errorMessage, "Asset index is not a version " + std::to_string(kIndexFormatVersion) + " index: " + indexPath.string());
+		return false;
+	}
+
+	std::vector<AssetRecord> records;
+	if (const auto assets = payload.find("assets"); assets != payload.end() && assets->is_array())
+	{
+		records.reserve(assets->size());
+		for (const auto &entry : *assets)
+		{
+			if (!entry.is_object() || !entry.contains("path"))
+			{
+				continue;
+			}
+			AssetRecord record;
+			record.path = entry.value("path", "");
+			record.size = entry.value("size", uint64_t{0});
+			record.modifiedTime = entry.value("mtime", int64_t{0});
+			record.contentHash = entry.value("hash", uint64_t{0});
+			record.meshCount = entry.value("meshes", 0u);
+			record.textureCount = entry.value("textures", 0u);
+			record.animationCount = entry.value("animations", 0u);
+			record.summaryValid = entry.value("summary_valid", false);
+			records.push_back(std::move(record));
+		}
+	}
+	outRecords = std::move(records);
+	return true;
+}
+
+bool AssetIndexer::writeIndexFile(const fs::path &indexPath, const std::vector<AssetRecord> &records, std::string *errorMessage)
+{
+	json assets = json::array();
+	for (const auto &record : records)
+	{
+		assets.push_back({{"path", record.path},
+		                  {"size", record.size},
+		                  {"mtime", record.modifiedTime},
+		                  {"hash", record.contentHash},
+		                  {"meshes", record.meshCount},
+		                  {"textures", record.textureCount},
+		                  {"animations", record.animationCount},
+		                  {"summary_valid", record.summaryValid}});
+	}
+	const json payload = {{"version", kIndexFormatVersion}, {"assets", std::move(assets)}};
+
+	std::error_code ec;
+	if (indexPath.has_parent_path())
+	{
+		fs::create_directories(indexPath.parent_path(), ec);
+	}
+
+	// Written next to the index and renamed over it, so a crash never leaves a truncated index behind.
+	fs::path temporaryPath = indexPath;
+	temporaryPath += ".tmp";
+	{
+		std::ofstream stream(temporaryPath, std::ios::trunc);
+		if (!stream.is_open())
+		{
+			setError(errorMessage, "Failed to write asset index: " + temporaryPath.string());
+			return false;
+		}
+		stream << payload.dump() << '\n';
+		if (!stream)
+		{
+			setError(errorMessage, "Failed to write asset index: " + temporaryPath.string());
+			return false;
+		}
+	}
+	fs::rename(temporaryPath, indexPath, ec);
+	if (ec)
+	{
+		setError(errorMessage, "Failed to replace asset index: " + ec.message());
+		return false;
+	}
+	return true;
+}
+
+void AssetIndexer::run()
+{
+	RecordMap                records;
+	std::vector<AssetRecord> stored;
+	if (!indexPath.empty() && readIndexFile(indexPath, stored))
+	{
+		for (auto &record : stored)
+		{
+			std::string key = record.path;
+			records.emplace(std::move(key), std::move(record));
+		}
+		publish(records);        // browsable right away; the first scan then corrects it
+	}
+	watchRoots(records);
+}
+
+bool AssetIndexer::scanRoots(RecordMap &records)
+{
+	scanning = true;
+	RecordMap next;
+	for (const auto &root : roots)
+	{
+		std::error_code ec;
+		for (auto it = fs::recursive_directory_iterator(root, fs::directory_options::skip_permission_denied, ec);
+		     !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+		{
+			if (stopRequested)
+			{
+				scanning = false;
+				return false;
+			}
+			if (!isIndexedAsset(it->path()) || !it->is_regular_file(ec))
+			{
+				continue;
+			}
+			const auto previous = records.find(it->path().lexically_normal().string());
+			if (auto record = describeFile(it->path(), previous != records.end() ? &previous->second : nullptr))
+			{
+				std::string key = record->path;
+				next.emplace(std::move(key), std::move(*record));
+			}
+		}
+	}
+
+	const bool changed = next != records;
+	records.swap(next);
+	scanning = false;
+	return changed;
+}
+
+void AssetIndexer::watchRoots(RecordMap &records)
+{
+	auto lastPersist = std::chrono::steady_clock::now();
+	bool unsaved = false;
+	const auto commit = [&](bool changed) {
+		if (changed)
+		{
+			publish(records);
+			unsaved = true;
+		}
+		// Bursts of changes (an export writing many files) rewrite the index at most once per interval.
+		const auto now = std::chrono::steady_clock::now();
+		if (unsaved && now - lastPersist >= kPersistInterval)
+		{
+			persist(records);
+			unsaved = false;
+			lastPersist = now;
+		}
+	};
+
+#ifdef __linux__
+	DirectoryWatch watch;
+	bool           watching = false;
+	bool           needScan = true;
+	while (!stopRequested)
+	{
+		if (takeRescanRequest() || needScan)
+		{
+			// Watches go in before the walk, so files created during it are reported rather than missed.
+			watching = watch.reset(roots);
+			needScan = false;
+			commit(scanRoots(records));
+		}
+		if (!watching)
+		{
+			waitForWork(kPollInterval);
+			needScan = true;
+			continue;
+		}
+
+		std::vector<fs::path> touched;
+		watch.read(kWatchTimeoutMs, touched, needScan);
+		bool changed = false;
+		for (const auto &path : touched)
+		{
+			std::error_code ec;
+			const std::string key = path.lexically_normal().string();
+			if (fs::is_directory(path, ec))
+			{
+				watch.addTree(path);
+				for (auto it = fs::recursive_directory_iterator(path, fs::directory_options::skip_permission_denied, ec);
+				     !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+				{
+					if (isIndexedAsset(it->path()) && it->is_regular_file(ec))
+					{
+						if (auto record = describeFile(it->path()))
+						{
+							std::string recordKey = record->path;
+							records.insert_or_assign(std::move(recordKey), std::move(*record));
+							changed = true;
+						}
+					}
+				}
+			}
+			else if (isIndexedAsset(path) && fs::is_regular_file(path, ec))
+			{
+				const auto previous = records.find(key);
+				auto       record = describeFile(path, previous != records.end() ? &previous->second : nullptr);
+				if (record && (previous == records.end() || previous->second != *record))
+				{
+					records.insert_or_assign(key, std::move(*record));
+					changed = true;
+				}
+			}
+			else
+			{
+				changed |= eraseRecords(records, key);
+			}
+		}
+		commit(changed);
+	}
+#else
+	while (!stopRequested)
+	{
+		takeRescanRequest();
+		commit(scanRoots(records));
+		waitForWork(kPollInterval);
+	}
+#endif
+
+	if (unsaved)
+	{
+		persist(records);
+	}
+}
+
+void AssetIndexer::publish(const RecordMap &records)
+{
+	auto next = std::make_shared<std::vector<AssetRecord>>();
+	next->reserve(records.size());
+	for (const auto &[path, record] : records)
+	{
+		next->push_back(record);
+	}
+	{
+		std::lock_guard lock(mutex);
+		snapshot = std::move(next);
+	}
+	version.fetch_add(1, std::memory_order_release);
+}
+
+void AssetIndexer::persist(const RecordMap &records) const
+{
+	if (indexPath.empty())
+	{
+		return;
+	}
+	std::vector<AssetRecord> list;
+	list.reserve(records.size());
+	for (const auto &[path, record] : records)
+	{
+		list.push_back(record);
+	}
+	writeIndexFile(indexPath, list);
+}
+
+bool AssetIndexer::takeRescanRequest()
+{
+	std::lock_guard lock(mutex);
+	return std::exchange(rescanRequested, false);
+}
+
+void AssetIndexer::waitForWork(std::chrono::milliseconds timeout)
+{
+	std::unique_lock lock(mutex);
+	wake.wait_for(lock, timeout, [this] { return stopRequested.load() || rescanRequested; });
+}
+}        // namespace LaphriaEditor
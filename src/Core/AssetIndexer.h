@@ -0,0 +1,96 @@
+#ifndef LAPHRIAENGINE_ASSETINDEXER_H
+#define LAPHRIAENGINE_ASSETINDEXER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace LaphriaEditor
+{
+struct AssetRecord
+{
+	std::string path;
+	uint64_t    size = 0;
+	int64_t     modifiedTime = 0;        // file clock ticks, compared for equality only
+	uint64_t    contentHash = 0;         // FNV-1a over the file contents
+	uint32_t    meshCount = 0;
+	uint32_t    textureCount = 0;
+	uint32_t    animationCount = 0;
+	bool        summaryValid = false;        // false when the glTF JSON could not be read
+
+	bool operator==(const AssetRecord &) const = default;
+};
+
+// Keeps an index of the glTF assets under a set of roots on a background thread. The index is persisted as
+// JSON, so a restart only re-reads files whose size or modification time changed. On Linux the roots are
+// watched with inotify and only the reported paths are re-examined; elsewhere the roots are re-walked
+// periodically, which costs one stat per file. Readers get immutable snapshots and never wait for a scan.
+class AssetIndexer
+{
+  public:
+	using Snapshot = std::shared_ptr<const std::vector<AssetRecord>>;
+
+	AssetIndexer() = default;
+	~AssetIndexer();
+	AssetIndexer(const AssetIndexer &) = delete;
+	AssetIndexer &operator=(const AssetIndexer &) = delete;
+
+	// Stops any running indexer, loads indexPath (may be empty for no persistence) and starts watching roots.
+	void start(std::vector<std::filesystem::path> roots, std::filesystem::path indexPath);
+	void stop();
+	// Re-walks every root; unchanged files keep their recorded hash and summary.
+	void requestRescan();
+
+	// Records sorted by path. getVersion() changes whenever a new snapshot is published.
+	[[nodiscard]] Snapshot getSnapshot() const;
+	[[nodiscard]] uint64_t getVersion() const
+	{
+		return version.load(std::memory_order_acquire);
+	}
+	[[nodiscard]] bool isScanning() const
+	{
+		return scanning.load(std::memory_order_relaxed);
+	}
+
+	static bool isIndexedAsset(const std::filesystem::path &path);
+	// Describes the file at path, reusing previous when its size and modification time still match.
+	static std::optional<AssetRecord> describeFile(const std::filesystem::path &path, const AssetRecord *previous = nullptr);
+	static bool readIndexFile(const std::filesystem::path &indexPath, std::vector<AssetRecord> &outRecords, std::string *errorMessage = nullptr);
+	static bool writeIndexFile(const std::filesystem::path &indexPath, const std::vector<AssetRecord> &records, std::string *errorMessage = nullptr);
+
+  private:
+	using RecordMap = std::map<std::string, AssetRecord>;
+
+	void run();
+	bool scanRoots(RecordMap &records);
+	void watchRoots(RecordMap &records);
+	void publish(const RecordMap &records);
+	void persist(const RecordMap &records) const;
+	bool takeRescanRequest();
+	void waitForWork(std::chrono::milliseconds timeout);
+
+	std::vector<std::filesystem::path> roots;
+	std::filesystem::path              indexPath;
+	std::thread                        worker;
+
+	mutable std::mutex      mutex;
+	std::condition_variable wake;
+	bool                    rescanRequested = false;
+	Snapshot                snapshot = std::make_shared<const std::vector<AssetRecord>>();
+
+	std::atomic<bool>     stopRequested{false};
+	std::atomic<uint64_t> version{0};
+	std::atomic<bool>     scanning{false};
+};
+}        // namespace LaphriaEditor
+
+#endif        // LAPHRIAENGINE_ASSETINDEXER_H
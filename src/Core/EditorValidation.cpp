@@ -1,4 +1,5 @@
 #include "EditorValidation.h"
+#include "../SceneManagement/SceneJsonStream.h"
 
 #include <filesystem>
 #include <fstream>
@@ -176,32 +177,34 @@ void validateProjectPayload(const json &payload, const std::string &file, Valida
     }
 }
 
-void validateSceneNode(const json &node,
-                       const std::string &file,
-                       const std::string &fieldPath,
-                       ValidationReport &report)
+// Collects schema errors from the streaming scene reader. Node contents are not retained.
+class SceneValidationHandler final : public Laphria::SceneJson::SceneReadHandler
 {
-    if (!node.is_object())
+  public:
+    SceneValidationHandler(const std::string &file, ValidationReport &report) :
+        file(file), report(report)
     {
-        report.addError(file, fieldPath, "Scene node must be an object.");
-        return;
     }
 
-    if (node.contains("children"))
+    bool beginNode(uint32_t, int32_t) override
     {
-        if (!node["children"].is_array())
-        {
-            report.addError(file, fieldPath + ".children", "Expected an array.");
-            return;
-        }
+        return true;
+    }
 
-        const auto &children = node["children"];
-        for (size_t i = 0; i < children.size(); ++i)
-        {
-            validateSceneNode(children[i], file, fieldPath + ".children[" + std::to_string(i) + "]", report);
-        }
+    bool endNode(uint32_t, const Laphria::SceneJson::NodeFields &) override
+    {
+        return true;
+    }
+
+    void onError(const std::string &fieldPath, const std::string &message) override
+    {
+        report.addError(file, fieldPath, message);
     }
-}
+
+  private:
+    const std::string &file;
+    ValidationReport  &report;
+};
 
 std::string inferScenePathFromProject(const std::string &projectPath, ValidationReport &report)
 {
@@ -320,19 +323,16 @@ ValidationReport EditorValidator::validateSceneFile(const std::string &path)
 {
     ValidationReport report;
 
-    json payload;
-    if (!loadJsonFile(path, payload, report))
-    {
-        return report;
-    }
-
-    if (!payload.is_object())
+    std::ifstream stream(path);
+    if (!stream.is_open())
     {
-        report.addError(path, "$", "Scene file must be a JSON object.");
+        report.addError(path, "$", "Failed to open file.");
         return report;
     }
 
-    validateSceneNode(payload, path, "$", report);
+    // Same streaming reader as Scene::loadScene; keeps going after schema errors so all of them are listed.
+    SceneValidationHandler handler(path, report);
+    Laphria::SceneJson::readScene(stream, handler, true);
     return report;
 }
 
@@ -3,9 +3,12 @@
 
 #include <cstdio>
 #include <cstdint>
+#include <limits>
 #include <glm/glm.hpp>
 #include <glm/gtx/hash.hpp>
 
+#include "EngineConfig.h"
+
 #if defined(__INTELLISENSE__) || !defined(USE_CPP20_MODULES)
 #	include <vulkan/vulkan_raii.hpp>
 #else
@@ -125,22 +128,174 @@ struct UniformBufferObject
 	// Path tracer temporal fields
 	alignas(16) glm::mat4 prevViewProj;   // previous frame VP for motion vector reprojection
 	alignas(4)  uint32_t  frameCount;     // monotonically increasing; seeds per-pixel RNG in Raygen
-	alignas(4)  float     jitter_x;       // sub-pixel x jitter in NDC (Halton sequence, zero when TAA disabled)
-	alignas(4)  float     jitter_y;       // sub-pixel y jitter in NDC
-	alignas(4)  uint32_t  _pad0;          // padding for 16-byte struct alignment
+	alignas(4)  float     jitter_x;       // sub-pixel x jitter in pixels (Halton sequence, zero when unused)
+	alignas(4)  float     jitter_y;       // sub-pixel y jitter in pixels
+	alignas(4)  uint32_t  punctualLightCount = 0; // entries in the punctual light buffer (global set binding 3)
 	alignas(4)  float     exposure = 1.0f; // global tone-mapping exposure scalar
-	alignas(4)  uint32_t  textureColorSpaceModel = static_cast<uint32_t>(TextureColorSpaceModel::HardwareSrgb);
-	alignas(16) glm::vec3 _padExposure = glm::vec3(0.0f);
+	alignas(4)  uint32_t  _pad0 = 0;             // the texture colour-space model is a specialization constant
+	alignas(4)  float     cameraNear = 0.1f;     // main camera planes, for the light cluster depth slices
+	alignas(4)  float     cameraFar  = 1000.0f;
+	alignas(4)  float     textureLodBias = 0.0f; // mip bias on material textures (frame-time controller)
+	alignas(4)  uint32_t  renderWidth  = 1;      // raster and classic RT render extent; converts the jitter to clip space
+	alignas(4)  uint32_t  renderHeight = 1;
+	alignas(4)  float     _padRenderExtent = 0.0f;
 };
 
 struct DenoisePushConstants
 {
-	int32_t stepSize;    // A-Trous step size: 1, 2, 4, 8, 16 for iterations 0-4; unused in reprojection pass
+	int32_t stepSize;    // A-Trous step size: 1, 2, 4, 8, 16 for iterations 0-4; 0 in reprojection pass
 	int32_t isLastPass;  // 1 on the final A-Trous iteration: triggers tone mapping + history copy
-	float   phiColor;    // luminance edge-stopping weight (typical: 10.0)
-	float   phiNormal;   // normal edge-stopping exponent (typical: 128.0)
+	float   phiColor;    // luminance edge-stopping weight (typical: 10.0); reprojection: minimum history blend weight
+	float   phiNormal;   // normal edge-stopping exponent (typical: 128.0); reprojection: variance clamp width in sigmas
 	float   exposureScale; // global exposure multiplier applied on final denoise pass
-	int32_t useRawInput;
+	uint32_t renderWidth;  // reprojection and tiled A-Trous: traced region of the full-size PT images
+	uint32_t renderHeight;
+	int32_t  resetHistory; // reprojection only: 1 discards all history (scene edit, mode switch, resize)
+	float    atrousPhiColor;  // fused reprojection + A-Trous pass only: edge-stopping weights of its filter step
+	float    atrousPhiNormal;
+};
+
+// Sample budget pass (SampleBudget.slang). Pushed through the denoiser pipeline layout, whose range is
+// sized for DenoisePushConstants.
+struct SampleBudgetPushConstants
+{
+	uint32_t renderWidth;
+	uint32_t renderHeight;
+	float    budgetScale;  // paths spent per unit of estimated relative error; tuned towards targetFrameMs
+	uint32_t maxSamples;   // per-pixel cap, 0 disables adaptive sampling (every pixel gets one path)
+	uint32_t allowSkip;    // 1 when nothing moved: converged pixels may trace no continuation paths
+	uint32_t frameIndex;   // staggers the refresh of skipped pixels
+	uint32_t resetHistory; // 1 when reprojection discards history this frame: every pixel gets maxSamples
+};
+static_assert(sizeof(SampleBudgetPushConstants) <= sizeof(DenoisePushConstants), "sample budget push constants exceed the denoiser push range");
+
+// Progressive reference accumulation (ProgressiveAccumulate.slang), also pushed through the denoiser layout.
+struct ProgressivePushConstants
+{
+	uint32_t renderWidth;
+	uint32_t renderHeight;
+	uint32_t sampleIndex;    // dispatches already in the accumulation buffer; 0 restarts it
+	uint32_t addSample;      // 0 once converged: only resolve the accumulated mean to the output
+	float    exposureScale;
+	float    noiseThreshold; // relative standard error a pixel must reach; 0 disables the noise count
+};
+static_assert(sizeof(ProgressivePushConstants) <= sizeof(DenoisePushConstants), "progressive push constants exceed the denoiser push range");
+
+// Temporal upscaler (TemporalUpscale.slang): reconstructs the native-resolution image from the jittered
+// render extent of the raster or classic RT backend.
+struct UpscalePushConstants
+{
+	uint32_t renderWidth;
+	uint32_t renderHeight;
+	uint32_t outputWidth;
+	uint32_t outputHeight;
+	uint32_t inputMode;      // 0: raster colour + depth, 1: classic RT colour + motion vectors
+	uint32_t resetHistory;   // 1 when the history holds no frame of this backend (first frame, mode switch, resize)
+};
+
+// Wavefront path tracer (WavefrontPathTracer.slang) — push constants and queue records, must mirror the shader.
+struct WavefrontPushConstants
+{
+	uint32_t renderWidth;
+	uint32_t renderHeight;
+	uint32_t chunkBase;      // first pixel of the chunk, row-major over the render extent
+	uint32_t chunkSize;      // pixels in the chunk, at most kWavefrontMaxPaths
+	uint32_t queueCapacity;  // kWavefrontMaxPaths: offset of the second path queue
+	uint32_t pathIndex;      // path of every pixel in flight (Generate and the bounces after it)
+	uint32_t bounce;         // 0 shades the primary hit
+	uint32_t queueIndex;     // path queue this bounce reads; Shade appends continuations to the other one
+	uint32_t sortHits;       // 1: Shade reads the hit queue in material bin order
+};
+
+struct WavefrontHitRecord
+{
+	uint32_t  instanceIndex;
+	uint32_t  geometryIndex;
+	uint32_t  primitiveIndex;
+	uint32_t  pathSlot;       // pixel offset within the chunk
+	glm::vec2 barycentrics;
+	float     hitT;           // < 0: the ray escaped (primary hits only)
+	uint32_t  materialBin;
+};
+
+struct WavefrontPathState
+{
+	alignas(16) glm::vec3 origin;
+	uint32_t              slot;
+	alignas(16) glm::vec3 direction;
+	uint32_t              rngState;
+	alignas(16) glm::vec3 throughput;
+	uint32_t              _pad;
+};
+
+struct WavefrontShadowRecord
+{
+	alignas(16) glm::vec3 origin;
+	uint32_t              slot;
+	alignas(16) glm::vec3 sunContribution;       // zero: no sun ray
+	float                 punctualTMax;
+	alignas(16) glm::vec3 punctualDirection;
+	uint32_t              flags;                 // bit 0: sun ray, bit 1: punctual ray
+	alignas(16) glm::vec3 punctualContribution;
+	float                 _pad;
+};
+static_assert(sizeof(WavefrontHitRecord) == 32 && sizeof(WavefrontPathState) == 48 && sizeof(WavefrontShadowRecord) == 64,
+              "wavefront records must match WavefrontPathTracer.slang");
+
+// Wavefront control buffer, in uints: queue counters, the indirect dispatch arguments of the trace and shade
+// kernels, then the material bin histogram and the bin cursors of the scatter pass.
+constexpr uint32_t kWavefrontControlHitCount   = 0;
+constexpr uint32_t kWavefrontControlPathCount  = 1;
+constexpr uint32_t kWavefrontControlTraceArgs  = 4;        // VkDispatchIndirectCommand + active path count
+constexpr uint32_t kWavefrontControlShadeArgs  = 8;        // VkDispatchIndirectCommand + hit count
+constexpr uint32_t kWavefrontControlBinCounts  = 16;
+constexpr uint32_t kWavefrontControlBinCursors = kWavefrontControlBinCounts + EngineConfig::kWavefrontMaterialBins;
+constexpr uint32_t kWavefrontControlUintCount  = kWavefrontControlBinCursors + EngineConfig::kWavefrontMaterialBins;
+
+// Raster occlusion culling (OcclusionCulling.slang) — must mirror the shader.
+struct HiZReducePushConstants
+{
+	uint32_t srcWidth;       // source region: the render extent of the depth image, or the previous mip
+	uint32_t srcHeight;
+	uint32_t dstWidth;       // mip being written
+	uint32_t dstHeight;
+};
+
+struct OcclusionCullPushConstants
+{
+	glm::mat4 viewProjection;        // unjittered camera matrix the first phase was drawn with
+	uint32_t  candidateCount;
+	uint32_t  pyramidWidth;          // mip 0 of the depth pyramid
+	uint32_t  pyramidHeight;
+	uint32_t  pyramidMipCount;
+	uint32_t  renderWidth;           // depth extent the pyramid was reduced from
+	uint32_t  renderHeight;
+};
+
+// One mesh instance in world space and the late draws it owns (none when the first phase drew it).
+struct OcclusionCandidate
+{
+	glm::vec4 boundsMin;             // xyz: world-space AABB
+	glm::vec4 boundsMax;
+	uint32_t  firstDraw;             // into the frame's VkDrawIndexedIndirectCommand array
+	uint32_t  drawCount;
+	uint32_t  _pad0;
+	uint32_t  _pad1;
+};
+static_assert(sizeof(OcclusionCandidate) == 48, "OcclusionCandidate must match OcclusionCulling.slang");
+
+// Occlusion result buffer, in uints: counters written by the cull pass, then one visibility flag per candidate.
+constexpr uint32_t kOcclusionResultVisibleCount = 0;
+constexpr uint32_t kOcclusionResultLateCount    = 1;        // candidates drawn by the second phase
+constexpr uint32_t kOcclusionResultHeaderUints  = 4;
+
+// Per TLAS instance (indexed by InstanceIndex()) data for path tracer object motion vectors — must mirror
+// InstanceMotion in ShaderCommon.slang.
+struct InstanceMotionData
+{
+	alignas(16) glm::vec4 prevObjectToWorld[3];                  // previous frame transform, 3x4 row-major
+	alignas(4) uint32_t   hasPrevSkinnedPositions = 0;           // 1: the model's previous skinned positions are bound
+	alignas(4) uint32_t   _pad[3]                 = {0, 0, 0};
 };
 
 struct SkinningPushConstants
@@ -204,7 +359,14 @@ struct MaterialData
 	alignas(4) float occlusionStrength    = 1.0f;
 	alignas(16) glm::vec3 emissiveFactor  = glm::vec3(0.0f);
 	alignas(4) float specularFactor       = 1.0f;
-	alignas(4) float alphaCutoff          = 0.5f;
+	alignas(4) float alphaCutoff          = 0.5f;        // <= 0 disables the alpha test (glTF OPAQUE)
+
+	// True when the alpha test can never discard: it is disabled, or there is no base color texture and the
+	// factor alone passes. BLAS geometry for such materials is built opaque, so traversal skips any-hit.
+	[[nodiscard]] bool isAlphaTestFree() const
+	{
+		return alphaCutoff <= 0.0f || (baseColorIndex < 0 && baseColorFactor.a >= alphaCutoff);
+	}
 };
 
 // CPU-side material description
@@ -233,6 +395,9 @@ struct LoadedMesh
 {
 	std::string                name;
 	std::vector<MeshPrimitive> primitives;
+	// Object-space AABB of every primitive's vertices (bind pose for skinned meshes); min > max when empty.
+	glm::vec3                  boundsMin{std::numeric_limits<float>::max()};
+	glm::vec3                  boundsMax{std::numeric_limits<float>::lowest()};
 };
 }        // namespace Laphria
 
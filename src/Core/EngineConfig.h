@@ -11,13 +11,39 @@ constexpr uint32_t kMaxPhysicsObjects = 10000;
 constexpr uint32_t kMaxTLASInstances = 10000;
 
 constexpr uint32_t kBindlessModelCapacity = 1000;
+constexpr uint32_t kMaxModelPrefetchWorkers = 8;
 constexpr uint32_t kDescriptorPoolScale = 1000;
 
 constexpr float kMainCameraFovDegrees = 45.0f;
 constexpr float kMainCameraNearPlane = 0.1f;
 constexpr float kMainCameraFarPlane = 1000.0f;
 
+// Imported punctual lights and the raster path's clustered culling grid (mirrored in ShaderCommon.slang).
+// Each cluster holds a count followed by up to kMaxLightsPerCluster light indices.
+constexpr uint32_t kMaxPunctualLights = 1024;
+constexpr uint32_t kLightClusterCountX = 16;
+constexpr uint32_t kLightClusterCountY = 9;
+constexpr uint32_t kLightClusterCountZ = 24;
+constexpr uint32_t kMaxLightsPerCluster = 63;
+constexpr uint32_t kLightClusterCount = kLightClusterCountX * kLightClusterCountY * kLightClusterCountZ;
+
+// Wavefront path tracer queues: paths in flight per chunk of pixels (one per pixel), and the material bins
+// hits are sorted into before shading (mirrored in WavefrontPathTracer.slang).
+constexpr uint32_t kWavefrontMaxPaths = 1u << 18;
+constexpr uint32_t kWavefrontMaterialBins = 256;
+
+// Raster occlusion culling: mesh instances tested against the depth pyramid per frame, and the late (second
+// phase) draws they can own. Instances past the first limit are drawn in the first phase untested.
+constexpr uint32_t kMaxOcclusionCandidates = 16384;
+constexpr uint32_t kMaxOcclusionDraws = 65536;
+
+// Driver pipeline cache, written next to the executable on shutdown and reloaded on the next start.
+constexpr const char *kPipelineCacheFile = "PipelineCache.bin";
+
 constexpr float kPhysicsBroadphaseCellSize = 4.0f;
+
+constexpr uint64_t kSceneJournalCompactBytes = 4ull * 1024ull * 1024ull;
+constexpr float kDefaultSceneAutosaveIntervalSeconds = 30.0f;
 } // namespace Laphria::EngineConfig
 
 #endif // LAPHRIAENGINE_ENGINECONFIG_H
@@ -4,8 +4,10 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -27,19 +29,77 @@ using namespace Laphria;
 
 namespace
 {
-constexpr uint32_t kPtTimestampQueryCountPerFrame = 8;
+constexpr uint32_t kPtMaxDenoiserIterations = 5;
+constexpr uint32_t kPtMaxSamplesPerPixel = 8; // must match MAX_PATHS_PER_PIXEL in PathTracing.slang
+constexpr float kPtMinSampleBudgetScale = 0.25f;
+constexpr float kPtMaxSampleBudgetScale = 8.0f;
+constexpr uint32_t kTimestampQueryCountPerFrame = 12 + kPtMaxDenoiserIterations;
+// Progressive mode's noise stop: converged once at most this share of pixels is above the threshold.
+constexpr float kPtProgressiveConvergedPixelFraction = 0.001f;
+constexpr float kPtProgressiveHistoryIntervalSeconds = 0.25f;
 constexpr double kWindowTitleUpdateIntervalSeconds = 0.5;
-enum PtTimestampSlot : uint32_t
+// Every backend brackets its passes with these; a slot left unwritten reads back as 0.
+enum GpuTimestampSlot : uint32_t
 {
-    kPtTS_TlasStart = 0,
-    kPtTS_TlasEnd = 1,
-    kPtTS_RayTraceStart = 2,
-    kPtTS_RayTraceEnd = 3,
-    kPtTS_ReprojectionStart = 4,
-    kPtTS_ReprojectionEnd = 5,
-    kPtTS_DenoiserStart = 6,
-    kPtTS_DenoiserEnd = 7
+    kTS_FrameStart = 0,
+    kTS_FrameEnd = 1,
+    kTS_TlasStart = 2,
+    kTS_TlasEnd = 3,
+    kTS_ShadowStart = 4,
+    kTS_ShadowEnd = 5,
+    kTS_SceneStart = 6, // raster main pass, classic RT trace or PT trace
+    kTS_SceneEnd = 7,
+    kTS_ReprojectionStart = 8,
+    kTS_ReprojectionEnd = 9,
+    kTS_DenoiserStart = 10,
+    kTS_DenoiserEnd = 11,
+    kTS_DenoiserIterationEnd = 12 // one per A-Trous iteration
 };
+// UpscalePushConstants::inputMode, mirrored by UPSCALE_INPUT_* in TemporalUpscale.slang.
+constexpr uint32_t kUpscaleInputRaster = 0;
+constexpr uint32_t kUpscaleInputRayTracer = 1;
+// Upscaler jitter phases per native pixel area: the sequence grows with the upscale ratio so every native
+// pixel keeps seeing samples close to its centre.
+constexpr float kUpscaleJitterPhasesPerPixel = 8.0f;
+
+FrameTimeBackend frameTimeBackend(RenderMode mode)
+{
+    switch (mode) {
+        case RenderMode::PathTracer:
+            return FrameTimeBackend::PathTracer;
+        case RenderMode::RayTracer:
+            return FrameTimeBackend::RayTracer;
+        default:
+            return FrameTimeBackend::Rasterizer;
+    }
+}
+
+// Radical inverse of index in the given base: the Halton sequence in [0, 1).
+float halton(uint32_t index, uint32_t base)
+{
+    float result = 0.0f;
+    float fraction = 1.0f / static_cast<float>(base);
+    while (index > 0) {
+        result += fraction * static_cast<float>(index % base);
+        index /= base;
+        fraction /= static_cast<float>(base);
+    }
+    return result;
+}
+
+// Object-space box a mesh is drawn within: for a skinned model the pose its skinned stream holds (one box for
+// all its meshes), otherwise the import bounds. False when there is nothing to test.
+bool meshCullBounds(const ModelResource &model, const LoadedMesh &mesh, glm::vec3 &localMin, glm::vec3 &localMax)
+{
+    if (model.hasRuntimeSkinning) {
+        localMin = model.skinnedPoseMin;
+        localMax = model.skinnedPoseMax;
+        return !model.skinnedBounds.empty();
+    }
+    localMin = mesh.boundsMin;
+    localMax = mesh.boundsMax;
+    return mesh.boundsMin.x <= mesh.boundsMax.x;
+}
 }
 
 EngineCore::EngineCore(EngineHostOptions optionsIn, EngineHostCallbacks callbacksIn)
@@ -175,7 +235,7 @@ void EngineCore::initVulkan() {
     //     for the entire lifetime of the ResourceManager.
     //  4. Descriptor set layouts must precede pipeline creation.
     //  5. Descriptor sets must be written after both pool and uniform buffers/images exist.
-    vulkan.init(window);
+    vulkan.init(window, options.allowRayTracing);
     vulkanInitialized = true;
     swapchain.init(vulkan, window);
     imagesInFlight.assign(swapchain.images.size(), vk::Fence{});
@@ -184,6 +244,7 @@ void EngineCore::initVulkan() {
 
     resourceManager = std::make_unique<ResourceManager>(vulkan.logicalDevice, vulkan.physicalDevice, frames.commandPool, vulkan.queue,
                                                         descriptorPool);
+    resourceManager->setRayTracingEnabled(vulkan.rayTracingSupported);
     scene = std::make_unique<Scene>();
     constexpr float bounds = Laphria::EngineConfig::kDefaultSceneBoundsExtent;
     scene->init({{-bounds, -bounds, -bounds}, {bounds, bounds, bounds}});
@@ -191,18 +252,28 @@ void EngineCore::initVulkan() {
     physicsSystem = std::make_unique<PhysicsSystem>();
 
     pipelines.createDescriptorSetLayouts(vulkan);
+    pipelines.createPipelineCache(vulkan);
+    pipelines.setShaderPermutation(vulkan, currentShaderPermutation());
 
     // Pipeline creation order matches dependency on the descriptor set layouts above.
     pipelines.createGraphicsPipeline(vulkan, swapchain.surfaceFormat.format, vulkan.findDepthFormat());
     pipelines.createShadowPipeline(vulkan);
     pipelines.createComputePipeline(vulkan);
     pipelines.createSkinningPipeline(vulkan);
+    pipelines.createLightCullingPipeline(vulkan);
     pipelines.createPhysicsPipeline(vulkan);
-    pipelines.createRayTracingPipeline(vulkan);
-    pipelines.createShaderBindingTable(vulkan);
+    if (vulkan.rayTracingSupported) {
+        pipelines.createRayTracingPipeline(vulkan);
+        pipelines.createShaderBindingTable(vulkan);
+        pipelines.createClassicRTPipeline(vulkan);
+        pipelines.createClassicRTShaderBindingTable(vulkan);
+    }
+    if (vulkan.rayQuerySupported) {
+        pipelines.createWavefrontPipelines(vulkan);
+    }
     pipelines.createDenoiserPipelines(vulkan);
-    pipelines.createClassicRTPipeline(vulkan);
-    pipelines.createClassicRTShaderBindingTable(vulkan);
+    pipelines.createUpscalePipeline(vulkan);
+    pipelines.createOcclusionCullingPipelines(vulkan);
 
     resourceManager->setSkinningDescriptorSetLayout(*pipelines.skinningDescriptorSetLayout);
 
@@ -211,6 +282,9 @@ void EngineCore::initVulkan() {
     createPhysicsDescriptorSets();
     createRayTracingDescriptorSets();
     createDenoiserDescriptorSets();
+    createUpscaleDescriptorSets();
+    createWavefrontDescriptorSets();
+    createOcclusionDescriptorSets();
     createTimestampQueryPool();
 }
 
@@ -254,7 +328,11 @@ void EngineCore::mainLoop() {
 
             if (ui.useGPUPhysics) {
                 auto cmd = VulkanUtils::beginSingleTimeCommands(vulkan.logicalDevice, frames.commandPool);
-                physicsSystem->updateGPU(scene->getAllNodes(), deltaTime, cmd, pipelines.physicsPipelineLayout, pipelines.physicsPipeline, physicsDescriptorSet);
+                // Bodies edited on the host since the last GPU step; null forces a full upload.
+                const bool haveChanges = scene->collectTransformChangesSince(gpuPhysicsChangeFrame, gpuPhysicsChanges);
+                physicsSystem->updateGPU(scene->getPhysicsBodies(), scene->getComponentsVersion(), haveChanges ? &gpuPhysicsChanges : nullptr,
+                                         deltaTime, cmd, pipelines.physicsPipelineLayout, pipelines.physicsPipeline, physicsDescriptorSet);
+                gpuPhysicsChangeFrame = scene->getTransformChangeFrame();
                 cmd.end();
 
                 vk::raii::Fence physicsFence(vulkan.logicalDevice, vk::FenceCreateInfo{});
@@ -269,9 +347,9 @@ void EngineCore::mainLoop() {
                 }
 
                 // Readback immediately
-                physicsSystem->syncFromGPU(scene->getAllNodes());
+                physicsSystem->syncFromGPU(scene->getPhysicsBodies());
             } else {
-                physicsSystem->updateCPU(scene->getAllNodes(), deltaTime);
+                physicsSystem->updateCPU(scene->getPhysicsBodies(), deltaTime);
             }
 
             auto end = std::chrono::high_resolution_clock::now();
@@ -291,6 +369,10 @@ void EngineCore::mainLoop() {
         if (scene) {
             scene->syncSpatialIndex();
         }
+        if (scene && resourceManager) {
+            // Snapshots this frame's edits; the write happens on the scene's background writer.
+            scene->updateAutosave(deltaTime, *resourceManager);
+        }
 
         // If models were loaded during the UI frame, the RT descriptor sets (bindings 5-8:
         // vertex/index/material/texture arrays) must be rebuilt to include the new buffers.
@@ -307,6 +389,7 @@ void EngineCore::mainLoop() {
     }
 
     vulkan.logicalDevice.waitIdle();
+    pipelines.savePipelineCache();
 }
 
 void EngineCore::updatePerformanceWindowTitle(float deltaTimeSeconds)
@@ -371,12 +454,20 @@ void EngineCore::recreateSwapChain() {
     swapchain.init(vulkan, window);
     imagesInFlight.assign(swapchain.images.size(), vk::Fence{});
     frames.recreate(vulkan, swapchain);
-    // Compute, RT, and denoiser descriptor sets reference images that are recreated above
-    // (storageImages, rayTracingOutputImages, and G-Buffer images are extent-dependent),
-    // so all three must be rewritten after frames.recreate().
+    // Compute, RT, denoiser, upscaler and occlusion descriptor sets reference images that are recreated above
+    // (storageImages, rayTracingOutputImages, G-Buffer, scene target, depth and pyramid images are
+    // extent-dependent), so all five must be rewritten after frames.recreate().
     createComputeDescriptorSets();
     createRayTracingDescriptorSets();
     createDenoiserDescriptorSets();
+    createUpscaleDescriptorSets();
+    createOcclusionDescriptorSets();
+    // The longest wavefront schedule grows with the extent.
+    createWavefrontTimestampQueryPool();
+    // The recreated history and accumulation images start empty even when the extent did not change.
+    ptHistoryInvalid = true;
+    upscaleHistoryInvalid = true;
+    ptProgressiveActive = false;
 }
 
 void EngineCore::createPhysicsDescriptorSets() {
@@ -453,9 +544,14 @@ void EngineCore::createComputeDescriptorSets() {
 }
 
 void EngineCore::createRayTracingDescriptorSets() {
+    // The raster-only tier has neither the layout nor a TLAS to write.
+    if (!vulkan.rayTracingSupported) {
+        return;
+    }
     // One set per frame in flight; bindings shifted to accommodate the new G-Buffer images.
-    // RT set bindings: 0 = TLAS, 1 = noisy colour, 2 = normals, 3 = depth, 4 = motion vectors,
-    //                  5 = vertex arrays, 6 = index arrays, 7 = material arrays, 8 = texture array.
+    // RT set bindings: 0 = TLAS, 1 = noisy colour, 2 = packed normal + depth, 4 = motion vectors,
+    //                  5 = vertex arrays, 6 = index arrays, 7 = material arrays, 8 = texture array,
+    //                  9 = per-instance motion data, 10 = previous skinned position arrays.
     std::vector<vk::DescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, *pipelines.rayTracingDescriptorSetLayout);
 
     std::vector<uint32_t> variableDescCounts(MAX_FRAMES_IN_FLIGHT, Laphria::EngineConfig::kBindlessModelCapacity);
@@ -501,16 +597,16 @@ void EngineCore::createRayTracingDescriptorSets() {
             .dstSet = *rtDescriptorSets[i], .dstBinding = 1, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageImage, .pImageInfo = &rtOutputImageInfo
         };
 
-        // Binding 2 — G-Buffer world normals.
-        vk::DescriptorImageInfo normalsInfo{.imageView = *frames.rtGBufferNormalsViews[i], .imageLayout = vk::ImageLayout::eGeneral};
-        vk::WriteDescriptorSet normalsWrite{
-            .dstSet = *rtDescriptorSets[i], .dstBinding = 2, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageImage, .pImageInfo = &normalsInfo
+        // Binding 2 — G-Buffer octahedral world normal + linear depth.
+        vk::DescriptorImageInfo gBufferInfo{.imageView = *frames.rtGBufferViews[i], .imageLayout = vk::ImageLayout::eGeneral};
+        vk::WriteDescriptorSet gBufferWrite{
+            .dstSet = *rtDescriptorSets[i], .dstBinding = 2, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageImage, .pImageInfo = &gBufferInfo
         };
 
-        // Binding 3 — G-Buffer linear depth.
-        vk::DescriptorImageInfo depthInfo{.imageView = *frames.rtGBufferDepthViews[i], .imageLayout = vk::ImageLayout::eGeneral};
-        vk::WriteDescriptorSet depthWrite{
-            .dstSet = *rtDescriptorSets[i], .dstBinding = 3, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageImage, .pImageInfo = &depthInfo
+        // Binding 3 — per-pixel sample budget (written by the budget pass before traceRays).
+        vk::DescriptorImageInfo budgetInfo{.imageView = *frames.rtSampleBudgetViews[i], .imageLayout = vk::ImageLayout::eGeneral};
+        vk::WriteDescriptorSet budgetWrite{
+            .dstSet = *rtDescriptorSets[i], .dstBinding = 3, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageImage, .pImageInfo = &budgetInfo
         };
 
         // Binding 4 — motion vectors.
@@ -519,12 +615,19 @@ void EngineCore::createRayTracingDescriptorSets() {
             .dstSet = *rtDescriptorSets[i], .dstBinding = 4, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageImage, .pImageInfo = &mvInfo
         };
 
+        // Binding 9 — previous-frame instance transforms, rewritten by the TLAS update each frame.
+        vk::DescriptorBufferInfo motionInfo{*frames.tlasMotionBuffers[i], 0, VK_WHOLE_SIZE};
+        vk::WriteDescriptorSet motionWrite{
+            .dstSet = *rtDescriptorSets[i], .dstBinding = 9, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageBuffer, .pBufferInfo = &motionInfo
+        };
+
         std::vector<vk::WriteDescriptorSet> descriptorWrites;
         descriptorWrites.push_back(tlasWrite);
         descriptorWrites.push_back(rtOutputWrite);
-        descriptorWrites.push_back(normalsWrite);
-        descriptorWrites.push_back(depthWrite);
+        descriptorWrites.push_back(gBufferWrite);
+        descriptorWrites.push_back(budgetWrite);
         descriptorWrites.push_back(mvWrite);
+        descriptorWrites.push_back(motionWrite);
 
         // Now we extract ALL global vertices, indices, materials, and textures
         // across all Scene Nodes that have been uploaded into VRAM by ResourceManager
@@ -532,6 +635,7 @@ void EngineCore::createRayTracingDescriptorSets() {
         std::vector<vk::DescriptorBufferInfo> indexInfos;
         std::vector<vk::DescriptorBufferInfo> materialInfos;
         std::vector<vk::DescriptorImageInfo> textureInfos;
+        std::vector<std::pair<uint32_t, vk::DescriptorBufferInfo>> prevPositionInfos; // sparse, by modelId
 
         // Since our ResourceManager stores ModelResource objects linearly in ID...
         // In a production engine, this would be an iterative flat map or array
@@ -546,6 +650,10 @@ void EngineCore::createRayTracingDescriptorSets() {
                 const vk::Buffer rtVertexBuffer = (model->hasRuntimeSkinning && *model->skinnedVertexBuffer) ? *model->skinnedVertexBuffer : *model->vertexBuffer;
                 vertexInfos.push_back({rtVertexBuffer, 0, VK_WHOLE_SIZE});
 
+                if (model->hasRuntimeSkinning && *model->prevSkinnedPositionBuffer) {
+                    prevPositionInfos.emplace_back(static_cast<uint32_t>(modelId), vk::DescriptorBufferInfo{*model->prevSkinnedPositionBuffer, 0, VK_WHOLE_SIZE});
+                }
+
                 // 2. Accumulate Index Buffers
                 indexInfos.push_back({*model->indexBuffer, 0, VK_WHOLE_SIZE});
 
@@ -605,12 +713,23 @@ void EngineCore::createRayTracingDescriptorSets() {
             });
         }
 
+        for (const auto &[modelId, info]: prevPositionInfos) {
+            descriptorWrites.push_back(vk::WriteDescriptorSet{
+                .dstSet = *rtDescriptorSets[i],
+                .dstBinding = 10,
+                .dstArrayElement = modelId,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &info
+            });
+        }
+
         vulkan.logicalDevice.updateDescriptorSets(descriptorWrites, {});
     }
 }
 
 void EngineCore::createDenoiserDescriptorSets() {
-    // One set per frame in flight. All 13 bindings are storage images.
+    // One set per frame in flight. Bindings 0-12 are storage images, 13 is the progressive noise counter.
     // Free old sets before replacing the pool; each RAII DescriptorSet stores its parent pool handle.
     denoiserDescriptorSets.clear();
     if (*denoiserDescriptorPool) {
@@ -618,7 +737,8 @@ void EngineCore::createDenoiserDescriptorSets() {
     }
 
     std::vector<vk::DescriptorPoolSize> poolSizes = {
-        {vk::DescriptorType::eStorageImage, 13 * MAX_FRAMES_IN_FLIGHT}
+        {vk::DescriptorType::eStorageImage, 13 * MAX_FRAMES_IN_FLIGHT},
+        {vk::DescriptorType::eStorageBuffer, MAX_FRAMES_IN_FLIGHT}
     };
     vk::DescriptorPoolCreateInfo poolInfo{
         .flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
@@ -643,22 +763,22 @@ void EngineCore::createDenoiserDescriptorSets() {
         // Build the 13 image info structs in binding order.
         vk::DescriptorImageInfo infos[13] = {
             {.imageView = *frames.rayTracingOutputImageViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 0: noisy colour
-            {.imageView = *frames.rtGBufferNormalsViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 1: current normals
-            {.imageView = *frames.rtGBufferDepthViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 2: current depth
-            {.imageView = *frames.rtMotionVectorsViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 3: motion vectors
-            {.imageView = *frames.historyColorViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 4: history colour read
-            {.imageView = *frames.historyColorViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 5: history colour write
-            {.imageView = *frames.historyMomentsViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 6: history moments read
-            {.imageView = *frames.historyMomentsViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 7: history moments write
-            {.imageView = *frames.atrousTempViews[atrousBase + 0], .imageLayout = vk::ImageLayout::eGeneral}, // 8: A-Trous buffer A
-            {.imageView = *frames.atrousTempViews[atrousBase + 1], .imageLayout = vk::ImageLayout::eGeneral}, // 9: A-Trous buffer B
-            {.imageView = *frames.rayTracingOutputImageViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 10: final denoised output (reuses slot 0 image)
-            {.imageView = *frames.rtGBufferNormalsViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 11: previous-frame normals
-            {.imageView = *frames.rtGBufferDepthViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 12: previous-frame depth
+            {.imageView = *frames.rtGBufferViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 1: current normal + depth
+            {.imageView = *frames.rtMotionVectorsViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 2: motion vectors
+            {.imageView = *frames.historyColorViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 3: history colour read
+            {.imageView = *frames.historyColorViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 4: history colour write
+            {.imageView = *frames.historyMomentsViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 5: history moments read
+            {.imageView = *frames.historyMomentsViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 6: history moments write
+            {.imageView = *frames.atrousTempViews[atrousBase + 0], .imageLayout = vk::ImageLayout::eGeneral}, // 7: A-Trous buffer A
+            {.imageView = *frames.atrousTempViews[atrousBase + 1], .imageLayout = vk::ImageLayout::eGeneral}, // 8: A-Trous buffer B
+            {.imageView = *frames.rayTracingOutputImageViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 9: final denoised output (reuses slot 0 image)
+            {.imageView = *frames.rtGBufferViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 10: previous-frame normal + depth
+            {.imageView = *frames.rtSampleBudgetViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 11: sample budget
+            {.imageView = *frames.progressiveAccumulationView, .imageLayout = vk::ImageLayout::eGeneral}, // 12: progressive accumulation
         };
 
         std::vector<vk::WriteDescriptorSet> writes;
-        writes.reserve(13);
+        writes.reserve(14);
         for (uint32_t b = 0; b < 13; ++b) {
             writes.push_back(vk::WriteDescriptorSet{
                 .dstSet = *denoiserDescriptorSets[i],
@@ -669,6 +789,232 @@ void EngineCore::createDenoiserDescriptorSets() {
                 .pImageInfo = &infos[b]
             });
         }
+        vk::DescriptorBufferInfo noiseCounterInfo{
+            .buffer = *frames.progressiveNoiseBuffers[i],
+            .offset = 0,
+            .range = sizeof(uint32_t)
+        };
+        writes.push_back(vk::WriteDescriptorSet{
+            .dstSet = *denoiserDescriptorSets[i],
+            .dstBinding = 13,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = vk::DescriptorType::eStorageBuffer,
+            .pBufferInfo = &noiseCounterInfo
+        });
+        vulkan.logicalDevice.updateDescriptorSets(writes, {});
+    }
+}
+
+void EngineCore::createUpscaleDescriptorSets() {
+    // One set per frame in flight: raster targets (sampled), classic RT output and motion, history ping-pong.
+    upscaleDescriptorSets.clear();
+    if (*upscaleDescriptorPool) {
+        upscaleDescriptorPool = nullptr;
+    }
+
+    std::vector<vk::DescriptorPoolSize> poolSizes = {
+        {vk::DescriptorType::eSampledImage, 2 * MAX_FRAMES_IN_FLIGHT},
+        {vk::DescriptorType::eStorageImage, 4 * MAX_FRAMES_IN_FLIGHT}
+    };
+    vk::DescriptorPoolCreateInfo poolInfo{
+        .flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+        .maxSets = MAX_FRAMES_IN_FLIGHT,
+        .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+        .pPoolSizes = poolSizes.data()
+    };
+    upscaleDescriptorPool = vk::raii::DescriptorPool(vulkan.logicalDevice, poolInfo);
+
+    std::vector<vk::DescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, *pipelines.upscaleDescriptorSetLayout);
+    vk::DescriptorSetAllocateInfo allocInfo{
+        .descriptorPool = *upscaleDescriptorPool,
+        .descriptorSetCount = static_cast<uint32_t>(layouts.size()),
+        .pSetLayouts = layouts.data()
+    };
+    upscaleDescriptorSets = vulkan.logicalDevice.allocateDescriptorSets(allocInfo);
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        size_t prevSlot = (i - 1 + MAX_FRAMES_IN_FLIGHT) % MAX_FRAMES_IN_FLIGHT;
+
+        vk::DescriptorImageInfo infos[6] = {
+            {.imageView = *frames.sceneColorImageViews[i], .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal}, // 0: raster colour
+            {.imageView = *frames.sceneDepthImageViews[i], .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal}, // 1: raster depth
+            {.imageView = *frames.rayTracingOutputImageViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 2: classic RT colour
+            {.imageView = *frames.rtMotionVectorsViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 3: classic RT motion vectors
+            {.imageView = *frames.upscaleHistoryViews[prevSlot], .imageLayout = vk::ImageLayout::eGeneral}, // 4: history read
+            {.imageView = *frames.upscaleHistoryViews[i], .imageLayout = vk::ImageLayout::eGeneral}, // 5: history write
+        };
+
+        std::array<vk::WriteDescriptorSet, 6> writes{};
+        for (uint32_t b = 0; b < 6; ++b) {
+            writes[b] = vk::WriteDescriptorSet{
+                .dstSet = *upscaleDescriptorSets[i],
+                .dstBinding = b,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = (b < 2) ? vk::DescriptorType::eSampledImage : vk::DescriptorType::eStorageImage,
+                .pImageInfo = &infos[b]
+            };
+        }
+        vulkan.logicalDevice.updateDescriptorSets(writes, {});
+    }
+}
+
+void EngineCore::createWavefrontDescriptorSets() {
+    if (!vulkan.rayQuerySupported) {
+        return;
+    }
+    // One set per frame in flight. The queues are shared (see FrameContext::createWavefrontBuffers); only the
+    // TLAS instances, which Primary/Extend read the instance transforms from, are the slot's own.
+    wavefrontDescriptorSets.clear();
+    if (*wavefrontDescriptorPool) {
+        wavefrontDescriptorPool = nullptr;
+    }
+
+    std::vector<vk::DescriptorPoolSize> poolSizes = {
+        {vk::DescriptorType::eStorageBuffer, 8 * MAX_FRAMES_IN_FLIGHT}
+    };
+    vk::DescriptorPoolCreateInfo poolInfo{
+        .flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+        .maxSets = MAX_FRAMES_IN_FLIGHT,
+        .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+        .pPoolSizes = poolSizes.data()
+    };
+    wavefrontDescriptorPool = vk::raii::DescriptorPool(vulkan.logicalDevice, poolInfo);
+
+    std::vector<vk::DescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, *pipelines.wavefrontDescriptorSetLayout);
+    vk::DescriptorSetAllocateInfo allocInfo{
+        .descriptorPool = *wavefrontDescriptorPool,
+        .descriptorSetCount = static_cast<uint32_t>(layouts.size()),
+        .pSetLayouts = layouts.data()
+    };
+    wavefrontDescriptorSets = vulkan.logicalDevice.allocateDescriptorSets(allocInfo);
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        vk::DescriptorBufferInfo infos[8] = {
+            {.buffer = *frames.wavefrontPrimaryHits, .offset = 0, .range = VK_WHOLE_SIZE},   // 0: primary hits
+            {.buffer = *frames.wavefrontPaths, .offset = 0, .range = VK_WHOLE_SIZE},         // 1: path queues
+            {.buffer = *frames.wavefrontHits, .offset = 0, .range = VK_WHOLE_SIZE},          // 2: hit queue
+            {.buffer = *frames.wavefrontSortedHits, .offset = 0, .range = VK_WHOLE_SIZE},    // 3: sorted hit indices
+            {.buffer = *frames.wavefrontShadowRecords, .offset = 0, .range = VK_WHOLE_SIZE}, // 4: light samples
+            {.buffer = *frames.wavefrontPathRadiance, .offset = 0, .range = VK_WHOLE_SIZE},  // 5: path radiance
+            {.buffer = *frames.wavefrontControl, .offset = 0, .range = VK_WHOLE_SIZE},       // 6: counters + indirect args
+            {.buffer = *frames.tlasInstanceBuffers[i], .offset = 0, .range = VK_WHOLE_SIZE}, // 7: TLAS instances
+        };
+
+        std::array<vk::WriteDescriptorSet, 8> writes{};
+        for (uint32_t b = 0; b < 8; ++b) {
+            writes[b] = vk::WriteDescriptorSet{
+                .dstSet = *wavefrontDescriptorSets[i],
+                .dstBinding = b,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &infos[b]
+            };
+        }
+        vulkan.logicalDevice.updateDescriptorSets(writes, {});
+    }
+}
+
+void EngineCore::createOcclusionDescriptorSets() {
+    // Rewritten with the swapchain: the depth images and the pyramid are extent-dependent.
+    hiZSourceDescriptorSets.clear();
+    hiZMipDescriptorSets.clear();
+    occlusionCullDescriptorSets.clear();
+    if (*occlusionDescriptorPool) {
+        occlusionDescriptorPool = nullptr;
+    }
+
+    const uint32_t sourceCount = static_cast<uint32_t>(frames.depthImageViews.size()) + 1;
+    const uint32_t mipCount = frames.hiZLayout.mipCount;
+    const uint32_t reduceSetCount = MAX_FRAMES_IN_FLIGHT * (sourceCount + mipCount - 1);
+    const uint32_t setCount = reduceSetCount + MAX_FRAMES_IN_FLIGHT;
+
+    std::vector<vk::DescriptorPoolSize> poolSizes = {
+        {vk::DescriptorType::eSampledImage, setCount},
+        {vk::DescriptorType::eStorageImage, reduceSetCount},
+        {vk::DescriptorType::eStorageBuffer, 3 * MAX_FRAMES_IN_FLIGHT}
+    };
+    vk::DescriptorPoolCreateInfo poolInfo{
+        .flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+        .maxSets = setCount,
+        .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+        .pPoolSizes = poolSizes.data()
+    };
+    occlusionDescriptorPool = vk::raii::DescriptorPool(vulkan.logicalDevice, poolInfo);
+
+    auto allocate = [&](uint32_t count, vk::DescriptorSetLayout layout) {
+        std::vector<vk::DescriptorSetLayout> layouts(count, layout);
+        vk::DescriptorSetAllocateInfo allocInfo{
+            .descriptorPool = *occlusionDescriptorPool,
+            .descriptorSetCount = count,
+            .pSetLayouts = layouts.data()
+        };
+        return vulkan.logicalDevice.allocateDescriptorSets(allocInfo);
+    };
+    auto writeReduceSet = [&](vk::DescriptorSet set, vk::ImageView source, vk::ImageLayout sourceLayout, vk::ImageView target) {
+        vk::DescriptorImageInfo infos[2] = {
+            {.imageView = source, .imageLayout = sourceLayout},                      // 0: source level
+            {.imageView = target, .imageLayout = vk::ImageLayout::eGeneral},         // 1: destination mip
+        };
+        std::array<vk::WriteDescriptorSet, 2> writes{};
+        for (uint32_t b = 0; b < 2; ++b) {
+            writes[b] = vk::WriteDescriptorSet{
+                .dstSet = set,
+                .dstBinding = b,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = (b == 0) ? vk::DescriptorType::eSampledImage : vk::DescriptorType::eStorageImage,
+                .pImageInfo = &infos[b]
+            };
+        }
+        vulkan.logicalDevice.updateDescriptorSets(writes, {});
+    };
+
+    hiZSourceDescriptorSets = allocate(MAX_FRAMES_IN_FLIGHT * sourceCount, *pipelines.hiZReduceDescriptorSetLayout);
+    if (mipCount > 1) {
+        hiZMipDescriptorSets = allocate(MAX_FRAMES_IN_FLIGHT * (mipCount - 1), *pipelines.hiZReduceDescriptorSetLayout);
+    }
+    occlusionCullDescriptorSets = allocate(MAX_FRAMES_IN_FLIGHT, *pipelines.occlusionCullDescriptorSetLayout);
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        vk::ImageView mip0 = *frames.hiZMipViews[i * mipCount];
+        // Mip 0 from the depth attachment: any swapchain image's, or the slot's reduced-resolution target.
+        for (uint32_t source = 0; source < sourceCount; ++source) {
+            vk::ImageView depthView = (source + 1 < sourceCount) ? *frames.depthImageViews[source] : *frames.sceneDepthImageViews[i];
+            writeReduceSet(*hiZSourceDescriptorSets[i * sourceCount + source], depthView, vk::ImageLayout::eShaderReadOnlyOptimal, mip0);
+        }
+        for (uint32_t mip = 1; mip < mipCount; ++mip) {
+            writeReduceSet(*hiZMipDescriptorSets[i * (mipCount - 1) + mip - 1], *frames.hiZMipViews[i * mipCount + mip - 1],
+                           vk::ImageLayout::eGeneral, *frames.hiZMipViews[i * mipCount + mip]);
+        }
+
+        vk::DescriptorImageInfo pyramidInfo{.imageView = *frames.hiZViews[i], .imageLayout = vk::ImageLayout::eGeneral};
+        vk::DescriptorBufferInfo bufferInfos[3] = {
+            {.buffer = *frames.occlusionCandidateBuffers[i], .offset = 0, .range = VK_WHOLE_SIZE}, // 1: candidates
+            {.buffer = *frames.occlusionDrawBuffers[i], .offset = 0, .range = VK_WHOLE_SIZE},      // 2: late draw commands
+            {.buffer = *frames.occlusionResultBuffers[i], .offset = 0, .range = VK_WHOLE_SIZE},    // 3: counters + visibility
+        };
+        std::array<vk::WriteDescriptorSet, 4> writes{};
+        writes[0] = vk::WriteDescriptorSet{
+            .dstSet = *occlusionCullDescriptorSets[i],
+            .dstBinding = 0,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = vk::DescriptorType::eSampledImage,
+            .pImageInfo = &pyramidInfo
+        };
+        for (uint32_t b = 1; b < 4; ++b) {
+            writes[b] = vk::WriteDescriptorSet{
+                .dstSet = *occlusionCullDescriptorSets[i],
+                .dstBinding = b,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &bufferInfos[b - 1]
+            };
+        }
         vulkan.logicalDevice.updateDescriptorSets(writes, {});
     }
 }
@@ -768,59 +1114,86 @@ void EngineCore::recordComputeCommandBuffer(const vk::raii::CommandBuffer &comma
         vk::ImageAspectFlagBits::eColor);
 }
 
+void EngineCore::recordLightCullingPass(const vk::raii::CommandBuffer &commandBuffer) const {
+    // Host writes to the light buffer are made visible by the submit; only the cluster lists need a barrier.
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.lightCullingPipeline);
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelines.lightCullingPipelineLayout, 0,
+                                     *descriptorSets[frames.frameIndex], nullptr);
+    commandBuffer.dispatch((Laphria::EngineConfig::kLightClusterCount + 63u) / 64u, 1, 1);
+
+    vk::MemoryBarrier2 clustersToFragmentBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .srcAccessMask = vk::AccessFlagBits2::eShaderWrite,
+        .dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderStorageRead};
+    vk::DependencyInfo clustersToFragmentDependency{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &clustersToFragmentBarrier};
+    commandBuffer.pipelineBarrier2(clustersToFragmentDependency);
+}
+
 void EngineCore::recordSkinningPass(const vk::raii::CommandBuffer &commandBuffer) const {
-    std::unordered_map<int, const SceneNode *> instanceRootsByModel;
-    for (const auto &node: scene->getAllNodes()) {
-        if (!node || node->modelId < 0) {
-            continue;
-        }
+    recordedSkinningStats = {};
+    // Every instance draws the one skinned stream of its model, posed from the first instance's joints.
+    std::unordered_map<int, std::vector<const SceneNode *>> instanceRootsByModel;
+    for (const auto &node: scene->getSkinnedInstances(*resourceManager)) {
         ModelResource *modelRes = resourceManager->getModelResource(node->modelId);
-        if (!modelRes || !modelRes->hasRuntimeSkinning || !*modelRes->skinningDescriptorSet || !modelRes->skinningJointMatricesMapped) {
+        if (!*modelRes->skinningDescriptorSet || !modelRes->skinningJointMatricesMapped) {
             continue;
         }
-        const SceneNode *parent = node->getParent();
-        const bool isInstanceRoot = (parent == nullptr || parent->modelId != node->modelId);
-        if (isInstanceRoot && !instanceRootsByModel.contains(node->modelId)) {
-            instanceRootsByModel.emplace(node->modelId, node.get());
-        }
+        instanceRootsByModel[node->modelId].push_back(node.get());
     }
 
     if (instanceRootsByModel.empty()) {
         return;
     }
 
-    vk::MemoryBarrier2 hostToComputeBarrier{
-        .srcStageMask = vk::PipelineStageFlagBits2::eHost,
-        .srcAccessMask = vk::AccessFlagBits2::eHostWrite,
-        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader,
-        .dstAccessMask = vk::AccessFlagBits2::eShaderRead};
-    vk::DependencyInfo hostToComputeDependency{
-        .memoryBarrierCount = 1,
-        .pMemoryBarriers = &hostToComputeBarrier};
-    commandBuffer.pipelineBarrier2(hostToComputeDependency);
-
-    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.skinningPipeline);
+    // Views that draw the skinned streams this frame: the camera, and in raster mode the cascades re-rendered.
+    // Only the cascade side planes are tested, like the shadow pass does for its casters.
+    struct SkinningCullView
+    {
+        Laphria::Frustum frustum;
+        size_t planeCount = 6;
+    };
+    std::vector<SkinningCullView> cullViews{{Laphria::Frustum::fromViewProjection(getCullingViewProjection()), 6}};
+    if (ui.renderMode == RenderMode::Rasterizer) {
+        for (uint32_t cascadeIdx = 0; cascadeIdx < NUM_SHADOW_CASCADES; ++cascadeIdx) {
+            if ((shadowCascadeUpdateMask & (1u << cascadeIdx)) != 0) {
+                cullViews.push_back({Laphria::Frustum::fromViewProjection(frames.cascadeViewProjCache[frames.frameIndex][cascadeIdx]), 4});
+            }
+        }
+    }
 
-    for (const auto &[modelId, rootNode] : instanceRootsByModel) {
+    const bool refitsBlas = ui.renderMode != RenderMode::Rasterizer;
+    const bool cullOffscreen = ui.offscreenSkinningCulling && !(refitsBlas && skinnedBlasBehind);
+    std::vector<int> posedModelIds;
+    for (const auto &[modelId, roots] : instanceRootsByModel) {
         ModelResource *modelRes = resourceManager->getModelResource(modelId);
         if (!modelRes || modelRes->skinningJointMatrixCount == 0 || modelRes->skinningVertexCount == 0) {
             continue;
         }
 
+        // Joints come from the first instance; the mesh nodes of all of them decide whether the pose is seen.
         std::unordered_map<int, const SceneNode *> nodesBySourceIndex;
-        std::vector<const SceneNode *> stack{rootNode};
-        while (!stack.empty()) {
-            const SceneNode *current = stack.back();
-            stack.pop_back();
-            if (!current || current->modelId != modelId) {
-                continue;
-            }
-            if (current->sourceNodeIndex >= 0 && !nodesBySourceIndex.contains(current->sourceNodeIndex)) {
-                nodesBySourceIndex.emplace(current->sourceNodeIndex, current);
-            }
-            for (const auto &child : current->getChildren()) {
-                if (child) {
-                    stack.push_back(child.get());
+        std::vector<const SceneNode *> meshNodes;
+        for (const SceneNode *root : roots) {
+            std::vector<const SceneNode *> stack{root};
+            while (!stack.empty()) {
+                const SceneNode *current = stack.back();
+                stack.pop_back();
+                if (!current || current->modelId != modelId) {
+                    continue;
+                }
+                if (root == roots.front() && current->sourceNodeIndex >= 0 && !nodesBySourceIndex.contains(current->sourceNodeIndex)) {
+                    nodesBySourceIndex.emplace(current->sourceNodeIndex, current);
+                }
+                if (!current->meshIndices.empty()) {
+                    meshNodes.push_back(current);
+                }
+                for (const auto &child : current->getChildren()) {
+                    if (child) {
+                        stack.push_back(child.get());
+                    }
                 }
             }
         }
@@ -840,8 +1213,58 @@ void EngineCore::recordSkinningPass(const vk::raii::CommandBuffer &commandBuffer
             }
         }
 
+        // A model is left as it is only when neither the new pose nor the one its stream holds can be seen, so
+        // a skipped model never shows a stale pose in view.
+        glm::vec3 poseMin;
+        glm::vec3 poseMax;
+        const bool hasPoseBounds = modelRes->skinnedBounds.posedBounds(jointPalette, poseMin, poseMax);
+        auto poseVisible = [&](const glm::vec3 &localMin, const glm::vec3 &localMax) {
+            for (const SceneNode *meshNode : meshNodes) {
+                glm::vec3 worldMin;
+                glm::vec3 worldMax;
+                Laphria::transformBounds(localMin, localMax, meshNode->getWorldTransform(), worldMin, worldMax);
+                for (const SkinningCullView &view : cullViews) {
+                    if (view.frustum.intersectsBox(worldMin, worldMax, view.planeCount)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        };
+        if (cullOffscreen && hasPoseBounds && !poseVisible(poseMin, poseMax) &&
+            !poseVisible(modelRes->skinnedPoseMin, modelRes->skinnedPoseMax)) {
+            ++recordedSkinningStats.skipped;
+            continue;
+        }
+        if (hasPoseBounds) {
+            modelRes->skinnedPoseMin = poseMin;
+            modelRes->skinnedPoseMax = poseMax;
+        }
+
         memcpy(modelRes->skinningJointMatricesMapped, jointPalette.data(), sizeof(glm::mat4) * jointPalette.size());
+        posedModelIds.push_back(modelId);
+    }
+    recordedSkinningStats.posed = static_cast<uint32_t>(posedModelIds.size());
+
+    if (posedModelIds.empty()) {
+        return;
+    }
+    skinnedBlasBehind = !refitsBlas;
+
+    vk::MemoryBarrier2 hostToComputeBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eHost,
+        .srcAccessMask = vk::AccessFlagBits2::eHostWrite,
+        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderRead};
+    vk::DependencyInfo hostToComputeDependency{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &hostToComputeBarrier};
+    commandBuffer.pipelineBarrier2(hostToComputeDependency);
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.skinningPipeline);
 
+    for (int modelId : posedModelIds) {
+        const ModelResource *modelRes = resourceManager->getModelResource(modelId);
         commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelines.skinningPipelineLayout, 0, {*modelRes->skinningDescriptorSet}, nullptr);
 
         Laphria::SkinningPushConstants push{};
@@ -857,15 +1280,21 @@ void EngineCore::recordSkinningPass(const vk::raii::CommandBuffer &commandBuffer
     vk::MemoryBarrier2 skinningToConsumerBarrier{
         .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader,
         .srcAccessMask = vk::AccessFlagBits2::eShaderWrite,
-        .dstStageMask = vk::PipelineStageFlagBits2::eVertexInput | vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR,
-        .dstAccessMask = vk::AccessFlagBits2::eVertexAttributeRead | vk::AccessFlagBits2::eAccelerationStructureReadKHR};
+        .dstStageMask = vk::PipelineStageFlagBits2::eVertexInput | vk::PipelineStageFlagBits2::eComputeShader,
+        .dstAccessMask = vk::AccessFlagBits2::eVertexAttributeRead | vk::AccessFlagBits2::eShaderStorageRead};
+    // BLAS refits and the RT pipelines only exist on ray tracing devices.
+    if (vulkan.rayTracingSupported) {
+        skinningToConsumerBarrier.dstStageMask |= vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR |
+                                                  vk::PipelineStageFlagBits2::eRayTracingShaderKHR;
+        skinningToConsumerBarrier.dstAccessMask |= vk::AccessFlagBits2::eAccelerationStructureReadKHR;
+    }
     vk::DependencyInfo skinningToConsumerDependency{
         .memoryBarrierCount = 1,
         .pMemoryBarriers = &skinningToConsumerBarrier};
     commandBuffer.pipelineBarrier2(skinningToConsumerDependency);
 
-    if (ui.renderMode != RenderMode::Rasterizer) {
-        resourceManager->recordSkinnedBLASRefit(commandBuffer);
+    if (refitsBlas) {
+        resourceManager->recordSkinnedBLASRefit(commandBuffer, posedModelIds);
     }
 }
 
@@ -900,163 +1329,214 @@ void EngineCore::recordClassicRTCommandBuffer(const vk::raii::CommandBuffer &com
         0,
         pushConstants);
 
-    // 3. Dispatch Rays
+    // 3. Dispatch Rays over the render extent (the top-left of the full-size output image)
+    const vk::Extent2D renderExtent = getRenderExtent();
+    const uint32_t queryBase = getTimestampQueryBase(fi);
+    if (*gpuTimestampQueryPool) {
+        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eRayTracingShaderKHR, *gpuTimestampQueryPool, queryBase + kTS_SceneStart);
+    }
     vk::StridedDeviceAddressRegionKHR callableRegion{};
     commandBuffer.traceRaysKHR(
         pipelines.classicRTRaygenRegion,
         pipelines.classicRTMissRegion,
         pipelines.classicRTHitRegion,
         callableRegion,
-        swapchain.extent.width,
-        swapchain.extent.height,
+        renderExtent.width,
+        renderExtent.height,
         1);
+    if (*gpuTimestampQueryPool) {
+        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eRayTracingShaderKHR, *gpuTimestampQueryPool, queryBase + kTS_SceneEnd);
+    }
 
-    // 4. Transition RT Output Image for Blit (General → TransferSrcOptimal)
-    transition_image_layout(
-        *frames.rayTracingOutputImages[fi],
-        vk::ImageLayout::eGeneral,
-        vk::ImageLayout::eTransferSrcOptimal,
-        vk::AccessFlagBits2::eShaderWrite,
-        vk::AccessFlagBits2::eTransferRead,
-        vk::PipelineStageFlagBits2::eRayTracingShaderKHR,
-        vk::PipelineStageFlagBits2::eTransfer,
-        vk::ImageAspectFlagBits::eColor);
-
-    // 5. Transition SwapChain Image for Blit
-    transition_image_layout(
-        swapchain.images[imageIndex],
-        vk::ImageLayout::eUndefined,
-        vk::ImageLayout::eTransferDstOptimal,
-        {},
-        vk::AccessFlagBits2::eTransferWrite,
-        vk::PipelineStageFlagBits2::eTopOfPipe,
-        vk::PipelineStageFlagBits2::eTransfer,
-        vk::ImageAspectFlagBits::eColor);
-
-    // 6. Blit RT Output to SwapChain Image
-    vk::ImageBlit blitRegion{
-        .srcSubresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1},
-        .srcOffsets = {{vk::Offset3D{0, 0, 0}, vk::Offset3D{static_cast<int32_t>(swapchain.extent.width), static_cast<int32_t>(swapchain.extent.height), 1}}},
-        .dstSubresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1},
-        .dstOffsets = {{vk::Offset3D{0, 0, 0}, vk::Offset3D{static_cast<int32_t>(swapchain.extent.width), static_cast<int32_t>(swapchain.extent.height), 1}}}
-    };
-    commandBuffer.blitImage(
-        *frames.rayTracingOutputImages[fi], vk::ImageLayout::eTransferSrcOptimal,
-        swapchain.images[imageIndex], vk::ImageLayout::eTransferDstOptimal,
-        blitRegion, vk::Filter::eLinear);
-
-    // 6b. Restore RT output image to eGeneral so it always matches the layout declared in
-    // rtDescriptorSets and denoiserDescriptorSets (prevents VUID-vkCmdDraw-None-09600 if
-    // the render mode is switched back to Rasterizer in a subsequent frame).
-    transition_image_layout(
-        *frames.rayTracingOutputImages[fi],
-        vk::ImageLayout::eTransferSrcOptimal,
-        vk::ImageLayout::eGeneral,
-        vk::AccessFlagBits2::eTransferRead,
-        {},
-        vk::PipelineStageFlagBits2::eTransfer,
-        vk::PipelineStageFlagBits2::eBottomOfPipe,
-        vk::ImageAspectFlagBits::eColor);
+    // 4. Reconstruct native resolution from the jittered trace, or scale the trace up with a plain blit.
+    //    Either way the output image returns to eGeneral so it always matches the layout declared in
+    //    rtDescriptorSets and denoiserDescriptorSets, and the swapchain image ends in eColorAttachmentOptimal.
+    if (isTemporalUpscalingActive()) {
+        // Colour and motion vectors stay in eGeneral; only their raygen writes must reach the upscaler.
+        vk::MemoryBarrier2 traceToUpscaleBarrier{
+            .srcStageMask = vk::PipelineStageFlagBits2::eRayTracingShaderKHR,
+            .srcAccessMask = vk::AccessFlagBits2::eShaderWrite,
+            .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+            .dstAccessMask = vk::AccessFlagBits2::eShaderRead};
+        vk::DependencyInfo traceToUpscaleDependency{
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &traceToUpscaleBarrier};
+        commandBuffer.pipelineBarrier2(traceToUpscaleDependency);
 
-    // 7. Transition SwapChain to Color Attachment for UI Rendering
-    transition_image_layout(
-        swapchain.images[imageIndex],
-        vk::ImageLayout::eTransferDstOptimal,
-        vk::ImageLayout::eColorAttachmentOptimal,
-        vk::AccessFlagBits2::eTransferWrite,
-        vk::AccessFlagBits2::eColorAttachmentWrite | vk::AccessFlagBits2::eColorAttachmentRead,
-        vk::PipelineStageFlagBits2::eTransfer,
-        vk::PipelineStageFlagBits2::eColorAttachmentOutput,
-        vk::ImageAspectFlagBits::eColor);
+        recordTemporalUpscalePass(commandBuffer, renderExtent, kUpscaleInputRayTracer);
+        recordBlitToSwapchain(commandBuffer, imageIndex, *frames.upscaleHistory[fi], swapchain.extent,
+                              vk::ImageLayout::eGeneral, vk::PipelineStageFlagBits2::eComputeShader,
+                              vk::AccessFlagBits2::eShaderWrite, vk::ImageLayout::eGeneral);
+    } else {
+        recordBlitToSwapchain(commandBuffer, imageIndex, *frames.rayTracingOutputImages[fi], renderExtent,
+                              vk::ImageLayout::eGeneral, vk::PipelineStageFlagBits2::eRayTracingShaderKHR,
+                              vk::AccessFlagBits2::eShaderWrite, vk::ImageLayout::eGeneral);
+    }
 }
 
 void EngineCore::recordRayTracingCommandBuffer(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex) const {
     const uint32_t fi = frames.frameIndex;
-    const uint32_t queryBase = getPathTracerQueryBase(fi);
+    const uint32_t queryBase = getTimestampQueryBase(fi);
     const size_t atrousBase = static_cast<size_t>(fi) * 2;
     const size_t atrousA = atrousBase + 0;
     const size_t atrousB = atrousBase + 1;
 
-    const float clampedScale = std::clamp(ui.pathTracerSettings.resolutionScale, 0.5f, 1.0f);
-    const float secondaryScale = ui.pathTracerSettings.reduceSecondaryEffects ? 0.90f : 1.0f;
-    const float effectiveScale = std::clamp(clampedScale * secondaryScale, 0.5f, 1.0f);
-    const uint32_t rtWidth = std::max(1u, static_cast<uint32_t>(static_cast<float>(swapchain.extent.width) * effectiveScale));
-    const uint32_t rtHeight = std::max(1u, static_cast<uint32_t>(static_cast<float>(swapchain.extent.height) * effectiveScale));
+    const vk::Extent2D rtExtent = getPathTracerRenderExtent();
+    const uint32_t rtWidth = rtExtent.width;
+    const uint32_t rtHeight = rtExtent.height;
     const uint32_t gx = (rtWidth + 15) / 16;
     const uint32_t gy = (rtHeight + 15) / 16;
 
+    // The wavefront tracer writes the same images from compute kernels instead of the ray tracing pipeline.
+    const bool wavefront = isWavefrontTracerActive();
+    const vk::PipelineStageFlags2 traceStage = wavefront ? vk::PipelineStageFlagBits2::eComputeShader
+                                                         : vk::PipelineStageFlagBits2::eRayTracingShaderKHR;
+
     // 1. Transition all PT images to general layout for writing.
     auto transitionToGeneral = [&](vk::Image img) {
         transition_image_layout(img, vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral,
                                 {}, vk::AccessFlagBits2::eShaderWrite,
-                                vk::PipelineStageFlagBits2::eTopOfPipe, vk::PipelineStageFlagBits2::eRayTracingShaderKHR,
+                                vk::PipelineStageFlagBits2::eTopOfPipe, traceStage,
                                 vk::ImageAspectFlagBits::eColor);
     };
     transitionToGeneral(*frames.rayTracingOutputImages[fi]);
-    transitionToGeneral(*frames.rtGBufferNormals[fi]);
-    transitionToGeneral(*frames.rtGBufferDepth[fi]);
+    transitionToGeneral(*frames.rtGBuffer[fi]);
     transitionToGeneral(*frames.rtMotionVectors[fi]);
     transitionToGeneral(*frames.atrousTemp[atrousA]);
     transitionToGeneral(*frames.atrousTemp[atrousB]);
 
-    // 2. Ray tracing dispatch.
-    commandBuffer.bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, *pipelines.rayTracingPipeline);
-    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eRayTracingKHR,
-                                     *pipelines.rayTracingPipelineLayout, 0,
-                                     {*rtDescriptorSets[fi], *descriptorSets[fi]}, nullptr);
-
-    ScenePushConstants rtPush{};
-    rtPush.modelMatrix = glm::mat4(1.0f);
-    commandBuffer.pushConstants<ScenePushConstants>(*pipelines.rayTracingPipelineLayout,
-                                                    vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eMissKHR,
-                                                    0, rtPush);
+    // 2. Sample budget: paths per pixel from the previous frame's history. Adaptive sampling needs that
+    // history, so without reprojection every pixel gets one path. Converged pixels may be skipped only
+    // while nothing moves: camera, TLAS instances (ranges rewritten this frame) and skinned joints.
+    // Progressive mode traces the same fixed count everywhere, and nothing once it has converged.
+    const bool traceRays = !ptProgressiveActive || !ptProgressiveConverged;
+    const bool adaptiveSampling = ui.pathTracerSettings.adaptiveSampling && ui.pathTracerSettings.enableReprojection &&
+                                  !ptProgressiveActive;
+    const bool sceneStatic = !ptCameraMoved && !ptHistoryInvalid && tlasMotionSettleRanges.empty() && !ptSkinnedPoseChanged;
+    transition_image_layout(*frames.rtSampleBudget[fi], vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral,
+                            {}, vk::AccessFlagBits2::eShaderWrite,
+                            vk::PipelineStageFlagBits2::eTopOfPipe, vk::PipelineStageFlagBits2::eComputeShader,
+                            vk::ImageAspectFlagBits::eColor);
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.sampleBudgetPipeline);
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                                     *pipelines.denoiserPipelineLayout, 0, *denoiserDescriptorSets[fi], nullptr);
+    // A reset history hands every pixel maxSamples, which is how progressive mode gets its fixed count.
+    const uint32_t maxSamples = ptProgressiveActive ? getProgressiveSamplesPerFrame()
+                              : adaptiveSampling    ? static_cast<uint32_t>(std::clamp(ui.pathTracerSettings.maxSamplesPerPixel, 1, static_cast<int>(kPtMaxSamplesPerPixel)))
+                                                    : 0u;
+    SampleBudgetPushConstants budgetPush{
+        .renderWidth = rtWidth,
+        .renderHeight = rtHeight,
+        .budgetScale = ptSampleBudgetScale,
+        .maxSamples = maxSamples,
+        .allowSkip = (adaptiveSampling && sceneStatic) ? 1u : 0u,
+        .frameIndex = frames.frameCount,
+        .resetHistory = (ptHistoryInvalid || ptProgressiveActive) ? 1u : 0u};
+    commandBuffer.pushConstants<SampleBudgetPushConstants>(*pipelines.denoiserPipelineLayout,
+                                                           vk::ShaderStageFlagBits::eCompute, 0, budgetPush);
+    if (traceRays) {
+        commandBuffer.dispatch(gx, gy, 1);
+    }
+    transition_image_layout(*frames.rtSampleBudget[fi], vk::ImageLayout::eGeneral, vk::ImageLayout::eGeneral,
+                            vk::AccessFlagBits2::eShaderWrite, vk::AccessFlagBits2::eShaderRead,
+                            vk::PipelineStageFlagBits2::eComputeShader, traceStage,
+                            vk::ImageAspectFlagBits::eColor);
 
-    if (*ptTimestampQueryPool) {
-        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eRayTracingShaderKHR, *ptTimestampQueryPool, queryBase + kPtTS_RayTraceStart);
+    // 3. Ray tracing dispatch.
+    if (*gpuTimestampQueryPool) {
+        commandBuffer.writeTimestamp2(traceStage, *gpuTimestampQueryPool, queryBase + kTS_SceneStart);
     }
-    vk::StridedDeviceAddressRegionKHR callableRegion{};
-    commandBuffer.traceRaysKHR(pipelines.raygenRegion, pipelines.missRegion, pipelines.hitRegion,
-                               callableRegion, rtWidth, rtHeight, 1);
-    if (*ptTimestampQueryPool) {
-        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eRayTracingShaderKHR, *ptTimestampQueryPool, queryBase + kPtTS_RayTraceEnd);
+    wavefrontTimestampCounts[fi] = 0;
+    if (wavefront) {
+        if (traceRays) {
+            recordWavefrontPathTrace(commandBuffer, rtExtent, maxSamples);
+        }
+    } else {
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, *pipelines.rayTracingPipeline);
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eRayTracingKHR,
+                                         *pipelines.rayTracingPipelineLayout, 0,
+                                         {*rtDescriptorSets[fi], *descriptorSets[fi]}, nullptr);
+
+        ScenePushConstants rtPush{};
+        rtPush.modelMatrix = glm::mat4(1.0f);
+        commandBuffer.pushConstants<ScenePushConstants>(*pipelines.rayTracingPipelineLayout,
+                                                        vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eMissKHR,
+                                                        0, rtPush);
+
+        vk::StridedDeviceAddressRegionKHR callableRegion{};
+        if (traceRays) {
+            commandBuffer.traceRaysKHR(pipelines.raygenRegion, pipelines.missRegion, pipelines.hitRegion,
+                                       callableRegion, rtWidth, rtHeight, 1);
+        }
+    }
+    if (*gpuTimestampQueryPool) {
+        commandBuffer.writeTimestamp2(traceStage, *gpuTimestampQueryPool, queryBase + kTS_SceneEnd);
     }
 
-    // 3. Barrier: RT writes -> compute reads.
+    // 4. Barrier: RT writes -> compute reads.
     auto barrierRTtoCompute = [&](vk::Image img) {
         transition_image_layout(img, vk::ImageLayout::eGeneral, vk::ImageLayout::eGeneral,
                                 vk::AccessFlagBits2::eShaderWrite, vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite,
-                                vk::PipelineStageFlagBits2::eRayTracingShaderKHR, vk::PipelineStageFlagBits2::eComputeShader,
+                                traceStage, vk::PipelineStageFlagBits2::eComputeShader,
                                 vk::ImageAspectFlagBits::eColor);
     };
     barrierRTtoCompute(*frames.rayTracingOutputImages[fi]);
-    barrierRTtoCompute(*frames.rtGBufferNormals[fi]);
-    barrierRTtoCompute(*frames.rtGBufferDepth[fi]);
+    barrierRTtoCompute(*frames.rtGBuffer[fi]);
     barrierRTtoCompute(*frames.rtMotionVectors[fi]);
 
-    // 4. Reprojection pass.
+    auto writeComputeTimestamp = [&](uint32_t slot) {
+        if (*gpuTimestampQueryPool) {
+            commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eComputeShader, *gpuTimestampQueryPool, queryBase + slot);
+        }
+    };
+
+    // Progressive reference: the accumulation pass replaces reprojection and A-Trous, and is timed as the
+    // denoiser.
+    if (ptProgressiveActive) {
+        writeComputeTimestamp(kTS_DenoiserStart);
+        recordProgressiveAccumulationPass(commandBuffer, rtExtent);
+        writeComputeTimestamp(kTS_DenoiserEnd);
+        recordPathTracerBlit(commandBuffer, imageIndex, rtExtent);
+        return;
+    }
+
+    const int atrousIterations = ui.pathTracerSettings.enableDenoiser
+                                     ? std::clamp(ui.pathTracerSettings.denoiserIterations, 1, static_cast<int>(kPtMaxDenoiserIterations))
+                                     : 0;
+    // The tiled path fuses the first A-Trous iteration into reprojection, which also produces the moments
+    // the later tiled iterations read their variance from. The fused pass reads the noisy colour image
+    // across tile borders, so it can never be the pass that writes the final output into that same image.
+    const bool tiledDenoiser = ui.pathTracerSettings.useTiledDenoiser && ui.pathTracerSettings.enableReprojection && atrousIterations > 1;
+    constexpr float kAtrousPhiColor = 1.0f;
+    constexpr float kAtrousPhiNormal = 128.0f;
+
+    // 5. Reprojection pass (fused with the first A-Trous iteration on the tiled path).
+    // Both timestamps are written even when the pass is skipped so every query in the slot becomes available.
+    writeComputeTimestamp(kTS_ReprojectionStart);
     if (ui.pathTracerSettings.enableReprojection) {
-        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.reprojectionPipeline);
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
+                                   tiledDenoiser ? *pipelines.reprojectionAtrousPipeline : *pipelines.reprojectionPipeline);
         commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
                                          *pipelines.denoiserPipelineLayout, 0, *denoiserDescriptorSets[fi], nullptr);
 
-        float historyAlpha = ptCameraMoved ? 1.0f : 0.1f;
+        // Under camera motion the history weight floor rises and the variance clamp tightens, trading a
+        // little noise for less reprojection blur; a static camera keeps accumulating towards the floor.
         DenoisePushConstants reproPush{
             .stepSize = 0,
             .isLastPass = 0,
-            .phiColor = historyAlpha,
-            .phiNormal = 128.0f,
+            .phiColor = ptCameraMoved ? 0.15f : 0.05f,
+            .phiNormal = ptCameraMoved ? 1.5f : 4.0f,
             .exposureScale = ui.exposure,
-            .useRawInput = 0};
+            .renderWidth = rtWidth,
+            .renderHeight = rtHeight,
+            .resetHistory = ptHistoryInvalid ? 1 : 0,
+            .atrousPhiColor = kAtrousPhiColor,
+            .atrousPhiNormal = kAtrousPhiNormal};
         commandBuffer.pushConstants<DenoisePushConstants>(*pipelines.denoiserPipelineLayout,
                                                           vk::ShaderStageFlagBits::eCompute, 0, reproPush);
-        if (*ptTimestampQueryPool) {
-            commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eComputeShader, *ptTimestampQueryPool, queryBase + kPtTS_ReprojectionStart);
-        }
         commandBuffer.dispatch(gx, gy, 1);
-        if (*ptTimestampQueryPool) {
-            commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eComputeShader, *ptTimestampQueryPool, queryBase + kPtTS_ReprojectionEnd);
-        }
     }
+    writeComputeTimestamp(kTS_ReprojectionEnd);
 
     auto barrierCompute = [&](vk::Image img) {
         transition_image_layout(img, vk::ImageLayout::eGeneral, vk::ImageLayout::eGeneral,
@@ -1066,42 +1546,44 @@ void EngineCore::recordRayTracingCommandBuffer(const vk::raii::CommandBuffer &co
     };
     barrierCompute(*frames.atrousTemp[atrousA]);
     barrierCompute(*frames.historyMoments[fi]);
+    if (tiledDenoiser) {
+        barrierCompute(*frames.atrousTemp[atrousB]);
+    }
 
-    // 5. A-Trous denoiser.
-    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.atrousPipeline);
+    // 6. A-Trous denoiser. Iteration i reads A when i is even and writes B (A on odd iterations); on the
+    // tiled path iteration 0 already ran inside the fused reprojection pass.
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
+                               tiledDenoiser ? *pipelines.atrousTiledPipeline : *pipelines.atrousPipeline);
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
                                      *pipelines.denoiserPipelineLayout, 0, *denoiserDescriptorSets[fi], nullptr);
 
-    const int atrousIterations = ui.pathTracerSettings.enableDenoiser ? std::clamp(ui.pathTracerSettings.denoiserIterations, 1, 5) : 0;
-    const int useRawInput = ui.pathTracerSettings.enableReprojection ? 0 : 1;
-    
-    if (*ptTimestampQueryPool) {
-        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eComputeShader, *ptTimestampQueryPool, queryBase + kPtTS_DenoiserStart);
-    }
-    
+    writeComputeTimestamp(kTS_DenoiserStart);
+
     if (atrousIterations == 0) {
         // Pass-through tonemapping
         DenoisePushConstants atrousPush{
             .stepSize = 0,
             .isLastPass = 1,
-            .phiColor = 1.0f,
-            .phiNormal = 128.0f,
-            .exposureScale = ui.exposure,
-            .useRawInput = useRawInput};
+            .phiColor = kAtrousPhiColor,
+            .phiNormal = kAtrousPhiNormal,
+            .exposureScale = ui.exposure};
         commandBuffer.pushConstants<DenoisePushConstants>(*pipelines.denoiserPipelineLayout,
                                                           vk::ShaderStageFlagBits::eCompute, 0, atrousPush);
         commandBuffer.dispatch(gx, gy, 1);
-    } else {
-        for (int iter = 0; iter < atrousIterations; ++iter) {
-            const int32_t stepSize = 1 << iter;
+    }
+
+    const int firstDispatchedIteration = tiledDenoiser ? 1 : 0;
+    for (int iter = 0; iter < static_cast<int>(kPtMaxDenoiserIterations); ++iter) {
+        if (iter >= firstDispatchedIteration && iter < atrousIterations) {
             const int32_t isLastPass = (iter == atrousIterations - 1) ? 1 : 0;
             DenoisePushConstants atrousPush{
-                .stepSize = stepSize,
+                .stepSize = 1 << iter,
                 .isLastPass = isLastPass,
-                .phiColor = 1.0f,
-                .phiNormal = 128.0f,
+                .phiColor = kAtrousPhiColor,
+                .phiNormal = kAtrousPhiNormal,
                 .exposureScale = ui.exposure,
-                .useRawInput = useRawInput};
+                .renderWidth = rtWidth,
+                .renderHeight = rtHeight};
             commandBuffer.pushConstants<DenoisePushConstants>(*pipelines.denoiserPipelineLayout,
                                                               vk::ShaderStageFlagBits::eCompute, 0, atrousPush);
             commandBuffer.dispatch(gx, gy, 1);
@@ -1111,17 +1593,177 @@ void EngineCore::recordRayTracingCommandBuffer(const vk::raii::CommandBuffer &co
                 barrierCompute(*frames.atrousTemp[(writeBuf == 0) ? atrousB : atrousA]);
             }
         }
+        writeComputeTimestamp(kTS_DenoiserIterationEnd + iter);
     }
-    
-    if (*ptTimestampQueryPool) {
-        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eComputeShader, *ptTimestampQueryPool, queryBase + kPtTS_DenoiserEnd);
+
+    writeComputeTimestamp(kTS_DenoiserEnd);
+
+    // 7. Blit denoised image to swapchain.
+    recordPathTracerBlit(commandBuffer, imageIndex, rtExtent);
+}
+
+void EngineCore::recordWavefrontPathTrace(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D rtExtent, uint32_t maxSamples) const {
+    const uint32_t fi = frames.frameIndex;
+
+    // The queues are shared by both frame slots: wait for the previous submission's kernels, then clear the
+    // counters, bin histogram and indirect arguments the first Bin and Extend read.
+    vk::MemoryBarrier2 previousToClearBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eDrawIndirect,
+        .srcAccessMask = vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eIndirectCommandRead,
+        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eTransfer,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eTransferWrite};
+    vk::DependencyInfo previousToClearDependency{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &previousToClearBarrier};
+    commandBuffer.pipelineBarrier2(previousToClearDependency);
+    commandBuffer.fillBuffer(*frames.wavefrontControl, 0, VK_WHOLE_SIZE, 0u);
+
+    vk::MemoryBarrier2 clearToKernelBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eTransfer,
+        .srcAccessMask = vk::AccessFlagBits2::eTransferWrite,
+        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eDrawIndirect,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eIndirectCommandRead};
+    vk::DependencyInfo clearToKernelDependency{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &clearToKernelBarrier};
+    commandBuffer.pipelineBarrier2(clearToKernelDependency);
+
+    // Every kernel consumes what the one before it wrote, either as data or as its indirect arguments.
+    vk::MemoryBarrier2 kernelToKernelBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .srcAccessMask = vk::AccessFlagBits2::eShaderWrite,
+        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eDrawIndirect,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eIndirectCommandRead};
+    vk::DependencyInfo kernelToKernelDependency{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &kernelToKernelBarrier};
+
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelines.wavefrontPipelineLayout, 0,
+                                     {*rtDescriptorSets[fi], *descriptorSets[fi], *wavefrontDescriptorSets[fi]}, nullptr);
+
+    // Without adaptive sampling every pixel traces one path (see the sample budget pass).
+    const uint32_t pixelCount = rtExtent.width * rtExtent.height;
+    WavefrontScheduleParams scheduleParams{
+        .pixelCount = pixelCount,
+        .chunkCapacity = EngineConfig::kWavefrontMaxPaths,
+        .maxPathsPerPixel = std::max(maxSamples, 1u),
+        .maxBounces = static_cast<uint32_t>(std::clamp(ui.pathTracerSettings.maxBounces, 1, 3)),
+        .sortHits = ui.pathTracerSettings.sortHitsByMaterial};
+    std::vector<WavefrontDispatch> &schedule = wavefrontSchedules[fi];
+    schedule = buildWavefrontSchedule(scheduleParams);
+
+    // The pool fits the longest schedule (see createWavefrontTimestampQueryPool); a shorter count is reported
+    // as truncated timings by collectGpuTimings.
+    const uint32_t timestampBase = fi * wavefrontTimestampQueryCountPerFrame;
+    uint32_t &timestampCount = wavefrontTimestampCounts[fi];
+    timestampCount = 0;
+    auto writeKernelTimestamp = [&]() {
+        if (*wavefrontTimestampQueryPool && timestampCount < wavefrontTimestampQueryCountPerFrame) {
+            commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eComputeShader, *wavefrontTimestampQueryPool,
+                                          timestampBase + timestampCount++);
+        }
+    };
+    if (*wavefrontTimestampQueryPool) {
+        commandBuffer.resetQueryPool(*wavefrontTimestampQueryPool, timestampBase, wavefrontTimestampQueryCountPerFrame);
+    }
+    writeKernelTimestamp();
+
+    constexpr uint32_t kGroupSize = 64;
+    const vk::DeviceSize traceArgsOffset = kWavefrontControlTraceArgs * sizeof(uint32_t);
+    const vk::DeviceSize shadeArgsOffset = kWavefrontControlShadeArgs * sizeof(uint32_t);
+    for (size_t i = 0; i < schedule.size(); ++i) {
+        const WavefrontDispatch &dispatch = schedule[i];
+        const uint32_t chunkBase = dispatch.chunk * EngineConfig::kWavefrontMaxPaths;
+        WavefrontPushConstants push{
+            .renderWidth = rtExtent.width,
+            .renderHeight = rtExtent.height,
+            .chunkBase = chunkBase,
+            .chunkSize = std::min(EngineConfig::kWavefrontMaxPaths, pixelCount - chunkBase),
+            .queueCapacity = EngineConfig::kWavefrontMaxPaths,
+            .pathIndex = dispatch.pathIndex,
+            .bounce = dispatch.bounce,
+            // Generate fills queue 0; each Shade appends to the other queue, which the next Extend reads.
+            .queueIndex = dispatch.bounce & 1u,
+            .sortHits = scheduleParams.sortHits ? 1u : 0u};
+
+        if (i > 0) {
+            commandBuffer.pipelineBarrier2(kernelToKernelDependency);
+        }
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.wavefrontPipelines[static_cast<uint32_t>(dispatch.kernel)]);
+        commandBuffer.pushConstants<WavefrontPushConstants>(*pipelines.wavefrontPipelineLayout,
+                                                            vk::ShaderStageFlagBits::eCompute, 0, push);
+        switch (dispatch.kernel) {
+            case WavefrontKernel::Primary:
+            case WavefrontKernel::Generate:
+            case WavefrontKernel::Resolve:
+                commandBuffer.dispatch((push.chunkSize + kGroupSize - 1) / kGroupSize, 1, 1);
+                break;
+            case WavefrontKernel::Bin:
+                commandBuffer.dispatch(1, 1, 1);
+                break;
+            case WavefrontKernel::Extend:
+                commandBuffer.dispatchIndirect(*frames.wavefrontControl, traceArgsOffset);
+                break;
+            case WavefrontKernel::Scatter:
+            case WavefrontKernel::Shade:
+            case WavefrontKernel::Shadow:
+                commandBuffer.dispatchIndirect(*frames.wavefrontControl, shadeArgsOffset);
+                break;
+        }
+        writeKernelTimestamp();
     }
+}
+
+void EngineCore::recordProgressiveAccumulationPass(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D rtExtent) const {
+    const uint32_t fi = frames.frameIndex;
 
-    // 6. Blit denoised image to swapchain.
-    transition_image_layout(*frames.rayTracingOutputImages[fi],
-                            vk::ImageLayout::eGeneral, vk::ImageLayout::eTransferSrcOptimal,
-                            vk::AccessFlagBits2::eShaderWrite, vk::AccessFlagBits2::eTransferRead,
-                            vk::PipelineStageFlagBits2::eComputeShader, vk::PipelineStageFlagBits2::eTransfer,
+    // The accumulation image is shared by both frame slots: wait for the previous submission's pass. Its
+    // first use after a restart (sample index 0) writes before it reads, so the old contents may be discarded.
+    const vk::ImageLayout accumulationOldLayout = (ptProgressiveSampleIndex == 0) ? vk::ImageLayout::eUndefined : vk::ImageLayout::eGeneral;
+    transition_image_layout(*frames.progressiveAccumulation, accumulationOldLayout, vk::ImageLayout::eGeneral,
+                            vk::AccessFlagBits2::eShaderWrite, vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite,
+                            vk::PipelineStageFlagBits2::eComputeShader, vk::PipelineStageFlagBits2::eComputeShader,
+                            vk::ImageAspectFlagBits::eColor);
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.progressiveAccumulatePipeline);
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                                     *pipelines.denoiserPipelineLayout, 0, *denoiserDescriptorSets[fi], nullptr);
+    ProgressivePushConstants progressivePush{
+        .renderWidth = rtExtent.width,
+        .renderHeight = rtExtent.height,
+        .sampleIndex = ptProgressiveSampleIndex,
+        .addSample = ptProgressiveConverged ? 0u : 1u,
+        .exposureScale = ui.exposure,
+        .noiseThreshold = std::max(0.0f, ui.pathTracerSettings.progressiveNoiseThreshold)};
+    commandBuffer.pushConstants<ProgressivePushConstants>(*pipelines.denoiserPipelineLayout,
+                                                          vk::ShaderStageFlagBits::eCompute, 0, progressivePush);
+    commandBuffer.dispatch((rtExtent.width + 15) / 16, (rtExtent.height + 15) / 16, 1);
+
+    // The noisy pixel count is read on the host once this slot's fence signals.
+    vk::MemoryBarrier2 computeToHostBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .srcAccessMask = vk::AccessFlagBits2::eShaderWrite,
+        .dstStageMask = vk::PipelineStageFlagBits2::eHost,
+        .dstAccessMask = vk::AccessFlagBits2::eHostRead};
+    vk::DependencyInfo computeToHostDependency{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &computeToHostBarrier};
+    commandBuffer.pipelineBarrier2(computeToHostDependency);
+}
+
+void EngineCore::recordPathTracerBlit(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex, vk::Extent2D rtExtent) const {
+    recordBlitToSwapchain(commandBuffer, imageIndex, *frames.rayTracingOutputImages[frames.frameIndex], rtExtent,
+                          vk::ImageLayout::eGeneral, vk::PipelineStageFlagBits2::eComputeShader,
+                          vk::AccessFlagBits2::eShaderWrite, vk::ImageLayout::eGeneral);
+}
+
+void EngineCore::recordBlitToSwapchain(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex, vk::Image source,
+                                       vk::Extent2D sourceExtent, vk::ImageLayout sourceLayout, vk::PipelineStageFlags2 sourceStage,
+                                       vk::AccessFlags2 sourceAccess, vk::ImageLayout restoreLayout) const {
+    transition_image_layout(source,
+                            sourceLayout, vk::ImageLayout::eTransferSrcOptimal,
+                            sourceAccess, vk::AccessFlagBits2::eTransferRead,
+                            sourceStage, vk::PipelineStageFlagBits2::eTransfer,
                             vk::ImageAspectFlagBits::eColor);
 
     transition_image_layout(swapchain.images[imageIndex],
@@ -1132,15 +1774,15 @@ void EngineCore::recordRayTracingCommandBuffer(const vk::raii::CommandBuffer &co
 
     vk::ImageBlit blitRegion{
         .srcSubresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1},
-        .srcOffsets = {{vk::Offset3D{0, 0, 0}, vk::Offset3D{static_cast<int32_t>(rtWidth), static_cast<int32_t>(rtHeight), 1}}},
+        .srcOffsets = {{vk::Offset3D{0, 0, 0}, vk::Offset3D{static_cast<int32_t>(sourceExtent.width), static_cast<int32_t>(sourceExtent.height), 1}}},
         .dstSubresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1},
         .dstOffsets = {{vk::Offset3D{0, 0, 0}, vk::Offset3D{static_cast<int32_t>(swapchain.extent.width), static_cast<int32_t>(swapchain.extent.height), 1}}}
     };
-    commandBuffer.blitImage(*frames.rayTracingOutputImages[fi], vk::ImageLayout::eTransferSrcOptimal,
+    commandBuffer.blitImage(source, vk::ImageLayout::eTransferSrcOptimal,
                             swapchain.images[imageIndex], vk::ImageLayout::eTransferDstOptimal, blitRegion, vk::Filter::eLinear);
 
-    transition_image_layout(*frames.rayTracingOutputImages[fi],
-                            vk::ImageLayout::eTransferSrcOptimal, vk::ImageLayout::eGeneral,
+    transition_image_layout(source,
+                            vk::ImageLayout::eTransferSrcOptimal, restoreLayout,
                             vk::AccessFlagBits2::eTransferRead, {},
                             vk::PipelineStageFlagBits2::eTransfer, vk::PipelineStageFlagBits2::eBottomOfPipe,
                             vk::ImageAspectFlagBits::eColor);
@@ -1152,22 +1794,53 @@ void EngineCore::recordRayTracingCommandBuffer(const vk::raii::CommandBuffer &co
                             vk::ImageAspectFlagBits::eColor);
 }
 
+void EngineCore::recordTemporalUpscalePass(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D renderExtent, uint32_t inputMode) const {
+    const uint32_t fi = frames.frameIndex;
+
+    // The previous submission's pass wrote the history this one reads, and read the one it writes.
+    vk::MemoryBarrier2 historyBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .srcAccessMask = vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eShaderRead,
+        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite};
+    vk::DependencyInfo historyDependency{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &historyBarrier};
+    commandBuffer.pipelineBarrier2(historyDependency);
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.temporalUpscalePipeline);
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelines.upscalePipelineLayout, 0,
+                                     {*upscaleDescriptorSets[fi], *descriptorSets[fi]}, nullptr);
+    UpscalePushConstants upscalePush{
+        .renderWidth = renderExtent.width,
+        .renderHeight = renderExtent.height,
+        .outputWidth = swapchain.extent.width,
+        .outputHeight = swapchain.extent.height,
+        .inputMode = inputMode,
+        .resetHistory = upscaleHistoryInvalid ? 1u : 0u};
+    commandBuffer.pushConstants<UpscalePushConstants>(*pipelines.upscalePipelineLayout,
+                                                      vk::ShaderStageFlagBits::eCompute, 0, upscalePush);
+    commandBuffer.dispatch((swapchain.extent.width + 15) / 16, (swapchain.extent.height + 15) / 16, 1);
+}
+
 void EngineCore::createDescriptorPool() {
     // Generous pool sizes to accommodate an arbitrary number of loaded models.
     // eSampledImage / eSampler are separate because the shadow map binding uses them
     // as distinct descriptor types (binding 1 and 2 in the global layout).
     constexpr uint32_t poolScale = Laphria::EngineConfig::kDescriptorPoolScale;
-    std::array<vk::DescriptorPoolSize, 7> poolSizes = {
+    std::vector<vk::DescriptorPoolSize> poolSizes = {
         vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, poolScale},
         // 1000 per loaded model (material textures) + 2×1000 for the two RT descriptor sets.
         vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, 5 * poolScale},
         vk::DescriptorPoolSize{vk::DescriptorType::eSampledImage, poolScale},
         vk::DescriptorPoolSize{vk::DescriptorType::eSampler, poolScale},
-        // 1000 for materials + vertex and index buffers * MAX_FRAMES
+        // 1000 each for vertex, index, material and previous skinned position arrays * MAX_FRAMES
         vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, 15 * poolScale},
-        vk::DescriptorPoolSize{vk::DescriptorType::eStorageImage, poolScale},
-        vk::DescriptorPoolSize{vk::DescriptorType::eAccelerationStructureKHR, MAX_FRAMES_IN_FLIGHT}
+        vk::DescriptorPoolSize{vk::DescriptorType::eStorageImage, poolScale}
     };
+    if (vulkan.rayTracingSupported) {
+        poolSizes.push_back(vk::DescriptorPoolSize{vk::DescriptorType::eAccelerationStructureKHR, MAX_FRAMES_IN_FLIGHT});
+    }
 
     vk::DescriptorPoolCreateInfo poolInfo{
         // eFreeDescriptorSet: allows individual sets to be freed (needed by ResourceManager).
@@ -1197,6 +1870,8 @@ void EngineCore::createDescriptorSets() {
     //   binding 0 → UniformBufferObject  (view/proj/light/cascade matrices, camera pos)
     //   binding 1 → shadow depth array   (sampled, ShaderReadOnlyOptimal)
     //   binding 2 → shadow PCF sampler   (comparison sampler)
+    //   binding 3 → punctual lights      (host-written PunctualLightData)
+    //   binding 4 → light clusters       (written by the light culling pass)
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
         vk::DescriptorBufferInfo bufferInfo{
             .buffer = *frames.uniformBuffers[i],
@@ -1244,7 +1919,27 @@ void EngineCore::createDescriptorSets() {
             .pImageInfo = &shadowSamplerInfo
         };
 
-        std::array<vk::WriteDescriptorSet, 3> writes = {uboWrite, shadowImageWrite, shadowSamplerWrite};
+        vk::DescriptorBufferInfo lightInfo{*frames.punctualLightBuffers[i], 0, VK_WHOLE_SIZE};
+        vk::WriteDescriptorSet lightWrite{
+            .dstSet = *descriptorSets[i],
+            .dstBinding = 3,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = vk::DescriptorType::eStorageBuffer,
+            .pBufferInfo = &lightInfo
+        };
+
+        vk::DescriptorBufferInfo clusterInfo{*frames.lightClusterBuffers[i], 0, VK_WHOLE_SIZE};
+        vk::WriteDescriptorSet clusterWrite{
+            .dstSet = *descriptorSets[i],
+            .dstBinding = 4,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = vk::DescriptorType::eStorageBuffer,
+            .pBufferInfo = &clusterInfo
+        };
+
+        std::array<vk::WriteDescriptorSet, 5> writes = {uboWrite, shadowImageWrite, shadowSamplerWrite, lightWrite, clusterWrite};
         vulkan.logicalDevice.updateDescriptorSets(writes, {});
     }
 }
@@ -1252,37 +1947,126 @@ void EngineCore::createDescriptorSets() {
 void EngineCore::createTimestampQueryPool() {
     vk::QueryPoolCreateInfo queryPoolInfo{
         .queryType = vk::QueryType::eTimestamp,
-        .queryCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * kPtTimestampQueryCountPerFrame};
-    ptTimestampQueryPool = vk::raii::QueryPool(vulkan.logicalDevice, queryPoolInfo);
+        .queryCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * kTimestampQueryCountPerFrame};
+    gpuTimestampQueryPool = vk::raii::QueryPool(vulkan.logicalDevice, queryPoolInfo);
+    createWavefrontTimestampQueryPool();
     timestampPeriodNs = vulkan.physicalDevice.getProperties().limits.timestampPeriod;
 }
 
-uint32_t EngineCore::getPathTracerQueryBase(uint32_t frameSlot) const {
-    return frameSlot * kPtTimestampQueryCountPerFrame;
+void EngineCore::createWavefrontTimestampQueryPool() {
+    // Slots recorded against the old pool have nothing to read back.
+    wavefrontTimestampQueryPool = nullptr;
+    wavefrontTimestampCounts.fill(0);
+    wavefrontTimestampQueryCountPerFrame = 0;
+    if (!vulkan.rayQuerySupported) {
+        return;
+    }
+    // One timestamp before the first dispatch and one after each, for the longest schedule a frame can record:
+    // the path tracer never renders above the swapchain extent, and its sample and bounce counts are clamped.
+    const WavefrontScheduleParams longestSchedule{
+        .pixelCount = swapchain.extent.width * swapchain.extent.height,
+        .chunkCapacity = EngineConfig::kWavefrontMaxPaths,
+        .maxPathsPerPixel = kPtMaxSamplesPerPixel,
+        .maxBounces = 3,
+        .sortHits = true};
+    wavefrontTimestampQueryCountPerFrame = static_cast<uint32_t>(wavefrontScheduleLength(longestSchedule)) + 1;
+    vk::QueryPoolCreateInfo wavefrontQueryPoolInfo{
+        .queryType = vk::QueryType::eTimestamp,
+        .queryCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT) * wavefrontTimestampQueryCountPerFrame};
+    wavefrontTimestampQueryPool = vk::raii::QueryPool(vulkan.logicalDevice, wavefrontQueryPoolInfo);
+}
+
+uint32_t EngineCore::getTimestampQueryBase(uint32_t frameSlot) const {
+    return frameSlot * kTimestampQueryCountPerFrame;
+}
+
+vk::Extent2D EngineCore::getPathTracerRenderExtent() const {
+    const float clampedScale = std::clamp(ui.pathTracerSettings.resolutionScale, 0.5f, 1.0f);
+    const float secondaryScale = ui.pathTracerSettings.reduceSecondaryEffects ? 0.90f : 1.0f;
+    const float effectiveScale = std::clamp(clampedScale * secondaryScale, 0.5f, 1.0f);
+    return {std::max(1u, static_cast<uint32_t>(static_cast<float>(swapchain.extent.width) * effectiveScale)),
+            std::max(1u, static_cast<uint32_t>(static_cast<float>(swapchain.extent.height) * effectiveScale))};
+}
+
+vk::Extent2D EngineCore::getRenderExtent() const {
+    const float scale = std::clamp(ui.frameTimeSettings.resolutionScale, 0.5f, 1.0f);
+    return {std::max(1u, static_cast<uint32_t>(static_cast<float>(swapchain.extent.width) * scale)),
+            std::max(1u, static_cast<uint32_t>(static_cast<float>(swapchain.extent.height) * scale))};
 }
 
-void EngineCore::collectPathTracerTimings(uint32_t frameSlot) {
-    if (!*ptTimestampQueryPool || !ptTimestampsValid[frameSlot]) {
+glm::mat4 EngineCore::getCullingViewProjection() const {
+    // The swapchain aspect like the UBO projection; the render extent keeps it up to rounding.
+    const float aspectRatio = static_cast<float>(swapchain.extent.width) / static_cast<float>(swapchain.extent.height);
+    const glm::mat4 proj = glm::perspective(
+        glm::radians(Laphria::EngineConfig::kMainCameraFovDegrees),
+        aspectRatio,
+        Laphria::EngineConfig::kMainCameraNearPlane,
+        Laphria::EngineConfig::kMainCameraFarPlane);
+    return proj * camera.getViewMatrix();
+}
+
+bool EngineCore::isWavefrontTracerActive() const {
+    // Devices without ray queries keep the megakernel whatever the setting.
+    return vulkan.rayQuerySupported && ui.pathTracerSettings.wavefront;
+}
+
+bool EngineCore::isTemporalUpscalingActive() const {
+    // At native resolution raster and classic RT render straight to the swapchain (raster) or blit 1:1.
+    return ui.renderMode != RenderMode::PathTracer && ui.frameTimeSettings.temporalUpscaling &&
+           getRenderExtent() != swapchain.extent;
+}
+
+float EngineCore::getFrameTimeNativePixels() const {
+    // Pixels at resolution scale 1. Reduced secondary effects shrink the path tracer's extent on top of the
+    // scale, so the controller sees them as part of the native size.
+    const float secondaryScale = (ui.renderMode == RenderMode::PathTracer && ui.pathTracerSettings.reduceSecondaryEffects) ? 0.90f : 1.0f;
+    return static_cast<float>(swapchain.extent.width) * static_cast<float>(swapchain.extent.height) * secondaryScale * secondaryScale;
+}
+
+FrameTimeKnobs EngineCore::getFrameTimeKnobs() const {
+    const bool pathTracer = ui.renderMode == RenderMode::PathTracer;
+    const bool adaptiveSampling = ui.pathTracerSettings.adaptiveSampling && ui.pathTracerSettings.enableReprojection;
+    FrameTimeKnobs knobs;
+    knobs.resolutionScale = pathTracer ? ui.pathTracerSettings.resolutionScale : ui.frameTimeSettings.resolutionScale;
+    knobs.sampleBudgetScale = (pathTracer && adaptiveSampling) ? ptSampleBudgetScale : 0.0f;
+    knobs.denoiserIterations = (pathTracer && ui.pathTracerSettings.enableDenoiser)
+                                   ? static_cast<uint32_t>(std::clamp(ui.pathTracerSettings.denoiserIterations, 1, static_cast<int>(kPtMaxDenoiserIterations)))
+                                   : 0u;
+    knobs.shadowUpdatePeriod = static_cast<uint32_t>(std::max(ui.frameTimeSettings.shadowUpdatePeriod, 1));
+    knobs.textureLodBias = ui.frameTimeSettings.textureLodBias;
+    return knobs;
+}
+
+void EngineCore::collectGpuTimings(uint32_t frameSlot) {
+    if (!*gpuTimestampQueryPool || !timestampsWritten[frameSlot]) {
         return;
     }
+    timestampsWritten[frameSlot] = false;
 
-    std::array<uint64_t, kPtTimestampQueryCountPerFrame> timestamps{};
+    // Value and availability per query: passes the slot's backend did not record stay unavailable, which
+    // makes the call report eNotReady without waiting, and read as 0 below.
+    std::array<uint64_t, 2 * kTimestampQueryCountPerFrame> results{};
     const VkResult queryResult = vkGetQueryPoolResults(
         static_cast<VkDevice>(*vulkan.logicalDevice),
-        static_cast<VkQueryPool>(*ptTimestampQueryPool),
-        getPathTracerQueryBase(frameSlot),
-        kPtTimestampQueryCountPerFrame,
-        sizeof(timestamps),
-        timestamps.data(),
-        sizeof(uint64_t),
-        VK_QUERY_RESULT_64_BIT);
-
-    if (queryResult != VK_SUCCESS) {
+        static_cast<VkQueryPool>(*gpuTimestampQueryPool),
+        getTimestampQueryBase(frameSlot),
+        kTimestampQueryCountPerFrame,
+        sizeof(results),
+        results.data(),
+        2 * sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+    if (queryResult != VK_SUCCESS && queryResult != VK_NOT_READY) {
         return;
     }
 
+    std::array<uint64_t, kTimestampQueryCountPerFrame> timestamps{};
+    for (uint32_t i = 0; i < kTimestampQueryCountPerFrame; ++i) {
+        timestamps[i] = (results[2 * i + 1] != 0) ? results[2 * i] : 0;
+    }
+
     auto toMs = [this](uint64_t start, uint64_t end) -> float {
-        if (end <= start) {
+        if (start == 0 || end <= start) {
             return 0.0f;
         }
         const double deltaTicks = static_cast<double>(end - start);
@@ -1290,56 +2074,740 @@ void EngineCore::collectPathTracerTimings(uint32_t frameSlot) {
         return static_cast<float>(deltaNs * 1e-6);
     };
 
-    ui.pathTracerPerfStats.tlasBuildMs = toMs(timestamps[kPtTS_TlasStart], timestamps[kPtTS_TlasEnd]);
-    ui.pathTracerPerfStats.rayTraceMs = toMs(timestamps[kPtTS_RayTraceStart], timestamps[kPtTS_RayTraceEnd]);
-    ui.pathTracerPerfStats.reprojectionMs = toMs(timestamps[kPtTS_ReprojectionStart], timestamps[kPtTS_ReprojectionEnd]);
-    ui.pathTracerPerfStats.denoiserMs = toMs(timestamps[kPtTS_DenoiserStart], timestamps[kPtTS_DenoiserEnd]);
+    FrameTimeSample &sample = submittedFrameTimeSamples[frameSlot];
+    sample.frameMs = toMs(timestamps[kTS_FrameStart], timestamps[kTS_FrameEnd]);
+    sample.shadowMs = toMs(timestamps[kTS_ShadowStart], timestamps[kTS_ShadowEnd]);
+    sample.sceneMs = toMs(timestamps[kTS_SceneStart], timestamps[kTS_SceneEnd]);
+    sample.reprojectionMs = toMs(timestamps[kTS_ReprojectionStart], timestamps[kTS_ReprojectionEnd]);
+    sample.denoiserMs = toMs(timestamps[kTS_DenoiserStart], timestamps[kTS_DenoiserEnd]);
+    frameTimeController.addSample(sample);
+
+    ui.frameTimeStats.shadowMs = sample.shadowMs;
+    ui.frameTimeStats.sceneMs = sample.sceneMs;
+    ui.frameTimeStats.shadowCascadesRendered = sample.shadowCascadesRendered;
+
+    if (submittedRenderModes[frameSlot] != RenderMode::PathTracer) {
+        return;
+    }
+    ui.pathTracerPerfStats.tlasBuildMs = toMs(timestamps[kTS_TlasStart], timestamps[kTS_TlasEnd]);
+    ui.pathTracerPerfStats.rayTraceMs = sample.sceneMs;
+    ui.pathTracerPerfStats.reprojectionMs = sample.reprojectionMs;
+    ui.pathTracerPerfStats.denoiserMs = sample.denoiserMs;
+    uint64_t iterationStart = timestamps[kTS_DenoiserStart];
+    for (uint32_t iter = 0; iter < kPtMaxDenoiserIterations; ++iter) {
+        const uint64_t iterationEnd = timestamps[kTS_DenoiserIterationEnd + iter];
+        ui.pathTracerPerfStats.denoiserIterationMs[iter] = toMs(iterationStart, iterationEnd);
+        iterationStart = iterationEnd;
+    }
+    ui.pathTracerPerfStats.totalFrameMs = sample.frameMs;
+
+    // Last trace time of each tracer at each bounce count, so both can be compared on the same view.
+    const uint32_t bounces = std::clamp(submittedMaxBounces[frameSlot], 1u, 3u);
+    ui.pathTracerPerfStats.traceMsByTracer[submittedWavefront[frameSlot] ? 1 : 0][bounces - 1] = sample.sceneMs;
+
+    std::fill(std::begin(ui.pathTracerPerfStats.wavefrontKernelMs), std::end(ui.pathTracerPerfStats.wavefrontKernelMs), 0.0f);
+    ui.pathTracerPerfStats.wavefrontTimingTruncated = false;
+    const uint32_t wavefrontTimestampCount = wavefrontTimestampCounts[frameSlot];
+    if (!submittedWavefront[frameSlot] || !*wavefrontTimestampQueryPool || wavefrontTimestampCount == 0) {
+        return;
+    }
+    // Dispatches past the pool's capacity ran untimed, so the breakdown only covers the leading ones.
+    ui.pathTracerPerfStats.wavefrontTimingTruncated = wavefrontTimestampCount < wavefrontSchedules[frameSlot].size() + 1;
+    std::vector<uint64_t> wavefrontResults(2 * static_cast<size_t>(wavefrontTimestampCount));
+    const VkResult wavefrontQueryResult = vkGetQueryPoolResults(
+        static_cast<VkDevice>(*vulkan.logicalDevice),
+        static_cast<VkQueryPool>(*wavefrontTimestampQueryPool),
+        frameSlot * wavefrontTimestampQueryCountPerFrame,
+        wavefrontTimestampCount,
+        wavefrontResults.size() * sizeof(uint64_t),
+        wavefrontResults.data(),
+        2 * sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (wavefrontQueryResult != VK_SUCCESS && wavefrontQueryResult != VK_NOT_READY) {
+        return;
+    }
+    std::vector<uint64_t> wavefrontTimestamps(wavefrontTimestampCount);
+    for (uint32_t i = 0; i < wavefrontTimestampCount; ++i) {
+        wavefrontTimestamps[i] = (wavefrontResults[2 * i + 1] != 0) ? wavefrontResults[2 * i] : 0;
+    }
+    const std::array<uint64_t, kWavefrontKernelCount> kernelTicks =
+        sumWavefrontKernelTicks(wavefrontSchedules[frameSlot], wavefrontTimestamps);
+    for (uint32_t kernel = 0; kernel < kWavefrontKernelCount; ++kernel) {
+        ui.pathTracerPerfStats.wavefrontKernelMs[kernel] =
+            static_cast<float>(static_cast<double>(kernelTicks[kernel]) * static_cast<double>(timestampPeriodNs) * 1e-6);
+    }
+}
+
+void EngineCore::updateFrameTimeController() {
+    // Progressive mode traces a fixed count at a fixed resolution; retuning either would restart it.
+    if (ptProgressiveActive) {
+        return;
+    }
+
+    const bool manual = ui.frameTimeSettings.mode == FrameTimeMode::Manual;
+    const bool pathTracer = ui.renderMode == RenderMode::PathTracer;
+    const bool rasterizer = ui.renderMode == RenderMode::Rasterizer;
+    const bool adaptiveSampling = pathTracer && ui.pathTracerSettings.adaptiveSampling && ui.pathTracerSettings.enableReprojection;
+    const FrameTimeKnobs current = getFrameTimeKnobs();
+
+    // Knobs the active backend does not read are pinned, and so is everything in Manual except the sample
+    // budget: adaptive sampling always spends whatever the target leaves.
+    FrameTimeLimits limits;
+    limits.minSampleBudgetScale = kPtMinSampleBudgetScale;
+    limits.maxSampleBudgetScale = kPtMaxSampleBudgetScale;
+    limits.maxDenoiserIterations = kPtMaxDenoiserIterations;
+    if (!adaptiveSampling) {
+        limits.minSampleBudgetScale = limits.maxSampleBudgetScale = current.sampleBudgetScale;
+    }
+    if (manual) {
+        limits.minResolutionScale = limits.maxResolutionScale = current.resolutionScale;
+    }
+    if (manual || current.denoiserIterations == 0) {
+        limits.minDenoiserIterations = limits.maxDenoiserIterations = current.denoiserIterations;
+    }
+    if (manual || !rasterizer) {
+        limits.minShadowUpdatePeriod = limits.maxShadowUpdatePeriod = current.shadowUpdatePeriod;
+    }
+    if (manual) {
+        limits.minTextureLodBias = limits.maxTextureLodBias = current.textureLodBias;
+    }
+
+    const FrameTimeBackend backend = frameTimeBackend(ui.renderMode);
+    const float nativePixels = getFrameTimeNativePixels();
+    const FrameTimeKnobs next = frameTimeController.update(backend, current, limits, nativePixels,
+                                                           ui.frameTimeSettings.targetFrameMs, ui.frameTimeSettings.mode);
+    if (pathTracer) {
+        ui.pathTracerSettings.resolutionScale = next.resolutionScale;
+        if (current.denoiserIterations > 0) {
+            ui.pathTracerSettings.denoiserIterations = static_cast<int>(next.denoiserIterations);
+        }
+        if (adaptiveSampling) {
+            ptSampleBudgetScale = next.sampleBudgetScale;
+        }
+    } else {
+        ui.frameTimeSettings.resolutionScale = next.resolutionScale;
+    }
+    ui.frameTimeSettings.shadowUpdatePeriod = static_cast<int>(next.shadowUpdatePeriod);
+    ui.frameTimeSettings.textureLodBias = next.textureLodBias;
+
+    ui.pathTracerPerfStats.sampleBudgetScale = adaptiveSampling ? ptSampleBudgetScale : 0.0f;
+    ui.frameTimeStats.gpuFrameMs = frameTimeController.smoothedFrameMs();
+    ui.frameTimeStats.predictedMs = frameTimeController.hasModel(backend) ? frameTimeController.predictMs(backend, next, nativePixels) : 0.0f;
+}
+
+uint32_t EngineCore::computeShadowCascadeUpdateMask() {
+    if (ui.renderMode != RenderMode::Rasterizer) {
+        return 0;
+    }
+    // Every cached cascade of both slots was rendered for the old light.
+    if (ui.lightDirection != shadowLightDirection) {
+        shadowCascadeValidMask.fill(0);
+        shadowLightDirection = ui.lightDirection;
+    }
+
+    const uint32_t slot = frames.frameIndex;
+    const uint32_t period = static_cast<uint32_t>(std::max(ui.frameTimeSettings.shadowUpdatePeriod, 1));
+    const uint32_t visit = shadowSlotVisits[slot]++;
+    // The first cascade covers the area around the camera and renders every frame. The others are staggered
+    // so a longer period spreads them evenly over the frames instead of rendering them all at once.
+    uint32_t mask = 1u;
+    for (uint32_t cascade = 1; cascade < NUM_SHADOW_CASCADES; ++cascade) {
+        if ((visit + cascade) % period == 0) {
+            mask |= 1u << cascade;
+        }
+    }
+    mask |= ~shadowCascadeValidMask[slot] & ((1u << NUM_SHADOW_CASCADES) - 1u);
+    shadowCascadeValidMask[slot] |= mask;
+    return mask;
+}
+
+uint32_t EngineCore::getProgressiveSamplesPerFrame() const {
+    return static_cast<uint32_t>(std::clamp(ui.pathTracerSettings.progressiveSamplesPerFrame, 1, static_cast<int>(kPtMaxSamplesPerPixel)));
+}
+
+glm::vec2 EngineCore::getProgressiveJitter() const {
+    if (!ptProgressiveActive || ptProgressiveConverged) {
+        return glm::vec2(0.0f);
+    }
+    // Index 0 of the sequence is the origin; start at 1 so the first frame is not the pixel corner.
+    const uint32_t index = ptProgressiveSampleIndex + 1;
+    return glm::vec2(halton(index, 2), halton(index, 3)) - 0.5f;
+}
 
-    const uint64_t totalStart = (timestamps[kPtTS_TlasStart] != 0) ? timestamps[kPtTS_TlasStart] : timestamps[kPtTS_RayTraceStart];
-    const uint64_t totalEnd = (timestamps[kPtTS_DenoiserEnd] != 0) ? timestamps[kPtTS_DenoiserEnd] : timestamps[kPtTS_RayTraceEnd];
-    ui.pathTracerPerfStats.totalFrameMs = toMs(totalStart, totalEnd);
+glm::vec2 EngineCore::getFrameJitter() const {
+    if (ui.renderMode == RenderMode::PathTracer) {
+        return getProgressiveJitter();
+    }
+    if (!isTemporalUpscalingActive()) {
+        return glm::vec2(0.0f);
+    }
+    const float scale = static_cast<float>(getRenderExtent().width) / static_cast<float>(swapchain.extent.width);
+    const auto phases = static_cast<uint32_t>(std::ceil(kUpscaleJitterPhasesPerPixel / (scale * scale)));
+    // Index 0 of the sequence is the origin; start at 1 like the progressive jitter.
+    const uint32_t index = frames.frameCount % phases + 1;
+    return glm::vec2(halton(index, 2), halton(index, 3)) - 0.5f;
 }
 
-void EngineCore::updateAdaptivePathTracerSettings() {
-    if (ui.pathTracerSettings.qualityMode == UISystem::PathTracerQualityMode::Manual) {
+void EngineCore::updateProgressiveAccumulation(bool restart) {
+    const bool enabled = ui.renderMode == RenderMode::PathTracer && ui.pathTracerSettings.progressiveReference;
+    if (!enabled) {
+        if (ptProgressiveActive) {
+            // Reprojection did not run while accumulating, so the denoiser history is stale.
+            ptProgressiveActive = false;
+            ptHistoryInvalid = true;
+        }
+        return;
+    }
+
+    // Only a static image converges: anything that moves restarts the mean, exposure and the stop conditions
+    // do not (the mean is tone mapped on every resolve, and a raised target simply resumes).
+    const bool sceneMoving = ptCameraMoved || !tlasMotionSettleRanges.empty() || ptSkinnedPoseChanged;
+    if (!ptProgressiveActive || restart || sceneMoving) {
+        ptProgressiveActive = true;
+        ptProgressiveConverged = false;
+        ptProgressiveSampleIndex = 0;
+        ++ptProgressiveGeneration;
+        ptProgressiveStartTime = std::chrono::steady_clock::now();
+        ptProgressiveLastHistorySeconds = 0.0f;
+        ui.progressiveStats = {};
         return;
     }
 
-    const float frameMs = ui.pathTracerPerfStats.totalFrameMs;
-    if (frameMs <= 0.0f) {
+    UISystem::ProgressiveStats &stats = ui.progressiveStats;
+    const uint32_t targetSpp = static_cast<uint32_t>(std::max(ui.pathTracerSettings.progressiveTargetSpp, 1));
+    const bool noiseConverged = ui.pathTracerSettings.progressiveNoiseThreshold > 0.0f && stats.noisyPixelFraction >= 0.0f &&
+                                stats.noisyPixelFraction <= kPtProgressiveConvergedPixelFraction;
+    const bool converged = stats.samplesPerPixel >= targetSpp || noiseConverged;
+    if (converged && !ptProgressiveConverged) {
+        stats.estimatedSecondsRemaining = 0.0f;
+        stats.history.push_back({stats.elapsedSeconds, stats.samplesPerPixel, stats.noisyPixelFraction});
+    }
+    ptProgressiveConverged = converged;
+    stats.converged = converged;
+}
+
+void EngineCore::advanceProgressiveAccumulation() {
+    if (!ptProgressiveActive || ptProgressiveConverged) {
         return;
     }
+    const uint32_t fi = frames.frameIndex;
+    const vk::Extent2D extent = getPathTracerRenderExtent();
+    ptProgressiveSlotGeneration[fi] = ptProgressiveGeneration;
+    // The shader only counts noise once the mean has two estimates to take a variance from.
+    ptProgressiveSlotPixels[fi] = (ptProgressiveSampleIndex >= 1) ? extent.width * extent.height : 0u;
+    ++ptProgressiveSampleIndex;
+
+    UISystem::ProgressiveStats &stats = ui.progressiveStats;
+    stats.samplesPerPixel += getProgressiveSamplesPerFrame();
+    stats.elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - ptProgressiveStartTime).count();
+    if (stats.elapsedSeconds > 0.0f) {
+        stats.samplesPerSecond = static_cast<float>(stats.samplesPerPixel) / stats.elapsedSeconds;
+        const uint32_t targetSpp = static_cast<uint32_t>(std::max(ui.pathTracerSettings.progressiveTargetSpp, 1));
+        stats.estimatedSecondsRemaining = (stats.samplesPerPixel >= targetSpp)
+                                              ? 0.0f
+                                              : static_cast<float>(targetSpp - stats.samplesPerPixel) / stats.samplesPerSecond;
+    }
+    if (stats.history.empty() || stats.elapsedSeconds - ptProgressiveLastHistorySeconds >= kPtProgressiveHistoryIntervalSeconds) {
+        stats.history.push_back({stats.elapsedSeconds, stats.samplesPerPixel, stats.noisyPixelFraction});
+        ptProgressiveLastHistorySeconds = stats.elapsedSeconds;
+    }
+}
+
+void EngineCore::collectProgressiveNoise(uint32_t frameSlot) {
+    auto *noisyPixels = static_cast<uint32_t *>(frames.progressiveNoiseBuffersMapped[frameSlot]);
+    if (ptProgressiveActive && ptProgressiveSlotPixels[frameSlot] > 0 &&
+        ptProgressiveSlotGeneration[frameSlot] == ptProgressiveGeneration &&
+        ui.pathTracerSettings.progressiveNoiseThreshold > 0.0f) {
+        ui.progressiveStats.noisyPixelFraction = static_cast<float>(*noisyPixels) / static_cast<float>(ptProgressiveSlotPixels[frameSlot]);
+    }
+    // The slot's fence has signalled, so the counter can be cleared for the frame about to be recorded into it.
+    *noisyPixels = 0;
+    ptProgressiveSlotPixels[frameSlot] = 0;
+}
 
-    const bool aggressive = (ui.pathTracerSettings.qualityMode == UISystem::PathTracerQualityMode::AutoAggressive);
-    const float targetMs = std::max(8.0f, ui.pathTracerSettings.targetFrameMs);
-    const float dropMargin = aggressive ? 0.25f : 0.75f;
-    const float raiseMargin = aggressive ? 2.5f : 1.5f;
+bool EngineCore::updatePunctualLights() {
+    if (!scene || !resourceManager) {
+        const bool changed = !punctualLightData.empty();
+        punctualLightData.clear();
+        return changed;
+    }
 
-    if (frameMs > targetMs + dropMargin) {
-        if (ui.pathTracerSettings.denoiserIterations > 1) {
-            ui.pathTracerSettings.denoiserIterations -= 1;
-        } else {
-            ui.pathTracerSettings.resolutionScale = std::max(0.50f, ui.pathTracerSettings.resolutionScale - 0.05f);
+    // Every node of an instantiated model is a renderable, so the registry covers light-only nodes too.
+    // Collapsed prefab instances carry their template's light nodes, placed per instance so overrides move them.
+    if (punctualLightInstancesVersion != scene->getComponentsVersion() ||
+        punctualLightInstancesModelCount != resourceManager->getModelCount()) {
+        punctualLightInstances.clear();
+        punctualLightWeights.clear();
+        size_t requested = 0;
+        auto addInstance = [&](const SceneNode &node, uint32_t templateIndex, const ModelResource &modelRes, int sourceNodeIndex) {
+            if (sourceNodeIndex < 0 || sourceNodeIndex >= static_cast<int>(modelRes.nodeLightIndices.size())) {
+                return;
+            }
+            const int lightIndex = modelRes.nodeLightIndices[sourceNodeIndex];
+            if (lightIndex < 0 || ++requested > Laphria::EngineConfig::kMaxPunctualLights) {
+                return;
+            }
+            punctualLightInstances.push_back({&node, templateIndex, node.modelId, lightIndex});
+            punctualLightWeights.push_back(Laphria::punctualLightSelectionWeight(modelRes.lights[lightIndex]));
+        };
+        for (const auto &node: scene->getRenderables()) {
+            const ModelResource *modelRes = resourceManager->getModelResource(node->modelId);
+            if (!modelRes || modelRes->lights.empty()) {
+                continue;
+            }
+            addInstance(*node, 0, *modelRes, node->sourceNodeIndex);
+            if (const auto &prefab = node->getPrefab()) {
+                const auto &templateNodes = prefab->getNodes();
+                for (size_t i = 1; i < templateNodes.size(); ++i) {
+                    addInstance(*node, static_cast<uint32_t>(i), *modelRes, templateNodes[i].sourceNodeIndex);
+                }
+            }
+        }
+        if (requested > punctualLightInstances.size()) {
+            LOGW("Scene has %zu punctual lights; only the first %u are rendered", requested, Laphria::EngineConfig::kMaxPunctualLights);
+        }
+        punctualLightInstancesVersion = scene->getComponentsVersion();
+        punctualLightInstancesModelCount = resourceManager->getModelCount();
+    }
+
+    std::vector<Laphria::PunctualLightData> lights;
+    lights.reserve(punctualLightInstances.size());
+    for (const auto &instance: punctualLightInstances) {
+        const ModelResource *modelRes = resourceManager->getModelResource(instance.modelId);
+        glm::mat4 worldFromLight = instance.node->getWorldTransform();
+        if (instance.templateIndex != 0 && instance.node->getPrefab()) {
+            worldFromLight = worldFromLight * instance.node->getPrefabRootFromNode(instance.templateIndex);
         }
+        lights.push_back(Laphria::makePunctualLightData(modelRes->lights[instance.lightIndex], worldFromLight));
+    }
+    Laphria::buildLightAliasTable(punctualLightWeights, lights);
+    if (!lights.empty()) {
+        memcpy(frames.punctualLightBuffersMapped[frames.frameIndex], lights.data(), sizeof(Laphria::PunctualLightData) * lights.size());
+    }
+
+    const bool changed = lights.size() != punctualLightData.size() ||
+                         (!lights.empty() && memcmp(lights.data(), punctualLightData.data(), sizeof(Laphria::PunctualLightData) * lights.size()) != 0);
+    punctualLightData = std::move(lights);
+    return changed;
+}
+
+void EngineCore::appendTlasInstances(const SceneNode &node, std::vector<vk::AccelerationStructureInstanceKHR> &out) const {
+    ModelResource *modelRes = resourceManager->getModelResource(node.modelId);
+    if (!modelRes || modelRes->blasElements.empty()) {
         return;
     }
 
-    if (frameMs < targetMs - raiseMargin) {
-        if (ui.pathTracerSettings.resolutionScale < 1.0f) {
-            ui.pathTracerSettings.resolutionScale = std::min(1.0f, ui.pathTracerSettings.resolutionScale + 0.05f);
-        } else if (ui.pathTracerSettings.denoiserIterations < 5) {
-            ui.pathTracerSettings.denoiserIterations += 1;
+    // Collapsed prefab instances contribute one TLAS instance per template mesh.
+    node.forEachMeshInstance([&](const glm::mat4 &transform, const std::vector<int> &meshIndices) {
+        // Convert to vk::TransformMatrixKHR (3x4 row-major array)
+        vk::TransformMatrixKHR transformMatrix;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                transformMatrix.matrix[r][c] = transform[c][r]; // GLM is column-major
+            }
         }
+
+        for (int meshIdx: meshIndices) {
+            if (meshIdx < 0 || meshIdx >= modelRes->blasElements.size()) {
+                continue;
+            }
+
+            auto &blas = modelRes->blasElements[meshIdx];
+
+            uint32_t primitiveOffset = 0;
+            for (int i = 0; i < meshIdx; ++i) {
+                primitiveOffset += modelRes->meshes[i].primitives.size();
+            }
+
+            // Encode modelId in top 10 bits, primitiveOffset in bottom 14 bits
+            // InstanceCustomIndex is exactly 24 bit in size.
+            assert(node.modelId < 1024 && "modelId exceeds 10-bit limit; customIndex encoding will be corrupted");
+            uint32_t customIndex = (node.modelId << 14) | (primitiveOffset & 0x3FFF);
+
+            vk::AccelerationStructureDeviceAddressInfoKHR addressInfo{};
+            addressInfo.accelerationStructure = *blas;
+            vk::DeviceAddress blasAddress = vulkan.logicalDevice.getAccelerationStructureAddressKHR(addressInfo);
+
+            vk::AccelerationStructureInstanceKHR instance{};
+            instance.transform = transformMatrix;
+            instance.instanceCustomIndex = customIndex;
+            instance.mask = 0xFF; // All rays hit
+            instance.instanceShaderBindingTableRecordOffset = 0;
+            instance.flags = static_cast<uint32_t>(vk::GeometryInstanceFlagBitsKHR::eTriangleFacingCullDisable);
+            instance.accelerationStructureReference = blasAddress;
+
+            out.push_back(instance);
+        }
+    });
+}
+
+void EngineCore::bindRasterScenePipeline(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D renderExtent) const {
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelines.graphicsPipeline);
+
+    // Y starts at height and height is negative: this flips the Vulkan NDC Y-axis so that
+    // +Y points up in clip space, matching GLM's convention (which was designed for OpenGL).
+    // Below native resolution only the top-left render extent of the scene targets is covered.
+    vk::Viewport viewport{
+        0.0f, static_cast<float>(renderExtent.height),
+        static_cast<float>(renderExtent.width),
+        -static_cast<float>(renderExtent.height), 0.0f, 1.0f
+    };
+    commandBuffer.setViewport(0, viewport);
+    commandBuffer.setScissor(0, vk::Rect2D({0, 0}, renderExtent));
+
+    // Global UBO Binding (Set 0)
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelines.graphicsPipelineLayout, 0,
+                                     *descriptorSets[frames.frameIndex], nullptr);
+}
+
+void EngineCore::recordRasterSceneDraw(const vk::raii::CommandBuffer &commandBuffer, const vk::RenderingInfo &renderingInfo,
+                                       vk::Image depthImage, uint32_t depthSource, vk::Extent2D renderExtent) const {
+    commandBuffer.beginRendering(renderingInfo);
+    bindRasterScenePipeline(commandBuffer, renderExtent);
+
+    const glm::mat4 viewProjection = getCullingViewProjection();
+    const glm::mat4 invViewProjection = glm::inverse(viewProjection);
+
+    const Laphria::Frustum frustum = Laphria::Frustum::fromViewProjection(viewProjection);
+    Laphria::AABB cullBounds = Laphria::Frustum::computeAABB(invViewProjection);
+    // Expand query bounds so close-up objects whose origins are just outside
+    // the near plane are still submitted in raster mode.
+    constexpr float kRasterCullMargin = 2.0f;
+    cullBounds.min -= glm::vec3(kRasterCullMargin);
+    cullBounds.max += glm::vec3(kRasterCullMargin);
+    const uint32_t queryBase = getTimestampQueryBase(frames.frameIndex);
+    if (*gpuTimestampQueryPool) {
+        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllGraphics, *gpuTimestampQueryPool, queryBase + kTS_SceneStart);
+    }
+    if (ui.occlusionCulling) {
+        scene->collectVisibleNodes(cullBounds, frustum, rasterVisibleNodes);
+        recordOcclusionCulledDraws(commandBuffer, renderingInfo, depthImage, depthSource, renderExtent, viewProjection);
+    } else {
+        scene->draw(commandBuffer, pipelines.graphicsPipelineLayout, *resourceManager, cullBounds, frustum);
+    }
+    if (*gpuTimestampQueryPool) {
+        commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllGraphics, *gpuTimestampQueryPool, queryBase + kTS_SceneEnd);
+    }
+}
+
+void EngineCore::recordOcclusionCulledDraws(const vk::raii::CommandBuffer &commandBuffer, const vk::RenderingInfo &renderingInfo,
+                                            vk::Image depthImage, uint32_t depthSource, vk::Extent2D renderExtent,
+                                            const glm::mat4 &viewProjection) const {
+    const uint32_t fi = frames.frameIndex;
+    auto *candidates = static_cast<Laphria::OcclusionCandidate *>(frames.occlusionCandidateBuffersMapped[fi]);
+    auto *lateCommands = static_cast<vk::DrawIndexedIndirectCommand *>(frames.occlusionDrawBuffersMapped[fi]);
+    std::vector<uint64_t> &keys = occlusionSlotKeys[fi];
+    keys.clear();
+    occlusionLateDraws.clear();
+    UISystem::RasterCullingStats &stats = submittedCullingStats[fi];
+    stats.frustumInstances = 0;
+    stats.drawnEarly = 0;
+    occlusionSlotRecorded[fi] = true;
+
+    // First phase: every mesh instance that was visible last frame or cannot be tested is drawn now. The rest
+    // only write their late draws with instanceCount 0, which the test sets; every testable instance becomes a
+    // candidate so next frame's first phase follows this frame's visibility.
+    for (const auto &node: rasterVisibleNodes) {
+        const auto *modelRes = resourceManager->getModelResource(node->modelId);
+        if (!modelRes) {
+            continue;
+        }
+        bool bound = false;
+        uint32_t instanceOrdinal = 0;
+        node->forEachMeshInstance([&](const glm::mat4 &worldTransform, const std::vector<int> &meshIndices) {
+            for (int meshIdx: meshIndices) {
+                if (meshIdx < 0 || meshIdx >= static_cast<int>(modelRes->meshes.size())) {
+                    continue;
+                }
+                const Laphria::LoadedMesh &mesh = modelRes->meshes[meshIdx];
+                ++stats.frustumInstances;
+
+                // Skinned meshes are tested with the pose their skinned stream holds; meshes without bounds are
+                // drawn untested like instances past the candidate limit.
+                const uint64_t key = Laphria::occlusionCandidateKey(node.get(), instanceOrdinal, static_cast<uint32_t>(meshIdx));
+                glm::vec3 localMin;
+                glm::vec3 localMax;
+                const bool testable = meshCullBounds(*modelRes, mesh, localMin, localMax) &&
+                                      keys.size() < Laphria::EngineConfig::kMaxOcclusionCandidates;
+                const bool drawLate = testable && !occlusionHistory.wasVisible(key) &&
+                                      occlusionLateDraws.size() + mesh.primitives.size() <= Laphria::EngineConfig::kMaxOcclusionDraws;
+                if (testable) {
+                    glm::vec3 worldMin;
+                    glm::vec3 worldMax;
+                    Laphria::transformBounds(localMin, localMax, worldTransform, worldMin, worldMax);
+                    candidates[keys.size()] = Laphria::OcclusionCandidate{
+                        .boundsMin = glm::vec4(worldMin, 1.0f),
+                        .boundsMax = glm::vec4(worldMax, 1.0f),
+                        .firstDraw = static_cast<uint32_t>(occlusionLateDraws.size()),
+                        .drawCount = drawLate ? static_cast<uint32_t>(mesh.primitives.size()) : 0u};
+                    keys.push_back(key);
+                }
+                if (!drawLate) {
+                    ++stats.drawnEarly;
+                }
+
+                for (const auto &prim: mesh.primitives) {
+                    Laphria::ScenePushConstants pc{};
+                    pc.modelMatrix = worldTransform;
+                    pc.materialIndex = prim.flatPrimitiveIndex;
+                    if (drawLate) {
+                        lateCommands[occlusionLateDraws.size()] = vk::DrawIndexedIndirectCommand{
+                            .indexCount = prim.indexCount,
+                            .instanceCount = 0,
+                            .firstIndex = prim.firstIndex,
+                            .vertexOffset = static_cast<int32_t>(prim.vertexOffset),
+                            .firstInstance = 0};
+                        occlusionLateDraws.push_back({node->modelId, pc});
+                        continue;
+                    }
+                    if (!bound) {
+                        resourceManager->bindResources(commandBuffer, node->modelId, modelRes->hasRuntimeSkinning);
+                        if (*modelRes->descriptorSet) {
+                            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelines.graphicsPipelineLayout, 1,
+                                                             {*modelRes->descriptorSet}, nullptr);
+                        }
+                        bound = true;
+                    }
+                    commandBuffer.pushConstants<Laphria::ScenePushConstants>(
+                        *pipelines.graphicsPipelineLayout,
+                        vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+                        0, pc);
+                    commandBuffer.drawIndexed(prim.indexCount, 1, prim.firstIndex, prim.vertexOffset, 0);
+                }
+            }
+            ++instanceOrdinal;
+        });
+    }
+
+    if (keys.empty()) {
+        return;
+    }
+    commandBuffer.endRendering();
+
+    transition_image_layout(depthImage,
+                            vk::ImageLayout::eDepthAttachmentOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+                            vk::AccessFlagBits2::eDepthStencilAttachmentWrite, vk::AccessFlagBits2::eShaderRead,
+                            vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                            vk::PipelineStageFlagBits2::eComputeShader,
+                            vk::ImageAspectFlagBits::eDepth);
+    recordOcclusionTest(commandBuffer, depthSource, renderExtent, viewProjection, static_cast<uint32_t>(keys.size()));
+    transition_image_layout(depthImage,
+                            vk::ImageLayout::eShaderReadOnlyOptimal, vk::ImageLayout::eDepthAttachmentOptimal,
+                            vk::AccessFlagBits2::eShaderRead,
+                            vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                            vk::PipelineStageFlagBits2::eComputeShader,
+                            vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                            vk::ImageAspectFlagBits::eDepth);
+
+    // Second phase: the same attachments, loaded instead of cleared.
+    std::vector<vk::RenderingAttachmentInfo> colorAttachments(renderingInfo.pColorAttachments,
+                                                              renderingInfo.pColorAttachments + renderingInfo.colorAttachmentCount);
+    for (auto &attachment: colorAttachments) {
+        attachment.loadOp = vk::AttachmentLoadOp::eLoad;
+    }
+    vk::RenderingAttachmentInfo depthAttachment = *renderingInfo.pDepthAttachment;
+    depthAttachment.loadOp = vk::AttachmentLoadOp::eLoad;
+    vk::RenderingInfo lateRenderingInfo = renderingInfo;
+    lateRenderingInfo.pColorAttachments = colorAttachments.data();
+    lateRenderingInfo.pDepthAttachment = &depthAttachment;
+    commandBuffer.beginRendering(lateRenderingInfo);
+    bindRasterScenePipeline(commandBuffer, renderExtent);
+
+    // Consecutive draws of one model share its bindings.
+    int boundModelId = -1;
+    for (size_t i = 0; i < occlusionLateDraws.size(); ++i) {
+        const OcclusionLateDraw &draw = occlusionLateDraws[i];
+        if (draw.modelId != boundModelId) {
+            const auto *modelRes = resourceManager->getModelResource(draw.modelId);
+            resourceManager->bindResources(commandBuffer, draw.modelId, modelRes->hasRuntimeSkinning);
+            if (*modelRes->descriptorSet) {
+                commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelines.graphicsPipelineLayout, 1,
+                                                 {*modelRes->descriptorSet}, nullptr);
+            }
+            boundModelId = draw.modelId;
+        }
+        commandBuffer.pushConstants<Laphria::ScenePushConstants>(
+            *pipelines.graphicsPipelineLayout,
+            vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+            0, draw.pushConstants);
+        commandBuffer.drawIndexedIndirect(*frames.occlusionDrawBuffers[fi], i * sizeof(vk::DrawIndexedIndirectCommand), 1,
+                                          sizeof(vk::DrawIndexedIndirectCommand));
+    }
+}
+
+void EngineCore::recordOcclusionTest(const vk::raii::CommandBuffer &commandBuffer, uint32_t depthSource, vk::Extent2D renderExtent,
+                                     const glm::mat4 &viewProjection, uint32_t candidateCount) const {
+    const uint32_t fi = frames.frameIndex;
+    // The pyramid covers the render extent; below native resolution only the top-left part of each mip is used.
+    const Laphria::HiZPyramidLayout layout = Laphria::computeHiZPyramidLayout(renderExtent.width, renderExtent.height);
+    const uint32_t sourceCount = static_cast<uint32_t>(frames.depthImageViews.size()) + 1;
+    const uint32_t allocatedMips = frames.hiZLayout.mipCount;
+
+    vk::MemoryBarrier2 mipBarrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .srcAccessMask = vk::AccessFlagBits2::eShaderWrite,
+        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderRead};
+    vk::DependencyInfo mipDependency{.memoryBarrierCount = 1, .pMemoryBarriers = &mipBarrier};
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.hiZReducePipeline);
+    uint32_t srcWidth = renderExtent.width;
+    uint32_t srcHeight = renderExtent.height;
+    for (uint32_t mip = 0; mip < layout.mipCount; ++mip) {
+        const vk::DescriptorSet set = (mip == 0) ? *hiZSourceDescriptorSets[fi * sourceCount + depthSource]
+                                                 : *hiZMipDescriptorSets[fi * (allocatedMips - 1) + mip - 1];
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelines.hiZReducePipelineLayout, 0, {set}, nullptr);
+        const Laphria::HiZReducePushConstants push{
+            .srcWidth = srcWidth,
+            .srcHeight = srcHeight,
+            .dstWidth = std::max(layout.width >> mip, 1u),
+            .dstHeight = std::max(layout.height >> mip, 1u)};
+        commandBuffer.pushConstants<Laphria::HiZReducePushConstants>(*pipelines.hiZReducePipelineLayout,
+                                                                      vk::ShaderStageFlagBits::eCompute, 0, push);
+        commandBuffer.dispatch((push.dstWidth + 7) / 8, (push.dstHeight + 7) / 8, 1);
+        commandBuffer.pipelineBarrier2(mipDependency);
+        srcWidth = push.dstWidth;
+        srcHeight = push.dstHeight;
+    }
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelines.occlusionCullPipeline);
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelines.occlusionCullPipelineLayout, 0,
+                                     {*occlusionCullDescriptorSets[fi]}, nullptr);
+    const Laphria::OcclusionCullPushConstants cullPush{
+        .viewProjection = viewProjection,
+        .candidateCount = candidateCount,
+        .pyramidWidth = layout.width,
+        .pyramidHeight = layout.height,
+        .pyramidMipCount = layout.mipCount,
+        .renderWidth = renderExtent.width,
+        .renderHeight = renderExtent.height};
+    commandBuffer.pushConstants<Laphria::OcclusionCullPushConstants>(*pipelines.occlusionCullPipelineLayout,
+                                                                      vk::ShaderStageFlagBits::eCompute, 0, cullPush);
+    commandBuffer.dispatch((candidateCount + 63) / 64, 1, 1);
+
+    // The late draws read the instance counts as indirect arguments; the host reads the visibility after the
+    // fence. The first phase's colour writes must also land before the second phase loads the attachment.
+    std::array<vk::MemoryBarrier2, 2> resultBarriers = {
+        vk::MemoryBarrier2{
+            .srcStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+            .srcAccessMask = vk::AccessFlagBits2::eShaderWrite,
+            .dstStageMask = vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eHost,
+            .dstAccessMask = vk::AccessFlagBits2::eIndirectCommandRead | vk::AccessFlagBits2::eHostRead},
+        vk::MemoryBarrier2{
+            .srcStageMask = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+            .srcAccessMask = vk::AccessFlagBits2::eColorAttachmentWrite,
+            .dstStageMask = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+            .dstAccessMask = vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite}};
+    vk::DependencyInfo resultDependency{
+        .memoryBarrierCount = static_cast<uint32_t>(resultBarriers.size()),
+        .pMemoryBarriers = resultBarriers.data()};
+    commandBuffer.pipelineBarrier2(resultDependency);
+}
+
+void EngineCore::collectOcclusionResults(uint32_t frameSlot) {
+    auto *results = static_cast<uint32_t *>(frames.occlusionResultBuffersMapped[frameSlot]);
+    if (occlusionSlotRecorded[frameSlot]) {
+        const std::vector<uint64_t> &keys = occlusionSlotKeys[frameSlot];
+        occlusionHistory.update(keys, std::span<const uint32_t>(results + Laphria::kOcclusionResultHeaderUints, keys.size()));
+
+        const UISystem::RasterCullingStats &submitted = submittedCullingStats[frameSlot];
+        const uint32_t visible = keys.empty() ? 0u : results[Laphria::kOcclusionResultVisibleCount];
+        ui.rasterCullingStats.frustumInstances = submitted.frustumInstances;
+        ui.rasterCullingStats.drawnEarly = submitted.drawnEarly;
+        ui.rasterCullingStats.drawnLate = keys.empty() ? 0u : results[Laphria::kOcclusionResultLateCount];
+        ui.rasterCullingStats.occluded = static_cast<uint32_t>(keys.size()) - std::min(visible, static_cast<uint32_t>(keys.size()));
+        occlusionSlotRecorded[frameSlot] = false;
+    } else if (ui.renderMode == RenderMode::Rasterizer && !ui.occlusionCulling) {
+        // Turning the test back on starts from an empty history rather than one that may be long out of date.
+        occlusionHistory.clear();
+    }
+    ui.rasterCullingStats.shadowCastersCulled = submittedCullingStats[frameSlot].shadowCastersCulled;
+    // The slot's fence has signalled, so the counters can be cleared for the frame about to be recorded into it.
+    std::fill_n(results, Laphria::kOcclusionResultHeaderUints, 0u);
+}
+
+void EngineCore::recordReducedResolutionRasterPass(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex,
+                                                   vk::Extent2D renderExtent, vk::ClearValue clearColor) const {
+    const uint32_t fi = frames.frameIndex;
+    vk::Image sceneColor = *frames.sceneColorImages[fi];
+    vk::Image sceneDepth = *frames.sceneDepthImages[fi];
+
+    // Both targets are fully cleared, so their previous contents are discarded.
+    transition_image_layout(sceneColor,
+                            vk::ImageLayout::eUndefined, vk::ImageLayout::eColorAttachmentOptimal,
+                            {}, vk::AccessFlagBits2::eColorAttachmentWrite | vk::AccessFlagBits2::eColorAttachmentRead,
+                            vk::PipelineStageFlagBits2::eTopOfPipe, vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                            vk::ImageAspectFlagBits::eColor);
+    transition_image_layout(sceneDepth,
+                            vk::ImageLayout::eUndefined, vk::ImageLayout::eDepthAttachmentOptimal,
+                            {}, vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                            vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                            vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                            vk::ImageAspectFlagBits::eDepth);
+
+    vk::RenderingAttachmentInfo colorAttachment{
+        .imageView = *frames.sceneColorImageViews[fi],
+        .imageLayout = vk::ImageLayout::eColorAttachmentOptimal,
+        .loadOp = vk::AttachmentLoadOp::eClear,
+        .storeOp = vk::AttachmentStoreOp::eStore,
+        .clearValue = clearColor
+    };
+    vk::RenderingAttachmentInfo depthAttachment{
+        .imageView = *frames.sceneDepthImageViews[fi],
+        .imageLayout = vk::ImageLayout::eDepthAttachmentOptimal,
+        .loadOp = vk::AttachmentLoadOp::eClear,
+        .storeOp = vk::AttachmentStoreOp::eStore,
+        .clearValue = vk::ClearDepthStencilValue{1.0f, 0}
+    };
+    vk::RenderingInfo renderingInfo{
+        .renderArea = {.offset = {0, 0}, .extent = renderExtent},
+        .layerCount = 1,
+        .colorAttachmentCount = 1,
+        .pColorAttachments = &colorAttachment,
+        .pDepthAttachment = &depthAttachment
+    };
+    recordRasterSceneDraw(commandBuffer, renderingInfo, sceneDepth, static_cast<uint32_t>(frames.depthImageViews.size()), renderExtent);
+    commandBuffer.endRendering();
+
+    // Depth goes back to the layout upscaleDescriptorSets declare whether or not the upscaler reads it.
+    transition_image_layout(sceneDepth,
+                            vk::ImageLayout::eDepthAttachmentOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+                            vk::AccessFlagBits2::eDepthStencilAttachmentWrite, vk::AccessFlagBits2::eShaderRead,
+                            vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                            vk::PipelineStageFlagBits2::eComputeShader,
+                            vk::ImageAspectFlagBits::eDepth);
+
+    if (isTemporalUpscalingActive()) {
+        transition_image_layout(sceneColor,
+                                vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eShaderReadOnlyOptimal,
+                                vk::AccessFlagBits2::eColorAttachmentWrite, vk::AccessFlagBits2::eShaderRead,
+                                vk::PipelineStageFlagBits2::eColorAttachmentOutput, vk::PipelineStageFlagBits2::eComputeShader,
+                                vk::ImageAspectFlagBits::eColor);
+        recordTemporalUpscalePass(commandBuffer, renderExtent, kUpscaleInputRaster);
+        recordBlitToSwapchain(commandBuffer, imageIndex, *frames.upscaleHistory[fi], swapchain.extent,
+                              vk::ImageLayout::eGeneral, vk::PipelineStageFlagBits2::eComputeShader,
+                              vk::AccessFlagBits2::eShaderWrite, vk::ImageLayout::eGeneral);
+    } else {
+        recordBlitToSwapchain(commandBuffer, imageIndex, sceneColor, renderExtent,
+                              vk::ImageLayout::eColorAttachmentOptimal, vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                              vk::AccessFlagBits2::eColorAttachmentWrite, vk::ImageLayout::eShaderReadOnlyOptimal);
     }
 }
 
 void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
     auto &commandBuffer = frames.commandBuffers[frames.frameIndex];
-    const uint32_t queryBase = getPathTracerQueryBase(frames.frameIndex);
-    if (*ptTimestampQueryPool) {
-        commandBuffer.resetQueryPool(*ptTimestampQueryPool, queryBase, kPtTimestampQueryCountPerFrame);
+    const uint32_t queryBase = getTimestampQueryBase(frames.frameIndex);
+    auto writeTimestamp = [&](vk::PipelineStageFlags2 stage, uint32_t slot) {
+        if (*gpuTimestampQueryPool) {
+            commandBuffer.writeTimestamp2(stage, *gpuTimestampQueryPool, queryBase + slot);
+        }
+    };
+    if (*gpuTimestampQueryPool) {
+        commandBuffer.resetQueryPool(*gpuTimestampQueryPool, queryBase, kTimestampQueryCountPerFrame);
     }
+    writeTimestamp(vk::PipelineStageFlagBits2::eTopOfPipe, kTS_FrameStart);
 
+    const bool rasterReduced = ui.renderMode == RenderMode::Rasterizer && getRenderExtent() != swapchain.extent;
     vk::ClearValue clearColor = vk::ClearColorValue(0.02f, 0.02f, 0.02f, 1.0f);
     if (ui.renderMode == RenderMode::Rasterizer) {
         // V1.3: raster path uses direct atmospheric clear color (no compute sky prepass).
@@ -1350,59 +2818,67 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
 
     // --- Build TLAS ---
     if (ui.renderMode != RenderMode::Rasterizer) {
-        std::vector<vk::AccelerationStructureInstanceKHR> tlasInstances;
-        for (const auto &node: scene->getAllNodes()) {
-            if (node->modelId < 0) {
-                continue;
-            }
-
-            ModelResource *modelRes = resourceManager->getModelResource(node->modelId);
-            if (!modelRes || modelRes->blasElements.empty()) {
-                continue;
+        // The instance list is rebuilt only when registry membership or the loaded models change, or when
+        // transform changes were missed; otherwise only the instances of nodes that moved are rewritten.
+        // Object motion vectors need each instance's previous-frame transform. Before a range is rewritten its
+        // old transform is kept; a range rewritten last frame but not this one settles to its current transform.
+        auto keepCurrentTransforms = [&](uint32_t first, uint32_t count) {
+            for (uint32_t i = first; i < first + count; ++i) {
+                for (int r = 0; r < 3; ++r) {
+                    const auto &row = tlasInstanceCache[i].transform.matrix[r];
+                    tlasInstanceMotion[i].prevObjectToWorld[r] = glm::vec4(row[0], row[1], row[2], row[3]);
+                }
             }
+        };
 
-            glm::mat4 transform = node->getWorldTransform();
-
-            // Convert to vk::TransformMatrixKHR (3x4 row-major array)
-            vk::TransformMatrixKHR transformMatrix;
-            for (int r = 0; r < 3; ++r) {
-                for (int c = 0; c < 4; ++c) {
-                    transformMatrix.matrix[r][c] = transform[c][r]; // GLM is column-major
-                }
+        bool fullRebuild = tlasInstanceCacheVersion != scene->getComponentsVersion() ||
+                           tlasInstanceCacheModelCount != resourceManager->getModelCount() ||
+                           !scene->collectTransformChangesSince(tlasInstanceCacheFrame, tlasChangeScratch);
+        if (!fullRebuild) {
+            for (const auto &[first, count]: tlasMotionSettleRanges) {
+                keepCurrentTransforms(first, count);
             }
+            tlasMotionSettleRanges.clear();
 
-            for (int meshIdx: node->getMeshIndices()) {
-                if (meshIdx < 0 || meshIdx >= modelRes->blasElements.size()) {
+            std::vector<vk::AccelerationStructureInstanceKHR> nodeInstances;
+            for (const SceneNode *node: tlasChangeScratch) {
+                const auto it = tlasInstanceRanges.find(node);
+                if (it == tlasInstanceRanges.end()) {
                     continue;
                 }
-
-                auto &blas = modelRes->blasElements[meshIdx];
-
-                uint32_t primitiveOffset = 0;
-                for (int i = 0; i < meshIdx; ++i) {
-                    primitiveOffset += modelRes->meshes[i].primitives.size();
+                nodeInstances.clear();
+                appendTlasInstances(*node, nodeInstances);
+                if (nodeInstances.size() != it->second.second) {
+                    fullRebuild = true; // mesh list changed without a registry update
+                    break;
                 }
-
-                // Encode modelId in top 10 bits, primitiveOffset in bottom 14 bits
-                // InstanceCustomIndex is exactly 24 bit in size.
-                assert(node->modelId < 1024 && "modelId exceeds 10-bit limit; customIndex encoding will be corrupted");
-                uint32_t customIndex = (node->modelId << 14) | (primitiveOffset & 0x3FFF);
-
-                vk::AccelerationStructureDeviceAddressInfoKHR addressInfo{};
-                addressInfo.accelerationStructure = *blas;
-                vk::DeviceAddress blasAddress = vulkan.logicalDevice.getAccelerationStructureAddressKHR(addressInfo);
-
-                vk::AccelerationStructureInstanceKHR instance{};
-                instance.transform = transformMatrix;
-                instance.instanceCustomIndex = customIndex;
-                instance.mask = 0xFF; // All rays hit
-                instance.instanceShaderBindingTableRecordOffset = 0;
-                instance.flags = static_cast<uint32_t>(vk::GeometryInstanceFlagBitsKHR::eTriangleFacingCullDisable);
-                instance.accelerationStructureReference = blasAddress;
-
-                tlasInstances.push_back(instance);
+                keepCurrentTransforms(it->second.first, it->second.second);
+                std::copy(nodeInstances.begin(), nodeInstances.end(), tlasInstanceCache.begin() + it->second.first);
+                tlasMotionSettleRanges.push_back(it->second);
             }
         }
+        if (fullRebuild) {
+            tlasInstanceCache.clear();
+            tlasInstanceRanges.clear();
+            tlasInstanceMotion.clear();
+            tlasMotionSettleRanges.clear();
+            for (const auto &node: scene->getRenderables()) {
+                const auto first = static_cast<uint32_t>(tlasInstanceCache.size());
+                appendTlasInstances(*node, tlasInstanceCache);
+                tlasInstanceRanges[node.get()] = {first, static_cast<uint32_t>(tlasInstanceCache.size()) - first};
+
+                const ModelResource *modelRes = resourceManager->getModelResource(node->modelId);
+                Laphria::InstanceMotionData motion{};
+                motion.hasPrevSkinnedPositions = (modelRes && modelRes->hasRuntimeSkinning && *modelRes->prevSkinnedPositionBuffer) ? 1u : 0u;
+                tlasInstanceMotion.resize(tlasInstanceCache.size(), motion);
+            }
+            // Instance order may have changed, so this frame carries no object motion.
+            keepCurrentTransforms(0, static_cast<uint32_t>(tlasInstanceCache.size()));
+            tlasInstanceCacheVersion = scene->getComponentsVersion();
+            tlasInstanceCacheModelCount = resourceManager->getModelCount();
+        }
+        tlasInstanceCacheFrame = scene->getTransformChangeFrame();
+        const auto &tlasInstances = tlasInstanceCache;
 
         if (tlasInstances.size() > frames.MAX_TLAS_INSTANCES) {
             throw std::runtime_error(
@@ -1415,6 +2891,8 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
         if (!tlasInstances.empty()) {
             size_t dataSize = tlasInstances.size() * sizeof(vk::AccelerationStructureInstanceKHR);
             memcpy(frames.tlasInstanceBuffersMapped[frames.frameIndex], tlasInstances.data(), dataSize);
+            memcpy(frames.tlasMotionBuffersMapped[frames.frameIndex], tlasInstanceMotion.data(),
+                   tlasInstanceMotion.size() * sizeof(Laphria::InstanceMotionData));
         }
 
         // Memory barrier to ensure host writes to the instance buffer are visible to the AS builder
@@ -1456,19 +2934,16 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
         buildRange.transformOffset = 0;
 
         const vk::AccelerationStructureBuildRangeInfoKHR *pBuildRange = &buildRange;
-        if (*ptTimestampQueryPool) {
-            commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, *ptTimestampQueryPool, queryBase + kPtTS_TlasStart);
-        }
+        writeTimestamp(vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, kTS_TlasStart);
         commandBuffer.buildAccelerationStructuresKHR(buildInfo, pBuildRange);
-        if (*ptTimestampQueryPool) {
-            commandBuffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, *ptTimestampQueryPool, queryBase + kPtTS_TlasEnd);
-        }
+        writeTimestamp(vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR, kTS_TlasEnd);
 
-        // Memory barrier to ensure TLAS build finishes before the ray tracing shader reads it
+        // Memory barrier to ensure TLAS build finishes before the ray tracing shaders (or the wavefront
+        // kernels' ray queries) read it
         vk::MemoryBarrier2 asBuildToRayTracingBarrier{
             .srcStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR,
             .srcAccessMask = vk::AccessFlagBits2::eAccelerationStructureWriteKHR,
-            .dstStageMask = vk::PipelineStageFlagBits2::eRayTracingShaderKHR,
+            .dstStageMask = vk::PipelineStageFlagBits2::eRayTracingShaderKHR | vk::PipelineStageFlagBits2::eComputeShader,
             .dstAccessMask = vk::AccessFlagBits2::eAccelerationStructureReadKHR
         };
 
@@ -1484,23 +2959,47 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
     // Only run for the raster path; both RT pipelines handle their own shadowing.
     if (ui.renderMode == RenderMode::Rasterizer) {
         vk::Image shadowImg = *frames.shadowImages[frames.frameIndex];
-
-        // Transition all 4 cascade layers: eUndefined → eDepthAttachmentOptimal.
-        // We always use eUndefined as the old layout so the previous frame's contents
-        // are discarded — the depth buffer is cleared at the start of each cascade render.
-        vk::ImageMemoryBarrier2 shadowToWrite{
-            .srcStageMask = vk::PipelineStageFlagBits2::eTopOfPipe,
-            .srcAccessMask = {},
-            .dstStageMask = vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
-            .dstAccessMask = vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
-            .oldLayout = vk::ImageLayout::eUndefined,
-            .newLayout = vk::ImageLayout::eDepthAttachmentOptimal,
-            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .image = shadowImg,
-            .subresourceRange = {vk::ImageAspectFlagBits::eDepth, 0, 1, 0, NUM_SHADOW_CASCADES}
-        };
-        vk::DependencyInfo shadowWriteDep{.imageMemoryBarrierCount = 1, .pImageMemoryBarriers = &shadowToWrite};
+        const uint32_t cascadeMask = shadowCascadeUpdateMask;
+
+        // Only the cascades in this frame's update mask are re-rendered; the others keep their depth (and the
+        // matrix it was rendered with) in eShaderReadOnlyOptimal. A re-rendered layer discards its old contents:
+        // the depth buffer is cleared at the start of each cascade render.
+        std::array<vk::ImageMemoryBarrier2, NUM_SHADOW_CASCADES> shadowToWrite{};
+        std::array<vk::ImageMemoryBarrier2, NUM_SHADOW_CASCADES> shadowToRead{};
+        uint32_t shadowBarrierCount = 0;
+        for (uint32_t cascadeIdx = 0; cascadeIdx < NUM_SHADOW_CASCADES; cascadeIdx++) {
+            if ((cascadeMask & (1u << cascadeIdx)) == 0) {
+                continue;
+            }
+            shadowToWrite[shadowBarrierCount] = vk::ImageMemoryBarrier2{
+                .srcStageMask = vk::PipelineStageFlagBits2::eTopOfPipe,
+                .srcAccessMask = {},
+                .dstStageMask = vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                .dstAccessMask = vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                .oldLayout = vk::ImageLayout::eUndefined,
+                .newLayout = vk::ImageLayout::eDepthAttachmentOptimal,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = shadowImg,
+                .subresourceRange = {vk::ImageAspectFlagBits::eDepth, 0, 1, cascadeIdx, 1}
+            };
+            // Transition back: eDepthAttachmentOptimal → eShaderReadOnlyOptimal so the main fragment shader can sample it.
+            shadowToRead[shadowBarrierCount] = vk::ImageMemoryBarrier2{
+                .srcStageMask = vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+                .srcAccessMask = vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                .dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader,
+                .dstAccessMask = vk::AccessFlagBits2::eShaderRead,
+                .oldLayout = vk::ImageLayout::eDepthAttachmentOptimal,
+                .newLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = shadowImg,
+                .subresourceRange = {vk::ImageAspectFlagBits::eDepth, 0, 1, cascadeIdx, 1}
+            };
+            ++shadowBarrierCount;
+        }
+        writeTimestamp(vk::PipelineStageFlagBits2::eAllGraphics, kTS_ShadowStart);
+        vk::DependencyInfo shadowWriteDep{.imageMemoryBarrierCount = shadowBarrierCount, .pImageMemoryBarriers = shadowToWrite.data()};
         commandBuffer.pipelineBarrier2(shadowWriteDep);
 
         // Render each cascade into its own layer of the shadow array image.
@@ -1516,7 +3015,11 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
         };
         vk::Rect2D shadowScissor{{0, 0}, {SHADOW_MAP_DIM, SHADOW_MAP_DIM}};
 
+        uint32_t shadowCastersCulled = 0;
         for (uint32_t cascadeIdx = 0; cascadeIdx < NUM_SHADOW_CASCADES; cascadeIdx++) {
+            if ((cascadeMask & (1u << cascadeIdx)) == 0) {
+                continue;
+            }
             uint32_t viewIdx = frames.frameIndex * NUM_SHADOW_CASCADES + cascadeIdx;
 
             vk::RenderingAttachmentInfo cascadeDepthAttachment{
@@ -1538,68 +3041,81 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
             commandBuffer.setViewport(0, shadowViewport);
             commandBuffer.setScissor(0, shadowScissor);
 
-            // Draw all scene nodes into this cascade.
-            for (const auto &node: scene->getAllNodes()) {
-                if (node->modelId < 0)
-                    continue;
+            // Draw all scene nodes into this cascade. Meshes outside its side planes cannot cast into it; the
+            // near and far planes are not tested, since casters between the light and the cascade still shadow it.
+            const Laphria::Frustum cascadeFrustum =
+                Laphria::Frustum::fromViewProjection(frames.cascadeViewProjCache[frames.frameIndex][cascadeIdx]);
+            for (const auto &node: scene->getRenderables()) {
                 auto *modelRes = resourceManager->getModelResource(node->modelId);
                 if (!modelRes)
                     continue;
 
-                resourceManager->bindResources(commandBuffer, node->modelId, modelRes->hasRuntimeSkinning);
-                glm::mat4 worldTransform = node->getWorldTransform();
-
-                if (*modelRes->descriptorSet) {
-                    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelines.shadowPipelineLayout, 1, {*modelRes->descriptorSet}, nullptr);
-                }
-
-                for (int meshIdx: node->getMeshIndices()) {
-                    if (meshIdx < 0 || meshIdx >= static_cast<int>(modelRes->meshes.size()))
-                        continue;
-                    for (const auto &prim: modelRes->meshes[meshIdx].primitives) {
-                        Laphria::ScenePushConstants pc{};
-                        pc.modelMatrix = worldTransform;
-                        pc.cascadeIndex = static_cast<int>(cascadeIdx);
-                        pc.materialIndex = prim.flatPrimitiveIndex;
-                        commandBuffer.pushConstants<Laphria::ScenePushConstants>(
-                            *pipelines.shadowPipelineLayout,
-                            vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
-                            0, pc);
-                        commandBuffer.drawIndexed(prim.indexCount, 1, prim.firstIndex, prim.vertexOffset, 0);
+                bool bound = false;
+                node->forEachMeshInstance([&](const glm::mat4 &worldTransform, const std::vector<int> &meshIndices) {
+                    for (int meshIdx: meshIndices) {
+                        if (meshIdx < 0 || meshIdx >= static_cast<int>(modelRes->meshes.size()))
+                            continue;
+                        const Laphria::LoadedMesh &mesh = modelRes->meshes[meshIdx];
+                        glm::vec3 localMin;
+                        glm::vec3 localMax;
+                        if (meshCullBounds(*modelRes, mesh, localMin, localMax)) {
+                            glm::vec3 worldMin;
+                            glm::vec3 worldMax;
+                            Laphria::transformBounds(localMin, localMax, worldTransform, worldMin, worldMax);
+                            if (!cascadeFrustum.intersectsBox(worldMin, worldMax, 4)) {
+                                shadowCastersCulled += static_cast<uint32_t>(mesh.primitives.size());
+                                continue;
+                            }
+                        }
+                        if (!bound) {
+                            resourceManager->bindResources(commandBuffer, node->modelId, modelRes->hasRuntimeSkinning);
+                            if (*modelRes->descriptorSet) {
+                                commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelines.shadowPipelineLayout, 1, {*modelRes->descriptorSet}, nullptr);
+                            }
+                            bound = true;
+                        }
+                        for (const auto &prim: mesh.primitives) {
+                            Laphria::ScenePushConstants pc{};
+                            pc.modelMatrix = worldTransform;
+                            pc.cascadeIndex = static_cast<int>(cascadeIdx);
+                            pc.materialIndex = prim.flatPrimitiveIndex;
+                            commandBuffer.pushConstants<Laphria::ScenePushConstants>(
+                                *pipelines.shadowPipelineLayout,
+                                vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+                                0, pc);
+                            commandBuffer.drawIndexed(prim.indexCount, 1, prim.firstIndex, prim.vertexOffset, 0);
+                        }
                     }
-                }
+                });
             }
 
             commandBuffer.endRendering();
         }
+        submittedCullingStats[frames.frameIndex].shadowCastersCulled = shadowCastersCulled;
 
-        // Transition shadow image: eDepthAttachmentOptimal → eShaderReadOnlyOptimal
-        // so the main fragment shader can sample it.
-        vk::ImageMemoryBarrier2 shadowToRead{
-            .srcStageMask = vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
-            .srcAccessMask = vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
-            .dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader,
-            .dstAccessMask = vk::AccessFlagBits2::eShaderRead,
-            .oldLayout = vk::ImageLayout::eDepthAttachmentOptimal,
-            .newLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
-            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .image = shadowImg,
-            .subresourceRange = {vk::ImageAspectFlagBits::eDepth, 0, 1, 0, NUM_SHADOW_CASCADES}
-        };
-        vk::DependencyInfo shadowReadDep{.imageMemoryBarrierCount = 1, .pImageMemoryBarriers = &shadowToRead};
+        vk::DependencyInfo shadowReadDep{.imageMemoryBarrierCount = shadowBarrierCount, .pImageMemoryBarriers = shadowToRead.data()};
         commandBuffer.pipelineBarrier2(shadowReadDep);
-        // V1.3: remove compute sky from raster path; render directly into a cleared color target.
+        writeTimestamp(vk::PipelineStageFlagBits2::eAllGraphics, kTS_ShadowEnd);
 
-        transition_image_layout(
-            swapchain.images[imageIndex],
-            vk::ImageLayout::eUndefined,
-            vk::ImageLayout::eColorAttachmentOptimal,
-            {},
-            vk::AccessFlagBits2::eColorAttachmentWrite | vk::AccessFlagBits2::eColorAttachmentRead,
-            vk::PipelineStageFlagBits2::eTopOfPipe,
-            vk::PipelineStageFlagBits2::eColorAttachmentOutput,
-            vk::ImageAspectFlagBits::eColor);
+        // Skipped without punctual lights: the fragment shader then never reads the cluster lists.
+        if (!punctualLightData.empty()) {
+            recordLightCullingPass(commandBuffer);
+        }
+        // V1.3: remove compute sky from raster path; render directly into a cleared color target.
+        // Below native resolution the scene goes to the scene targets first and the main pass only draws the UI.
+        if (rasterReduced) {
+            recordReducedResolutionRasterPass(commandBuffer, imageIndex, getRenderExtent(), clearColor);
+        } else {
+            transition_image_layout(
+                swapchain.images[imageIndex],
+                vk::ImageLayout::eUndefined,
+                vk::ImageLayout::eColorAttachmentOptimal,
+                {},
+                vk::AccessFlagBits2::eColorAttachmentWrite | vk::AccessFlagBits2::eColorAttachmentRead,
+                vk::PipelineStageFlagBits2::eTopOfPipe,
+                vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                vk::ImageAspectFlagBits::eColor);
+        }
     }
 
     if (ui.renderMode == RenderMode::PathTracer) {
@@ -1607,6 +3123,7 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
     } else if (ui.renderMode == RenderMode::RayTracer) {
         recordClassicRTCommandBuffer(commandBuffer, imageIndex);
     }
+    const bool rasterNative = ui.renderMode == RenderMode::Rasterizer && !rasterReduced;
 
     transition_image_layout(
         *frames.depthImages[imageIndex],
@@ -1621,7 +3138,7 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
     vk::RenderingAttachmentInfo attachmentInfo = {
         .imageView = *swapchain.imageViews[imageIndex],
         .imageLayout = vk::ImageLayout::eColorAttachmentOptimal,
-        .loadOp = (ui.renderMode == RenderMode::Rasterizer) ? vk::AttachmentLoadOp::eClear : vk::AttachmentLoadOp::eLoad,
+        .loadOp = rasterNative ? vk::AttachmentLoadOp::eClear : vk::AttachmentLoadOp::eLoad,
         .storeOp = vk::AttachmentStoreOp::eStore,
         .clearValue = clearColor
     };
@@ -1642,43 +3159,10 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
         .pDepthAttachment = &depthAttachmentInfo
     };
 
-    commandBuffer.beginRendering(renderingInfo);
-
-    if (ui.renderMode == RenderMode::Rasterizer) {
-        commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelines.graphicsPipeline);
-
-        // Y starts at height and height is negative: this flips the Vulkan NDC Y-axis so that
-        // +Y points up in clip space, matching GLM's convention (which was designed for OpenGL).
-        vk::Viewport viewport{
-            0.0f, static_cast<float>(swapchain.extent.height),
-            static_cast<float>(swapchain.extent.width),
-            -static_cast<float>(swapchain.extent.height), 0.0f, 1.0f
-        };
-        commandBuffer.setViewport(0, viewport);
-        commandBuffer.setScissor(0, vk::Rect2D({0, 0}, swapchain.extent));
-
-        // Global UBO Binding (Set 0)
-        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelines.graphicsPipelineLayout, 0,
-                                         *descriptorSets[frames.frameIndex], nullptr);
-
-        const float aspectRatio = static_cast<float>(swapchain.extent.width) / static_cast<float>(swapchain.extent.height);
-        const glm::mat4 view = camera.getViewMatrix();
-        const glm::mat4 proj = glm::perspective(
-            glm::radians(Laphria::EngineConfig::kMainCameraFovDegrees),
-            aspectRatio,
-            Laphria::EngineConfig::kMainCameraNearPlane,
-            Laphria::EngineConfig::kMainCameraFarPlane);
-        const glm::mat4 viewProjection = proj * view;
-        const glm::mat4 invViewProjection = glm::inverse(viewProjection);
-
-        const Laphria::Frustum frustum = Laphria::Frustum::fromViewProjection(viewProjection);
-        Laphria::AABB cullBounds = Laphria::Frustum::computeAABB(invViewProjection);
-        // Expand query bounds so close-up objects whose origins are just outside
-        // the near plane are still submitted in raster mode.
-        constexpr float kRasterCullMargin = 2.0f;
-        cullBounds.min -= glm::vec3(kRasterCullMargin);
-        cullBounds.max += glm::vec3(kRasterCullMargin);
-        scene->draw(commandBuffer, pipelines.graphicsPipelineLayout, *resourceManager, cullBounds, frustum);
+    if (rasterNative) {
+        recordRasterSceneDraw(commandBuffer, renderingInfo, *frames.depthImages[imageIndex], imageIndex, swapchain.extent);
+    } else {
+        commandBuffer.beginRendering(renderingInfo);
     }
 
     ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), *commandBuffer);
@@ -1695,6 +3179,7 @@ void EngineCore::recordCommandBuffer(uint32_t imageIndex) const {
         vk::PipelineStageFlagBits2::eColorAttachmentOutput,
         vk::PipelineStageFlagBits2::eBottomOfPipe,
         vk::ImageAspectFlagBits::eColor);
+    writeTimestamp(vk::PipelineStageFlagBits2::eAllCommands, kTS_FrameEnd);
 }
 
 // Inline Synchronization2 image barrier recorded into the current frame's command buffer.
@@ -1735,7 +3220,20 @@ void EngineCore::transition_image_layout(
     frames.commandBuffers[frames.frameIndex].pipelineBarrier2(dependency_info);
 }
 
+Laphria::ShaderPermutation EngineCore::currentShaderPermutation() const {
+    Laphria::ShaderPermutation permutation;
+    permutation.ptMaxBounces = static_cast<uint32_t>(std::clamp(ui.pathTracerSettings.maxBounces, 1, 3));
+    permutation.textureColorSpaceModel = static_cast<uint32_t>(ui.textureColorSpaceModel);
+    permutation.shadowCascadeCount = NUM_SHADOW_CASCADES;
+    permutation.ptReprojection = ui.pathTracerSettings.enableReprojection;
+    return permutation;
+}
+
 void EngineCore::drawFrame() {
+    // Project files and the UI may still ask for an RT backend; the raster-only tier keeps the rasterizer.
+    if (!vulkan.rayTracingSupported) {
+        ui.renderMode = RenderMode::Rasterizer;
+    }
     if (!renderModeInitialized) {
         lastSubmittedRenderMode = ui.renderMode;
         renderModeInitialized = true;
@@ -1743,10 +3241,19 @@ void EngineCore::drawFrame() {
         // Renderer switches can otherwise overlap in-flight GPU work that uses different
         // pipeline/resource access patterns (especially PT denoiser scratch buffers).
         vulkan.logicalDevice.waitIdle();
-        ptCameraMoved = true; // force history reset on the first PT frame after a mode switch
+        ptHistoryInvalid = true; // force history reset on the first PT frame after a mode switch
+        upscaleHistoryInvalid = true;
         lastSubmittedRenderMode = ui.renderMode;
     }
 
+    // Settings baked into specialization constants rebuild the pipelines that read them, through the
+    // pipeline cache, once no submitted frame uses those pipelines any more.
+    const Laphria::ShaderPermutation permutation = currentShaderPermutation();
+    if (permutation != pipelines.getShaderPermutation()) {
+        vulkan.logicalDevice.waitIdle();
+        pipelines.setShaderPermutation(vulkan, permutation);
+    }
+
     // Note: inFlightFences, presentCompleteSemaphores, and commandBuffers are indexed by frameIndex,
     //       while renderFinishedSemaphores is indexed by imageIndex
     auto fenceResult = vulkan.logicalDevice.waitForFences(*frames.inFlightFences[frames.frameIndex], vk::True, UINT64_MAX);
@@ -1756,7 +3263,7 @@ void EngineCore::drawFrame() {
 
     // Runtime skinned BLAS refit currently reuses per-model AS buffers across frames.
     // Serialize in-flight submissions in this mode to avoid cross-frame AS write hazards.
-    if (resourceManager && resourceManager->hasRuntimeSkinnedModels()) {
+    if (vulkan.rayTracingSupported && resourceManager && resourceManager->hasRuntimeSkinnedModels()) {
         for (size_t i = 0; i < frames.inFlightFences.size(); ++i) {
             if (i == frames.frameIndex) {
                 continue;
@@ -1768,10 +3275,10 @@ void EngineCore::drawFrame() {
         }
     }
 
-    if (submittedRenderModes[frames.frameIndex] == RenderMode::PathTracer) {
-        collectPathTracerTimings(frames.frameIndex);
-        updateAdaptivePathTracerSettings();
-    }
+    collectGpuTimings(frames.frameIndex);
+    updateFrameTimeController();
+    collectProgressiveNoise(frames.frameIndex);
+    collectOcclusionResults(frames.frameIndex);
 
     auto [result, imageIndex] = swapchain.swapChain.acquireNextImage(
         UINT64_MAX, *frames.presentCompleteSemaphores[frames.frameIndex], nullptr);
@@ -1794,10 +3301,10 @@ void EngineCore::drawFrame() {
         }
     }
 
-    frames.updateUniformBuffer(frames.frameIndex, camera, swapchain.extent, ui.lightDirection, ui.exposure, ui.textureColorSpaceModel);
+    const bool punctualLightsChanged = updatePunctualLights();
 
-    // Detect camera movement for path tracer history reset.
-    // Any translation or rotation invalidates the reprojected history.
+    // Camera movement keeps the path tracer history (reprojection rejects disoccluded pixels) and only
+    // selects the tighter blend parameters. Anything that changes every pixel's result discards it.
     ptCameraMoved = (glm::distance(camera.position, ptPrevCameraPos) > 1e-5f ||
                      std::abs(camera.pitch - ptPrevPitch) > 1e-5f ||
                      std::abs(camera.yaw - ptPrevYaw) > 1e-5f);
@@ -1805,6 +3312,37 @@ void EngineCore::drawFrame() {
     ptPrevPitch = camera.pitch;
     ptPrevYaw = camera.yaw;
 
+    // A loaded rig alone moves nothing: only joints whose transforms changed this frame re-pose a skinned stream.
+    ptSkinnedPoseChanged = false;
+    if (scene && resourceManager) {
+        for (const auto &node: scene->getChangedNodes()) {
+            const ModelResource *modelRes = resourceManager->getModelResource(node->modelId);
+            if (modelRes && modelRes->hasRuntimeSkinning) {
+                ptSkinnedPoseChanged = true;
+                break;
+            }
+        }
+    }
+
+    const uint64_t sceneVersion = scene ? scene->getComponentsVersion() : 0;
+    const vk::Extent2D ptExtent = getPathTracerRenderExtent();
+    const bool ptSceneChanged = sceneVersion != ptHistorySceneVersion || ui.lightDirection != ptHistoryLightDirection ||
+                                punctualLightsChanged || ptExtent != ptHistoryExtent ||
+                                ui.pathTracerSettings.maxBounces != ptHistoryMaxBounces;
+    if (ptSceneChanged || !ui.pathTracerSettings.enableReprojection) {
+        ptHistoryInvalid = true;
+    }
+    ptHistorySceneVersion = sceneVersion;
+    ptHistoryLightDirection = ui.lightDirection;
+    ptHistoryExtent = ptExtent;
+    ptHistoryMaxBounces = ui.pathTracerSettings.maxBounces;
+    updateProgressiveAccumulation(ptSceneChanged);
+
+    shadowCascadeUpdateMask = computeShadowCascadeUpdateMask();
+    frames.updateUniformBuffer(frames.frameIndex, camera, swapchain.extent, ui.lightDirection, ui.exposure,
+                               static_cast<uint32_t>(punctualLightData.size()), getFrameJitter(), getRenderExtent(),
+                               ui.frameTimeSettings.textureLodBias, shadowCascadeUpdateMask);
+
     // Only reset the fence if we are submitting work
     vulkan.logicalDevice.resetFences(*frames.inFlightFences[frames.frameIndex]);
 
@@ -1814,8 +3352,25 @@ void EngineCore::drawFrame() {
 
     // 2. Main Pass
     recordCommandBuffer(imageIndex);
+    ui.skinningCullingStats = recordedSkinningStats;
     submittedRenderModes[frames.frameIndex] = ui.renderMode;
-    ptTimestampsValid[frames.frameIndex] = (ui.renderMode == RenderMode::PathTracer);
+    submittedWavefront[frames.frameIndex] = isWavefrontTracerActive();
+    submittedMaxBounces[frames.frameIndex] = static_cast<uint32_t>(std::clamp(ui.pathTracerSettings.maxBounces, 1, 3));
+    FrameTimeSample &frameTimeSample = submittedFrameTimeSamples[frames.frameIndex];
+    frameTimeSample = FrameTimeSample{};
+    frameTimeSample.backend = frameTimeBackend(ui.renderMode);
+    frameTimeSample.knobs = getFrameTimeKnobs();
+    // Progressive frames trace a fixed count and resolve instead of denoising; a zero size keeps them out of
+    // the cost model.
+    frameTimeSample.nativePixels = ptProgressiveActive ? 0.0f : getFrameTimeNativePixels();
+    frameTimeSample.shadowCascadesRendered = static_cast<uint32_t>(std::popcount(shadowCascadeUpdateMask));
+    timestampsWritten[frames.frameIndex] = true;
+    if (ui.renderMode == RenderMode::PathTracer && ui.pathTracerSettings.enableReprojection && !ptProgressiveActive) {
+        ptHistoryInvalid = false; // the reset was recorded into this frame's reprojection pass
+    }
+    // The upscaler history only continues across consecutive upscaled frames.
+    upscaleHistoryInvalid = !isTemporalUpscalingActive();
+    advanceProgressiveAccumulation();
 
     // The swapchain image is accessed at eColorAttachmentOutput (main/ImGui pass) and at
     // eTransfer (blit in compute and RT paths). Both stages must wait for vkAcquireNextImage.
@@ -4,12 +4,15 @@
 #include <chrono>
 #include <array>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../Physics/PhysicsSystem.h"
 #include "../SceneManagement/Scene.h"
 #include "Camera.h"
 #include "FrameContext.h"
+#include "FrameTimeController.h"
 #include "InputSystem.h"
 #include "PipelineCollection.h"
 #include "ResourceManager.h"
@@ -17,6 +20,7 @@
 #include "EngineHost.h"
 #include "UISystem.h"
 #include "VulkanDevice.h"
+#include "WavefrontSchedule.h"
 
 class EngineCore
 {
@@ -57,10 +61,59 @@ class EngineCore
 	// Denoiser Resources (one set per frame in flight)
 	vk::raii::DescriptorPool             denoiserDescriptorPool{nullptr};
 	std::vector<vk::raii::DescriptorSet> denoiserDescriptorSets;
-	vk::raii::QueryPool                  ptTimestampQueryPool{nullptr};
+
+	// Temporal upscaler Resources (one set per frame in flight)
+	vk::raii::DescriptorPool             upscaleDescriptorPool{nullptr};
+	std::vector<vk::raii::DescriptorSet> upscaleDescriptorSets;
+	// Set whenever the upscaler history stops holding the running backend's image (first frame, mode switch,
+	// resize, a frame at native resolution); cleared once a reset has been recorded.
+	bool                                 upscaleHistoryInvalid{true};
+
+	// Wavefront path tracer Resources (one set per frame in flight: shared queues, the slot's TLAS instances)
+	vk::raii::DescriptorPool             wavefrontDescriptorPool{nullptr};
+	std::vector<vk::raii::DescriptorSet> wavefrontDescriptorSets;
+	// Dispatches each slot recorded, timed one timestamp apart in wavefrontTimestampQueryPool.
+	mutable std::array<std::vector<Laphria::WavefrontDispatch>, MAX_FRAMES_IN_FLIGHT> wavefrontSchedules;
+	mutable std::array<uint32_t, MAX_FRAMES_IN_FLIGHT>                                 wavefrontTimestampCounts{};
+	vk::raii::QueryPool                                                                wavefrontTimestampQueryPool{nullptr};
+	uint32_t                                                                           wavefrontTimestampQueryCountPerFrame{0};        // sized for the longest schedule at the swapchain extent
+	// Tracer and bounce count each slot's path tracer frame was recorded with, for the per-mode trace times.
+	std::array<bool, MAX_FRAMES_IN_FLIGHT>     submittedWavefront{};
+	std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> submittedMaxBounces{};
+
+	// Raster occlusion culling. Pyramid mip 0 is reduced from either a swapchain depth image or the slot's
+	// reduced-resolution depth, so its sets are [slot * (swapchain images + 1) + source], the slot's scene depth
+	// last; the further mips are [slot * (mips - 1) + mip - 1]; the test has one set per slot.
+	vk::raii::DescriptorPool             occlusionDescriptorPool{nullptr};
+	std::vector<vk::raii::DescriptorSet> hiZSourceDescriptorSets;
+	std::vector<vk::raii::DescriptorSet> hiZMipDescriptorSets;
+	std::vector<vk::raii::DescriptorSet> occlusionCullDescriptorSets;
+	// Instances the last read-back frame found visible, drawn before the pyramid is built.
+	Laphria::OcclusionHistory                                                   occlusionHistory;
+	// Key of each candidate a slot submitted, in candidate order; its read-back visibility is in the same order.
+	mutable std::array<std::vector<uint64_t>, MAX_FRAMES_IN_FLIGHT>              occlusionSlotKeys;
+	mutable std::array<bool, MAX_FRAMES_IN_FLIGHT>                               occlusionSlotRecorded{};
+	mutable std::array<UISystem::RasterCullingStats, MAX_FRAMES_IN_FLIGHT>       submittedCullingStats{};
+	// Second-phase draws of the frame being recorded: the candidate's model and push constants per command.
+	struct OcclusionLateDraw
+	{
+		int                         modelId = -1;
+		Laphria::ScenePushConstants pushConstants{};
+	};
+	mutable std::vector<OcclusionLateDraw> occlusionLateDraws;
+	mutable std::vector<SceneNode::Ptr>    rasterVisibleNodes;
+	// Skinning pass counters of the frame being recorded, shown once it is submitted.
+	mutable UISystem::SkinningCullingStats recordedSkinningStats{};
+	// Raster frames pose skinned models without refitting their BLASes; the next RT frame then poses them all.
+	mutable bool skinnedBlasBehind = false;
+
+	vk::raii::QueryPool                  gpuTimestampQueryPool{nullptr};
 	float                                timestampPeriodNs = 1.0f;
-	std::array<bool, MAX_FRAMES_IN_FLIGHT>       ptTimestampsValid{};
+	std::array<bool, MAX_FRAMES_IN_FLIGHT>       timestampsWritten{};
 	std::array<RenderMode, MAX_FRAMES_IN_FLIGHT> submittedRenderModes{};
+	// Knobs and resolution each slot was recorded with; its pass times are filled in after the fence.
+	std::array<Laphria::FrameTimeSample, MAX_FRAMES_IN_FLIGHT> submittedFrameTimeSamples{};
+	Laphria::FrameTimeController                               frameTimeController{NUM_SHADOW_CASCADES};
 	std::vector<vk::Fence>                       imagesInFlight;
 
 	// Scene System
@@ -68,11 +121,66 @@ class EngineCore
 	std::unique_ptr<ResourceManager> resourceManager;
 	std::unique_ptr<PhysicsSystem>   physicsSystem;
 
-	// Path tracer camera movement detection (history reset on camera change)
-	glm::vec3 ptPrevCameraPos{0.f};
-	float     ptPrevPitch{0.f};
-	float     ptPrevYaw{0.f};
-	bool      ptCameraMoved{false};
+	// Transform-journal consumers remember the scene's drain count they last caught up with
+	uint64_t                 gpuPhysicsChangeFrame{0};
+	std::vector<SceneNode *> gpuPhysicsChanges;
+	// TLAS instances persist across frames; only the ranges of nodes whose transform changed are rewritten
+	mutable std::vector<vk::AccelerationStructureInstanceKHR>                      tlasInstanceCache;
+	mutable std::unordered_map<const SceneNode *, std::pair<uint32_t, uint32_t>> tlasInstanceRanges;        // first, count
+	mutable std::vector<SceneNode *>                                               tlasChangeScratch;
+	mutable uint64_t                                                               tlasInstanceCacheVersion{0};
+	mutable size_t                                                                 tlasInstanceCacheModelCount{0};
+	mutable uint64_t                                                               tlasInstanceCacheFrame{0};
+	// Previous-frame transform per cached instance; ranges rewritten last frame settle on the next update
+	mutable std::vector<Laphria::InstanceMotionData>       tlasInstanceMotion;
+	mutable std::vector<std::pair<uint32_t, uint32_t>>     tlasMotionSettleRanges;        // first, count
+
+	// Imported punctual lights: the (node, light) pairs are gathered again after registry changes, their world
+	// placement is recomputed every frame into punctualLightData and uploaded with its alias table.
+	struct PunctualLightInstance
+	{
+		const SceneNode *node = nullptr;
+		uint32_t         templateIndex = 0;        // prefab template node below a collapsed instance root, 0 for the node itself
+		int              modelId    = -1;
+		int              lightIndex = -1;
+	};
+	std::vector<PunctualLightInstance>      punctualLightInstances;
+	std::vector<float>                      punctualLightWeights;
+	std::vector<Laphria::PunctualLightData> punctualLightData;
+	uint64_t                                punctualLightInstancesVersion{0};
+	size_t                                  punctualLightInstancesModelCount{0};
+
+	// Path tracer temporal history. Camera motion only tightens the reprojection blend; history is discarded
+	// on real invalidation (scene edit, light change, render extent change, bounce count change, mode switch).
+	glm::vec3    ptPrevCameraPos{0.f};
+	float        ptPrevPitch{0.f};
+	float        ptPrevYaw{0.f};
+	bool         ptCameraMoved{false};
+	bool         ptSkinnedPoseChanged{false};        // joints of a skinned model moved this frame
+	bool         ptHistoryInvalid{true};
+	uint64_t     ptHistorySceneVersion{0};
+	glm::vec3    ptHistoryLightDirection{0.f};
+	vk::Extent2D ptHistoryExtent{};
+	int          ptHistoryMaxBounces{0};
+	// Adaptive sampling: paths spent per unit of estimated error, set by the frame-time controller
+	float ptSampleBudgetScale{1.0f};
+	// Progressive reference accumulation. The sample index counts the frames summed into the accumulation
+	// image since the last restart; the generation advances on every restart so that noise counts read back
+	// from frames recorded before it are ignored.
+	bool                                       ptProgressiveActive{false};
+	bool                                       ptProgressiveConverged{false};
+	uint32_t                                   ptProgressiveSampleIndex{0};
+	uint64_t                                   ptProgressiveGeneration{0};
+	std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> ptProgressiveSlotGeneration{};
+	std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> ptProgressiveSlotPixels{};        // 0: the slot counted no noise
+	std::chrono::steady_clock::time_point      ptProgressiveStartTime{};
+	float                                      ptProgressiveLastHistorySeconds{0.0f};
+	// Raster shadow cascades past the first re-render every shadowUpdatePeriod-th frame of their slot; the
+	// others keep last render's depth and matrix. A cascade is valid once it holds a render for the current light.
+	std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> shadowCascadeValidMask{};
+	std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> shadowSlotVisits{};
+	uint32_t                                   shadowCascadeUpdateMask{0};        // cascades recorded this frame
+	glm::vec3                                  shadowLightDirection{0.f};
 	RenderMode lastSubmittedRenderMode{RenderMode::Rasterizer};
 	bool       renderModeInitialized{false};
 	std::chrono::high_resolution_clock::time_point lastFrameTime{};
@@ -109,21 +217,82 @@ class EngineCore
 
 	void createRayTracingDescriptorSets();
 	void createDenoiserDescriptorSets();
+	void createUpscaleDescriptorSets();
+	void createWavefrontDescriptorSets();
+	void createOcclusionDescriptorSets();
+
+	// Specialization constants the current UI settings select (see PipelineCollection::setShaderPermutation).
+	[[nodiscard]] Laphria::ShaderPermutation currentShaderPermutation() const;
 
 	void recordComputeCommandBuffer(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex) const;
+	// Poses the skinned models some view can see; models outside all of them keep the pose they hold.
 	void recordSkinningPass(const vk::raii::CommandBuffer &commandBuffer) const;
 	void recordClassicRTCommandBuffer(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex) const;
 	void recordRayTracingCommandBuffer(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex) const;
+	// Wavefront alternative to traceRaysKHR: same images in, same noisy colour, G-buffer and motion out.
+	void recordWavefrontPathTrace(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D rtExtent, uint32_t maxSamples) const;
+	void recordProgressiveAccumulationPass(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D rtExtent) const;
+	void recordPathTracerBlit(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex, vk::Extent2D rtExtent) const;
+	// Raster below native resolution: draws into the scene targets, then upscales or blits to the swapchain image.
+	void recordReducedResolutionRasterPass(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex,
+	                                       vk::Extent2D renderExtent, vk::ClearValue clearColor) const;
+	// Begins renderingInfo and draws the raster scene into it, leaving the pass open for the caller. With occlusion
+	// culling the pass is split around the depth pyramid and test: depthImage (the pass's depth attachment,
+	// hiZSourceDescriptorSets source depthSource) is read between them, and the attachments are loaded again.
+	void recordRasterSceneDraw(const vk::raii::CommandBuffer &commandBuffer, const vk::RenderingInfo &renderingInfo,
+	                           vk::Image depthImage, uint32_t depthSource, vk::Extent2D renderExtent) const;
+	void bindRasterScenePipeline(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D renderExtent) const;
+	void recordOcclusionCulledDraws(const vk::raii::CommandBuffer &commandBuffer, const vk::RenderingInfo &renderingInfo,
+	                                vk::Image depthImage, uint32_t depthSource, vk::Extent2D renderExtent,
+	                                const glm::mat4 &viewProjection) const;
+	// Builds the slot's depth pyramid from depth source depthSource (in eShaderReadOnlyOptimal) and tests the candidates.
+	void recordOcclusionTest(const vk::raii::CommandBuffer &commandBuffer, uint32_t depthSource, vk::Extent2D renderExtent,
+	                         const glm::mat4 &viewProjection, uint32_t candidateCount) const;
+	// Folds a finished slot's visibility into occlusionHistory and its counters into the UI stats.
+	void collectOcclusionResults(uint32_t frameSlot);
+	void recordTemporalUpscalePass(const vk::raii::CommandBuffer &commandBuffer, vk::Extent2D renderExtent, uint32_t inputMode) const;
+	// Blits the top-left sourceExtent of source over the whole swapchain image and leaves the swapchain image in
+	// eColorAttachmentOptimal for the UI pass. source is in sourceLayout, last written at sourceStage.
+	void recordBlitToSwapchain(const vk::raii::CommandBuffer &commandBuffer, uint32_t imageIndex, vk::Image source,
+	                           vk::Extent2D sourceExtent, vk::ImageLayout sourceLayout, vk::PipelineStageFlags2 sourceStage,
+	                           vk::AccessFlags2 sourceAccess, vk::ImageLayout restoreLayout) const;
 
 	void createDescriptorPool();
 
 	void createDescriptorSets();
 	void createTimestampQueryPool();
-	void collectPathTracerTimings(uint32_t frameSlot);
-	void updateAdaptivePathTracerSettings();
-
-	[[nodiscard]] uint32_t getPathTracerQueryBase(uint32_t frameSlot) const;
-
+	void createWavefrontTimestampQueryPool();
+	// Reads a finished slot's timestamps into its frame-time sample and the UI timings, then lets the
+	// frame-time controller retune the knobs for the next frame.
+	void collectGpuTimings(uint32_t frameSlot);
+	void updateFrameTimeController();
+	[[nodiscard]] Laphria::FrameTimeKnobs getFrameTimeKnobs() const;
+	[[nodiscard]] float getFrameTimeNativePixels() const;
+	[[nodiscard]] uint32_t computeShadowCascadeUpdateMask();
+	// Progressive mode: restart or continue the accumulation before recording, account for the recorded frame
+	// after it, and fold in the noise count of a finished frame slot.
+	void updateProgressiveAccumulation(bool restart);
+	void advanceProgressiveAccumulation();
+	void collectProgressiveNoise(uint32_t frameSlot);
+	[[nodiscard]] uint32_t getProgressiveSamplesPerFrame() const;
+	[[nodiscard]] glm::vec2 getProgressiveJitter() const;
+	// Sub-pixel jitter of this frame in render pixels: progressive mode's, or the upscaler's for raster and
+	// classic RT; zero otherwise.
+	[[nodiscard]] glm::vec2 getFrameJitter() const;
+	// Uploads this frame's punctual lights; returns true when any of them differs from the previous frame.
+	bool updatePunctualLights();
+	void recordLightCullingPass(const vk::raii::CommandBuffer &commandBuffer) const;
+
+	[[nodiscard]] uint32_t getTimestampQueryBase(uint32_t frameSlot) const;
+	[[nodiscard]] vk::Extent2D getPathTracerRenderExtent() const;
+	// Raster and classic RT render extent; below the swapchain extent they render reduced and upscale.
+	[[nodiscard]] vk::Extent2D getRenderExtent() const;
+	// Unjittered camera view-projection that culling runs against.
+	[[nodiscard]] glm::mat4 getCullingViewProjection() const;
+	[[nodiscard]] bool isTemporalUpscalingActive() const;
+	[[nodiscard]] bool isWavefrontTracerActive() const;
+
+	void appendTlasInstances(const SceneNode &node, std::vector<vk::AccelerationStructureInstanceKHR> &out) const;
 	void recordCommandBuffer(uint32_t imageIndex) const;
 
 	void transition_image_layout(vk::Image image, vk::ImageLayout old_layout, vk::ImageLayout new_layout, vk::AccessFlags2 src_access_mask, vk::AccessFlags2 dst_access_mask,
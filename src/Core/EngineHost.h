@@ -49,6 +49,7 @@ struct EngineHostOptions
 	bool        showEditorPanels = true;
 	bool        runPhysicsSimulation = true;
 	bool        enableDefaultCameraInput = true;
+	bool        allowRayTracing = true;        // false runs the raster-only tier even on a ray tracing GPU
 };
 
 class EngineHost
@@ -1,6 +1,7 @@
 #include "FrameContext.h"
 #include "VulkanUtils.h"
 #include "EngineConfig.h"
+#include "PunctualLights.h"
 
 #include <algorithm>
 #include <cassert>
@@ -34,33 +35,65 @@ FrameContext::~FrameContext()
 	destroyImagesAndReleaseAllocations(depthImages);
 	destroyImagesAndReleaseAllocations(storageImages);
 	destroyImagesAndReleaseAllocations(rayTracingOutputImages);
-	destroyImagesAndReleaseAllocations(rtGBufferNormals);
-	destroyImagesAndReleaseAllocations(rtGBufferDepth);
+	destroyImagesAndReleaseAllocations(rtGBuffer);
 	destroyImagesAndReleaseAllocations(rtMotionVectors);
+	destroyImagesAndReleaseAllocations(rtSampleBudget);
 	destroyImagesAndReleaseAllocations(historyColor);
 	destroyImagesAndReleaseAllocations(historyMoments);
 	destroyImagesAndReleaseAllocations(atrousTemp);
+	destroyImagesAndReleaseAllocations(sceneColorImages);
+	destroyImagesAndReleaseAllocations(sceneDepthImages);
+	destroyImagesAndReleaseAllocations(upscaleHistory);
+	destroyImagesAndReleaseAllocations(hiZImages);
+	progressiveAccumulationView = nullptr;
+	progressiveAccumulation.reset();
 
 	destroyBuffersAndReleaseAllocations(uniformBuffers);
 	destroyBuffersAndReleaseAllocations(tlasBuffers);
 	destroyBuffersAndReleaseAllocations(tlasScratchBuffers);
 	destroyBuffersAndReleaseAllocations(tlasInstanceBuffers);
+	destroyBuffersAndReleaseAllocations(tlasMotionBuffers);
+	destroyBuffersAndReleaseAllocations(punctualLightBuffers);
+	destroyBuffersAndReleaseAllocations(lightClusterBuffers);
+	destroyBuffersAndReleaseAllocations(progressiveNoiseBuffers);
+	destroyBuffersAndReleaseAllocations(occlusionCandidateBuffers);
+	destroyBuffersAndReleaseAllocations(occlusionDrawBuffers);
+	destroyBuffersAndReleaseAllocations(occlusionResultBuffers);
+	wavefrontPrimaryHits.reset();
+	wavefrontPaths.reset();
+	wavefrontHits.reset();
+	wavefrontSortedHits.reset();
+	wavefrontShadowRecords.reset();
+	wavefrontPathRadiance.reset();
+	wavefrontControl.reset();
 }
 
 void FrameContext::init(VulkanDevice &dev, SwapchainManager &swapchain) {
     // Command pool must be created first; ResourceManager needs it for staging uploads.
     createCommandPool(dev);
     createUniformBuffers(dev);
+    createLightBuffers(dev);
+    createProgressiveNoiseBuffers(dev);
+    createOcclusionBuffers(dev);
+    if (dev.rayQuerySupported) {
+        createWavefrontBuffers(dev);
+    }
     createDepthResources(dev, swapchain);
     createStorageResources(dev, swapchain);
     createRayTracingOutputImages(dev, swapchain);
     createGBufferResources(dev, swapchain);
     createHistoryResources(dev, swapchain);
     createAtrousResources(dev, swapchain);
+    createUpscaleResources(dev, swapchain);
+    createHiZResources(dev, swapchain);
     // Shadow resources are extent-independent and live for the engine's full lifetime.
     createShadowResources(dev);
 
-    createTLASResources(dev);
+    // The raster-only tier has no acceleration structures; the RT output images above stay, since the
+    // upscaler and denoiser descriptor sets reference them whatever the backend.
+    if (dev.rayTracingSupported) {
+        createTLASResources(dev);
+    }
     createCommandBuffers(dev);
     createSyncObjects(dev, static_cast<uint32_t>(swapchain.images.size()));
 }
@@ -69,12 +102,16 @@ void FrameContext::cleanupSwapChainDependents() {
     destroyImagesAndReleaseAllocations(storageImages);
     destroyImagesAndReleaseAllocations(rayTracingOutputImages);
     destroyImagesAndReleaseAllocations(depthImages);
-    destroyImagesAndReleaseAllocations(rtGBufferNormals);
-    destroyImagesAndReleaseAllocations(rtGBufferDepth);
+    destroyImagesAndReleaseAllocations(rtGBuffer);
     destroyImagesAndReleaseAllocations(rtMotionVectors);
+    destroyImagesAndReleaseAllocations(rtSampleBudget);
     destroyImagesAndReleaseAllocations(historyColor);
     destroyImagesAndReleaseAllocations(historyMoments);
     destroyImagesAndReleaseAllocations(atrousTemp);
+    destroyImagesAndReleaseAllocations(sceneColorImages);
+    destroyImagesAndReleaseAllocations(sceneDepthImages);
+    destroyImagesAndReleaseAllocations(upscaleHistory);
+    destroyImagesAndReleaseAllocations(hiZImages);
 
     storageImageViews.clear();
     storageImages.clear();
@@ -84,20 +121,33 @@ void FrameContext::cleanupSwapChainDependents() {
     depthImages.clear();
 
     // G-Buffer images are extent-dependent.
-    rtGBufferNormalsViews.clear();
-    rtGBufferNormals.clear();
-    rtGBufferDepthViews.clear();
-    rtGBufferDepth.clear();
+    rtGBufferViews.clear();
+    rtGBuffer.clear();
     rtMotionVectorsViews.clear();
     rtMotionVectors.clear();
+    rtSampleBudgetViews.clear();
+    rtSampleBudget.clear();
 
     // History and A-Trous images are extent-dependent.
     historyColorViews.clear();
     historyColor.clear();
     historyMomentsViews.clear();
     historyMoments.clear();
+    progressiveAccumulationView = nullptr;
+    progressiveAccumulation.reset();
     atrousTempViews.clear();
     atrousTemp.clear();
+
+    // Reduced-resolution raster targets and the upscaler history are allocated at the swapchain extent.
+    sceneColorImageViews.clear();
+    sceneColorImages.clear();
+    sceneDepthImageViews.clear();
+    sceneDepthImages.clear();
+    upscaleHistoryViews.clear();
+    upscaleHistory.clear();
+    hiZMipViews.clear();
+    hiZViews.clear();
+    hiZImages.clear();
 }
 
 void FrameContext::recreate(VulkanDevice &dev, SwapchainManager &swapchain) {
@@ -108,6 +158,8 @@ void FrameContext::recreate(VulkanDevice &dev, SwapchainManager &swapchain) {
     createGBufferResources(dev, swapchain);
     createHistoryResources(dev, swapchain);
     createAtrousResources(dev, swapchain);
+    createUpscaleResources(dev, swapchain);
+    createHiZResources(dev, swapchain);
 }
 
 void FrameContext::createCommandPool(const VulkanDevice &dev) {
@@ -154,6 +206,7 @@ void FrameContext::createDepthResources(const VulkanDevice &dev, const Swapchain
     depthImageViews.clear();
 
     // One depth image per swapchain image so each in-flight frame has its own depth buffer.
+    // eSampled: the occlusion pass reduces it into the frame's depth pyramid between its two draw phases.
     size_t count = swapchain.images.size();
     depthImages.reserve(count);
     depthImageViews.reserve(count);
@@ -163,7 +216,7 @@ void FrameContext::createDepthResources(const VulkanDevice &dev, const Swapchain
 
         VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice, swapchain.extent.width, swapchain.extent.height,
                                  depthFormat, vk::ImageTiling::eOptimal,
-                                 vk::ImageUsageFlagBits::eDepthStencilAttachment,
+                                 vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled,
                                  vk::MemoryPropertyFlagBits::eDeviceLocal, img);
 
         depthImages.push_back(std::move(img));
@@ -259,8 +312,105 @@ void FrameContext::createUniformBuffers(const VulkanDevice &dev) {
     }
 }
 
+void FrameContext::createLightBuffers(const VulkanDevice &dev) {
+    punctualLightBuffers.clear();
+    punctualLightBuffersMapped.clear();
+    lightClusterBuffers.clear();
+
+    const vk::DeviceSize lightBufferSize = sizeof(Laphria::PunctualLightData) * Laphria::EngineConfig::kMaxPunctualLights;
+    const vk::DeviceSize clusterBufferSize = sizeof(uint32_t) * Laphria::EngineConfig::kLightClusterCount *
+                                             (Laphria::EngineConfig::kMaxLightsPerCluster + 1);
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        // Rewritten by the host every frame, like the UBO.
+        VulkanUtils::VmaBuffer lightBuffer{};
+        VulkanUtils::createBuffer(dev.logicalDevice, dev.physicalDevice, lightBufferSize,
+                                  vk::BufferUsageFlagBits::eStorageBuffer,
+                                  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                                  lightBuffer);
+        punctualLightBuffersMapped.push_back(lightBuffer.memory.mapMemory(0, lightBufferSize));
+        punctualLightBuffers.push_back(std::move(lightBuffer));
+
+        // Written and read on the GPU only (LightCulling.slang → fragment shader).
+        VulkanUtils::VmaBuffer clusterBuffer{};
+        VulkanUtils::createBuffer(dev.logicalDevice, dev.physicalDevice, clusterBufferSize,
+                                  vk::BufferUsageFlagBits::eStorageBuffer,
+                                  vk::MemoryPropertyFlagBits::eDeviceLocal, clusterBuffer);
+        lightClusterBuffers.push_back(std::move(clusterBuffer));
+    }
+}
+
+void FrameContext::createProgressiveNoiseBuffers(const VulkanDevice &dev) {
+    progressiveNoiseBuffers.clear();
+    progressiveNoiseBuffersMapped.clear();
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        // A single uint the progressive pass increments atomically; host-visible so it needs no copy back.
+        VulkanUtils::VmaBuffer noiseBuffer{};
+        VulkanUtils::createBuffer(dev.logicalDevice, dev.physicalDevice, sizeof(uint32_t),
+                                  vk::BufferUsageFlagBits::eStorageBuffer,
+                                  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                                  noiseBuffer);
+        progressiveNoiseBuffersMapped.push_back(noiseBuffer.memory.mapMemory(0, sizeof(uint32_t)));
+        *static_cast<uint32_t *>(progressiveNoiseBuffersMapped.back()) = 0;
+        progressiveNoiseBuffers.push_back(std::move(noiseBuffer));
+    }
+}
+
+void FrameContext::createOcclusionBuffers(const VulkanDevice &dev) {
+    occlusionCandidateBuffers.clear();
+    occlusionCandidateBuffersMapped.clear();
+    occlusionDrawBuffers.clear();
+    occlusionDrawBuffersMapped.clear();
+    occlusionResultBuffers.clear();
+    occlusionResultBuffersMapped.clear();
+
+    const vk::DeviceSize candidateSize = sizeof(Laphria::OcclusionCandidate) * Laphria::EngineConfig::kMaxOcclusionCandidates;
+    const vk::DeviceSize drawSize = sizeof(vk::DrawIndexedIndirectCommand) * Laphria::EngineConfig::kMaxOcclusionDraws;
+    const vk::DeviceSize resultSize = sizeof(uint32_t) * (Laphria::kOcclusionResultHeaderUints + Laphria::EngineConfig::kMaxOcclusionCandidates);
+    auto createMapped = [&](vk::DeviceSize size, vk::BufferUsageFlags usage,
+                            std::vector<VulkanUtils::VmaBuffer> &buffers, std::vector<void *> &mapped) {
+        VulkanUtils::VmaBuffer buffer{};
+        VulkanUtils::createBuffer(dev.logicalDevice, dev.physicalDevice, size, usage,
+                                  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                                  buffer);
+        mapped.push_back(buffer.memory.mapMemory(0, size));
+        buffers.push_back(std::move(buffer));
+    };
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        createMapped(candidateSize, vk::BufferUsageFlagBits::eStorageBuffer,
+                     occlusionCandidateBuffers, occlusionCandidateBuffersMapped);
+        // The cull pass writes instanceCount in place; drawIndexedIndirect reads the commands.
+        createMapped(drawSize, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+                     occlusionDrawBuffers, occlusionDrawBuffersMapped);
+        createMapped(resultSize, vk::BufferUsageFlagBits::eStorageBuffer,
+                     occlusionResultBuffers, occlusionResultBuffersMapped);
+        std::fill_n(static_cast<uint32_t *>(occlusionResultBuffersMapped.back()), Laphria::kOcclusionResultHeaderUints, 0u);
+    }
+}
+
+void FrameContext::createWavefrontBuffers(const VulkanDevice &dev) {
+    const vk::DeviceSize capacity = Laphria::EngineConfig::kWavefrontMaxPaths;
+    auto createQueue = [&](vk::DeviceSize size, vk::BufferUsageFlags usage, VulkanUtils::VmaBuffer &buffer) {
+        VulkanUtils::createBuffer(dev.logicalDevice, dev.physicalDevice, size, usage,
+                                  vk::MemoryPropertyFlagBits::eDeviceLocal, buffer);
+    };
+    createQueue(sizeof(Laphria::WavefrontHitRecord) * capacity, vk::BufferUsageFlagBits::eStorageBuffer, wavefrontPrimaryHits);
+    createQueue(sizeof(Laphria::WavefrontPathState) * capacity * 2, vk::BufferUsageFlagBits::eStorageBuffer, wavefrontPaths);
+    createQueue(sizeof(Laphria::WavefrontHitRecord) * capacity, vk::BufferUsageFlagBits::eStorageBuffer, wavefrontHits);
+    createQueue(sizeof(uint32_t) * capacity, vk::BufferUsageFlagBits::eStorageBuffer, wavefrontSortedHits);
+    createQueue(sizeof(Laphria::WavefrontShadowRecord) * capacity, vk::BufferUsageFlagBits::eStorageBuffer, wavefrontShadowRecords);
+    createQueue(sizeof(glm::vec4) * capacity, vk::BufferUsageFlagBits::eStorageBuffer, wavefrontPathRadiance);
+    // Zeroed with fillBuffer at the start of every wavefront frame; the trace and shade arguments are read by
+    // vkCmdDispatchIndirect.
+    createQueue(sizeof(uint32_t) * Laphria::kWavefrontControlUintCount,
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
+                    vk::BufferUsageFlagBits::eTransferDst,
+                wavefrontControl);
+}
+
 void FrameContext::updateUniformBuffer(uint32_t frameIdx, const Camera &camera, vk::Extent2D extent, glm::vec3 lightDirection,
-                                       float exposure, TextureColorSpaceModel textureColorSpaceModel) {
+                                       float exposure, uint32_t punctualLightCount, glm::vec2 jitter, vk::Extent2D renderExtent,
+                                       float textureLodBias, uint32_t cascadeUpdateMask) {
     Laphria::UniformBufferObject ubo{};
     ubo.view = camera.getViewMatrix();
 
@@ -301,6 +451,10 @@ void FrameContext::updateUniformBuffer(uint32_t frameIdx, const Camera &camera,
     glm::vec3 lightUp = (std::abs(lightDir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
 
     for (uint32_t i = 0; i < NUM_SHADOW_CASCADES; i++) {
+        if ((cascadeUpdateMask & (1u << i)) == 0) {
+            ubo.cascadeViewProj[i] = cascadeViewProjCache[frameIdx][i];
+            continue;
+        }
         float prevSplit = (i == 0) ? NEAR_PLANE : cascadeSplitDepths[i - 1];
         float currSplit = cascadeSplitDepths[i];
 
@@ -372,17 +526,21 @@ void FrameContext::updateUniformBuffer(uint32_t frameIdx, const Camera &camera,
         lightProj[3][1] += roundOffset.y;
 
         ubo.cascadeViewProj[i] = lightProj * lightView;
+        cascadeViewProjCache[frameIdx][i] = ubo.cascadeViewProj[i];
     }
 
     // Path tracer temporal fields — carry the previous frame's VP and advance the frame counter.
     ubo.prevViewProj = prevViewProj;
     ubo.frameCount = frameCount;
-    ubo.jitter_x = 0.0f; // Sub-pixel jitter disabled; set to halton values to enable TAA
-    ubo.jitter_y = 0.0f;
-    ubo._pad0 = 0;
+    ubo.jitter_x = jitter.x; // sub-pixel offset of the primary rays (progressive mode) or raster/RT samples (upscaling)
+    ubo.jitter_y = jitter.y;
+    ubo.punctualLightCount = std::min(punctualLightCount, Laphria::EngineConfig::kMaxPunctualLights);
     ubo.exposure = std::max(0.0f, exposure);
-    ubo.textureColorSpaceModel = static_cast<uint32_t>(textureColorSpaceModel);
-    ubo._padExposure = glm::vec3(0.0f);
+    ubo.cameraNear = Laphria::EngineConfig::kMainCameraNearPlane;
+    ubo.cameraFar = Laphria::EngineConfig::kMainCameraFarPlane;
+    ubo.textureLodBias = std::max(0.0f, textureLodBias);
+    ubo.renderWidth = std::max(renderExtent.width, 1u);
+    ubo.renderHeight = std::max(renderExtent.height, 1u);
 
     // Update persistent state for the next frame.
     prevViewProj = ubo.proj * ubo.view;
@@ -455,58 +613,59 @@ void FrameContext::createShadowResources(const VulkanDevice &dev) {
 }
 
 void FrameContext::createGBufferResources(const VulkanDevice &dev, const SwapchainManager &swapchain) {
-    rtGBufferNormals.clear();
-    rtGBufferNormalsViews.clear();
-    rtGBufferDepth.clear();
-    rtGBufferDepthViews.clear();
+    rtGBuffer.clear();
+    rtGBufferViews.clear();
     rtMotionVectors.clear();
     rtMotionVectorsViews.clear();
+    rtSampleBudget.clear();
+    rtSampleBudgetViews.clear();
 
-    rtGBufferNormals.reserve(MAX_FRAMES_IN_FLIGHT);
-    rtGBufferNormalsViews.reserve(MAX_FRAMES_IN_FLIGHT);
-    rtGBufferDepth.reserve(MAX_FRAMES_IN_FLIGHT);
-    rtGBufferDepthViews.reserve(MAX_FRAMES_IN_FLIGHT);
+    rtGBuffer.reserve(MAX_FRAMES_IN_FLIGHT);
+    rtGBufferViews.reserve(MAX_FRAMES_IN_FLIGHT);
     rtMotionVectors.reserve(MAX_FRAMES_IN_FLIGHT);
     rtMotionVectorsViews.reserve(MAX_FRAMES_IN_FLIGHT);
+    rtSampleBudget.reserve(MAX_FRAMES_IN_FLIGHT);
+    rtSampleBudgetViews.reserve(MAX_FRAMES_IN_FLIGHT);
 
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        // Normals — R16G16B16A16_SFLOAT: world-space XYZ packed into RGB, W unused.
+        // Normal + depth — R32G32_UINT: octahedral world normal as two 16-bit snorm halves in R,
+        // linear ray hit distance (negative = sky miss) as float bits in G.
         {
             VulkanUtils::VmaImage img{};
             VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
                                      swapchain.extent.width, swapchain.extent.height,
-                                     vk::Format::eR16G16B16A16Sfloat, vk::ImageTiling::eOptimal,
+                                     vk::Format::eR32G32Uint, vk::ImageTiling::eOptimal,
                                      vk::ImageUsageFlagBits::eStorage,
                                      vk::MemoryPropertyFlagBits::eDeviceLocal, img);
-            rtGBufferNormals.push_back(std::move(img));
-            rtGBufferNormalsViews.push_back(VulkanUtils::createImageView(dev.logicalDevice,
-                                                                         *rtGBufferNormals.back(), vk::Format::eR16G16B16A16Sfloat, vk::ImageAspectFlagBits::eColor));
+            rtGBuffer.push_back(std::move(img));
+            rtGBufferViews.push_back(VulkanUtils::createImageView(dev.logicalDevice,
+                                                                  *rtGBuffer.back(), vk::Format::eR32G32Uint, vk::ImageAspectFlagBits::eColor));
         }
 
-        // Depth — R32_SFLOAT: linear ray hit distance (negative = sky miss).
+        // Motion vectors — R16G16_SFLOAT: screen-space pixel offset in UV space.
         {
             VulkanUtils::VmaImage img{};
             VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
                                      swapchain.extent.width, swapchain.extent.height,
-                                     vk::Format::eR32Sfloat, vk::ImageTiling::eOptimal,
+                                     vk::Format::eR16G16Sfloat, vk::ImageTiling::eOptimal,
                                      vk::ImageUsageFlagBits::eStorage,
                                      vk::MemoryPropertyFlagBits::eDeviceLocal, img);
-            rtGBufferDepth.push_back(std::move(img));
-            rtGBufferDepthViews.push_back(VulkanUtils::createImageView(dev.logicalDevice,
-                                                                       *rtGBufferDepth.back(), vk::Format::eR32Sfloat, vk::ImageAspectFlagBits::eColor));
+            rtMotionVectors.push_back(std::move(img));
+            rtMotionVectorsViews.push_back(VulkanUtils::createImageView(dev.logicalDevice,
+                                                                        *rtMotionVectors.back(), vk::Format::eR16G16Sfloat, vk::ImageAspectFlagBits::eColor));
         }
 
-        // Motion vectors — R16G16_SFLOAT: screen-space pixel offset in UV space.
+        // Sample budget — R8_UINT: paths Raygen traces for each pixel (0 to the UI maximum).
         {
             VulkanUtils::VmaImage img{};
             VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
                                      swapchain.extent.width, swapchain.extent.height,
-                                     vk::Format::eR16G16Sfloat, vk::ImageTiling::eOptimal,
+                                     vk::Format::eR8Uint, vk::ImageTiling::eOptimal,
                                      vk::ImageUsageFlagBits::eStorage,
                                      vk::MemoryPropertyFlagBits::eDeviceLocal, img);
-            rtMotionVectors.push_back(std::move(img));
-            rtMotionVectorsViews.push_back(VulkanUtils::createImageView(dev.logicalDevice,
-                                                                        *rtMotionVectors.back(), vk::Format::eR16G16Sfloat, vk::ImageAspectFlagBits::eColor));
+            rtSampleBudget.push_back(std::move(img));
+            rtSampleBudgetViews.push_back(VulkanUtils::createImageView(dev.logicalDevice,
+                                                                       *rtSampleBudget.back(), vk::Format::eR8Uint, vk::ImageAspectFlagBits::eColor));
         }
     }
 
@@ -514,13 +673,13 @@ void FrameContext::createGBufferResources(const VulkanDevice &dev, const Swapcha
     // rtDescriptorSets and denoiserDescriptorSets, even when no RT pass has run yet.
     {
         auto cmd = VulkanUtils::beginSingleTimeCommands(dev.logicalDevice, commandPool);
-        for (auto &img: rtGBufferNormals)
+        for (auto &img: rtGBuffer)
             VulkanUtils::recordImageLayoutTransition(cmd, *img,
                                                      vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral);
-        for (auto &img: rtGBufferDepth)
+        for (auto &img: rtMotionVectors)
             VulkanUtils::recordImageLayoutTransition(cmd, *img,
                                                      vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral);
-        for (auto &img: rtMotionVectors)
+        for (auto &img: rtSampleBudget)
             VulkanUtils::recordImageLayoutTransition(cmd, *img,
                                                      vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral);
         VulkanUtils::endSingleTimeCommands(dev.logicalDevice, dev.queue, commandPool, cmd);
@@ -566,6 +725,18 @@ void FrameContext::createHistoryResources(const VulkanDevice &dev, const Swapcha
         }
     }
 
+    // Progressive accumulation — R32G32B32A32_SFLOAT: half floats would stop resolving new samples after a few
+    // thousand frames. Only ever written at sample index 0 before it is read, so it needs no clear.
+    progressiveAccumulationView = nullptr;
+    progressiveAccumulation.reset();
+    VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
+                             swapchain.extent.width, swapchain.extent.height,
+                             vk::Format::eR32G32B32A32Sfloat, vk::ImageTiling::eOptimal,
+                             vk::ImageUsageFlagBits::eStorage,
+                             vk::MemoryPropertyFlagBits::eDeviceLocal, progressiveAccumulation);
+    progressiveAccumulationView = VulkanUtils::createImageView(dev.logicalDevice, *progressiveAccumulation,
+                                                               vk::Format::eR32G32B32A32Sfloat, vk::ImageAspectFlagBits::eColor);
+
     // Transition all history images from UNDEFINED to GENERAL once so the layout matches
     // the eGeneral written in the denoiser descriptor set on the first frame (and after any
     // swapchain resize that recreates these images).  atrousTemp gets the same treatment
@@ -579,6 +750,8 @@ void FrameContext::createHistoryResources(const VulkanDevice &dev, const Swapcha
         for (auto &img: historyMoments)
             VulkanUtils::recordImageLayoutTransition(cmd, *img,
                                                      vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral);
+        VulkanUtils::recordImageLayoutTransition(cmd, *progressiveAccumulation,
+                                                 vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral);
         VulkanUtils::endSingleTimeCommands(dev.logicalDevice, dev.queue, commandPool, cmd);
     }
 }
@@ -590,17 +763,21 @@ void FrameContext::createAtrousResources(const VulkanDevice &dev, const Swapchai
     atrousTemp.reserve(bufferCount);
     atrousTempViews.reserve(bufferCount);
 
+    // Intermediate filter results are non-negative HDR RGB, so the packed 32-bit float format is enough
+    // and halves the ping-pong traffic; devices without storage support for it fall back to RGBA16F.
+    const vk::Format atrousFormat = dev.findAtrousFormat();
+
     // Two ping-pong buffers per frame slot. This removes shared scratch hazards between in-flight frames.
     for (size_t i = 0; i < bufferCount; i++) {
         VulkanUtils::VmaImage img{};
         VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
                                  swapchain.extent.width, swapchain.extent.height,
-                                 vk::Format::eR16G16B16A16Sfloat, vk::ImageTiling::eOptimal,
+                                 atrousFormat, vk::ImageTiling::eOptimal,
                                  vk::ImageUsageFlagBits::eStorage,
                                  vk::MemoryPropertyFlagBits::eDeviceLocal, img);
         atrousTemp.push_back(std::move(img));
         atrousTempViews.push_back(VulkanUtils::createImageView(dev.logicalDevice,
-                                                               *atrousTemp.back(), vk::Format::eR16G16B16A16Sfloat, vk::ImageAspectFlagBits::eColor));
+                                                               *atrousTemp.back(), atrousFormat, vk::ImageAspectFlagBits::eColor));
     }
 
     // Pre-transition A-Trous ping-pong buffers to eGeneral so they match the declared layout in
@@ -614,6 +791,118 @@ void FrameContext::createAtrousResources(const VulkanDevice &dev, const Swapchai
     }
 }
 
+void FrameContext::createUpscaleResources(const VulkanDevice &dev, const SwapchainManager &swapchain) {
+    sceneColorImages.clear();
+    sceneColorImageViews.clear();
+    sceneDepthImages.clear();
+    sceneDepthImageViews.clear();
+    upscaleHistory.clear();
+    upscaleHistoryViews.clear();
+
+    sceneColorImages.reserve(MAX_FRAMES_IN_FLIGHT);
+    sceneColorImageViews.reserve(MAX_FRAMES_IN_FLIGHT);
+    sceneDepthImages.reserve(MAX_FRAMES_IN_FLIGHT);
+    sceneDepthImageViews.reserve(MAX_FRAMES_IN_FLIGHT);
+    upscaleHistory.reserve(MAX_FRAMES_IN_FLIGHT);
+    upscaleHistoryViews.reserve(MAX_FRAMES_IN_FLIGHT);
+
+    // Allocated at the swapchain extent so that changing the render scale never recreates them; the raster
+    // pass only covers the render extent. The colour target keeps the swapchain format so the graphics
+    // pipeline is shared with the native path, and the upscaler reads it back as linear colour.
+    const vk::Format colorFormat = swapchain.surfaceFormat.format;
+    const vk::Format depthFormat = dev.findDepthFormat();
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        {
+            VulkanUtils::VmaImage img{};
+            VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
+                                     swapchain.extent.width, swapchain.extent.height,
+                                     colorFormat, vk::ImageTiling::eOptimal,
+                                     vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferSrc,
+                                     vk::MemoryPropertyFlagBits::eDeviceLocal, img);
+            sceneColorImages.push_back(std::move(img));
+            sceneColorImageViews.push_back(VulkanUtils::createImageView(dev.logicalDevice, *sceneColorImages.back(),
+                                                                        colorFormat, vk::ImageAspectFlagBits::eColor));
+        }
+        {
+            VulkanUtils::VmaImage img{};
+            VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
+                                     swapchain.extent.width, swapchain.extent.height,
+                                     depthFormat, vk::ImageTiling::eOptimal,
+                                     vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled,
+                                     vk::MemoryPropertyFlagBits::eDeviceLocal, img);
+            sceneDepthImages.push_back(std::move(img));
+            sceneDepthImageViews.push_back(VulkanUtils::createImageView(dev.logicalDevice, *sceneDepthImages.back(),
+                                                                        depthFormat, vk::ImageAspectFlagBits::eDepth));
+        }
+        // eTransferSrc: the reconstruction is blitted 1:1 to the swapchain image.
+        {
+            VulkanUtils::VmaImage img{};
+            VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice,
+                                     swapchain.extent.width, swapchain.extent.height,
+                                     vk::Format::eR16G16B16A16Sfloat, vk::ImageTiling::eOptimal,
+                                     vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eTransferSrc,
+                                     vk::MemoryPropertyFlagBits::eDeviceLocal, img);
+            upscaleHistory.push_back(std::move(img));
+            upscaleHistoryViews.push_back(VulkanUtils::createImageView(dev.logicalDevice, *upscaleHistory.back(),
+                                                                       vk::Format::eR16G16B16A16Sfloat, vk::ImageAspectFlagBits::eColor));
+        }
+    }
+
+    // Pre-transition everything to the layouts declared in upscaleDescriptorSets, which the upscaler binds
+    // in both backends, so the inputs of the backend that is not running are still valid.
+    {
+        auto cmd = VulkanUtils::beginSingleTimeCommands(dev.logicalDevice, commandPool);
+        for (auto &img: sceneColorImages)
+            VulkanUtils::recordImageLayoutTransition(cmd, *img,
+                                                     vk::ImageLayout::eUndefined, vk::ImageLayout::eShaderReadOnlyOptimal);
+        for (auto &img: sceneDepthImages)
+            VulkanUtils::recordImageLayoutTransition(cmd, *img,
+                                                     vk::ImageLayout::eUndefined, vk::ImageLayout::eShaderReadOnlyOptimal,
+                                                     vk::ImageAspectFlagBits::eDepth);
+        for (auto &img: upscaleHistory)
+            VulkanUtils::recordImageLayoutTransition(cmd, *img,
+                                                     vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral);
+        VulkanUtils::endSingleTimeCommands(dev.logicalDevice, dev.queue, commandPool, cmd);
+    }
+}
+
+void FrameContext::createHiZResources(const VulkanDevice &dev, const SwapchainManager &swapchain) {
+    hiZImages.clear();
+    hiZViews.clear();
+    hiZMipViews.clear();
+
+    hiZLayout = Laphria::computeHiZPyramidLayout(swapchain.extent.width, swapchain.extent.height);
+    hiZImages.reserve(MAX_FRAMES_IN_FLIGHT);
+    hiZViews.reserve(MAX_FRAMES_IN_FLIGHT);
+    hiZMipViews.reserve(static_cast<size_t>(MAX_FRAMES_IN_FLIGHT) * hiZLayout.mipCount);
+
+    // eStorage: each mip is written by the reduction; eSampled: the cull pass loads any mip.
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        VulkanUtils::VmaImage img{};
+        VulkanUtils::createImage(dev.logicalDevice, dev.physicalDevice, hiZLayout.width, hiZLayout.height,
+                                 vk::Format::eR32Sfloat, vk::ImageTiling::eOptimal,
+                                 vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled,
+                                 vk::MemoryPropertyFlagBits::eDeviceLocal, img, 1, hiZLayout.mipCount);
+        hiZImages.push_back(std::move(img));
+        hiZViews.push_back(VulkanUtils::createImageView(dev.logicalDevice, *hiZImages.back(), vk::Format::eR32Sfloat,
+                                                        vk::ImageAspectFlagBits::eColor, hiZLayout.mipCount));
+        for (uint32_t mip = 0; mip < hiZLayout.mipCount; ++mip) {
+            hiZMipViews.push_back(VulkanUtils::createImageViewMip(dev.logicalDevice, *hiZImages.back(), vk::Format::eR32Sfloat,
+                                                                  vk::ImageAspectFlagBits::eColor, mip));
+        }
+    }
+
+    // Pre-transition every mip to eGeneral, the layout occlusion descriptor sets declare for both passes.
+    {
+        auto cmd = VulkanUtils::beginSingleTimeCommands(dev.logicalDevice, commandPool);
+        for (auto &img: hiZImages)
+            VulkanUtils::recordImageLayoutTransition(cmd, *img,
+                                                     vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral,
+                                                     vk::ImageAspectFlagBits::eColor, 0, hiZLayout.mipCount);
+        VulkanUtils::endSingleTimeCommands(dev.logicalDevice, dev.queue, commandPool, cmd);
+    }
+}
+
 void FrameContext::createTLASResources(VulkanDevice &dev) {
     vk::AccelerationStructureGeometryInstancesDataKHR instancesData{};
     instancesData.arrayOfPointers = vk::False;
@@ -665,12 +954,23 @@ void FrameContext::createTLASResources(VulkanDevice &dev) {
         VulkanUtils::VmaBuffer instanceBuffer{};
         vk::DeviceSize instanceBufferSize = sizeof(vk::AccelerationStructureInstanceKHR) * MAX_TLAS_INSTANCES;
         VulkanUtils::createBuffer(dev.logicalDevice, dev.physicalDevice, instanceBufferSize,
-                                  vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress,
+                                  vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress |
+                                      vk::BufferUsageFlagBits::eStorageBuffer, // wavefront kernels read instance transforms
                                   vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
                                   instanceBuffer);
 
         tlasInstanceBuffersMapped.push_back(instanceBuffer.memory.mapMemory(0, instanceBufferSize));
         tlasInstanceBuffers.push_back(std::move(instanceBuffer));
         tlasInstanceAddresses.push_back(VulkanUtils::getBufferDeviceAddress(dev.logicalDevice, tlasInstanceBuffers.back()));
+
+        // --- Instance Motion Buffer ---
+        VulkanUtils::VmaBuffer motionBuffer{};
+        const vk::DeviceSize motionBufferSize = sizeof(Laphria::InstanceMotionData) * MAX_TLAS_INSTANCES;
+        VulkanUtils::createBuffer(dev.logicalDevice, dev.physicalDevice, motionBufferSize,
+                                  vk::BufferUsageFlagBits::eStorageBuffer,
+                                  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                                  motionBuffer);
+        tlasMotionBuffersMapped.push_back(motionBuffer.memory.mapMemory(0, motionBufferSize));
+        tlasMotionBuffers.push_back(std::move(motionBuffer));
     }
 }
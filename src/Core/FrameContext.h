@@ -1,6 +1,7 @@
 #ifndef LAPHRIAENGINE_FRAMECONTEXT_H
 #define LAPHRIAENGINE_FRAMECONTEXT_H
 
+#include <array>
 #include <glm/glm.hpp>
 #include <vector>
 #include <vulkan/vulkan_raii.hpp>
@@ -8,6 +9,7 @@
 #include "Camera.h"
 #include "EngineAuxiliary.h"
 #include "EngineConfig.h"
+#include "OcclusionCulling.h"
 #include "SwapchainManager.h"
 #include "VulkanDevice.h"
 #include "VulkanUtils.h"
@@ -23,7 +25,8 @@ class FrameContext
 	void cleanupSwapChainDependents();
 	void recreate(VulkanDevice &dev, SwapchainManager &swapchain);
 	void updateUniformBuffer(uint32_t frameIdx, const Camera &camera, vk::Extent2D extent, glm::vec3 lightDirection,
-	                         float exposure, TextureColorSpaceModel textureColorSpaceModel);
+	                         float exposure, uint32_t punctualLightCount, glm::vec2 jitter, vk::Extent2D renderExtent,
+	                         float textureLodBias, uint32_t cascadeUpdateMask);
 
 	// ── CSM Shadow resources (extent-independent, NOT cleaned on swapchain resize) ──
 	// One depth array image per frame-in-flight; each has NUM_SHADOW_CASCADES layers at SHADOW_MAP_DIM x SHADOW_MAP_DIM.
@@ -35,6 +38,9 @@ class FrameContext
 	std::vector<vk::raii::ImageView>    shadowArrayViews;
 	// Comparison sampler (shared across frames and cascades).
 	vk::raii::Sampler                   shadowSampler{nullptr};
+	// Light matrix each cascade layer was last rendered with; cascades outside updateUniformBuffer's update mask
+	// keep theirs so the matrix matches the depth still in the layer.
+	std::array<std::array<glm::mat4, NUM_SHADOW_CASCADES>, MAX_FRAMES_IN_FLIGHT> cascadeViewProjCache{};
 
 	uint32_t frameIndex = 0;
 
@@ -56,22 +62,48 @@ class FrameContext
 	std::vector<vk::raii::ImageView>            storageImageViews;
 
 	// ── RT output images (per frame in flight) ────────────────────────────
-	// Noisy 1-SPP path tracer output. After denoising, the final denoised result is
+	// Noisy path tracer output (alpha = paths traced per pixel). After denoising, the final denoised result is
 	// written back here so the existing swapchain blit path remains unchanged.
 	std::vector<Laphria::VulkanUtils::VmaImage> rayTracingOutputImages;
 	std::vector<vk::raii::ImageView>            rayTracingOutputImageViews;
 
+	// ── Reduced-resolution raster targets (per frame in flight) ───────────
+	// Used instead of the swapchain image and depthImages when the raster backend renders below native
+	// resolution: the scene is drawn into the top-left render extent, then upscaled or blitted. Both rest in
+	// eShaderReadOnlyOptimal, the layout upscaleDescriptorSets declare.
+	std::vector<Laphria::VulkanUtils::VmaImage> sceneColorImages;        // swapchain format
+	std::vector<vk::raii::ImageView>            sceneColorImageViews;
+	std::vector<Laphria::VulkanUtils::VmaImage> sceneDepthImages;        // dev.findDepthFormat()
+	std::vector<vk::raii::ImageView>            sceneDepthImageViews;
+
+	// ── Temporal upscaler history (per frame in flight) ───────────────────
+	// Native-resolution reconstruction; slot i is written by frame slot i, read by the next frame and then
+	// blitted to the swapchain.
+	std::vector<Laphria::VulkanUtils::VmaImage> upscaleHistory;          // R16G16B16A16_SFLOAT
+	std::vector<vk::raii::ImageView>            upscaleHistoryViews;
+
+	// ── Raster occlusion culling (per frame in flight) ────────────────────
+	// Depth pyramid built from the frame's first-phase depth, sized for the swapchain extent; reduced
+	// resolution frames use the top-left part. Rests in eGeneral. hiZViews cover every mip for the cull pass,
+	// hiZMipViews[frameIndex * hiZLayout.mipCount + mip] one mip each for the reduction.
+	std::vector<Laphria::VulkanUtils::VmaImage> hiZImages;               // R32_SFLOAT
+	std::vector<vk::raii::ImageView>            hiZViews;
+	std::vector<vk::raii::ImageView>            hiZMipViews;
+	Laphria::HiZPyramidLayout                   hiZLayout;
+
 	// ── G-Buffer images written by the Raygen shader (per frame in flight) ──
 	// All are swapchain-extent-dependent and recreated on resize.
-	std::vector<Laphria::VulkanUtils::VmaImage> rtGBufferNormals;        // R16G16B16A16_SFLOAT world normals
-	std::vector<vk::raii::ImageView>            rtGBufferNormalsViews;
-
-	std::vector<Laphria::VulkanUtils::VmaImage> rtGBufferDepth;          // R32_SFLOAT linear depth (ray hit t)
-	std::vector<vk::raii::ImageView>            rtGBufferDepthViews;
+	// Slot i is read by the next frame as its previous-frame G-buffer, so history needs no copy.
+	std::vector<Laphria::VulkanUtils::VmaImage> rtGBuffer;               // R32G32_UINT octahedral normal + linear depth (ray hit t)
+	std::vector<vk::raii::ImageView>            rtGBufferViews;
 
 	std::vector<Laphria::VulkanUtils::VmaImage> rtMotionVectors;         // R16G16_SFLOAT screen-space motion
 	std::vector<vk::raii::ImageView>            rtMotionVectorsViews;
 
+	// Written by the sample budget pass before traceRays, read by Raygen as its per-pixel path count.
+	std::vector<Laphria::VulkanUtils::VmaImage> rtSampleBudget;          // R8_UINT
+	std::vector<vk::raii::ImageView>            rtSampleBudgetViews;
+
 	// ── Temporal accumulation history buffers (per frame in flight) ─────────
 	// historyColor[i] stores the blended reprojection output from frame slot i,
 	// read by frame slot (i+1)%2 as "previous frame" and written by frame slot i.
@@ -81,10 +113,16 @@ class FrameContext
 	std::vector<Laphria::VulkanUtils::VmaImage> historyMoments;          // R16G16_SFLOAT (mean, variance)
 	std::vector<vk::raii::ImageView>            historyMomentsViews;
 
+	// ── Progressive reference accumulation (shared by both frame slots) ─────
+	// Running sum of every path traced estimate since the camera or scene last changed; frames in flight
+	// update it in submission order. Extent-dependent like the history images.
+	Laphria::VulkanUtils::VmaImage progressiveAccumulation;              // R32G32B32A32_SFLOAT (radiance sum, luminance² sum)
+	vk::raii::ImageView            progressiveAccumulationView{nullptr};
+
 	// ── A-Trous ping-pong buffers (per frame slot) ─────────────────────────
 	// Layout: atrousTemp[frameIndex*2 + 0] and atrousTemp[frameIndex*2 + 1].
 	// This avoids cross-frame hazards and removes the need to serialize PT frames.
-	std::vector<Laphria::VulkanUtils::VmaImage> atrousTemp;              // MAX_FRAMES_IN_FLIGHT * 2 × R16G16B16A16_SFLOAT
+	std::vector<Laphria::VulkanUtils::VmaImage> atrousTemp;              // MAX_FRAMES_IN_FLIGHT * 2 × VulkanDevice::findAtrousFormat()
 	std::vector<vk::raii::ImageView>            atrousTempViews;
 
 	// ── Temporal tracking (updated each frame by updateUniformBuffer) ────────
@@ -95,7 +133,7 @@ class FrameContext
 	std::vector<Laphria::VulkanUtils::VmaBuffer> uniformBuffers;
 	std::vector<void *>                          uniformBuffersMapped;
 
-	// ── Ray Tracing TLAS (per frame in flight) ────────────────────────────
+	// ── Ray Tracing TLAS (per frame in flight; empty on the raster-only tier) ─
 	static constexpr uint32_t                       MAX_TLAS_INSTANCES = Laphria::EngineConfig::kMaxTLASInstances;
 	std::vector<vk::raii::AccelerationStructureKHR> tlas;
 	std::vector<Laphria::VulkanUtils::VmaBuffer>    tlasBuffers;
@@ -107,6 +145,44 @@ class FrameContext
 	std::vector<void *>                          tlasInstanceBuffersMapped;
 	std::vector<vk::DeviceAddress>               tlasInstanceAddresses;
 
+	// Per-instance previous transforms (InstanceMotionData) for path tracer object motion vectors
+	std::vector<Laphria::VulkanUtils::VmaBuffer> tlasMotionBuffers;
+	std::vector<void *>                          tlasMotionBuffersMapped;
+
+	// ── Punctual lights (per frame in flight) ─────────────────────────────
+	// World-space PunctualLightData written by the host each frame, and the per-cluster light lists the raster
+	// path's culling pass builds from them (count + kMaxLightsPerCluster indices per cluster).
+	std::vector<Laphria::VulkanUtils::VmaBuffer> punctualLightBuffers;
+	std::vector<void *>                          punctualLightBuffersMapped;
+	std::vector<Laphria::VulkanUtils::VmaBuffer> lightClusterBuffers;
+
+	// Pixels the progressive pass found above its noise threshold, one counter per frame in flight. Reset by the
+	// host before recording and read back once the slot's fence has signalled.
+	std::vector<Laphria::VulkanUtils::VmaBuffer> progressiveNoiseBuffers;
+	std::vector<void *>                          progressiveNoiseBuffersMapped;
+
+	// Occlusion test inputs and outputs, written by the host while recording and read back after the fence:
+	// OcclusionCandidate records, the second-phase DrawIndexedIndirectCommands whose instanceCount the cull
+	// pass sets, and the result counters followed by one visibility flag per candidate.
+	std::vector<Laphria::VulkanUtils::VmaBuffer> occlusionCandidateBuffers;
+	std::vector<void *>                          occlusionCandidateBuffersMapped;
+	std::vector<Laphria::VulkanUtils::VmaBuffer> occlusionDrawBuffers;
+	std::vector<void *>                          occlusionDrawBuffersMapped;
+	std::vector<Laphria::VulkanUtils::VmaBuffer> occlusionResultBuffers;
+	std::vector<void *>                          occlusionResultBuffersMapped;
+
+	// ── Wavefront path tracer queues (shared by both frame slots) ─────────
+	// Sized for one chunk of kWavefrontMaxPaths pixels, whatever the extent; larger extents run several chunks.
+	// Frames in flight use them in submission order behind the barrier recordWavefrontPathTrace opens with.
+	// Only created on devices with ray queries (VulkanDevice::rayQuerySupported).
+	Laphria::VulkanUtils::VmaBuffer wavefrontPrimaryHits;     // WavefrontHitRecord per pixel of the chunk
+	Laphria::VulkanUtils::VmaBuffer wavefrontPaths;           // WavefrontPathState, two queues of kWavefrontMaxPaths
+	Laphria::VulkanUtils::VmaBuffer wavefrontHits;            // WavefrontHitRecord queue of the current bounce
+	Laphria::VulkanUtils::VmaBuffer wavefrontSortedHits;      // hit queue indices in material bin order
+	Laphria::VulkanUtils::VmaBuffer wavefrontShadowRecords;   // WavefrontShadowRecord per shaded hit
+	Laphria::VulkanUtils::VmaBuffer wavefrontPathRadiance;    // float4 per pixel of the chunk: summed path radiance
+	Laphria::VulkanUtils::VmaBuffer wavefrontControl;         // kWavefrontControlUintCount uints, also indirect arguments
+
   private:
 	void createCommandPool(const VulkanDevice &dev);
 	void createCommandBuffers(const VulkanDevice &dev);
@@ -117,8 +193,14 @@ class FrameContext
 	void createGBufferResources(const VulkanDevice &dev, const SwapchainManager &swapchain);
 	void createHistoryResources(const VulkanDevice &dev, const SwapchainManager &swapchain);
 	void createAtrousResources(const VulkanDevice &dev, const SwapchainManager &swapchain);
+	void createUpscaleResources(const VulkanDevice &dev, const SwapchainManager &swapchain);
+	void createHiZResources(const VulkanDevice &dev, const SwapchainManager &swapchain);
 
 	void createUniformBuffers(const VulkanDevice &dev);
+	void createLightBuffers(const VulkanDevice &dev);
+	void createProgressiveNoiseBuffers(const VulkanDevice &dev);
+	void createOcclusionBuffers(const VulkanDevice &dev);
+	void createWavefrontBuffers(const VulkanDevice &dev);
 	void createTLASResources(VulkanDevice &dev);
 	void createShadowResources(const VulkanDevice &dev);
 };
@@ -0,0 +1,287 @@
+#include "FrameTimeController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Laphria
+{
+namespace
+{
+// Weight of a new sample in the smoothed unit costs and frame time.
+constexpr float kCostSmoothing = 0.2f;
+// Samples a backend needs before the controller trusts its model.
+constexpr uint32_t kWarmupSamples = 4;
+// Assumed scene-pass saving per mip level of texture LOD bias (bandwidth and cache misses). It only has to
+// rank settings: the measured cost is normalised by the same factor.
+constexpr float kLodBiasSavingPerLevel = 0.15f;
+// Budget moves smaller than this are dropped so the continuous knob does not churn between settle periods.
+constexpr float kMinSampleBudgetChange = 0.05f;
+constexpr int   kSearchSteps           = 16;
+
+struct ModeMargins
+{
+	float    headroom;              // a change aims at target * (1 - headroom)
+	float    raiseThreshold;        // quality is only won back below target * raiseThreshold
+	uint32_t settleFrames;          // frames a change is held before the next one
+};
+
+ModeMargins marginsFor(FrameTimeMode mode)
+{
+	return (mode == FrameTimeMode::AutoAggressive) ? ModeMargins{0.10f, 0.80f, 4} : ModeMargins{0.05f, 0.85f, 8};
+}
+
+float megapixels(const FrameTimeKnobs &knobs, float nativePixels)
+{
+	return nativePixels * knobs.resolutionScale * knobs.resolutionScale * 1e-6f;
+}
+
+// Scene work relative to one path (or one shaded sample) per pixel at full resolution and no LOD bias.
+// Adaptive sampling spends one base path plus roughly budgetScale extra paths per pixel.
+float sceneWork(FrameTimeBackend backend, const FrameTimeKnobs &knobs, float nativePixels)
+{
+	const float paths = (backend == FrameTimeBackend::PathTracer && knobs.sampleBudgetScale > 0.0f) ? 1.0f + knobs.sampleBudgetScale : 1.0f;
+	return megapixels(knobs, nativePixels) * paths / (1.0f + kLodBiasSavingPerLevel * knobs.textureLodBias);
+}
+
+void blend(float &value, float sample, bool first)
+{
+	value = first ? sample : value + kCostSmoothing * (sample - value);
+}
+
+// One knob as a quality position: higher is better and cheaper positions are lower. step quantises the
+// position (0: continuous).
+struct KnobAxis
+{
+	float (*position)(const FrameTimeKnobs &);
+	void (*apply)(FrameTimeKnobs &, float);
+	float lowest;
+	float highest;
+	float step;
+};
+
+float quantizeDown(const KnobAxis &axis, float position)
+{
+	if (axis.step > 0.0f)
+	{
+		position = std::floor(position / axis.step + 1e-3f) * axis.step;
+	}
+	return std::clamp(position, axis.lowest, axis.highest);
+}
+
+// The order in which knobs give up quality; they win it back in reverse.
+std::array<KnobAxis, 5> knobAxes(const FrameTimeLimits &limits)
+{
+	auto periodLevel = [](uint32_t period) { return std::floor(std::log2(static_cast<float>(std::max(period, 1u)))); };
+	return {{
+	    {[](const FrameTimeKnobs &k) { return k.sampleBudgetScale; },
+	     [](FrameTimeKnobs &k, float p) { k.sampleBudgetScale = p; },
+	     limits.minSampleBudgetScale, limits.maxSampleBudgetScale, 0.0f},
+	    {[](const FrameTimeKnobs &k) { return -std::log2(static_cast<float>(k.shadowUpdatePeriod)); },
+	     [](FrameTimeKnobs &k, float p) { k.shadowUpdatePeriod = 1u << static_cast<uint32_t>(std::lround(-p)); },
+	     -periodLevel(limits.maxShadowUpdatePeriod), -periodLevel(limits.minShadowUpdatePeriod), 1.0f},
+	    {[](const FrameTimeKnobs &k) { return -k.textureLodBias; },
+	     [](FrameTimeKnobs &k, float p) { k.textureLodBias = -p; },
+	     -limits.maxTextureLodBias, -limits.minTextureLodBias, 0.25f},
+	    {[](const FrameTimeKnobs &k) { return static_cast<float>(k.denoiserIterations); },
+	     [](FrameTimeKnobs &k, float p) { k.denoiserIterations = static_cast<uint32_t>(std::lround(p)); },
+	     static_cast<float>(limits.minDenoiserIterations), static_cast<float>(limits.maxDenoiserIterations), 1.0f},
+	    {[](const FrameTimeKnobs &k) { return k.resolutionScale; },
+	     [](FrameTimeKnobs &k, float p) { k.resolutionScale = p; },
+	     limits.minResolutionScale, limits.maxResolutionScale, 0.05f},
+	}};
+}
+
+FrameTimeKnobs clampKnobs(const FrameTimeKnobs &knobs, const FrameTimeLimits &limits)
+{
+	FrameTimeKnobs clamped     = knobs;
+	clamped.resolutionScale    = std::clamp(knobs.resolutionScale, limits.minResolutionScale, limits.maxResolutionScale);
+	clamped.sampleBudgetScale  = std::clamp(knobs.sampleBudgetScale, limits.minSampleBudgetScale, limits.maxSampleBudgetScale);
+	clamped.denoiserIterations = std::clamp(knobs.denoiserIterations, limits.minDenoiserIterations, limits.maxDenoiserIterations);
+	clamped.textureLodBias     = std::clamp(knobs.textureLodBias, limits.minTextureLodBias, limits.maxTextureLodBias);
+	// Periods are powers of two so a slot's cascades are refreshed on a fixed rotation.
+	uint32_t period = 1;
+	while (period * 2 <= std::clamp(knobs.shadowUpdatePeriod, limits.minShadowUpdatePeriod, limits.maxShadowUpdatePeriod))
+	{
+		period *= 2;
+	}
+	clamped.shadowUpdatePeriod = period;
+	return clamped;
+}
+}        // namespace
+
+FrameTimeController::FrameTimeController(uint32_t shadowCascadeCount) :
+    cascadeCount(shadowCascadeCount)
+{
+}
+
+float FrameTimeController::averageShadowCascades(uint32_t updatePeriod) const
+{
+	if (cascadeCount == 0)
+	{
+		return 0.0f;
+	}
+	// The first cascade renders every frame, the others once per period.
+	return 1.0f + static_cast<float>(cascadeCount - 1) / static_cast<float>(std::max(updatePeriod, 1u));
+}
+
+void FrameTimeController::addSample(const FrameTimeSample &sample)
+{
+	if (sample.frameMs <= 0.0f || sample.nativePixels <= 0.0f)
+	{
+		return;
+	}
+
+	UnitCosts  &cost  = costs[static_cast<size_t>(sample.backend)];
+	const bool  first = (cost.sampleCount == 0);
+	const float mpx   = megapixels(sample.knobs, sample.nativePixels);
+
+	if (sample.shadowCascadesRendered > 0)
+	{
+		blend(cost.shadowCascadeMs, sample.shadowMs / static_cast<float>(sample.shadowCascadesRendered), first);
+	}
+	const float work = sceneWork(sample.backend, sample.knobs, sample.nativePixels);
+	if (work > 0.0f)
+	{
+		blend(cost.scenePixelMs, sample.sceneMs / work, first);
+	}
+	if (sample.backend == FrameTimeBackend::PathTracer && mpx > 0.0f)
+	{
+		// Also learns 0 while reprojection is switched off, so the prediction follows the toggle.
+		blend(cost.reprojectPixelMs, sample.reprojectionMs / mpx, first);
+		if (sample.knobs.denoiserIterations > 0)
+		{
+			blend(cost.denoisePixelMs, sample.denoiserMs / (mpx * static_cast<float>(sample.knobs.denoiserIterations)),
+			      first || cost.denoisePixelMs <= 0.0f);
+		}
+	}
+	const float scaledMs = sample.shadowMs + sample.sceneMs + sample.reprojectionMs + sample.denoiserMs;
+	blend(cost.fixedMs, std::max(sample.frameMs - scaledMs, 0.0f), first);
+	++cost.sampleCount;
+
+	if (sample.backend == activeBackend)
+	{
+		blend(smoothedMs, sample.frameMs, smoothedMs <= 0.0f);
+	}
+}
+
+bool FrameTimeController::hasModel(FrameTimeBackend backend) const
+{
+	return costs[static_cast<size_t>(backend)].sampleCount >= kWarmupSamples;
+}
+
+float FrameTimeController::predictMs(FrameTimeBackend backend, const FrameTimeKnobs &knobs, float nativePixels) const
+{
+	const UnitCosts &cost = costs[static_cast<size_t>(backend)];
+	if (cost.sampleCount == 0)
+	{
+		return 0.0f;
+	}
+
+	const float mpx = megapixels(knobs, nativePixels);
+	float       ms  = cost.fixedMs + cost.scenePixelMs * sceneWork(backend, knobs, nativePixels);
+	if (backend == FrameTimeBackend::Rasterizer)
+	{
+		ms += cost.shadowCascadeMs * averageShadowCascades(knobs.shadowUpdatePeriod);
+	}
+	if (backend == FrameTimeBackend::PathTracer)
+	{
+		ms += cost.reprojectPixelMs * mpx + cost.denoisePixelMs * mpx * static_cast<float>(knobs.denoiserIterations);
+	}
+	return ms;
+}
+
+FrameTimeKnobs FrameTimeController::update(FrameTimeBackend backend, const FrameTimeKnobs &current, const FrameTimeLimits &limits,
+                                           float nativePixels, float targetMs, FrameTimeMode mode)
+{
+	FrameTimeKnobs knobs = clampKnobs(current, limits);
+	if (backend != activeBackend)
+	{
+		activeBackend     = backend;
+		smoothedMs        = 0.0f;
+		framesSinceChange = 0;
+		return knobs;
+	}
+
+	const ModeMargins margins = marginsFor(mode);
+	if (++framesSinceChange < margins.settleFrames || !hasModel(backend) || targetMs <= 0.0f)
+	{
+		return knobs;
+	}
+
+	const float predictedMs = predictMs(backend, knobs, nativePixels);
+	const float fitMs       = targetMs * (1.0f - margins.headroom);
+	const bool  lower       = predictedMs > targetMs;
+	const bool  raise       = predictedMs < targetMs * margins.raiseThreshold;
+	if (!lower && !raise)
+	{
+		return knobs;
+	}
+
+	auto predictAt = [&](const KnobAxis &axis, FrameTimeKnobs candidate, float position) {
+		axis.apply(candidate, position);
+		return predictMs(backend, candidate, nativePixels);
+	};
+	// Highest position in [low, high] whose prediction fits, by bisection (cost grows with position).
+	auto fitPosition = [&](const KnobAxis &axis, float low, float high) {
+		if (predictAt(axis, knobs, high) <= fitMs)
+		{
+			return high;
+		}
+		for (int i = 0; i < kSearchSteps; ++i)
+		{
+			const float mid = 0.5f * (low + high);
+			(predictAt(axis, knobs, mid) <= fitMs ? low : high) = mid;
+		}
+		return low;
+	};
+
+	const std::array<KnobAxis, 5> axes = knobAxes(limits);
+	if (lower)
+	{
+		for (const KnobAxis &axis : axes)
+		{
+			const float position = axis.position(knobs);
+			if (position <= axis.lowest || predictAt(axis, knobs, axis.lowest) >= predictMs(backend, knobs, nativePixels))
+			{
+				continue;        // at its floor, or does not affect this backend
+			}
+			axis.apply(knobs, quantizeDown(axis, fitPosition(axis, axis.lowest, position)));
+			if (predictMs(backend, knobs, nativePixels) <= fitMs)
+			{
+				break;
+			}
+		}
+	}
+	else
+	{
+		for (auto it = axes.rbegin(); it != axes.rend(); ++it)
+		{
+			const KnobAxis &axis     = *it;
+			const float     position = axis.position(knobs);
+			if (position >= axis.highest || predictAt(axis, knobs, axis.highest) <= predictMs(backend, knobs, nativePixels))
+			{
+				continue;
+			}
+			const float raised = std::max(quantizeDown(axis, fitPosition(axis, position, axis.highest)), position);
+			axis.apply(knobs, raised);
+			if (raised < axis.highest)
+			{
+				break;        // the headroom is used up
+			}
+		}
+	}
+
+	const FrameTimeKnobs previous = clampKnobs(current, limits);
+	if (std::abs(knobs.sampleBudgetScale - previous.sampleBudgetScale) < kMinSampleBudgetChange * previous.sampleBudgetScale)
+	{
+		knobs.sampleBudgetScale = previous.sampleBudgetScale;
+	}
+	if (knobs.resolutionScale != previous.resolutionScale || knobs.sampleBudgetScale != previous.sampleBudgetScale ||
+	    knobs.denoiserIterations != previous.denoiserIterations || knobs.shadowUpdatePeriod != previous.shadowUpdatePeriod ||
+	    knobs.textureLodBias != previous.textureLodBias)
+	{
+		framesSinceChange = 0;
+	}
+	return knobs;
+}
+}        // namespace Laphria
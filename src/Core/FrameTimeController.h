@@ -0,0 +1,114 @@
+#ifndef LAPHRIAENGINE_FRAMETIMECONTROLLER_H
+#define LAPHRIAENGINE_FRAMETIMECONTROLLER_H
+
+#include <array>
+#include <cstdint>
+
+namespace Laphria
+{
+enum class FrameTimeMode : uint32_t
+{
+	Manual         = 0,        // knobs stay where the user put them; only the PT sample budget follows the target
+	AutoBalanced   = 1,
+	AutoAggressive = 2         // more headroom and a shorter settle period
+};
+
+enum class FrameTimeBackend : uint32_t
+{
+	Rasterizer = 0,
+	RayTracer  = 1,
+	PathTracer = 2
+};
+
+// Everything the controller may change. A backend ignores the knobs it has no pass for.
+struct FrameTimeKnobs
+{
+	float    resolutionScale    = 1.0f;
+	float    sampleBudgetScale  = 0.0f;        // PT adaptive sampling paths per unit of error; 0 when off
+	uint32_t denoiserIterations = 0;           // PT A-Trous iterations; 0 when the denoiser is off
+	uint32_t shadowUpdatePeriod = 1;           // raster: cascades past the first re-render every Nth frame (1, 2, 4)
+	float    textureLodBias     = 0.0f;        // mip bias on material textures
+};
+
+// Range each knob may take. A knob whose min equals its max is pinned and never moved.
+struct FrameTimeLimits
+{
+	float    minResolutionScale    = 0.5f;
+	float    maxResolutionScale    = 1.0f;
+	float    minSampleBudgetScale  = 0.25f;
+	float    maxSampleBudgetScale  = 8.0f;
+	uint32_t minDenoiserIterations = 1;
+	uint32_t maxDenoiserIterations = 5;
+	uint32_t minShadowUpdatePeriod = 1;
+	uint32_t maxShadowUpdatePeriod = 4;
+	float    minTextureLodBias     = 0.0f;
+	float    maxTextureLodBias     = 2.0f;
+};
+
+// GPU times of one finished frame, together with the knobs and resolution it was recorded with. Pass times
+// are 0 for passes that did not run.
+struct FrameTimeSample
+{
+	FrameTimeBackend backend = FrameTimeBackend::Rasterizer;
+	FrameTimeKnobs   knobs;
+	float            nativePixels           = 0.0f;        // render pixels at resolution scale 1
+	uint32_t         shadowCascadesRendered = 0;
+	float            frameMs                = 0.0f;        // whole command buffer
+	float            shadowMs               = 0.0f;
+	float            sceneMs                = 0.0f;        // raster main pass, RT trace or PT trace
+	float            reprojectionMs         = 0.0f;
+	float            denoiserMs             = 0.0f;
+};
+
+// Predictive frame-time controller. Every sample is divided by the work its knobs implied, giving smoothed
+// unit costs (ms per cascade, per megapixel, per path, per A-Trous iteration) for each backend. update()
+// predicts the frame time of candidate knob settings from those costs and moves the knobs straight to the
+// best setting that fits, instead of stepping by a fixed amount each frame.
+//
+// Knobs give up quality in a fixed order (sample budget, shadow update period, LOD bias, denoiser iterations,
+// resolution) and win it back in reverse. A change is only made when the prediction leaves the band between
+// the raise threshold and the target, always aims a little below the target, and is followed by a settle
+// period in which the new samples reach the model, which keeps the knobs from oscillating.
+class FrameTimeController
+{
+  public:
+	explicit FrameTimeController(uint32_t shadowCascadeCount);
+
+	void addSample(const FrameTimeSample &sample);
+
+	// Returns the knobs for the next frame of backend, starting from current. Knobs are clamped to limits even
+	// while the model is still warming up.
+	FrameTimeKnobs update(FrameTimeBackend backend, const FrameTimeKnobs &current, const FrameTimeLimits &limits,
+	                      float nativePixels, float targetMs, FrameTimeMode mode);
+
+	// Predicted GPU time of a frame of backend rendered with knobs; 0 before the backend has a model.
+	float predictMs(FrameTimeBackend backend, const FrameTimeKnobs &knobs, float nativePixels) const;
+
+	bool  hasModel(FrameTimeBackend backend) const;
+	float smoothedFrameMs() const
+	{
+		return smoothedMs;
+	}
+
+  private:
+	struct UnitCosts
+	{
+		float    fixedMs          = 0.0f;        // passes no knob scales (TLAS, culling, UI, blit)
+		float    shadowCascadeMs  = 0.0f;
+		float    scenePixelMs     = 0.0f;        // per megapixel and unit of scene work
+		float    reprojectPixelMs = 0.0f;        // per megapixel
+		float    denoisePixelMs   = 0.0f;        // per megapixel and iteration
+		uint32_t sampleCount      = 0;
+	};
+
+	float averageShadowCascades(uint32_t updatePeriod) const;
+
+	uint32_t                 cascadeCount;
+	std::array<UnitCosts, 3> costs{};
+	float                    smoothedMs        = 0.0f;
+	FrameTimeBackend         activeBackend     = FrameTimeBackend::Rasterizer;
+	uint32_t                 framesSinceChange = 0;
+};
+}        // namespace Laphria
+
+#endif        // LAPHRIAENGINE_FRAMETIMECONTROLLER_H
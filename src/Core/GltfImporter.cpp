@@ -140,6 +140,7 @@ SceneNode::Ptr GltfImporter::processGltfNode(const fastgltf::Asset &gltf, size_t
 		const auto         &mesh = gltf.meshes[node.meshIndex.value()];
 		Laphria::LoadedMesh loadedMesh;
 		loadedMesh.name = mesh.name;
+		const size_t meshFirstVertex = vertices.size();
 
 		for (const auto &primitive : mesh.primitives)
 		{
@@ -293,6 +294,12 @@ SceneNode::Ptr GltfImporter::processGltfNode(const fastgltf::Asset &gltf, size_t
 			loadedMesh.primitives.push_back(meshPrim);
 		}
 
+		for (size_t i = meshFirstVertex; i < vertices.size(); ++i)
+		{
+			loadedMesh.boundsMin = glm::min(loadedMesh.boundsMin, vertices[i].pos);
+			loadedMesh.boundsMax = glm::max(loadedMesh.boundsMax, vertices[i].pos);
+		}
+
 		modelResource.meshes.push_back(loadedMesh);
 		newNode->addMeshIndex(modelResource.meshes.size() - 1);
 	}
@@ -558,6 +565,15 @@ void GltfImporter::populateMaterials(const fastgltf::Asset &gltf, ModelResource
 		pbrMat.data.baseColorFactor = glm::vec4(mat.pbrData.baseColorFactor[0], mat.pbrData.baseColorFactor[1], mat.pbrData.baseColorFactor[2], mat.pbrData.baseColorFactor[3]);
 		pbrMat.data.metallicFactor  = mat.pbrData.metallicFactor;
 		pbrMat.data.roughnessFactor = mat.pbrData.roughnessFactor;
+		// OPAQUE ignores alpha entirely; BLEND has no sorted transparency path yet and stays a 0.5 cutout.
+		if (mat.alphaMode == fastgltf::AlphaMode::Opaque)
+		{
+			pbrMat.data.alphaCutoff = 0.0f;
+		}
+		else if (mat.alphaMode == fastgltf::AlphaMode::Mask)
+		{
+			pbrMat.data.alphaCutoff = mat.alphaCutoff;
+		}
 
 		if (mat.pbrData.baseColorTexture.has_value())
 		{
@@ -602,6 +618,58 @@ void GltfImporter::populateMaterials(const fastgltf::Asset &gltf, ModelResource
 	}
 }
 
+void GltfImporter::populatePunctualLights(const fastgltf::Asset &gltf, ModelResource &modelResource) const
+{
+	modelResource.lights.clear();
+	modelResource.lights.reserve(gltf.lights.size());
+	for (const auto &light : gltf.lights)
+	{
+		Laphria::PunctualLight imported;
+		switch (light.type)
+		{
+			case fastgltf::LightType::Directional:
+				imported.type = Laphria::PunctualLightType::Directional;
+				break;
+			case fastgltf::LightType::Spot:
+				imported.type = Laphria::PunctualLightType::Spot;
+				break;
+			case fastgltf::LightType::Point:
+			default:
+				imported.type = Laphria::PunctualLightType::Point;
+				break;
+		}
+		imported.color     = glm::vec3(light.color[0], light.color[1], light.color[2]);
+		imported.intensity = static_cast<float>(light.intensity);
+		if (light.range.has_value())
+		{
+			imported.range = static_cast<float>(light.range.value());
+		}
+		if (light.innerConeAngle.has_value())
+		{
+			imported.innerConeAngle = static_cast<float>(light.innerConeAngle.value());
+		}
+		if (light.outerConeAngle.has_value())
+		{
+			imported.outerConeAngle = static_cast<float>(light.outerConeAngle.value());
+		}
+		modelResource.lights.push_back(imported);
+	}
+
+	modelResource.nodeLightIndices.assign(gltf.nodes.size(), -1);
+	if (modelResource.lights.empty())
+	{
+		return;
+	}
+	for (size_t nodeIndex = 0; nodeIndex < gltf.nodes.size(); ++nodeIndex)
+	{
+		const auto &node = gltf.nodes[nodeIndex];
+		if (node.lightIndex.has_value() && node.lightIndex.value() < modelResource.lights.size())
+		{
+			modelResource.nodeLightIndices[nodeIndex] = static_cast<int>(node.lightIndex.value());
+		}
+	}
+}
+
 std::vector<Laphria::MaterialData> GltfImporter::buildPerPrimitiveMaterials(ModelResource &modelResource) const
 {
 	uint32_t                           currentFlatPrimitiveIndex = 0;
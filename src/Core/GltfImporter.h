@@ -38,6 +38,7 @@ class GltfImporter
 	[[nodiscard]] std::vector<TextureImportSource> buildTextureImportSources(const fastgltf::Asset &gltf, const std::filesystem::path &modelDirectory) const;
 	void populateAnimationClips(const fastgltf::Asset &gltf, ModelResource &modelResource, ModelImportReport &report) const;
 	void populateMaterials(const fastgltf::Asset &gltf, ModelResource &modelResource) const;
+	void populatePunctualLights(const fastgltf::Asset &gltf, ModelResource &modelResource) const;
 	[[nodiscard]] std::vector<Laphria::MaterialData> buildPerPrimitiveMaterials(ModelResource &modelResource) const;
 	SceneNode::Ptr buildSceneNodes(const fastgltf::Asset &gltf, ModelResource &modelResource, std::vector<Laphria::Vertex> &vertices,
 	                               std::vector<uint32_t> &indices, std::vector<ModelResource::SkinningInfluence> &skinningInfluences,
@@ -18,6 +18,16 @@ void GpuResourceRegistry::setSkinningDescriptorSetLayout(vk::DescriptorSetLayout
 	skinningDescriptorSetLayout = layout;
 }
 
+void GpuResourceRegistry::setRayTracingEnabled(bool enabled)
+{
+	rayTracingEnabled = enabled;
+}
+
+vk::BufferUsageFlags GpuResourceRegistry::accelerationStructureInputUsage() const
+{
+	return rayTracingEnabled ? vk::BufferUsageFlags(vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR) : vk::BufferUsageFlags{};
+}
+
 void GpuResourceRegistry::uploadModelBuffers(ModelResource &modelResource, const std::vector<Laphria::Vertex> &vertices, const std::vector<uint32_t> &indices,
                                              const UploadBatchContext *batchContext) const
 {
@@ -29,9 +39,8 @@ void GpuResourceRegistry::uploadModelBuffers(ModelResource &modelResource, const
 		return;
 	}
 
-	constexpr vk::BufferUsageFlags vertexUsage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
-	                                             vk::BufferUsageFlagBits::eShaderDeviceAddress |
-	                                             vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+	const vk::BufferUsageFlags vertexUsage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+	                                         vk::BufferUsageFlagBits::eShaderDeviceAddress | accelerationStructureInputUsage();
 	if (batchContext && batchContext->commandBuffer && batchContext->stagingBuffers && batchContext->stagingMemories)
 	{
 		Laphria::VulkanUtils::createDeviceLocalBufferFromDataBatched(device, physicalDevice, *batchContext->commandBuffer,
@@ -46,9 +55,8 @@ void GpuResourceRegistry::uploadModelBuffers(ModelResource &modelResource, const
 		                                                      modelResource.vertexBuffer);
 	}
 
-	constexpr vk::BufferUsageFlags indexUsage = vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
-	                                            vk::BufferUsageFlagBits::eShaderDeviceAddress |
-	                                            vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+	const vk::BufferUsageFlags indexUsage = vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+	                                        vk::BufferUsageFlagBits::eShaderDeviceAddress | accelerationStructureInputUsage();
 	if (batchContext && batchContext->commandBuffer && batchContext->stagingBuffers && batchContext->stagingMemories)
 	{
 		Laphria::VulkanUtils::createDeviceLocalBufferFromDataBatched(device, physicalDevice, *batchContext->commandBuffer,
@@ -191,6 +199,11 @@ void GpuResourceRegistry::createSkinningResources(const fastgltf::Asset &gltf, M
 		const uint32_t jointOffset = (skinIndex < modelResource.skins.size()) ? modelResource.skins[skinIndex].jointMatrixOffset : 0u;
 		influence.joints += glm::uvec4(jointOffset, jointOffset, jointOffset, jointOffset);
 	}
+	modelResource.skinnedBounds.reset(modelResource.skinningJointMatrixCount);
+	for (size_t vertexIndex = 0; vertexIndex < vertices.size(); ++vertexIndex)
+	{
+		modelResource.skinnedBounds.addVertex(vertices[vertexIndex].pos, influences[vertexIndex].joints, influences[vertexIndex].weights);
+	}
 
 	if (batchContext && batchContext->commandBuffer && batchContext->stagingBuffers && batchContext->stagingMemories)
 	{
@@ -210,10 +223,10 @@ void GpuResourceRegistry::createSkinningResources(const fastgltf::Asset &gltf, M
 		    modelResource.skinningInfluenceBuffer);
 	}
 
-	constexpr vk::BufferUsageFlags skinnedVertexUsage = vk::BufferUsageFlagBits::eVertexBuffer |
-	                                                    vk::BufferUsageFlagBits::eStorageBuffer |
-	                                                    vk::BufferUsageFlagBits::eShaderDeviceAddress |
-	                                                    vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+	const vk::BufferUsageFlags skinnedVertexUsage = vk::BufferUsageFlagBits::eVertexBuffer |
+	                                                vk::BufferUsageFlagBits::eStorageBuffer |
+	                                                vk::BufferUsageFlagBits::eShaderDeviceAddress |
+	                                                accelerationStructureInputUsage();
 	if (batchContext && batchContext->commandBuffer && batchContext->stagingBuffers && batchContext->stagingMemories)
 	{
 		Laphria::VulkanUtils::createDeviceLocalBufferFromDataBatched(
@@ -230,6 +243,14 @@ void GpuResourceRegistry::createSkinningResources(const fastgltf::Asset &gltf, M
 		    modelResource.skinnedVertexBuffer);
 	}
 
+	// Previous-frame skinned positions for path tracer motion vectors; the skinning pass fills it before
+	// overwriting the skinned stream, so its initial contents are never read.
+	Laphria::VulkanUtils::createBuffer(
+	    device, physicalDevice, sizeof(glm::vec3) * vertices.size(),
+	    vk::BufferUsageFlagBits::eStorageBuffer,
+	    vk::MemoryPropertyFlagBits::eDeviceLocal,
+	    modelResource.prevSkinnedPositionBuffer);
+
 	const vk::DeviceSize jointPaletteBufferSize = sizeof(glm::mat4) * modelResource.skinningJointMatrixCount;
 	Laphria::VulkanUtils::createBuffer(
 	    device, physicalDevice, jointPaletteBufferSize,
@@ -239,6 +260,8 @@ void GpuResourceRegistry::createSkinningResources(const fastgltf::Asset &gltf, M
 	modelResource.skinningJointMatricesMapped = modelResource.skinningJointMatrixBuffer.memory.mapMemory(0, jointPaletteBufferSize);
 	std::vector<glm::mat4> identityPalette(modelResource.skinningJointMatrixCount, glm::mat4(1.0f));
 	memcpy(modelResource.skinningJointMatricesMapped, identityPalette.data(), jointPaletteBufferSize);
+	// The skinned stream starts out as a copy of the bind pose.
+	modelResource.skinnedBounds.posedBounds(identityPalette, modelResource.skinnedPoseMin, modelResource.skinnedPoseMax);
 
 	vk::DescriptorSetAllocateInfo allocInfo{
 	    .descriptorPool = *descriptorPool,
@@ -262,8 +285,12 @@ void GpuResourceRegistry::createSkinningResources(const fastgltf::Asset &gltf, M
 	    .buffer = *modelResource.skinningJointMatrixBuffer,
 	    .offset = 0,
 	    .range = VK_WHOLE_SIZE};
+	vk::DescriptorBufferInfo prevPositionsInfo{
+	    .buffer = *modelResource.prevSkinnedPositionBuffer,
+	    .offset = 0,
+	    .range = VK_WHOLE_SIZE};
 
-	std::array<vk::WriteDescriptorSet, 4> writes = {
+	std::array<vk::WriteDescriptorSet, 5> writes = {
 	    vk::WriteDescriptorSet{
 	        .dstSet = *modelResource.skinningDescriptorSet,
 	        .dstBinding = 0,
@@ -291,7 +318,14 @@ void GpuResourceRegistry::createSkinningResources(const fastgltf::Asset &gltf, M
 	        .dstArrayElement = 0,
 	        .descriptorCount = 1,
 	        .descriptorType = vk::DescriptorType::eStorageBuffer,
-	        .pBufferInfo = &jointMatricesInfo}};
+	        .pBufferInfo = &jointMatricesInfo},
+	    vk::WriteDescriptorSet{
+	        .dstSet = *modelResource.skinningDescriptorSet,
+	        .dstBinding = 4,
+	        .dstArrayElement = 0,
+	        .descriptorCount = 1,
+	        .descriptorType = vk::DescriptorType::eStorageBuffer,
+	        .pBufferInfo = &prevPositionsInfo}};
 	device.updateDescriptorSets(writes, nullptr);
 
 	modelResource.hasRuntimeSkinning = true;
@@ -356,9 +390,20 @@ void GpuResourceRegistry::createModelDescriptorSet(ModelResource &modelResource,
 	device.updateDescriptorSets(writes, nullptr);
 }
 
+vk::GeometryFlagsKHR GpuResourceRegistry::blasGeometryFlags(const ModelResource &modelResource, const Laphria::MeshPrimitive &primitive)
+{
+	// Same material lookup as GltfImporter::buildPerPrimitiveMaterials, including its default for unassigned primitives.
+	Laphria::MaterialData material{};
+	if (primitive.materialIndex >= 0 && static_cast<size_t>(primitive.materialIndex) < modelResource.materials.size())
+	{
+		material = modelResource.materials[primitive.materialIndex].data;
+	}
+	return material.isAlphaTestFree() ? vk::GeometryFlagsKHR(vk::GeometryFlagBitsKHR::eOpaque) : vk::GeometryFlagsKHR{};
+}
+
 void GpuResourceRegistry::buildBLAS(ModelResource &modelResource, const std::vector<Laphria::Vertex> &vertices, const std::vector<uint32_t> &indices) const
 {
-	if (modelResource.meshes.empty() || !*modelResource.vertexBuffer || !*modelResource.indexBuffer)
+	if (!rayTracingEnabled || modelResource.meshes.empty() || !*modelResource.vertexBuffer || !*modelResource.indexBuffer)
 	{
 		return;
 	}
@@ -379,6 +424,7 @@ void GpuResourceRegistry::buildBLAS(ModelResource &modelResource, const std::vec
 
 			vk::AccelerationStructureGeometryKHR geometry{};
 			geometry.geometryType = vk::GeometryTypeKHR::eTriangles;
+			geometry.flags = blasGeometryFlags(modelResource, prim);
 			auto &triangles = geometry.geometry.triangles;
 			triangles.vertexFormat = vk::Format::eR32G32B32Sfloat;
 			triangles.vertexData.deviceAddress = vertexAddress;
@@ -27,11 +27,20 @@ class GpuResourceRegistry
 	void uploadMaterialBuffer(ModelResource &modelResource, const Laphria::MaterialData &material,
 	                          const UploadBatchContext *batchContext = nullptr) const;
 	void setSkinningDescriptorSetLayout(vk::DescriptorSetLayout layout);
+	// Off on the raster-only device tier: no BLAS is built and mesh buffers are not acceleration structure inputs.
+	void setRayTracingEnabled(bool enabled);
+	[[nodiscard]] bool isRayTracingEnabled() const
+	{
+		return rayTracingEnabled;
+	}
+	[[nodiscard]] vk::BufferUsageFlags accelerationStructureInputUsage() const;
 	void createSkinningResources(const fastgltf::Asset &gltf, ModelResource &modelResource, const std::vector<Laphria::Vertex> &vertices,
 	                             const std::vector<ModelResource::SkinningInfluence> &skinningInfluences, const std::vector<int> &nodeSkinIndices,
 	                             const UploadBatchContext *batchContext = nullptr) const;
 	void createModelDescriptorSet(ModelResource &modelResource, vk::DescriptorSetLayout layout) const;
 	void buildBLAS(ModelResource &modelResource, const std::vector<Laphria::Vertex> &vertices, const std::vector<uint32_t> &indices) const;
+	// eOpaque for primitives whose material never fails the alpha test; BLAS refits must pass the same flags.
+	static vk::GeometryFlagsKHR blasGeometryFlags(const ModelResource &modelResource, const Laphria::MeshPrimitive &primitive);
 
   private:
 	vk::raii::Device         &device;
@@ -40,6 +49,7 @@ class GpuResourceRegistry
 	vk::raii::Queue          &queue;
 	vk::raii::DescriptorPool &descriptorPool;
 	vk::DescriptorSetLayout   skinningDescriptorSetLayout = nullptr;
+	bool                      rayTracingEnabled = true;
 };
 
 #endif // LAPHRIAENGINE_GPURESOURCEREGISTRY_H
@@ -0,0 +1,59 @@
+#include "OcclusionCulling.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Laphria
+{
+HiZPyramidLayout computeHiZPyramidLayout(uint32_t depthWidth, uint32_t depthHeight)
+{
+	HiZPyramidLayout layout;
+	layout.width    = std::bit_floor(std::max(depthWidth, 1u));
+	layout.height   = std::bit_floor(std::max(depthHeight, 1u));
+	layout.mipCount = static_cast<uint32_t>(std::bit_width(std::max(layout.width, layout.height)));
+	return layout;
+}
+
+void transformBounds(const glm::vec3 &localMin, const glm::vec3 &localMax, const glm::mat4 &transform,
+                     glm::vec3 &worldMin, glm::vec3 &worldMax)
+{
+	// Arvo: per axis, the translation plus the smaller / larger product of each matrix entry with the extent.
+	worldMin = glm::vec3(transform[3]);
+	worldMax = worldMin;
+	for (int column = 0; column < 3; ++column)
+	{
+		for (int row = 0; row < 3; ++row)
+		{
+			const float a = transform[column][row] * localMin[column];
+			const float b = transform[column][row] * localMax[column];
+			worldMin[row] += std::min(a, b);
+			worldMax[row] += std::max(a, b);
+		}
+	}
+}
+
+uint64_t occlusionCandidateKey(const void *node, uint32_t instanceOrdinal, uint32_t meshIndex)
+{
+	uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node));
+	key ^= (static_cast<uint64_t>(instanceOrdinal) << 32 | meshIndex) + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2);
+	return key;
+}
+
+void OcclusionHistory::update(std::span<const uint64_t> keys, std::span<const uint32_t> visibility)
+{
+	visibleKeys.clear();
+	const size_t count = std::min(keys.size(), visibility.size());
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (visibility[i] != 0)
+		{
+			visibleKeys.insert(keys[i]);
+		}
+	}
+}
+
+void OcclusionHistory::clear()
+{
+	visibleKeys.clear();
+}
+}        // namespace Laphria
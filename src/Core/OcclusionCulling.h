@@ -0,0 +1,54 @@
+#ifndef LAPHRIAENGINE_OCCLUSIONCULLING_H
+#define LAPHRIAENGINE_OCCLUSIONCULLING_H
+
+#include <cstdint>
+#include <span>
+#include <unordered_set>
+
+#include <glm/glm.hpp>
+
+namespace Laphria
+{
+// Depth pyramid of the raster occlusion pass: mip 0 is the largest power of two not above each side of the
+// depth extent, so every further mip halves it exactly and each texel holds the farthest depth below it.
+struct HiZPyramidLayout
+{
+	uint32_t width    = 1;
+	uint32_t height   = 1;
+	uint32_t mipCount = 1;
+};
+
+HiZPyramidLayout computeHiZPyramidLayout(uint32_t depthWidth, uint32_t depthHeight);
+
+// World-space AABB of an object-space AABB under an affine transform.
+void transformBounds(const glm::vec3 &localMin, const glm::vec3 &localMax, const glm::mat4 &transform,
+                     glm::vec3 &worldMin, glm::vec3 &worldMax);
+
+// Identity of one mesh instance across frames: the node, the prefab template node drawing through it and the mesh.
+uint64_t occlusionCandidateKey(const void *node, uint32_t instanceOrdinal, uint32_t meshIndex);
+
+// Mesh instances the last read-back cull pass found visible. They are drawn before the depth pyramid is built;
+// everything else waits for the test against it. A stale entry only moves an instance between the two phases.
+class OcclusionHistory
+{
+  public:
+	[[nodiscard]] bool wasVisible(uint64_t key) const
+	{
+		return visibleKeys.contains(key);
+	}
+
+	// Replaces the set with one frame's results: keys[i] is visible when visibility[i] != 0.
+	void update(std::span<const uint64_t> keys, std::span<const uint32_t> visibility);
+	void clear();
+
+	[[nodiscard]] size_t visibleCount() const
+	{
+		return visibleKeys.size();
+	}
+
+  private:
+	std::unordered_set<uint64_t> visibleKeys;
+};
+}        // namespace Laphria
+
+#endif        // LAPHRIAENGINE_OCCLUSIONCULLING_H
@@ -1,6 +1,7 @@
 #include "PipelineCollection.h"
 
 #include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <stdexcept>
@@ -39,8 +40,125 @@ std::vector<std::filesystem::path> buildShaderSearchCandidates(const std::string
 	    executableDir / relativePath,
 	    std::filesystem::current_path() / relativePath};
 }
+
+std::filesystem::path getPipelineCachePath()
+{
+	return getExecutableDirectory() / EngineConfig::kPipelineCacheFile;
+}
+
+// Vulkan view of a SpecializationBlock for one pipeline creation; the block must outlive it.
+struct VulkanSpecialization
+{
+	std::array<vk::SpecializationMapEntry, kSpecializationConstantCount> entries{};
+	vk::SpecializationInfo                                               info{};
+
+	explicit VulkanSpecialization(const SpecializationBlock &block)
+	{
+		for (uint32_t i = 0; i < kSpecializationConstantCount; ++i)
+		{
+			entries[i] = vk::SpecializationMapEntry{
+			    .constantID = block.entries[i].constantId,
+			    .offset     = block.entries[i].offset,
+			    .size       = block.entries[i].size};
+		}
+		info = vk::SpecializationInfo{
+		    .mapEntryCount = static_cast<uint32_t>(entries.size()),
+		    .pMapEntries   = entries.data(),
+		    .dataSize      = sizeof(block.values),
+		    .pData         = block.values.data()};
+	}
+	VulkanSpecialization(const VulkanSpecialization &)            = delete;
+	VulkanSpecialization &operator=(const VulkanSpecialization &) = delete;
+};
 }        // namespace
 
+// ── Pipeline Cache & Permutation ───────────────────────────────────────────
+
+void PipelineCollection::createPipelineCache(const VulkanDevice &dev)
+{
+	// Only seed the cache with data written by this device and driver; anything else starts it empty.
+	std::vector<char> data;
+	std::ifstream     file(getPipelineCachePath(), std::ios::ate | std::ios::binary);
+	if (file.is_open())
+	{
+		data.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		file.read(data.data(), static_cast<std::streamsize>(data.size()));
+		if (file.fail())
+		{
+			data.clear();
+		}
+	}
+
+	if (data.size() >= sizeof(VkPipelineCacheHeaderVersionOne))
+	{
+		VkPipelineCacheHeaderVersionOne header{};
+		std::memcpy(&header, data.data(), sizeof(header));
+		const vk::PhysicalDeviceProperties properties = dev.physicalDevice.getProperties();
+		if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || header.vendorID != properties.vendorID ||
+		    header.deviceID != properties.deviceID ||
+		    std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0)
+		{
+			data.clear();
+		}
+	}
+	else
+	{
+		data.clear();
+	}
+
+	vk::PipelineCacheCreateInfo info{
+	    .initialDataSize = data.size(),
+	    .pInitialData    = data.empty() ? nullptr : data.data()};
+	pipelineCache = vk::raii::PipelineCache(dev.logicalDevice, info);
+}
+
+void PipelineCollection::savePipelineCache() const
+{
+	if (!*pipelineCache)
+	{
+		return;
+	}
+	// A failed write only costs the next run its warm start.
+	const std::vector<uint8_t> data = pipelineCache.getData();
+	std::ofstream              file(getPipelineCachePath(), std::ios::binary | std::ios::trunc);
+	if (file.is_open())
+	{
+		file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+	}
+}
+
+void PipelineCollection::setShaderPermutation(VulkanDevice &dev, const ShaderPermutation &permutation)
+{
+	const uint32_t rebuild = permutedPipelinesToRebuild(shaderPermutation, permutation);
+	shaderPermutation      = permutation;
+	specializationBlock    = buildSpecializationBlock(permutation);
+
+	// Pipelines that do not exist yet pick the new values up when they are created.
+	if ((rebuild & kPermutedRaster) && *graphicsPipeline)
+	{
+		createGraphicsPipeline(dev, graphicsColorFormat, graphicsDepthFormat);
+	}
+	if ((rebuild & kPermutedPathTracer) && *rayTracingPipeline)
+	{
+		createRayTracingPipeline(dev);
+		createShaderBindingTable(dev);
+	}
+	if ((rebuild & kPermutedClassicRT) && *classicRTPipeline)
+	{
+		createClassicRTPipeline(dev);
+		createClassicRTShaderBindingTable(dev);
+	}
+	if ((rebuild & kPermutedWavefront) && !wavefrontPipelines.empty())
+	{
+		createWavefrontPipelines(dev);
+	}
+	if ((rebuild & kPermutedDenoiser) && *atrousPipeline)
+	{
+		createDenoiserPipelines(dev);
+	}
+}
+
 // ── Top-level init ─────────────────────────────────────────────────────────
 
 void PipelineCollection::createDescriptorSetLayouts(const VulkanDevice &dev)
@@ -49,9 +167,15 @@ void PipelineCollection::createDescriptorSetLayouts(const VulkanDevice &dev)
 	createMaterialDescriptorSetLayout(dev);
 	createComputeDescriptorSetLayout(dev);
 	createSkinningDescriptorSetLayout(dev);
-	createRayTracingDescriptorSetLayout(dev);
+	if (dev.rayTracingSupported)
+	{
+		createRayTracingDescriptorSetLayout(dev);
+	}
 	createPhysicsDescriptorSetLayout(dev);
 	createDenoiserDescriptorSetLayout(dev);
+	createUpscaleDescriptorSetLayout(dev);
+	createWavefrontDescriptorSetLayout(dev);
+	createOcclusionDescriptorSetLayouts(dev);
 }
 
 // ── Descriptor Set Layout Implementations ──────────────────────────────────
@@ -62,14 +186,20 @@ void PipelineCollection::createGlobalDescriptorSetLayout(const VulkanDevice &dev
 	// Binding 1 — CSM shadow depth array (sampled image). ePartiallyBound so RT/compute
 	//             pipelines that bind this set without providing binding 1 are still valid.
 	// Binding 2 — CSM comparison sampler. Same ePartiallyBound rationale.
-	std::array<vk::DescriptorSetLayoutBinding, 3> globalBindings = {
+	// Binding 3 — punctual lights (PunctualLightData): clustered raster shading, light culling, path tracer NEE.
+	// Binding 4 — per-cluster light lists written by the light culling pass, read by the raster fragment shader.
+	// RT stages are only named on devices that enable the ray tracing pipeline.
+	const vk::ShaderStageFlags rtStages = dev.rayTracingSupported ? vk::ShaderStageFlagBits::eRaygenKHR |
+	                                                                     vk::ShaderStageFlagBits::eClosestHitKHR |
+	                                                                     vk::ShaderStageFlagBits::eMissKHR
+	                                                               : vk::ShaderStageFlags{};
+	std::array<vk::DescriptorSetLayoutBinding, 5> globalBindings = {
 	    vk::DescriptorSetLayoutBinding{
 	        .binding         = 0,
 	        .descriptorType  = vk::DescriptorType::eUniformBuffer,
 	        .descriptorCount = 1,
 	        .stageFlags      = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment |
-	                      vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eClosestHitKHR |
-	                      vk::ShaderStageFlagBits::eMissKHR},
+	                      vk::ShaderStageFlagBits::eCompute | rtStages},
 	    vk::DescriptorSetLayoutBinding{
 	        .binding         = 1,
 	        .descriptorType  = vk::DescriptorType::eSampledImage,
@@ -79,12 +209,25 @@ void PipelineCollection::createGlobalDescriptorSetLayout(const VulkanDevice &dev
 	        .binding         = 2,
 	        .descriptorType  = vk::DescriptorType::eSampler,
 	        .descriptorCount = 1,
-	        .stageFlags      = vk::ShaderStageFlagBits::eFragment}};
+	        .stageFlags      = vk::ShaderStageFlagBits::eFragment},
+	    vk::DescriptorSetLayoutBinding{
+	        .binding         = 3,
+	        .descriptorType  = vk::DescriptorType::eStorageBuffer,
+	        .descriptorCount = 1,
+	        .stageFlags      = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eCompute |
+	                      (rtStages & vk::ShaderStageFlagBits::eRaygenKHR)},
+	    vk::DescriptorSetLayoutBinding{
+	        .binding         = 4,
+	        .descriptorType  = vk::DescriptorType::eStorageBuffer,
+	        .descriptorCount = 1,
+	        .stageFlags      = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eCompute}};
 
-	std::array<vk::DescriptorBindingFlags, 3> bindFlags = {
+	std::array<vk::DescriptorBindingFlags, 5> bindFlags = {
 	    vk::DescriptorBindingFlags{},                           // binding 0 — always provided
 	    vk::DescriptorBindingFlagBits::ePartiallyBound,         // binding 1 — optional for RT/compute
-	    vk::DescriptorBindingFlagBits::ePartiallyBound};        // binding 2 — optional for RT/compute
+	    vk::DescriptorBindingFlagBits::ePartiallyBound,         // binding 2 — optional for RT/compute
+	    vk::DescriptorBindingFlags{},                           // binding 3 — always provided
+	    vk::DescriptorBindingFlags{}};                          // binding 4 — always provided
 
 	vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{
 	    .bindingCount  = static_cast<uint32_t>(bindFlags.size()),
@@ -140,7 +283,8 @@ void PipelineCollection::createComputeDescriptorSetLayout(const VulkanDevice &de
 
 void PipelineCollection::createSkinningDescriptorSetLayout(const VulkanDevice &dev)
 {
-	std::array<vk::DescriptorSetLayoutBinding, 4> bindings = {
+	// 0: source vertices, 1: skinned vertices, 2: influences, 3: joint palette, 4: previous skinned positions
+	std::array<vk::DescriptorSetLayoutBinding, 5> bindings = {
 	    vk::DescriptorSetLayoutBinding{
 	        .binding         = 0,
 	        .descriptorType  = vk::DescriptorType::eStorageBuffer,
@@ -160,6 +304,11 @@ void PipelineCollection::createSkinningDescriptorSetLayout(const VulkanDevice &d
 	        .binding         = 3,
 	        .descriptorType  = vk::DescriptorType::eStorageBuffer,
 	        .descriptorCount = 1,
+	        .stageFlags      = vk::ShaderStageFlagBits::eCompute},
+	    vk::DescriptorSetLayoutBinding{
+	        .binding         = 4,
+	        .descriptorType  = vk::DescriptorType::eStorageBuffer,
+	        .descriptorCount = 1,
 	        .stageFlags      = vk::ShaderStageFlagBits::eCompute}};
 
 	vk::DescriptorSetLayoutCreateInfo layoutInfo{
@@ -184,64 +333,79 @@ void PipelineCollection::createPhysicsDescriptorSetLayout(const VulkanDevice &de
 void PipelineCollection::createRayTracingDescriptorSetLayout(const VulkanDevice &dev)
 {
 	// Set 0 — RT pipeline bindings.
-	// Bindings 0-4: acceleration structure + storage images written by Raygen.
+	// Bindings 0-4: acceleration structure + storage images used by Raygen. Binding 3 is the per-pixel sample
+	//               budget written by the compute pass that runs before traceRays.
 	// Bindings 5-8: mesh data arrays read by ClosestHit (shifted from old 2-5 to make room).
-	std::array<vk::DescriptorSetLayoutBinding, 9> bindings = {
+	// Bindings 9-10: previous-frame instance transforms and skinned positions for object motion vectors.
+	// Every binding is also visible to compute: the wavefront path tracer's kernels bind this set with ray queries.
+	std::array<vk::DescriptorSetLayoutBinding, 11> bindings = {
 	    vk::DescriptorSetLayoutBinding{// 0: TLAS
 	                                   .binding         = 0,
 	                                   .descriptorType  = vk::DescriptorType::eAccelerationStructureKHR,
 	                                   .descriptorCount = 1,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eClosestHitKHR},
-	    vk::DescriptorSetLayoutBinding{// 1: Noisy colour output (1 SPP path tracer)
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eCompute},
+	    vk::DescriptorSetLayoutBinding{// 1: Noisy colour output (alpha = paths traced)
 	                                   .binding         = 1,
 	                                   .descriptorType  = vk::DescriptorType::eStorageImage,
 	                                   .descriptorCount = 1,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR},
-	    vk::DescriptorSetLayoutBinding{// 2: G-Buffer world normals
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eCompute},
+	    vk::DescriptorSetLayoutBinding{// 2: G-Buffer octahedral world normal + linear depth (ray hit t)
 	                                   .binding         = 2,
 	                                   .descriptorType  = vk::DescriptorType::eStorageImage,
 	                                   .descriptorCount = 1,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR},
-	    vk::DescriptorSetLayoutBinding{// 3: G-Buffer linear depth (ray hit t)
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eCompute},
+	    vk::DescriptorSetLayoutBinding{// 3: Sample budget (paths per pixel)
 	                                   .binding         = 3,
 	                                   .descriptorType  = vk::DescriptorType::eStorageImage,
 	                                   .descriptorCount = 1,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR},
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eCompute},
 	    vk::DescriptorSetLayoutBinding{// 4: Motion vectors
 	                                   .binding         = 4,
 	                                   .descriptorType  = vk::DescriptorType::eStorageImage,
 	                                   .descriptorCount = 1,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR},
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eRaygenKHR | vk::ShaderStageFlagBits::eCompute},
 	    vk::DescriptorSetLayoutBinding{// 5: Vertex buffers array
 	                                   .binding         = 5,
 	                                   .descriptorType  = vk::DescriptorType::eStorageBuffer,
 	                                   .descriptorCount = 1000,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR},
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR | vk::ShaderStageFlagBits::eCompute},
 	    vk::DescriptorSetLayoutBinding{// 6: Index buffers array
 	                                   .binding         = 6,
 	                                   .descriptorType  = vk::DescriptorType::eStorageBuffer,
 	                                   .descriptorCount = 1000,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR},
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR | vk::ShaderStageFlagBits::eCompute},
 	    vk::DescriptorSetLayoutBinding{// 7: Material buffers array
 	                                   .binding         = 7,
 	                                   .descriptorType  = vk::DescriptorType::eStorageBuffer,
 	                                   .descriptorCount = 1000,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR},
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR | vk::ShaderStageFlagBits::eCompute},
 	    vk::DescriptorSetLayoutBinding{// 8: Textures array — variably sized
 	                                   .binding         = 8,
 	                                   .descriptorType  = vk::DescriptorType::eCombinedImageSampler,
 	                                   .descriptorCount = 1000,
-	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR}};
-	std::array<vk::DescriptorBindingFlags, 9> flags = {
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eAnyHitKHR | vk::ShaderStageFlagBits::eCompute},
+	    vk::DescriptorSetLayoutBinding{// 9: Per-instance motion data (indexed by InstanceIndex())
+	                                   .binding         = 9,
+	                                   .descriptorType  = vk::DescriptorType::eStorageBuffer,
+	                                   .descriptorCount = 1,
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eCompute},
+	    vk::DescriptorSetLayoutBinding{// 10: Previous skinned positions array (skinned models only)
+	                                   .binding         = 10,
+	                                   .descriptorType  = vk::DescriptorType::eStorageBuffer,
+	                                   .descriptorCount = 1000,
+	                                   .stageFlags      = vk::ShaderStageFlagBits::eClosestHitKHR | vk::ShaderStageFlagBits::eCompute}};
+	std::array<vk::DescriptorBindingFlags, 11> flags = {
 	    vk::DescriptorBindingFlags{},   // 0: TLAS
 	    vk::DescriptorBindingFlags{},   // 1: noisy colour
-	    vk::DescriptorBindingFlags{},   // 2: normals
-	    vk::DescriptorBindingFlags{},   // 3: depth
+	    vk::DescriptorBindingFlags{},   // 2: normal + depth
+	    vk::DescriptorBindingFlags{},   // 3: sample budget
 	    vk::DescriptorBindingFlags{},   // 4: motion vectors
 	    vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,  // 5
 	    vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,  // 6
 	    vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,  // 7
-	    vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eVariableDescriptorCount | vk::DescriptorBindingFlagBits::eUpdateAfterBind}; // 8
+	    vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,  // 8
+	    vk::DescriptorBindingFlags{},   // 9: instance motion
+	    vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eVariableDescriptorCount | vk::DescriptorBindingFlagBits::eUpdateAfterBind}; // 10
 	vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlags{
 	    .bindingCount  = static_cast<uint32_t>(flags.size()),
 	    .pBindingFlags = flags.data()};
@@ -255,29 +419,97 @@ void PipelineCollection::createRayTracingDescriptorSetLayout(const VulkanDevice
 
 void PipelineCollection::createDenoiserDescriptorSetLayout(const VulkanDevice &dev)
 {
-	// 13 storage image bindings covering all denoiser pass inputs and outputs.
-	// Both reprojection and A-Trous shaders share this single layout, selecting
-	// the relevant bindings via the shader source.
-	std::array<vk::DescriptorSetLayoutBinding, 13> bindings = {
+	// 13 storage image bindings covering all denoiser pass inputs and outputs, plus the progressive mode's
+	// noise counter. The sample budget, reprojection, A-Trous and progressive accumulation shaders share this
+	// single layout, selecting the relevant bindings via the shader source.
+	std::array<vk::DescriptorSetLayoutBinding, 14> bindings = {
 	    vk::DescriptorSetLayoutBinding{.binding = 0,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // noisy colour (reprojection input)
-	    vk::DescriptorSetLayoutBinding{.binding = 1,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // G-Buffer normals (current frame)
-	    vk::DescriptorSetLayoutBinding{.binding = 2,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // G-Buffer depth (current frame)
-	    vk::DescriptorSetLayoutBinding{.binding = 3,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // motion vectors
-	    vk::DescriptorSetLayoutBinding{.binding = 4,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history colour read  [(i+1)%2]
-	    vk::DescriptorSetLayoutBinding{.binding = 5,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history colour write [i]
-	    vk::DescriptorSetLayoutBinding{.binding = 6,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history moments read [(i+1)%2]
-	    vk::DescriptorSetLayoutBinding{.binding = 7,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history moments write [i]
-	    vk::DescriptorSetLayoutBinding{.binding = 8,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // A-Trous ping-pong buffer A
-	    vk::DescriptorSetLayoutBinding{.binding = 9,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // A-Trous ping-pong buffer B
-	    vk::DescriptorSetLayoutBinding{.binding = 10, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // final denoised output (= noisy colour image, reused)
-	    vk::DescriptorSetLayoutBinding{.binding = 11, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // previous-frame G-Buffer normals [(i+1)%2]
-	    vk::DescriptorSetLayoutBinding{.binding = 12, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute}};  // previous-frame G-Buffer depth   [(i+1)%2]
+	    vk::DescriptorSetLayoutBinding{.binding = 1,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // packed G-Buffer normal + depth (current frame)
+	    vk::DescriptorSetLayoutBinding{.binding = 2,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // motion vectors
+	    vk::DescriptorSetLayoutBinding{.binding = 3,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history colour read  [(i+1)%2]
+	    vk::DescriptorSetLayoutBinding{.binding = 4,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history colour write [i]
+	    vk::DescriptorSetLayoutBinding{.binding = 5,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history moments read [(i+1)%2]
+	    vk::DescriptorSetLayoutBinding{.binding = 6,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history moments write [i]
+	    vk::DescriptorSetLayoutBinding{.binding = 7,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // A-Trous ping-pong buffer A
+	    vk::DescriptorSetLayoutBinding{.binding = 8,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // A-Trous ping-pong buffer B
+	    vk::DescriptorSetLayoutBinding{.binding = 9,  .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // final denoised output (= noisy colour image, reused)
+	    vk::DescriptorSetLayoutBinding{.binding = 10, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // packed G-Buffer normal + depth (previous frame) [(i+1)%2]
+	    vk::DescriptorSetLayoutBinding{.binding = 11, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // path tracer sample budget [i]
+	    vk::DescriptorSetLayoutBinding{.binding = 12, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // progressive accumulation (shared by all slots)
+	    vk::DescriptorSetLayoutBinding{.binding = 13, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute}};  // progressive noisy pixel count [i]
 	vk::DescriptorSetLayoutCreateInfo layoutInfo{
 	    .bindingCount = static_cast<uint32_t>(bindings.size()),
 	    .pBindings    = bindings.data()};
 	denoiserDescriptorSetLayout = vk::raii::DescriptorSetLayout(dev.logicalDevice, layoutInfo);
 }
 
+void PipelineCollection::createUpscaleDescriptorSetLayout(const VulkanDevice &dev)
+{
+	// Inputs of both backends the upscaler serves, plus its history ping-pong. The raster targets are sampled
+	// images (read with Load: the swapchain colour format does not support storage); everything else is a
+	// storage image in eGeneral. The camera matrices come from the global set (Set 1).
+	std::array<vk::DescriptorSetLayoutBinding, 6> bindings = {
+	    vk::DescriptorSetLayoutBinding{.binding = 0, .descriptorType = vk::DescriptorType::eSampledImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // raster colour [i]
+	    vk::DescriptorSetLayoutBinding{.binding = 1, .descriptorType = vk::DescriptorType::eSampledImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // raster depth [i]
+	    vk::DescriptorSetLayoutBinding{.binding = 2, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // classic RT colour [i]
+	    vk::DescriptorSetLayoutBinding{.binding = 3, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // classic RT motion vectors [i]
+	    vk::DescriptorSetLayoutBinding{.binding = 4, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // history read  [(i+1)%2]
+	    vk::DescriptorSetLayoutBinding{.binding = 5, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute}};  // history write [i]
+	vk::DescriptorSetLayoutCreateInfo layoutInfo{
+	    .bindingCount = static_cast<uint32_t>(bindings.size()),
+	    .pBindings    = bindings.data()};
+	upscaleDescriptorSetLayout = vk::raii::DescriptorSetLayout(dev.logicalDevice, layoutInfo);
+}
+
+void PipelineCollection::createWavefrontDescriptorSetLayout(const VulkanDevice &dev)
+{
+	// Set 2 of the wavefront path tracer: the queues between its kernels (FrameContext::wavefront*) and the
+	// TLAS instance records, read for the object-to-world transform of a ray query hit. Sets 0 and 1 are the
+	// path tracer's RT set and the global set.
+	std::array<vk::DescriptorSetLayoutBinding, 8> bindings = {
+	    vk::DescriptorSetLayoutBinding{.binding = 0, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // primary hits
+	    vk::DescriptorSetLayoutBinding{.binding = 1, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // path queues (ping-pong)
+	    vk::DescriptorSetLayoutBinding{.binding = 2, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // hit queue
+	    vk::DescriptorSetLayoutBinding{.binding = 3, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // hit indices sorted by material bin
+	    vk::DescriptorSetLayoutBinding{.binding = 4, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // shadow ray records
+	    vk::DescriptorSetLayoutBinding{.binding = 5, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // per-pixel path radiance
+	    vk::DescriptorSetLayoutBinding{.binding = 6, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // counters, indirect arguments, bins
+	    vk::DescriptorSetLayoutBinding{.binding = 7, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute}};  // TLAS instances [i]
+	vk::DescriptorSetLayoutCreateInfo layoutInfo{
+	    .bindingCount = static_cast<uint32_t>(bindings.size()),
+	    .pBindings    = bindings.data()};
+	wavefrontDescriptorSetLayout = vk::raii::DescriptorSetLayout(dev.logicalDevice, layoutInfo);
+}
+
+void PipelineCollection::createOcclusionDescriptorSetLayouts(const VulkanDevice &dev)
+{
+	// Hi-Z reduction, one set per pyramid level: the level below (the depth attachment for mip 0, sampled in
+	// eShaderReadOnlyOptimal; otherwise the previous mip in eGeneral) and the mip written.
+	{
+		std::array<vk::DescriptorSetLayoutBinding, 2> bindings = {
+		    vk::DescriptorSetLayoutBinding{.binding = 0, .descriptorType = vk::DescriptorType::eSampledImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // source level
+		    vk::DescriptorSetLayoutBinding{.binding = 1, .descriptorType = vk::DescriptorType::eStorageImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute}};  // destination mip
+		vk::DescriptorSetLayoutCreateInfo layoutInfo{
+		    .bindingCount = static_cast<uint32_t>(bindings.size()),
+		    .pBindings    = bindings.data()};
+		hiZReduceDescriptorSetLayout = vk::raii::DescriptorSetLayout(dev.logicalDevice, layoutInfo);
+	}
+
+	// Occlusion test: the whole pyramid and the slot's candidate, draw command and result buffers
+	// (FrameContext::occlusion*).
+	{
+		std::array<vk::DescriptorSetLayoutBinding, 4> bindings = {
+		    vk::DescriptorSetLayoutBinding{.binding = 0, .descriptorType = vk::DescriptorType::eSampledImage, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},    // depth pyramid [i]
+		    vk::DescriptorSetLayoutBinding{.binding = 1, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // candidates [i]
+		    vk::DescriptorSetLayoutBinding{.binding = 2, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute},   // late draw commands [i]
+		    vk::DescriptorSetLayoutBinding{.binding = 3, .descriptorType = vk::DescriptorType::eStorageBuffer, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eCompute}};  // counters + visibility [i]
+		vk::DescriptorSetLayoutCreateInfo layoutInfo{
+		    .bindingCount = static_cast<uint32_t>(bindings.size()),
+		    .pBindings    = bindings.data()};
+		occlusionCullDescriptorSetLayout = vk::raii::DescriptorSetLayout(dev.logicalDevice, layoutInfo);
+	}
+}
+
 // ── Pipeline Layout Implementations ────────────────────────────────────────
 
 void PipelineCollection::createShadowPipelineLayout(const VulkanDevice &dev)
@@ -343,6 +575,15 @@ void PipelineCollection::createSkinningPipelineLayout(const VulkanDevice &dev)
 	skinningPipelineLayout = vk::raii::PipelineLayout(dev.logicalDevice, pipelineLayoutInfo);
 }
 
+void PipelineCollection::createLightCullingPipelineLayout(const VulkanDevice &dev)
+{
+	// Everything the culling pass needs (camera, lights, cluster lists) lives in the global set.
+	vk::PipelineLayoutCreateInfo pipelineLayoutInfo{
+	    .setLayoutCount = 1,
+	    .pSetLayouts    = &*descriptorSetLayoutGlobal};
+	lightCullingPipelineLayout = vk::raii::PipelineLayout(dev.logicalDevice, pipelineLayoutInfo);
+}
+
 void PipelineCollection::createPhysicsPipelineLayout(const VulkanDevice &dev)
 {
 	vk::PushConstantRange pushConstantRange{
@@ -376,12 +617,22 @@ void PipelineCollection::createRayTracingPipelineLayout(const VulkanDevice &dev)
 
 void PipelineCollection::createGraphicsPipeline(VulkanDevice &dev, vk::Format colorFormat, vk::Format depthFormat)
 {
-	vk::raii::ShaderModule shaderModule = createShaderModule(dev, readFile("Shaders/LaphriaEngine.slang.spv"));
+	graphicsColorFormat = colorFormat;
+	graphicsDepthFormat = depthFormat;
+
+	vk::raii::ShaderModule     shaderModule = createShaderModule(dev, readFile("Shaders/LaphriaEngine.slang.spv"));
+	const VulkanSpecialization specialization(specializationBlock);
 
 	vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
-	    .stage = vk::ShaderStageFlagBits::eVertex, .module = *shaderModule, .pName = "vertMain"};
+	    .stage               = vk::ShaderStageFlagBits::eVertex,
+	    .module              = *shaderModule,
+	    .pName               = "vertMain",
+	    .pSpecializationInfo = &specialization.info};
 	vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
-	    .stage = vk::ShaderStageFlagBits::eFragment, .module = *shaderModule, .pName = "fragMain"};
+	    .stage               = vk::ShaderStageFlagBits::eFragment,
+	    .module              = *shaderModule,
+	    .pName               = "fragMain",
+	    .pSpecializationInfo = &specialization.info};
 	vk::PipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
 	auto                                   bindingDescription    = Vertex::getBindingDescription();
@@ -429,7 +680,10 @@ void PipelineCollection::createGraphicsPipeline(VulkanDevice &dev, vk::Format co
 	    .dynamicStateCount = static_cast<uint32_t>(dynamicStates.size()),
 	    .pDynamicStates    = dynamicStates.data()};
 
-	createGraphicsPipelineLayout(dev);
+	if (!*graphicsPipelineLayout)
+	{
+		createGraphicsPipelineLayout(dev);
+	}
 
 	vk::PipelineRenderingCreateInfo pipelineRenderingCreateInfo{
 	    .colorAttachmentCount    = 1,
@@ -449,7 +703,7 @@ void PipelineCollection::createGraphicsPipeline(VulkanDevice &dev, vk::Format co
 	    .pDynamicState       = &dynamicState,
 	    .layout              = *graphicsPipelineLayout,
 	    .renderPass          = nullptr};
-	graphicsPipeline = vk::raii::Pipeline(dev.logicalDevice, nullptr, pipelineInfo);
+	graphicsPipeline = vk::raii::Pipeline(dev.logicalDevice, pipelineCache, pipelineInfo);
 }
 
 void PipelineCollection::createShadowPipeline(VulkanDevice &dev)
@@ -537,7 +791,7 @@ void PipelineCollection::createShadowPipeline(VulkanDevice &dev)
 	    .pDynamicState       = &dynamicState,
 	    .layout              = *shadowPipelineLayout,
 	    .renderPass          = nullptr};
-	shadowPipeline = vk::raii::Pipeline(dev.logicalDevice, nullptr, pipelineInfo);
+	shadowPipeline = vk::raii::Pipeline(dev.logicalDevice, pipelineCache, pipelineInfo);
 }
 
 void PipelineCollection::createComputePipeline(const VulkanDevice &dev)
@@ -554,7 +808,7 @@ void PipelineCollection::createComputePipeline(const VulkanDevice &dev)
 	vk::ComputePipelineCreateInfo pipelineInfo{
 	    .stage  = computeShaderStageInfo,
 	    .layout = *computePipelineLayout};
-	computePipeline = vk::raii::Pipeline(dev.logicalDevice, nullptr, pipelineInfo);
+	computePipeline = vk::raii::Pipeline(dev.logicalDevice, pipelineCache, pipelineInfo);
 }
 
 void PipelineCollection::createSkinningPipeline(const VulkanDevice &dev)
@@ -569,7 +823,22 @@ void PipelineCollection::createSkinningPipeline(const VulkanDevice &dev)
 	vk::ComputePipelineCreateInfo pipelineInfo{
 	    .stage  = computeShaderStageInfo,
 	    .layout = *skinningPipelineLayout};
-	skinningPipeline = vk::raii::Pipeline(dev.logicalDevice, nullptr, pipelineInfo);
+	skinningPipeline = vk::raii::Pipeline(dev.logicalDevice, pipelineCache, pipelineInfo);
+}
+
+void PipelineCollection::createLightCullingPipeline(const VulkanDevice &dev)
+{
+	createLightCullingPipelineLayout(dev);
+
+	vk::raii::ShaderModule            shaderModule = createShaderModule(dev, readFile("Shaders/LightCulling.slang.spv"));
+	vk::PipelineShaderStageCreateInfo computeShaderStageInfo{
+	    .stage  = vk::ShaderStageFlagBits::eCompute,
+	    .module = *shaderModule,
+	    .pName  = "lightCullingMain"};
+	vk::ComputePipelineCreateInfo pipelineInfo{
+	    .stage  = computeShaderStageInfo,
+	    .layout = *lightCullingPipelineLayout};
+	lightCullingPipeline = vk::raii::Pipeline(dev.logicalDevice, pipelineCache, pipelineInfo);
 }
 
 void PipelineCollection::createPhysicsPipeline(const VulkanDevice &dev)
@@ -584,7 +853,7 @@ void PipelineCollection::createPhysicsPipeline(const VulkanDevice &dev)
 	vk::ComputePipelineCreateInfo pipelineInfo{
 	    .stage  = computeShaderStageInfo,
 	    .layout = *physicsPipelineLayout};
-	physicsPipeline = vk::raii::Pipeline(dev.logicalDevice, nullptr, pipelineInfo);
+	physicsPipeline = vk::raii::Pipeline(dev.logicalDevice, pipelineCache, pipelineInfo);
 }
 
 void PipelineCollection::createRayTracingPipeline(const VulkanDevice &dev)
@@ -593,26 +862,44 @@ void PipelineCollection::createRayTracingPipeline(const VulkanDevice &dev)
 	vk::raii::ShaderModule rmissModule = createShaderModule(dev, readFile("Shaders/Miss.slang.spv"));
 	vk::raii::ShaderModule rchitModule = createShaderModule(dev, readFile("Shaders/ClosestHit.slang.spv"));
 	vk::raii::ShaderModule ranyModule  = createShaderModule(dev, readFile("Shaders/AnyHit.slang.spv"));
+	vk::raii::ShaderModule smissModule = createShaderModule(dev, readFile("Shaders/ShadowMiss.slang.spv"));
+	vk::raii::ShaderModule sanyModule  = createShaderModule(dev, readFile("Shaders/ShadowAnyHit.slang.spv"));
+	const VulkanSpecialization specialization(specializationBlock);
 
-	std::array<vk::PipelineShaderStageCreateInfo, 4> stages = {
+	std::array<vk::PipelineShaderStageCreateInfo, 6> stages = {
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eRaygenKHR,
-	        .module = *rgenModule,
-	        .pName  = "main"},
+	        .stage               = vk::ShaderStageFlagBits::eRaygenKHR,
+	        .module              = *rgenModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eMissKHR,
-	        .module = *rmissModule,
-	        .pName  = "main"},
+	        .stage               = vk::ShaderStageFlagBits::eMissKHR,
+	        .module              = *rmissModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eClosestHitKHR,
-	        .module = *rchitModule,
-	        .pName  = "main"},
+	        .stage               = vk::ShaderStageFlagBits::eClosestHitKHR,
+	        .module              = *rchitModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eAnyHitKHR,
-	        .module = *ranyModule,
-	        .pName  = "main"}};
+	        .stage               = vk::ShaderStageFlagBits::eAnyHitKHR,
+	        .module              = *ranyModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
+	    vk::PipelineShaderStageCreateInfo{
+	        .stage               = vk::ShaderStageFlagBits::eMissKHR,
+	        .module              = *smissModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
+	    vk::PipelineShaderStageCreateInfo{
+	        .stage               = vk::ShaderStageFlagBits::eAnyHitKHR,
+	        .module              = *sanyModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info}};
 
-	std::array<vk::RayTracingShaderGroupCreateInfoKHR, 3> groups = {
+	// Miss and hit groups are laid out [surface, shadow]; shadow rays trace with miss index 1 and hit group offset 1.
+	std::array<vk::RayTracingShaderGroupCreateInfoKHR, 5> groups = {
 	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 0 - RayGen
 	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eGeneral,
 	                                           .generalShader      = 0,
@@ -625,14 +912,30 @@ void PipelineCollection::createRayTracingPipeline(const VulkanDevice &dev)
 	                                           .closestHitShader   = VK_SHADER_UNUSED_KHR,
 	                                           .anyHitShader       = VK_SHADER_UNUSED_KHR,
 	                                           .intersectionShader = VK_SHADER_UNUSED_KHR},
-	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 2 - Closest Hit + Any Hit
+	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 2 - Shadow Miss
+	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eGeneral,
+	                                           .generalShader      = 4,
+	                                           .closestHitShader   = VK_SHADER_UNUSED_KHR,
+	                                           .anyHitShader       = VK_SHADER_UNUSED_KHR,
+	                                           .intersectionShader = VK_SHADER_UNUSED_KHR},
+	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 3 - Closest Hit + Any Hit
 	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eTrianglesHitGroup,
 	                                           .generalShader      = VK_SHADER_UNUSED_KHR,
 	                                           .closestHitShader   = 2,
 	                                           .anyHitShader       = 3,
+	                                           .intersectionShader = VK_SHADER_UNUSED_KHR},
+	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 4 - Shadow: alpha-test Any Hit only
+	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eTrianglesHitGroup,
+	                                           .generalShader      = VK_SHADER_UNUSED_KHR,
+	                                           .closestHitShader   = VK_SHADER_UNUSED_KHR,
+	                                           .anyHitShader       = 5,
 	                                           .intersectionShader = VK_SHADER_UNUSED_KHR}};
 
-	createRayTracingPipelineLayout(dev);
+	// Kept across permutation rebuilds: the classic RT pipeline shares it.
+	if (!*rayTracingPipelineLayout)
+	{
+		createRayTracingPipelineLayout(dev);
+	}
 
 	vk::RayTracingPipelineCreateInfoKHR pipelineInfo{
 	    .stageCount                   = static_cast<uint32_t>(stages.size()),
@@ -642,7 +945,7 @@ void PipelineCollection::createRayTracingPipeline(const VulkanDevice &dev)
 	    .maxPipelineRayRecursionDepth = 1,
 	    .layout                       = *rayTracingPipelineLayout};
 
-	rayTracingPipeline = dev.logicalDevice.createRayTracingPipelineKHR(nullptr, nullptr, pipelineInfo);
+	rayTracingPipeline = dev.logicalDevice.createRayTracingPipelineKHR(nullptr, pipelineCache, pipelineInfo);
 }
 
 void PipelineCollection::createShaderBindingTable(const VulkanDevice &dev)
@@ -654,14 +957,15 @@ void PipelineCollection::createShaderBindingTable(const VulkanDevice &dev)
 	const uint32_t handleSizeAligned = VulkanUtils::alignUp(handleSize, handleAlignment);
 
 	const uint32_t raygenSBTSize = VulkanUtils::alignUp(handleSizeAligned, baseAlignment);
-	const uint32_t missSBTSize   = VulkanUtils::alignUp(handleSizeAligned, baseAlignment);
-	const uint32_t hitSBTSize    = VulkanUtils::alignUp(handleSizeAligned, baseAlignment);
+	const uint32_t missSBTSize   = VulkanUtils::alignUp(2 * handleSizeAligned, baseAlignment);
+	const uint32_t hitSBTSize    = VulkanUtils::alignUp(2 * handleSizeAligned, baseAlignment);
 
-	constexpr uint32_t   groupCount = 3;
+	constexpr uint32_t   groupCount = 5;
 	const uint32_t       sbtSize    = groupCount * handleSize;
 	std::vector<uint8_t> handles    = rayTracingPipeline.getRayTracingShaderGroupHandlesKHR<uint8_t>(0, groupCount, sbtSize);
 
-	auto createSBTBuffer = [&](VulkanUtils::VmaBuffer &buffer, uint32_t size, void *data, uint32_t handleOffset) {
+	// Copies handleCount consecutive group handles into records spaced handleSizeAligned apart.
+	auto createSBTBuffer = [&](VulkanUtils::VmaBuffer &buffer, uint32_t size, void *data, uint32_t firstGroup, uint32_t handleCount) {
 		VulkanUtils::createBuffer(
 		    dev.logicalDevice, dev.physicalDevice, size,
 		    vk::BufferUsageFlagBits::eShaderBindingTableKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress,
@@ -669,13 +973,16 @@ void PipelineCollection::createShaderBindingTable(const VulkanDevice &dev)
 		    buffer);
 
 		void *mapped = buffer.memory.mapMemory(0, size);
-		memcpy(mapped, static_cast<uint8_t *>(data) + handleOffset, handleSize);
+		for (uint32_t i = 0; i < handleCount; ++i)
+		{
+			memcpy(static_cast<uint8_t *>(mapped) + i * handleSizeAligned, static_cast<uint8_t *>(data) + (firstGroup + i) * handleSize, handleSize);
+		}
 		buffer.memory.unmapMemory();
 	};
 
-	createSBTBuffer(raygenSBTBuffer, raygenSBTSize, handles.data(), 0);
-	createSBTBuffer(missSBTBuffer, missSBTSize, handles.data(), handleSize);
-	createSBTBuffer(hitSBTBuffer, hitSBTSize, handles.data(), handleSize * 2);
+	createSBTBuffer(raygenSBTBuffer, raygenSBTSize, handles.data(), 0, 1);
+	createSBTBuffer(missSBTBuffer, missSBTSize, handles.data(), 1, 2);
+	createSBTBuffer(hitSBTBuffer, hitSBTSize, handles.data(), 3, 2);
 
 	vk::BufferDeviceAddressInfo raygenInfo{.buffer = *raygenSBTBuffer};
 	raygenRegion.deviceAddress = dev.logicalDevice.getBufferAddress(raygenInfo);
@@ -701,26 +1008,44 @@ void PipelineCollection::createClassicRTPipeline(const VulkanDevice &dev)
 	vk::raii::ShaderModule rmissModule = createShaderModule(dev, readFile("Shaders/RT_Miss.slang.spv"));
 	vk::raii::ShaderModule rchitModule = createShaderModule(dev, readFile("Shaders/RT_ClosestHit.slang.spv"));
 	vk::raii::ShaderModule ranyModule  = createShaderModule(dev, readFile("Shaders/RT_AnyHit.slang.spv"));
+	vk::raii::ShaderModule smissModule = createShaderModule(dev, readFile("Shaders/ShadowMiss.slang.spv"));
+	vk::raii::ShaderModule sanyModule  = createShaderModule(dev, readFile("Shaders/ShadowAnyHit.slang.spv"));
+	const VulkanSpecialization specialization(specializationBlock);
 
-	std::array<vk::PipelineShaderStageCreateInfo, 4> stages = {
+	std::array<vk::PipelineShaderStageCreateInfo, 6> stages = {
+	    vk::PipelineShaderStageCreateInfo{
+	        .stage               = vk::ShaderStageFlagBits::eRaygenKHR,
+	        .module              = *rgenModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eRaygenKHR,
-	        .module = *rgenModule,
-	        .pName  = "main"},
+	        .stage               = vk::ShaderStageFlagBits::eMissKHR,
+	        .module              = *rmissModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eMissKHR,
-	        .module = *rmissModule,
-	        .pName  = "main"},
+	        .stage               = vk::ShaderStageFlagBits::eClosestHitKHR,
+	        .module              = *rchitModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eClosestHitKHR,
-	        .module = *rchitModule,
-	        .pName  = "main"},
+	        .stage               = vk::ShaderStageFlagBits::eAnyHitKHR,
+	        .module              = *ranyModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
 	    vk::PipelineShaderStageCreateInfo{
-	        .stage  = vk::ShaderStageFlagBits::eAnyHitKHR,
-	        .module = *ranyModule,
-	        .pName  = "main"}};
+	        .stage               = vk::ShaderStageFlagBits::eMissKHR,
+	        .module              = *smissModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info},
+	    vk::PipelineShaderStageCreateInfo{
+	        .stage               = vk::ShaderStageFlagBits::eAnyHitKHR,
+	        .module              = *sanyModule,
+	        .pName               = "main",
+	        .pSpecializationInfo = &specialization.info}};
 
-	std::array<vk::RayTracingShaderGroupCreateInfoKHR, 3> groups = {
+	// Miss and hit groups are laid out [surface, shadow]; shadow rays trace with miss index 1 and hit group offset 1.
+	std::array<vk::RayTracingShaderGroupCreateInfoKHR, 5> groups = {
 	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 0 - RayGen
 	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eGeneral,
 	                                           .generalShader      = 0,
@@ -733,11 +1058,23 @@ void PipelineCollection::createClassicRTPipeline(const VulkanDevice &dev)
 	                                           .closestHitShader   = VK_SHADER_UNUSED_KHR,
 	                                           .anyHitShader       = VK_SHADER_UNUSED_KHR,
 	                                           .intersectionShader = VK_SHADER_UNUSED_KHR},
-	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 2 - Closest Hit + Any Hit
+	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 2 - Shadow Miss
+	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eGeneral,
+	                                           .generalShader      = 4,
+	                                           .closestHitShader   = VK_SHADER_UNUSED_KHR,
+	                                           .anyHitShader       = VK_SHADER_UNUSED_KHR,
+	                                           .intersectionShader = VK_SHADER_UNUSED_KHR},
+	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 3 - Closest Hit + Any Hit
 	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eTrianglesHitGroup,
 	                                           .generalShader      = VK_SHADER_UNUSED_KHR,
 	                                           .closestHitShader   = 2,
 	                                           .anyHitShader       = 3,
+	                                           .intersectionShader = VK_SHADER_UNUSED_KHR},
+	    vk::RayTracingShaderGroupCreateInfoKHR{// Group 4 - Shadow: alpha-test Any Hit only
+	                                           .type               = vk::RayTracingShaderGroupTypeKHR::eTrianglesHitGroup,
+	                                           .generalShader      = VK_SHADER_UNUSED_KHR,
+	                                           .closestHitShader   = VK_SHADER_UNUSED_KHR,
+	                                           .anyHitShader       = 5,
 	                                           .intersectionShader = VK_SHADER_UNUSED_KHR}};
 
 	vk::RayTracingPipelineCreateInfoKHR pipelineInfo{
@@ -748,7 +1085,7 @@ void PipelineCollection::createClassicRTPipeline(const VulkanDevice &dev)
 	    .maxPipelineRayRecursionDepth = 2,   // Primary ray + one shadow ray from ClosestHit
 	    .layout                       = *rayTracingPipelineLayout};
 
-	classicRTPipeline = dev.logicalDevice.createRayTracingPipelineKHR(nullptr, nullptr, pipelineInfo);
+	classicRTPipeline = dev.logicalDevice.createRayTracingPipelineKHR(nullptr, pipelineCache, pipelineInfo);
 }
 
 void PipelineCollection::createClassicRTShaderBindingTable(const VulkanDevice &dev)
@@ -759,14 +1096,15 @@ void PipelineCollection::createClassicRTShaderBindingTable(const VulkanDevice &d
 
 	const uint32_t handleSizeAligned = VulkanUtils::alignUp(handleSize, handleAlignment);
 	const uint32_t raygenSBTSize     = VulkanUtils::alignUp(handleSizeAligned, baseAlignment);
-	const uint32_t missSBTSize       = VulkanUtils::alignUp(handleSizeAligned, baseAlignment);
-	const uint32_t hitSBTSize        = VulkanUtils::alignUp(handleSizeAligned, baseAlignment);
+	const uint32_t missSBTSize       = VulkanUtils::alignUp(2 * handleSizeAligned, baseAlignment);
+	const uint32_t hitSBTSize        = VulkanUtils::alignUp(2 * handleSizeAligned, baseAlignment);
 
-	constexpr uint32_t   groupCount = 3;
+	constexpr uint32_t   groupCount = 5;
 	const uint32_t       sbtSize    = groupCount * handleSize;
 	std::vector<uint8_t> handles    = classicRTPipeline.getRayTracingShaderGroupHandlesKHR<uint8_t>(0, groupCount, sbtSize);
 
-	auto createSBTBuffer = [&](VulkanUtils::VmaBuffer &buffer, uint32_t size, void *data, uint32_t handleOffset) {
+	// Copies handleCount consecutive group handles into records spaced handleSizeAligned apart.
+	auto createSBTBuffer = [&](VulkanUtils::VmaBuffer &buffer, uint32_t size, void *data, uint32_t firstGroup, uint32_t handleCount) {
 		VulkanUtils::createBuffer(
 		    dev.logicalDevice, dev.physicalDevice, size,
 		    vk::BufferUsageFlagBits::eShaderBindingTableKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress,
@@ -774,13 +1112,16 @@ void PipelineCollection::createClassicRTShaderBindingTable(const VulkanDevice &d
 		    buffer);
 
 		void *mapped = buffer.memory.mapMemory(0, size);
-		memcpy(mapped, static_cast<uint8_t *>(data) + handleOffset, handleSize);
+		for (uint32_t i = 0; i < handleCount; ++i)
+		{
+			memcpy(static_cast<uint8_t *>(mapped) + i * handleSizeAligned, static_cast<uint8_t *>(data) + (firstGroup + i) * handleSize, handleSize);
+		}
 		buffer.memory.unmapMemory();
 	};
 
-	createSBTBuffer(classicRTRaygenSBTBuffer, raygenSBTSize, handles.data(), 0);
-	createSBTBuffer(classicRTMissSBTBuffer,   missSBTSize,   handles.data(), handleSize);
-	createSBTBuffer(classicRTHitSBTBuffer,    hitSBTSize,    handles.data(), handleSize * 2);
+	createSBTBuffer(classicRTRaygenSBTBuffer, raygenSBTSize, handles.data(), 0, 1);
+	createSBTBuffer(classicRTMissSBTBuffer,   missSBTSize,   handles.data(), 1, 2);
+	createSBTBuffer(classicRTHitSBTBuffer,    hitSBTSize,    handles.data(), 3, 2);
 
 	vk::BufferDeviceAddressInfo raygenInfo{.buffer = *classicRTRaygenSBTBuffer};
 	classicRTRaygenRegion.deviceAddress = dev.logicalDevice.getBufferAddress(raygenInfo);
@@ -814,29 +1155,164 @@ void PipelineCollection::createDenoiserPipelineLayout(const VulkanDevice &dev)
 
 void PipelineCollection::createDenoiserPipelines(const VulkanDevice &dev)
 {
-	createDenoiserPipelineLayout(dev);
-
-	// Reprojection compute pipeline
+	if (!*denoiserPipelineLayout)
 	{
-		vk::raii::ShaderModule mod = createShaderModule(dev, readFile("Shaders/Reprojection.slang.spv"));
+		createDenoiserPipelineLayout(dev);
+	}
+	const VulkanSpecialization specialization(specializationBlock);
+
+	auto createComputePipeline = [&](const vk::raii::ShaderModule &mod, const char *entryPoint) {
 		vk::PipelineShaderStageCreateInfo stage{
-		    .stage  = vk::ShaderStageFlagBits::eCompute,
-		    .module = *mod,
-		    .pName  = "reprojectionMain"};
+		    .stage               = vk::ShaderStageFlagBits::eCompute,
+		    .module              = *mod,
+		    .pName               = entryPoint,
+		    .pSpecializationInfo = &specialization.info};
 		vk::ComputePipelineCreateInfo info{.stage = stage, .layout = *denoiserPipelineLayout};
-		reprojectionPipeline = vk::raii::Pipeline(dev.logicalDevice, nullptr, info);
+		return vk::raii::Pipeline(dev.logicalDevice, pipelineCache, info);
+	};
+
+	// The A-Trous images' storage format is declared in the shaders, so the fallback format has its own build.
+	const bool atrousRgba16 = dev.findAtrousFormat() == vk::Format::eR16G16B16A16Sfloat;
+
+	// Reprojection compute pipelines: standalone, and fused with the first A-Trous iteration
+	{
+		vk::raii::ShaderModule mod = createShaderModule(dev, readFile(atrousRgba16 ? "Shaders/ReprojectionRgba16.slang.spv" : "Shaders/Reprojection.slang.spv"));
+		reprojectionPipeline       = createComputePipeline(mod, "reprojectionMain");
+		reprojectionAtrousPipeline = createComputePipeline(mod, "reprojectionAtrousMain");
+	}
+
+	// A-Trous spatial filter compute pipelines: per-pixel, and tiled through groupshared memory
+	{
+		vk::raii::ShaderModule mod = createShaderModule(dev, readFile(atrousRgba16 ? "Shaders/DenoiserRgba16.slang.spv" : "Shaders/Denoiser.slang.spv"));
+		atrousPipeline      = createComputePipeline(mod, "atrousMain");
+		atrousTiledPipeline = createComputePipeline(mod, "atrousTiledMain");
+	}
+
+	// Per-pixel path budget, computed from the previous frame's history before traceRays
+	{
+		vk::raii::ShaderModule mod = createShaderModule(dev, readFile("Shaders/SampleBudget.slang.spv"));
+		sampleBudgetPipeline = createComputePipeline(mod, "sampleBudgetMain");
+	}
+
+	// Progressive reference accumulation, replacing reprojection and A-Trous while it is enabled
+	{
+		vk::raii::ShaderModule mod = createShaderModule(dev, readFile("Shaders/ProgressiveAccumulate.slang.spv"));
+		progressiveAccumulatePipeline = createComputePipeline(mod, "progressiveAccumulateMain");
+	}
+}
+
+void PipelineCollection::createUpscalePipelineLayout(const VulkanDevice &dev)
+{
+	vk::PushConstantRange pushRange{
+	    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+	    .offset     = 0,
+	    .size       = sizeof(UpscalePushConstants)};
+	std::array                   layouts = {*upscaleDescriptorSetLayout, *descriptorSetLayoutGlobal};
+	vk::PipelineLayoutCreateInfo info{
+	    .setLayoutCount         = static_cast<uint32_t>(layouts.size()),
+	    .pSetLayouts            = layouts.data(),
+	    .pushConstantRangeCount = 1,
+	    .pPushConstantRanges    = &pushRange};
+	upscalePipelineLayout = vk::raii::PipelineLayout(dev.logicalDevice, info);
+}
+
+void PipelineCollection::createUpscalePipeline(const VulkanDevice &dev)
+{
+	createUpscalePipelineLayout(dev);
+
+	vk::raii::ShaderModule            shaderModule = createShaderModule(dev, readFile("Shaders/TemporalUpscale.slang.spv"));
+	vk::PipelineShaderStageCreateInfo computeShaderStageInfo{
+	    .stage  = vk::ShaderStageFlagBits::eCompute,
+	    .module = *shaderModule,
+	    .pName  = "temporalUpscaleMain"};
+	vk::ComputePipelineCreateInfo pipelineInfo{
+	    .stage  = computeShaderStageInfo,
+	    .layout = *upscalePipelineLayout};
+	temporalUpscalePipeline = vk::raii::Pipeline(dev.logicalDevice, pipelineCache, pipelineInfo);
+}
+
+void PipelineCollection::createWavefrontPipelineLayout(const VulkanDevice &dev)
+{
+	vk::PushConstantRange pushRange{
+	    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+	    .offset     = 0,
+	    .size       = sizeof(WavefrontPushConstants)};
+	std::array                   layouts = {*rayTracingDescriptorSetLayout, *descriptorSetLayoutGlobal, *wavefrontDescriptorSetLayout};
+	vk::PipelineLayoutCreateInfo info{
+	    .setLayoutCount         = static_cast<uint32_t>(layouts.size()),
+	    .pSetLayouts            = layouts.data(),
+	    .pushConstantRangeCount = 1,
+	    .pPushConstantRanges    = &pushRange};
+	wavefrontPipelineLayout = vk::raii::PipelineLayout(dev.logicalDevice, info);
+}
+
+void PipelineCollection::createWavefrontPipelines(const VulkanDevice &dev)
+{
+	if (!*wavefrontPipelineLayout)
+	{
+		createWavefrontPipelineLayout(dev);
 	}
+	const VulkanSpecialization specialization(specializationBlock);
+
+	// One compute pipeline per kernel, in WavefrontKernel order.
+	constexpr std::array<const char *, Laphria::kWavefrontKernelCount> entryPoints = {
+	    "wavefrontPrimaryMain", "wavefrontGenerateMain", "wavefrontExtendMain", "wavefrontBinMain",
+	    "wavefrontScatterMain", "wavefrontShadeMain", "wavefrontShadowMain", "wavefrontResolveMain"};
 
-	// A-Trous spatial filter compute pipeline
+	vk::raii::ShaderModule mod = createShaderModule(dev, readFile("Shaders/WavefrontPathTracer.slang.spv"));
+	wavefrontPipelines.clear();
+	for (const char *entryPoint : entryPoints)
 	{
-		vk::raii::ShaderModule mod = createShaderModule(dev, readFile("Shaders/Denoiser.slang.spv"));
+		vk::PipelineShaderStageCreateInfo stage{
+		    .stage               = vk::ShaderStageFlagBits::eCompute,
+		    .module              = *mod,
+		    .pName               = entryPoint,
+		    .pSpecializationInfo = &specialization.info};
+		vk::ComputePipelineCreateInfo info{.stage = stage, .layout = *wavefrontPipelineLayout};
+		wavefrontPipelines.emplace_back(dev.logicalDevice, pipelineCache, info);
+	}
+}
+
+void PipelineCollection::createOcclusionPipelineLayouts(const VulkanDevice &dev)
+{
+	vk::PushConstantRange reduceRange{
+	    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+	    .offset     = 0,
+	    .size       = sizeof(HiZReducePushConstants)};
+	vk::PipelineLayoutCreateInfo reduceInfo{
+	    .setLayoutCount         = 1,
+	    .pSetLayouts            = &*hiZReduceDescriptorSetLayout,
+	    .pushConstantRangeCount = 1,
+	    .pPushConstantRanges    = &reduceRange};
+	hiZReducePipelineLayout = vk::raii::PipelineLayout(dev.logicalDevice, reduceInfo);
+
+	vk::PushConstantRange cullRange{
+	    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+	    .offset     = 0,
+	    .size       = sizeof(OcclusionCullPushConstants)};
+	vk::PipelineLayoutCreateInfo cullInfo{
+	    .setLayoutCount         = 1,
+	    .pSetLayouts            = &*occlusionCullDescriptorSetLayout,
+	    .pushConstantRangeCount = 1,
+	    .pPushConstantRanges    = &cullRange};
+	occlusionCullPipelineLayout = vk::raii::PipelineLayout(dev.logicalDevice, cullInfo);
+}
+
+void PipelineCollection::createOcclusionCullingPipelines(const VulkanDevice &dev)
+{
+	createOcclusionPipelineLayouts(dev);
+
+	auto createComputePipeline = [&](const char *path, const char *entryPoint, const vk::raii::PipelineLayout &layout) {
+		vk::raii::ShaderModule            mod = createShaderModule(dev, readFile(path));
 		vk::PipelineShaderStageCreateInfo stage{
 		    .stage  = vk::ShaderStageFlagBits::eCompute,
 		    .module = *mod,
-		    .pName  = "atrousMain"};
-		vk::ComputePipelineCreateInfo info{.stage = stage, .layout = *denoiserPipelineLayout};
-		atrousPipeline = vk::raii::Pipeline(dev.logicalDevice, nullptr, info);
-	}
+		    .pName  = entryPoint};
+		vk::ComputePipelineCreateInfo info{.stage = stage, .layout = *layout};
+		return vk::raii::Pipeline(dev.logicalDevice, pipelineCache, info);
+	};
+	hiZReducePipeline     = createComputePipeline("Shaders/HiZReduce.slang.spv", "hiZReduceMain", hiZReducePipelineLayout);
+	occlusionCullPipeline = createComputePipeline("Shaders/OcclusionCulling.slang.spv", "occlusionCullMain", occlusionCullPipelineLayout);
 }
 
 // ── Helpers ────────────────────────────────────────────────────────────────
@@ -5,8 +5,10 @@
 #include <vector>
 
 #include "EngineAuxiliary.h"
+#include "ShaderPermutation.h"
 #include "VulkanDevice.h"
 #include "VulkanUtils.h"
+#include "WavefrontSchedule.h"
 
 // Owns all descriptor set layouts, pipelines, and pipeline layouts.
 // Call createDescriptorSetLayouts() first, then each createXxxPipeline() in order.
@@ -15,18 +17,33 @@ class PipelineCollection
   public:
 	~PipelineCollection() = default;
 
+	// Pipeline cache every pipeline is created through, seeded from the previous run's file when the
+	// device matches it. savePipelineCache() writes it back; call it once the device is idle.
+	void createPipelineCache(const VulkanDevice &dev);
+	void savePipelineCache() const;
+
+	// Specialization constants baked into the permuted pipelines (Laphria::PermutedPipelines). Pipelines
+	// created afterwards use the new values; existing pipelines that read a changed constant are rebuilt,
+	// so the caller must make sure the GPU is no longer using them.
+	void setShaderPermutation(VulkanDevice &dev, const Laphria::ShaderPermutation &permutation);
+	[[nodiscard]] const Laphria::ShaderPermutation &getShaderPermutation() const { return shaderPermutation; }
+
 	void createDescriptorSetLayouts(const VulkanDevice &dev);
 	void createGraphicsPipeline(VulkanDevice &dev, vk::Format colorFormat, vk::Format depthFormat);
 	void createShadowPipeline(VulkanDevice &dev);
 
 	void createComputePipeline(const VulkanDevice &dev);
 	void createSkinningPipeline(const VulkanDevice &dev);
+	void createLightCullingPipeline(const VulkanDevice &dev);
 	void createPhysicsPipeline(const VulkanDevice &dev);
 	void createRayTracingPipeline(const VulkanDevice &dev);
 	void createShaderBindingTable(const VulkanDevice &dev);
 	void createDenoiserPipelines(const VulkanDevice &dev);
 	void createClassicRTPipeline(const VulkanDevice &dev);
 	void createClassicRTShaderBindingTable(const VulkanDevice &dev);
+	void createUpscalePipeline(const VulkanDevice &dev);
+	void createWavefrontPipelines(const VulkanDevice &dev);
+	void createOcclusionCullingPipelines(const VulkanDevice &dev);
 
 	// ── Descriptor Set Layouts ────────────────────────────────────────────
 	vk::raii::DescriptorSetLayout descriptorSetLayoutGlobal{nullptr};
@@ -36,30 +53,59 @@ class PipelineCollection
 	vk::raii::DescriptorSetLayout physicsDescriptorSetLayout{nullptr};
 	vk::raii::DescriptorSetLayout rayTracingDescriptorSetLayout{nullptr};
 	vk::raii::DescriptorSetLayout denoiserDescriptorSetLayout{nullptr};
+	vk::raii::DescriptorSetLayout upscaleDescriptorSetLayout{nullptr};
+	vk::raii::DescriptorSetLayout wavefrontDescriptorSetLayout{nullptr};
+	vk::raii::DescriptorSetLayout hiZReduceDescriptorSetLayout{nullptr};
+	vk::raii::DescriptorSetLayout occlusionCullDescriptorSetLayout{nullptr};
+
+	// ── Pipeline Cache ────────────────────────────────────────────────────
+	vk::raii::PipelineCache pipelineCache{nullptr};
 
 	// ── Pipelines ─────────────────────────────────────────────────────────
 	vk::raii::Pipeline graphicsPipeline{nullptr};
 	vk::raii::Pipeline shadowPipeline{nullptr};
 	vk::raii::Pipeline computePipeline{nullptr};
 	vk::raii::Pipeline skinningPipeline{nullptr};
+	vk::raii::Pipeline lightCullingPipeline{nullptr};        // raster path: punctual lights → cluster lists
 	vk::raii::Pipeline physicsPipeline{nullptr};
 
 	vk::raii::Pipeline rayTracingPipeline{nullptr};   // path tracer
 	vk::raii::Pipeline classicRTPipeline{nullptr};    // classic ray tracer (direct illumination)
 
-	// Denoiser: two compute pipelines (temporal reprojection + spatial A-Trous).
+	// Denoiser: temporal reprojection + spatial A-Trous, plus the tiled variants (reprojection fused with
+	// the first A-Trous iteration, then A-Trous through groupshared tiles). The adaptive sampling budget
+	// and progressive accumulation passes share their layout.
 	vk::raii::Pipeline reprojectionPipeline{nullptr};
 	vk::raii::Pipeline atrousPipeline{nullptr};
+	vk::raii::Pipeline reprojectionAtrousPipeline{nullptr};
+	vk::raii::Pipeline atrousTiledPipeline{nullptr};
+	vk::raii::Pipeline sampleBudgetPipeline{nullptr};
+	vk::raii::Pipeline progressiveAccumulatePipeline{nullptr};
+
+	// Temporal upscaler: raster and classic RT at a reduced render extent → native resolution
+	vk::raii::Pipeline temporalUpscalePipeline{nullptr};
+
+	// Wavefront path tracer: one compute kernel per stage, indexed by Laphria::WavefrontKernel
+	std::vector<vk::raii::Pipeline> wavefrontPipelines;
+
+	// Raster occlusion culling: depth → max-depth pyramid, then the mesh instance test against it
+	vk::raii::Pipeline hiZReducePipeline{nullptr};
+	vk::raii::Pipeline occlusionCullPipeline{nullptr};
 
 	// ── Pipeline Layouts ──────────────────────────────────────────────────
 	vk::raii::PipelineLayout graphicsPipelineLayout{nullptr};
 	vk::raii::PipelineLayout shadowPipelineLayout{nullptr};
 	vk::raii::PipelineLayout computePipelineLayout{nullptr};
 	vk::raii::PipelineLayout skinningPipelineLayout{nullptr};
+	vk::raii::PipelineLayout lightCullingPipelineLayout{nullptr};
 	vk::raii::PipelineLayout physicsPipelineLayout{nullptr};
 
 	vk::raii::PipelineLayout rayTracingPipelineLayout{nullptr};
 	vk::raii::PipelineLayout denoiserPipelineLayout{nullptr};
+	vk::raii::PipelineLayout upscalePipelineLayout{nullptr};
+	vk::raii::PipelineLayout wavefrontPipelineLayout{nullptr};
+	vk::raii::PipelineLayout hiZReducePipelineLayout{nullptr};
+	vk::raii::PipelineLayout occlusionCullPipelineLayout{nullptr};
 
 	// ── Shader Binding Table (SBT) — Path Tracer ─────────────────────────
 	Laphria::VulkanUtils::VmaBuffer   raygenSBTBuffer{};
@@ -82,6 +128,12 @@ class PipelineCollection
 	vk::StridedDeviceAddressRegionKHR classicRTHitRegion{};
 
   private:
+	Laphria::ShaderPermutation   shaderPermutation{};
+	Laphria::SpecializationBlock specializationBlock = Laphria::buildSpecializationBlock(Laphria::ShaderPermutation{});
+	// Attachment formats of the main raster pipeline, kept so a permutation change can rebuild it.
+	vk::Format graphicsColorFormat = vk::Format::eUndefined;
+	vk::Format graphicsDepthFormat = vk::Format::eUndefined;
+
 	void createGlobalDescriptorSetLayout(const VulkanDevice &dev);
 	void createMaterialDescriptorSetLayout(const VulkanDevice &dev);
 	void createComputeDescriptorSetLayout(const VulkanDevice &dev);
@@ -90,10 +142,17 @@ class PipelineCollection
 	void createRayTracingDescriptorSetLayout(const VulkanDevice &dev);
 	void createDenoiserDescriptorSetLayout(const VulkanDevice &dev);
 	void createDenoiserPipelineLayout(const VulkanDevice &dev);
+	void createUpscaleDescriptorSetLayout(const VulkanDevice &dev);
+	void createUpscalePipelineLayout(const VulkanDevice &dev);
+	void createWavefrontDescriptorSetLayout(const VulkanDevice &dev);
+	void createWavefrontPipelineLayout(const VulkanDevice &dev);
+	void createOcclusionDescriptorSetLayouts(const VulkanDevice &dev);
+	void createOcclusionPipelineLayouts(const VulkanDevice &dev);
 	void createGraphicsPipelineLayout(const VulkanDevice &dev);
 	void createShadowPipelineLayout(const VulkanDevice &dev);
 	void createComputePipelineLayout(const VulkanDevice &dev);
 	void createSkinningPipelineLayout(const VulkanDevice &dev);
+	void createLightCullingPipelineLayout(const VulkanDevice &dev);
 	void createPhysicsPipelineLayout(const VulkanDevice &dev);
 	void createRayTracingPipelineLayout(const VulkanDevice &dev);
 
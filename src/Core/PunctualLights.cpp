@@ -0,0 +1,121 @@
+#include "PunctualLights.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Laphria
+{
+namespace
+{
+constexpr float kPi = 3.14159265359f;
+// Point and spot intensities are in candela, directional ones in lux. A directional light is weighted like a
+// point light that gives the same illuminance at this distance.
+constexpr float kDirectionalReferenceDistance = 10.0f;
+
+float luminance(const glm::vec3 &color)
+{
+	return glm::dot(color, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+}
+}        // namespace
+
+PunctualLightData makePunctualLightData(const PunctualLight &light, const glm::mat4 &worldFromLight)
+{
+	PunctualLightData data{};
+	data.position  = glm::vec3(worldFromLight * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+	data.direction = glm::vec3(worldFromLight * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f));
+	const float directionLength = glm::length(data.direction);
+	data.direction = directionLength > 1e-6f ? data.direction / directionLength : glm::vec3(0.0f, 0.0f, -1.0f);
+	data.range     = std::max(light.range, 0.0f);
+	data.type      = static_cast<uint32_t>(light.type);
+	data.intensity = light.color * std::max(light.intensity, 0.0f);
+
+	if (light.type == PunctualLightType::Spot)
+	{
+		// KHR_lights_punctual reference falloff, with the cone cosines folded into one multiply-add.
+		const float cosOuter = std::cos(light.outerConeAngle);
+		const float cosInner = std::cos(std::min(light.innerConeAngle, light.outerConeAngle));
+		data.spotScale       = 1.0f / std::max(cosInner - cosOuter, 1e-3f);
+		data.spotOffset      = -cosOuter * data.spotScale;
+	}
+	return data;
+}
+
+float punctualLightSelectionWeight(const PunctualLight &light)
+{
+	const float lum = luminance(light.color) * std::max(light.intensity, 0.0f);
+	switch (light.type)
+	{
+		case PunctualLightType::Spot:
+			return lum * 2.0f * kPi * (1.0f - std::cos(light.outerConeAngle));
+		case PunctualLightType::Directional:
+			return lum * 4.0f * kPi * kDirectionalReferenceDistance * kDirectionalReferenceDistance;
+		case PunctualLightType::Point:
+		default:
+			return lum * 4.0f * kPi;
+	}
+}
+
+void buildLightAliasTable(const std::vector<float> &weights, std::vector<PunctualLightData> &lights)
+{
+	const size_t count = lights.size();
+	if (count == 0)
+	{
+		return;
+	}
+
+	double total = 0.0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		total += (i < weights.size()) ? std::max(weights[i], 0.0f) : 0.0f;
+	}
+	auto weightOf = [&](size_t i) -> double {
+		if (total <= 0.0)
+		{
+			return 1.0;
+		}
+		return (i < weights.size()) ? std::max(weights[i], 0.0f) : 0.0f;
+	};
+	if (total <= 0.0)
+	{
+		total = static_cast<double>(count);
+	}
+
+	// Vose: slots under the average are topped up by one over it, so every slot holds at most two lights.
+	std::vector<double>   scaled(count);
+	std::vector<uint32_t> small;
+	std::vector<uint32_t> large;
+	small.reserve(count);
+	large.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		lights[i].selectionPdf = static_cast<float>(weightOf(i) / total);
+		scaled[i]              = weightOf(i) * static_cast<double>(count) / total;
+		(scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+	}
+
+	while (!small.empty() && !large.empty())
+	{
+		const uint32_t under = small.back();
+		small.pop_back();
+		const uint32_t over = large.back();
+		large.pop_back();
+
+		lights[under].aliasProbability = static_cast<float>(scaled[under]);
+		lights[under].aliasIndex       = over;
+		scaled[over]                   = (scaled[over] + scaled[under]) - 1.0;
+		(scaled[over] < 1.0 ? small : large).push_back(over);
+	}
+
+	// Whatever is left is exactly average up to rounding and keeps its own slot.
+	for (const uint32_t i : small)
+	{
+		lights[i].aliasProbability = 1.0f;
+		lights[i].aliasIndex       = i;
+	}
+	for (const uint32_t i : large)
+	{
+		lights[i].aliasProbability = 1.0f;
+		lights[i].aliasIndex       = i;
+	}
+}
+}        // namespace Laphria
@@ -0,0 +1,60 @@
+#ifndef LAPHRIAENGINE_PUNCTUALLIGHTS_H
+#define LAPHRIAENGINE_PUNCTUALLIGHTS_H
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Laphria
+{
+enum class PunctualLightType : uint32_t
+{
+	Point       = 0,
+	Spot        = 1,
+	Directional = 2
+};
+
+// One KHR_lights_punctual light as imported, in the space of the node that references it: at the origin,
+// pointing down -Z.
+struct PunctualLight
+{
+	PunctualLightType type = PunctualLightType::Point;
+	glm::vec3         color{1.0f};
+	float             intensity      = 1.0f;        // candela for point and spot lights, lux for directional
+	float             range          = 0.0f;        // <= 0: unlimited
+	float             innerConeAngle = 0.0f;
+	float             outerConeAngle = 0.7853981634f;        // glTF default, pi / 4
+};
+
+// World-space light as read by the shaders — must mirror PunctualLight in ShaderCommon.slang.
+// The last three fields are a Vose alias table over all lights of the frame (buildLightAliasTable): pick a
+// uniform slot i, keep it with probability aliasProbability, else take aliasIndex. selectionPdf is the
+// resulting probability of picking this light, so one sample per shading point costs the same for any count.
+struct PunctualLightData
+{
+	alignas(16) glm::vec3 position{0.0f};
+	alignas(4) float      range = 0.0f;
+	alignas(16) glm::vec3 direction{0.0f, 0.0f, -1.0f};        // the way the light points
+	alignas(4) uint32_t   type = static_cast<uint32_t>(PunctualLightType::Point);
+	alignas(16) glm::vec3 intensity{0.0f};                     // color * intensity
+	alignas(4) float      spotScale  = 0.0f;                   // spot falloff: saturate(cos * scale + offset)^2
+	alignas(4) float      spotOffset = 1.0f;
+	alignas(4) float      selectionPdf     = 0.0f;
+	alignas(4) float      aliasProbability = 1.0f;
+	alignas(4) uint32_t   aliasIndex       = 0;
+};
+static_assert(sizeof(PunctualLightData) == 64, "PunctualLightData must match the shader struct stride");
+
+// Places light in the world through worldFromLight (the referencing node's world transform).
+PunctualLightData makePunctualLightData(const PunctualLight &light, const glm::mat4 &worldFromLight);
+
+// Relative emitted power, used as the light's weight in the alias table.
+float punctualLightSelectionWeight(const PunctualLight &light);
+
+// Fills selectionPdf, aliasProbability and aliasIndex of every light from weights (one per light). When no
+// weight is positive every light is equally likely.
+void buildLightAliasTable(const std::vector<float> &weights, std::vector<PunctualLightData> &lights);
+}        // namespace Laphria
+
+#endif        // LAPHRIAENGINE_PUNCTUALLIGHTS_H
@@ -1,16 +1,22 @@
 #include "ResourceManager.h"
+#include "EngineConfig.h"
 #include "GltfImporter.h"
 #include "GpuResourceRegistry.h"
 #include "VulkanUtils.h"
 
 #include <fastgltf/types.hpp>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <ktx.h>
+#include <thread>
+#include <unordered_set>
 
 using namespace Laphria;
 using Laphria::LoadedMesh;
@@ -23,6 +29,9 @@ namespace
 static_assert(sizeof(Vertex) == 60, "Skinning shader expects Vertex stride of 60 bytes.");
 static_assert(sizeof(ModelResource::SkinningInfluence) == 48, "Skinning shader expects SkinningInfluence stride of 48 bytes.");
 
+constexpr size_t kMaxUploadBatchTextures = 16;
+constexpr size_t kMaxUploadBatchBytes = 256ull * 1024ull * 1024ull; // 256 MiB of staging per submit.
+
 enum class ImportTextureRole : uint8_t
 {
 	Color,
@@ -205,6 +214,63 @@ void buildSingleMipRgbaPayload(const unsigned char *pixels, uint32_t width, uint
 }
 }
 
+// CPU-side import state produced by prepareGltfModel(). Everything in here is built without touching
+// the Vulkan device, so several of these can be prepared concurrently on worker threads.
+struct ResourceManager::PreparedGltfModel {
+    std::string path;
+    GltfImporter::ParsedAsset parsedAsset;
+    std::unique_ptr<ModelResource> modelResource;
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<ModelResource::SkinningInfluence> skinningInfluences;
+    std::vector<int> nodeSkinIndices;
+    std::vector<VulkanUtils::TextureUploadPayload> texturePayloads;
+    SceneNode::Ptr rootNode;
+    ModelImportReport report;
+    TextureLoadStats textureStats;
+    double prepareMs = 0.0;
+    double commitMs = 0.0;
+    int modelId = -1;
+};
+
+// Single-time command buffer shared by several texture/buffer uploads. Submitted when it grows past
+// kMaxUploadBatchTextures/kMaxUploadBatchBytes, and once more when the import (or the whole prefetch batch) is done.
+struct ResourceManager::UploadBatch {
+    vk::raii::CommandBuffer commandBuffer{nullptr};
+    std::vector<vk::raii::Buffer> stagingBuffers;
+    std::vector<vk::raii::DeviceMemory> stagingMemories;
+    size_t recordedTextures = 0;
+    size_t recordedBytes = 0;
+
+    [[nodiscard]] GpuResourceRegistry::UploadBatchContext context() {
+        return GpuResourceRegistry::UploadBatchContext{
+            .commandBuffer = &commandBuffer,
+            .stagingBuffers = &stagingBuffers,
+            .stagingMemories = &stagingMemories};
+    }
+};
+
+struct ResourceManager::PendingGltfPrefetch {
+    std::vector<std::string> requestedPaths;        // de-duplicated, in request order
+    std::vector<std::string> preparePaths;          // subset that was not cached when the batch started
+    std::vector<std::promise<std::unique_ptr<PreparedGltfModel>>> promises;
+    std::vector<std::future<std::unique_ptr<PreparedGltfModel>>> futures;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextIndex{0};
+    size_t cachedCount = 0;
+    std::chrono::high_resolution_clock::time_point startTime;
+
+    ~PendingGltfPrefetch() {
+        // Abandoned batch: stop handing out work, then wait for in-progress imports.
+        nextIndex.store(preparePaths.size());
+        for (auto &worker: workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+};
+
 ResourceManager::ResourceManager(vk::raii::Device &device, vk::raii::PhysicalDevice &physicalDevice, vk::raii::CommandPool &commandPool, vk::raii::Queue &queue,
                                  vk::raii::DescriptorPool &descriptorPool) : device(device),
                                                                              physicalDevice(physicalDevice),
@@ -221,6 +287,10 @@ void ResourceManager::setSkinningDescriptorSetLayout(vk::DescriptorSetLayout lay
     gpuResourceRegistry->setSkinningDescriptorSetLayout(layout);
 }
 
+void ResourceManager::setRayTracingEnabled(bool enabled) const {
+    gpuResourceRegistry->setRayTracingEnabled(enabled);
+}
+
 void ResourceManager::setTextureColorSpaceModel(TextureColorSpaceModel model) {
     if (textureColorSpaceModel == model) {
         return;
@@ -363,51 +433,41 @@ bool ResourceManager::prepareKTXFromMemory(const unsigned char *data, size_t len
     return true;
 }
 
-void ResourceManager::loadTextures(const fastgltf::Asset &gltf, const std::filesystem::path &modelDir, ModelResource *modelRes, TextureLoadStats &stats) const {
+void ResourceManager::beginUploadBatch(UploadBatch &batch) const {
+    batch.commandBuffer = VulkanUtils::beginSingleTimeCommands(device, commandPool);
+    batch.recordedTextures = 0;
+    batch.recordedBytes = 0;
+}
+
+double ResourceManager::submitUploadBatch(UploadBatch &batch, bool reopen) const {
+    double submitMs = 0.0;
+    if (*batch.commandBuffer && (batch.recordedBytes > 0 || !batch.stagingBuffers.empty())) {
+        const auto submitStart = std::chrono::high_resolution_clock::now();
+        VulkanUtils::endSingleTimeCommands(device, queue, commandPool, batch.commandBuffer);
+        const auto submitEnd = std::chrono::high_resolution_clock::now();
+        submitMs = std::chrono::duration<double, std::milli>(submitEnd - submitStart).count();
+    }
+    batch.commandBuffer = vk::raii::CommandBuffer{nullptr};
+    batch.stagingBuffers.clear();
+    batch.stagingMemories.clear();
+    batch.recordedTextures = 0;
+    batch.recordedBytes = 0;
+    if (reopen) {
+        beginUploadBatch(batch);
+    }
+    return submitMs;
+}
+
+std::vector<VulkanUtils::TextureUploadPayload> ResourceManager::decodeTextures(const fastgltf::Asset &gltf, const std::filesystem::path &modelDir,
+                                                                             TextureLoadStats &stats) const {
     const auto textureSources = gltfImporter->buildTextureImportSources(gltf, modelDir);
+    std::vector<VulkanUtils::TextureUploadPayload> payloads;
     if (textureSources.empty()) {
-        return;
+        return payloads;
     }
     const auto textureRoles = buildTextureRoles(gltf, stats.mixedUsageCount);
     LOGI("Texture import: %zu image(s) detected", textureSources.size());
-
-    modelRes->textureImages.reserve(textureSources.size());
-    modelRes->textureImageViews.reserve(textureSources.size());
-    modelRes->textureSamplers.reserve(textureSources.size());
-
-    constexpr size_t maxBatchTextures = 16;
-    constexpr size_t maxBatchBytes = 256ull * 1024ull * 1024ull; // 256 MiB of staging per submit.
-
-    vk::raii::CommandBuffer uploadCommandBuffer{nullptr};
-    std::vector<vk::raii::Buffer> stagingBuffers;
-    std::vector<vk::raii::DeviceMemory> stagingMemories;
-    stagingBuffers.reserve(maxBatchTextures);
-    stagingMemories.reserve(maxBatchTextures);
-    size_t batchTextureCount = 0;
-    size_t batchBytes = 0;
-    size_t submittedTextureCount = 0;
-
-    auto beginBatch = [&]() {
-        uploadCommandBuffer = VulkanUtils::beginSingleTimeCommands(device, commandPool);
-    };
-    auto flushBatch = [&]() {
-        if (batchTextureCount == 0) {
-            return;
-        }
-        const auto uploadSubmitStart = std::chrono::high_resolution_clock::now();
-        VulkanUtils::endSingleTimeCommands(device, queue, commandPool, uploadCommandBuffer);
-        const auto uploadSubmitEnd = std::chrono::high_resolution_clock::now();
-        stats.uploadMs += std::chrono::duration<double, std::milli>(uploadSubmitEnd - uploadSubmitStart).count();
-
-        submittedTextureCount += batchTextureCount;
-        LOGI("Texture upload progress: %zu/%zu textures submitted", submittedTextureCount, textureSources.size());
-
-        stagingBuffers.clear();
-        stagingMemories.clear();
-        batchTextureCount = 0;
-        batchBytes = 0;
-    };
-    beginBatch();
+    payloads.resize(textureSources.size());
 
     for (size_t i = 0; i < textureSources.size(); ++i) {
         const auto decodeStart = std::chrono::high_resolution_clock::now();
@@ -417,8 +477,7 @@ void ResourceManager::loadTextures(const fastgltf::Asset &gltf, const std::files
         const bool useSrgbForColorRole = (role == TextureSemanticRole::Color) &&
                                          (textureColorSpaceModel == TextureColorSpaceModel::HardwareSrgb);
 
-        VulkanUtils::VmaImage img{};
-        VulkanUtils::TextureUploadPayload payload{};
+        VulkanUtils::TextureUploadPayload &payload = payloads[i];
         bool success = false;
         std::string decodePathTag = "rgba-fallback";
 
@@ -506,13 +565,41 @@ void ResourceManager::loadTextures(const fastgltf::Asset &gltf, const std::files
         const auto decodeEnd = std::chrono::high_resolution_clock::now();
         stats.decodeMs += std::chrono::duration<double, std::milli>(decodeEnd - decodeStart).count();
 
+        if (((i + 1) % 8) == 0 || (i + 1) == textureSources.size()) {
+            LOGI("Texture decode progress: %zu/%zu", i + 1, textureSources.size());
+        }
+    }
+
+    LOGI("Texture decode path summary: bc7=%u bc3=%u bc1=%u nativeKtx=%u rgbaFallback=%u",
+         stats.basisuBc7Count, stats.basisuBc3Count, stats.basisuBc1Count, stats.nativeKtxCount,
+         stats.rgbaFallbackCount);
+    LOGI("Texture color-space summary: srgbColor=%u unormLinear=%u mixedUsage=%u forcedRemap=%u model=%s",
+         stats.srgbColorCount, stats.unormLinearCount, stats.mixedUsageCount, stats.forcedRemapCount,
+         textureColorSpaceModel == TextureColorSpaceModel::HardwareSrgb ? "HardwareSrgb" : "LegacyManual");
+    return payloads;
+}
+
+void ResourceManager::uploadTextures(std::vector<VulkanUtils::TextureUploadPayload> &payloads, ModelResource *modelRes, UploadBatch &batch,
+                                     TextureLoadStats &stats) const {
+    if (payloads.empty()) {
+        return;
+    }
+
+    modelRes->textureImages.reserve(payloads.size());
+    modelRes->textureImageViews.reserve(payloads.size());
+    modelRes->textureSamplers.reserve(payloads.size());
+
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        const auto &payload = payloads[i];
+        VulkanUtils::VmaImage img{};
+
         const auto uploadRecordStart = std::chrono::high_resolution_clock::now();
-        VulkanUtils::createTextureImageFromPayloadBatched(device, physicalDevice, uploadCommandBuffer,
-                                                          stagingBuffers, stagingMemories, payload, img);
+        VulkanUtils::createTextureImageFromPayloadBatched(device, physicalDevice, batch.commandBuffer,
+                                                          batch.stagingBuffers, batch.stagingMemories, payload, img);
         const auto uploadRecordEnd = std::chrono::high_resolution_clock::now();
         stats.uploadMs += std::chrono::duration<double, std::milli>(uploadRecordEnd - uploadRecordStart).count();
-        ++batchTextureCount;
-        batchBytes += payload.data.size();
+        ++batch.recordedTextures;
+        batch.recordedBytes += payload.data.size();
 
         vk::ImageViewCreateInfo viewInfo{};
         viewInfo.image = *img;
@@ -536,66 +623,32 @@ void ResourceManager::loadTextures(const fastgltf::Asset &gltf, const std::files
         samplerInfo.maxLod = static_cast<float>(payload.mipLevels);
         modelRes->textureSamplers.emplace_back(device, samplerInfo);
 
-        if (((i + 1) % 8) == 0 || (i + 1) == textureSources.size()) {
-            LOGI("Texture decode progress: %zu/%zu", i + 1, textureSources.size());
-        }
-        if (batchTextureCount >= maxBatchTextures || batchBytes >= maxBatchBytes) {
-            flushBatch();
-            if ((i + 1) < textureSources.size()) {
-                beginBatch();
-            }
+        if (batch.recordedTextures >= kMaxUploadBatchTextures || batch.recordedBytes >= kMaxUploadBatchBytes) {
+            stats.uploadMs += submitUploadBatch(batch, true);
+            LOGI("Texture upload progress: %zu/%zu textures submitted", i + 1, payloads.size());
         }
     }
 
-    flushBatch();
-    LOGI("Texture decode path summary: bc7=%u bc3=%u bc1=%u nativeKtx=%u rgbaFallback=%u",
-         stats.basisuBc7Count, stats.basisuBc3Count, stats.basisuBc1Count, stats.nativeKtxCount,
-         stats.rgbaFallbackCount);
-    LOGI("Texture color-space summary: srgbColor=%u unormLinear=%u mixedUsage=%u forcedRemap=%u model=%s",
-         stats.srgbColorCount, stats.unormLinearCount, stats.mixedUsageCount, stats.forcedRemapCount,
-         textureColorSpaceModel == TextureColorSpaceModel::HardwareSrgb ? "HardwareSrgb" : "LegacyManual");
+    // Staging copies are already recorded; the decoded pixels are no longer needed.
+    payloads.clear();
+    payloads.shrink_to_fit();
 }
 
-SceneNode::Ptr ResourceManager::loadGltfModel(const std::string &path, vk::DescriptorSetLayout layout) {
-    const auto importStart = std::chrono::high_resolution_clock::now();
-    ModelImportReport report{};
+std::unique_ptr<ResourceManager::PreparedGltfModel> ResourceManager::prepareGltfModel(const std::string &path) const {
+    const auto prepareStart = std::chrono::high_resolution_clock::now();
+    auto prepared = std::make_unique<PreparedGltfModel>();
+    prepared->path = path;
+    ModelImportReport &report = prepared->report;
     report.modelPath = path;
 
-    auto it = loadedModels.find(path);
-    if (it != loadedModels.end()) {
-        if (const auto *cachedModel = getModelResource(it->second); cachedModel && cachedModel->hasRuntimeSkinning) {
-            // Skinned models keep per-model mutable GPU output buffers. Reusing them via cache would
-            // couple multiple scene instances to the same animated pose.
-            loadedModels.erase(it);
-        } else {
-            LOGI("Loading GLTF from cache: %s", path.c_str());
-            report.supportedFeatures.push_back("cached_model_instance");
-            if (const auto *cachedModel = getModelResource(it->second)) {
-                report.hasAnimations = cachedModel->hasAnimations;
-                report.hasSkins = cachedModel->hasSkins;
-                if (!cachedModel->animationClipNames.empty()) {
-                    report.supportedFeatures.push_back("animation_clips");
-                }
-                if (!cachedModel->animationClips.empty()) {
-                    report.supportedFeatures.push_back("runtime_animation_playback");
-                }
-                if (cachedModel->hasRuntimeSkinning) {
-                    report.supportedFeatures.push_back("gpu_skinning_raster");
-                }
-            }
-            lastImportReport = std::move(report);
-            return models[it->second]->prototype->clone();
-        }
-    }
-
     LOGI("Loading GLTF: %s", path.c_str());
 
     const auto parseStart = std::chrono::high_resolution_clock::now();
-    const GltfImporter::ParsedAsset parsedAsset = gltfImporter->parseAsset(path);
+    prepared->parsedAsset = gltfImporter->parseAsset(path);
     const auto parseEnd = std::chrono::high_resolution_clock::now();
     report.parseMs = std::chrono::duration<double, std::milli>(parseEnd - parseStart).count();
-    const auto &gltf = parsedAsset.asset;
-    const std::filesystem::path &modelDir = parsedAsset.modelDirectory;
+    const auto &gltf = prepared->parsedAsset.asset;
+    const std::filesystem::path &modelDir = prepared->parsedAsset.modelDirectory;
     report.hasAnimations = !gltf.animations.empty();
     report.hasSkins = !gltf.skins.empty();
     report.supportedFeatures.push_back("meshes");
@@ -606,31 +659,24 @@ SceneNode::Ptr ResourceManager::loadGltfModel(const std::string &path, vk::Descr
     if (report.hasSkins) {
         report.supportedFeatures.push_back("skins");
     }
-    const bool hasSkinningAttributes = parsedAsset.hasSkinningAttributes;
 
     // Create a new ModelResource
-    auto modelRes = std::make_unique<ModelResource>();
-    modelRes->name = std::filesystem::path(path).filename().string();
-    modelRes->path = path;
-    modelRes->hasAnimations = report.hasAnimations;
-    modelRes->hasSkins = report.hasSkins;
-    modelRes->dynamicGeometry = report.hasSkins;
-    gltfImporter->populateAnimationClips(gltf, *modelRes, report);
-    if (!modelRes->animationClipNames.empty()) {
+    prepared->modelResource = std::make_unique<ModelResource>();
+    ModelResource &modelRes = *prepared->modelResource;
+    modelRes.name = std::filesystem::path(path).filename().string();
+    modelRes.path = path;
+    modelRes.hasAnimations = report.hasAnimations;
+    modelRes.hasSkins = report.hasSkins;
+    modelRes.dynamicGeometry = report.hasSkins;
+    gltfImporter->populateAnimationClips(gltf, modelRes, report);
+    if (!modelRes.animationClipNames.empty()) {
         report.supportedFeatures.push_back("animation_clips");
     }
 
-    int totalTexturesLoaded = 0;
-    for (const auto &m: models) {
-        totalTexturesLoaded += m->textureImageViews.size();
-    }
-    modelRes->globalTextureOffset = totalTexturesLoaded;
-
-    // 1. Textures
-    TextureLoadStats textureStats{};
-    loadTextures(gltf, modelDir, modelRes.get(), textureStats);
+    // 1. Texture decode (upload happens in commitPreparedGltfModel)
+    TextureLoadStats &textureStats = prepared->textureStats;
+    prepared->texturePayloads = decodeTextures(gltf, modelDir, textureStats);
     report.textureDecodeMs = textureStats.decodeMs;
-    report.textureUploadMs = textureStats.uploadMs;
     report.supportedFeatures.push_back("texture_decode_path_bc7:" + std::to_string(textureStats.basisuBc7Count));
     report.supportedFeatures.push_back("texture_decode_path_bc3:" + std::to_string(textureStats.basisuBc3Count));
     report.supportedFeatures.push_back("texture_decode_path_bc1:" + std::to_string(textureStats.basisuBc1Count));
@@ -645,82 +691,78 @@ SceneNode::Ptr ResourceManager::loadGltfModel(const std::string &path, vk::Descr
         (textureColorSpaceModel == TextureColorSpaceModel::HardwareSrgb ? "HardwareSrgb" : "LegacyManual"));
 
     // 2. Materials
-    gltfImporter->populateMaterials(gltf, *modelRes);
+    gltfImporter->populateMaterials(gltf, modelRes);
+    gltfImporter->populatePunctualLights(gltf, modelRes);
+    if (!modelRes.lights.empty()) {
+        report.supportedFeatures.push_back("punctual_lights:" + std::to_string(modelRes.lights.size()));
+    }
 
     // 3. Meshes & Scene Graph
     const auto meshStart = std::chrono::high_resolution_clock::now();
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-    std::vector<ModelResource::SkinningInfluence> skinningInfluences;
-    std::vector<int> nodeSkinIndices(gltf.nodes.size(), -1);
-    SceneNode::Ptr rootNode = gltfImporter->buildSceneNodes(gltf, *modelRes, vertices, indices, skinningInfluences, nodeSkinIndices);
+    prepared->nodeSkinIndices.assign(gltf.nodes.size(), -1);
+    prepared->rootNode = gltfImporter->buildSceneNodes(gltf, modelRes, prepared->vertices, prepared->indices, prepared->skinningInfluences,
+                                                       prepared->nodeSkinIndices);
     const auto meshEnd = std::chrono::high_resolution_clock::now();
     report.meshExtractionMs = std::chrono::duration<double, std::milli>(meshEnd - meshStart).count();
-    if (report.hasAnimations && !modelRes->animationClips.empty()) {
+    if (report.hasAnimations && !modelRes.animationClips.empty()) {
         report.supportedFeatures.push_back("runtime_animation_playback");
-    } else if (report.hasAnimations && modelRes->animationClips.empty()) {
+    } else if (report.hasAnimations && modelRes.animationClips.empty()) {
         report.warnings.push_back("Animation clips were found, but no runtime-supported TRS channels were imported.");
     }
-    if (hasSkinningAttributes && !report.hasSkins) {
+    if (prepared->parsedAsset.hasSkinningAttributes && !report.hasSkins) {
         report.warnings.push_back("JOINTS_0/WEIGHTS_0 attributes were found without a skin block.");
     }
 
+    const auto prepareEnd = std::chrono::high_resolution_clock::now();
+    prepared->prepareMs = std::chrono::duration<double, std::milli>(prepareEnd - prepareStart).count();
+    return prepared;
+}
+
+int ResourceManager::commitPreparedGltfModel(PreparedGltfModel &prepared, vk::DescriptorSetLayout layout, UploadBatch &batch) {
+    const auto commitStart = std::chrono::high_resolution_clock::now();
+    ModelImportReport &report = prepared.report;
+    std::unique_ptr<ModelResource> &modelRes = prepared.modelResource;
+    const auto &gltf = prepared.parsedAsset.asset;
+
+    int totalTexturesLoaded = 0;
+    for (const auto &m: models) {
+        totalTexturesLoaded += m->textureImageViews.size();
+    }
+    modelRes->globalTextureOffset = totalTexturesLoaded;
+
+    // 1. Texture upload
+    uploadTextures(prepared.texturePayloads, modelRes.get(), batch, prepared.textureStats);
+    report.textureUploadMs = prepared.textureStats.uploadMs;
+
     // 4. Build flattened Material Buffer specifically sized per-primitive
     std::vector<MaterialData> perPrimitiveMaterials = gltfImporter->buildPerPrimitiveMaterials(*modelRes);
 
+    const auto bufferUploadStart = std::chrono::high_resolution_clock::now();
+    const GpuResourceRegistry::UploadBatchContext uploadBatchContext = batch.context();
     if (!perPrimitiveMaterials.empty()) {
-        const auto bufferUploadStart = std::chrono::high_resolution_clock::now();
-        auto bufferUploadCommandBuffer = VulkanUtils::beginSingleTimeCommands(device, commandPool);
-        std::vector<vk::raii::Buffer> bufferStagingBuffers;
-        std::vector<vk::raii::DeviceMemory> bufferStagingMemories;
-        GpuResourceRegistry::UploadBatchContext uploadBatchContext{
-            .commandBuffer = &bufferUploadCommandBuffer,
-            .stagingBuffers = &bufferStagingBuffers,
-            .stagingMemories = &bufferStagingMemories};
-
         gpuResourceRegistry->uploadMaterialBuffer(*modelRes, perPrimitiveMaterials, &uploadBatchContext);
-
-        // 5. Upload Geometry
-        gpuResourceRegistry->uploadModelBuffers(*modelRes, vertices, indices, &uploadBatchContext);
-        gpuResourceRegistry->createSkinningResources(gltf, *modelRes, vertices, skinningInfluences, nodeSkinIndices, &uploadBatchContext);
-
-        VulkanUtils::endSingleTimeCommands(device, queue, commandPool, bufferUploadCommandBuffer);
-        const auto bufferUploadEnd = std::chrono::high_resolution_clock::now();
-        report.bufferUploadMs = std::chrono::duration<double, std::milli>(bufferUploadEnd - bufferUploadStart).count();
-    } else {
-        const auto bufferUploadStart = std::chrono::high_resolution_clock::now();
-        auto bufferUploadCommandBuffer = VulkanUtils::beginSingleTimeCommands(device, commandPool);
-        std::vector<vk::raii::Buffer> bufferStagingBuffers;
-        std::vector<vk::raii::DeviceMemory> bufferStagingMemories;
-        GpuResourceRegistry::UploadBatchContext uploadBatchContext{
-            .commandBuffer = &bufferUploadCommandBuffer,
-            .stagingBuffers = &bufferStagingBuffers,
-            .stagingMemories = &bufferStagingMemories};
-
-        gpuResourceRegistry->uploadModelBuffers(*modelRes, vertices, indices, &uploadBatchContext);
-        gpuResourceRegistry->createSkinningResources(gltf, *modelRes, vertices, skinningInfluences, nodeSkinIndices, &uploadBatchContext);
-
-        VulkanUtils::endSingleTimeCommands(device, queue, commandPool, bufferUploadCommandBuffer);
-        const auto bufferUploadEnd = std::chrono::high_resolution_clock::now();
-        report.bufferUploadMs = std::chrono::duration<double, std::milli>(bufferUploadEnd - bufferUploadStart).count();
     }
 
+    // 5. Upload Geometry
+    gpuResourceRegistry->uploadModelBuffers(*modelRes, prepared.vertices, prepared.indices, &uploadBatchContext);
+    gpuResourceRegistry->createSkinningResources(gltf, *modelRes, prepared.vertices, prepared.skinningInfluences, prepared.nodeSkinIndices,
+                                                 &uploadBatchContext);
+    batch.recordedBytes += sizeof(MaterialData) * perPrimitiveMaterials.size() + sizeof(Vertex) * prepared.vertices.size() +
+                           sizeof(uint32_t) * prepared.indices.size();
+    const auto bufferUploadEnd = std::chrono::high_resolution_clock::now();
+    report.bufferUploadMs = std::chrono::duration<double, std::milli>(bufferUploadEnd - bufferUploadStart).count();
+
     if (report.hasSkins && modelRes->hasRuntimeSkinning) {
         report.supportedFeatures.push_back("gpu_skinning_raster");
     } else if (report.hasSkins) {
         report.warnings.push_back("Skinning data detected, but GPU skinning setup is incomplete. Mesh will render in bind pose.");
     }
 
-    // 6. Build BLAS (requires vertex/index buffers to be on the GPU)
-    const auto blasStart = std::chrono::high_resolution_clock::now();
-    gpuResourceRegistry->buildBLAS(*modelRes, vertices, indices);
-    const auto blasEnd = std::chrono::high_resolution_clock::now();
-    report.blasBuildMs = std::chrono::duration<double, std::milli>(blasEnd - blasStart).count();
-
     // Store model resource
     models.push_back(std::move(modelRes));
-    int modelId = models.size() - 1;
+    const int modelId = static_cast<int>(models.size() - 1);
     ModelResource *res = models.back().get();
+    prepared.modelId = modelId;
 
     // 5. Descriptor Set
     gpuResourceRegistry->createModelDescriptorSet(*res, layout);
@@ -728,7 +770,7 @@ SceneNode::Ptr ResourceManager::loadGltfModel(const std::string &path, vk::Descr
     // Fix up SceneNodes to point to this modelID
     std::function<void(SceneNode::Ptr)> fixNodes = [&](const SceneNode::Ptr &node) {
         node->modelId = modelId;
-        node->assetRef.path = path;
+        node->assetRef.path = prepared.path;
         node->assetRef.variant = "default";
         if (res->hasAnimations) {
             node->animation.enabled = true;
@@ -739,22 +781,233 @@ SceneNode::Ptr ResourceManager::loadGltfModel(const std::string &path, vk::Descr
         for (auto &child: node->getChildren())
             fixNodes(child);
     };
-    fixNodes(rootNode);
+    fixNodes(prepared.rootNode);
+
+    res->prototype = prepared.rootNode;
+    if (!res->hasAnimations && !res->hasRuntimeSkinning) {
+        std::vector<PrefabTemplate::MeshBounds> meshBounds;
+        meshBounds.reserve(res->meshes.size());
+        for (const auto &mesh: res->meshes) {
+            meshBounds.push_back({mesh.boundsMin, mesh.boundsMax});
+        }
+        res->prefabTemplate = PrefabTemplate::build(*res->prototype, meshBounds);
+    }
+    if (!res->hasRuntimeSkinning) {
+        loadedModels[prepared.path] = modelId;
+    }
+
+    const auto commitEnd = std::chrono::high_resolution_clock::now();
+    prepared.commitMs = std::chrono::duration<double, std::milli>(commitEnd - commitStart).count();
+    return modelId;
+}
+
+void ResourceManager::finalizePreparedGltfModel(PreparedGltfModel &prepared) {
+    ModelImportReport &report = prepared.report;
+    ModelResource *res = getModelResource(prepared.modelId);
+    if (!res) {
+        return;
+    }
+
+    // 6. Build BLAS (requires vertex/index buffers to be on the GPU, i.e. the upload batch was submitted)
+    const auto blasStart = std::chrono::high_resolution_clock::now();
+    gpuResourceRegistry->buildBLAS(*res, prepared.vertices, prepared.indices);
+    const auto blasEnd = std::chrono::high_resolution_clock::now();
+    report.blasBuildMs = std::chrono::duration<double, std::milli>(blasEnd - blasStart).count();
 
-    LOGI("Loaded Model. Vertices: %zu, Indices: %zu", vertices.size(), indices.size());
-    const auto importEnd = std::chrono::high_resolution_clock::now();
-    report.totalMs = std::chrono::duration<double, std::milli>(importEnd - importStart).count();
+    LOGI("Loaded Model. Vertices: %zu, Indices: %zu", prepared.vertices.size(), prepared.indices.size());
+    report.totalMs = prepared.prepareMs + prepared.commitMs + report.blasBuildMs.value_or(0.0);
     LOGI("Import timings (ms) | parse=%.2f decode=%.2f texUpload=%.2f mesh=%.2f bufUpload=%.2f blas=%.2f total=%.2f",
          report.parseMs.value_or(0.0), report.textureDecodeMs.value_or(0.0), report.textureUploadMs.value_or(0.0),
          report.meshExtractionMs.value_or(0.0), report.bufferUploadMs.value_or(0.0), report.blasBuildMs.value_or(0.0), report.totalMs.value_or(0.0));
 
-    models.back()->prototype = rootNode;
-    if (!res->hasRuntimeSkinning) {
-        loadedModels[path] = modelId;
-    }
+    prepared.vertices.clear();
+    prepared.indices.clear();
+    prepared.skinningInfluences.clear();
     lastImportReport = std::move(report);
+}
+
+SceneNode::Ptr ResourceManager::loadGltfModel(const std::string &path, vk::DescriptorSetLayout layout) {
+    ModelImportReport report{};
+    report.modelPath = path;
+
+    auto it = loadedModels.find(path);
+    if (it != loadedModels.end()) {
+        if (const auto *cachedModel = getModelResource(it->second); cachedModel && cachedModel->hasRuntimeSkinning) {
+            // Skinned models keep per-model mutable GPU output buffers. Reusing them via cache would
+            // couple multiple scene instances to the same animated pose.
+            loadedModels.erase(it);
+        } else {
+            LOGI("Loading GLTF from cache: %s", path.c_str());
+            report.supportedFeatures.push_back("cached_model_instance");
+            if (const auto *cachedModel = getModelResource(it->second)) {
+                report.hasAnimations = cachedModel->hasAnimations;
+                report.hasSkins = cachedModel->hasSkins;
+                if (!cachedModel->animationClipNames.empty()) {
+                    report.supportedFeatures.push_back("animation_clips");
+                }
+                if (!cachedModel->animationClips.empty()) {
+                    report.supportedFeatures.push_back("runtime_animation_playback");
+                }
+                if (cachedModel->hasRuntimeSkinning) {
+                    report.supportedFeatures.push_back("gpu_skinning_raster");
+                }
+                if (cachedModel->prefabTemplate) {
+                    report.supportedFeatures.push_back("prefab_instance");
+                }
+            }
+            lastImportReport = std::move(report);
+            return instantiateModel(it->second);
+        }
+    }
+
+    auto prepared = prepareGltfModel(path);
 
-    return rootNode->clone();
+    UploadBatch batch;
+    beginUploadBatch(batch);
+    commitPreparedGltfModel(*prepared, layout, batch);
+    const double submitMs = submitUploadBatch(batch, false);
+    prepared->report.bufferUploadMs = prepared->report.bufferUploadMs.value_or(0.0) + submitMs;
+    prepared->commitMs += submitMs;
+    finalizePreparedGltfModel(*prepared);
+
+    return instantiateModel(prepared->modelId);
+}
+
+SceneNode::Ptr ResourceManager::instantiateModel(int modelId) const {
+    const ModelResource *res = getModelResource(modelId);
+    if (!res || !res->prototype) {
+        return nullptr;
+    }
+    if (!res->prefabTemplate) {
+        return res->prototype->clone();
+    }
+    auto instance = res->prototype->cloneNode();
+    instance->setPrefab(res->prefabTemplate);
+    return instance;
+}
+
+void ResourceManager::beginGltfPrefetch(const std::vector<std::string> &paths) {
+    // Only one batch can be in flight; an abandoned one is joined and its results dropped.
+    pendingPrefetch.reset();
+
+    auto pending = std::make_unique<PendingGltfPrefetch>();
+    pending->startTime = std::chrono::high_resolution_clock::now();
+    std::unordered_set<std::string> seen;
+    for (const auto &path: paths) {
+        if (path.empty() || !seen.insert(path).second) {
+            continue;
+        }
+        pending->requestedPaths.push_back(path);
+        if (loadedModels.contains(path)) {
+            ++pending->cachedCount;
+            continue;
+        }
+        pending->preparePaths.push_back(path);
+    }
+
+    const size_t prepareCount = pending->preparePaths.size();
+    pending->promises.resize(prepareCount);
+    pending->futures.reserve(prepareCount);
+    for (auto &promise: pending->promises) {
+        pending->futures.push_back(promise.get_future());
+    }
+
+    if (prepareCount > 0) {
+        const size_t hardwareThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        const size_t workerCount = std::min({prepareCount, hardwareThreads, static_cast<size_t>(EngineConfig::kMaxModelPrefetchWorkers)});
+        PendingGltfPrefetch *state = pending.get();
+        for (size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex) {
+            state->workers.emplace_back([this, state]() {
+                for (size_t i = state->nextIndex.fetch_add(1); i < state->preparePaths.size(); i = state->nextIndex.fetch_add(1)) {
+                    try {
+                        state->promises[i].set_value(prepareGltfModel(state->preparePaths[i]));
+                    } catch (...) {
+                        state->promises[i].set_exception(std::current_exception());
+                    }
+                }
+            });
+        }
+        LOGI("GLTF prefetch: preparing %zu model(s) on %zu worker(s), %zu already cached", prepareCount, workerCount, pending->cachedCount);
+    }
+
+    pendingPrefetch = std::move(pending);
+}
+
+std::unordered_map<std::string, int> ResourceManager::completeGltfPrefetch(vk::DescriptorSetLayout layout, ModelBatchLoadReport *batchReport) {
+    std::unordered_map<std::string, int> modelIds;
+    ModelBatchLoadReport report{};
+    if (!pendingPrefetch) {
+        if (batchReport) {
+            *batchReport = std::move(report);
+        }
+        return modelIds;
+    }
+
+    std::unique_ptr<PendingGltfPrefetch> pending = std::move(pendingPrefetch);
+    report.requestedCount = pending->requestedPaths.size();
+    report.cachedCount = pending->cachedCount;
+
+    // Commit in request order as soon as each worker result is ready, so GPU uploads for early models
+    // overlap with decoding of later ones. All uploads share one staging batch.
+    double waitMs = 0.0;
+    double commitMs = 0.0;
+    std::vector<std::unique_ptr<PreparedGltfModel>> committed;
+    committed.reserve(pending->futures.size());
+    UploadBatch batch;
+    beginUploadBatch(batch);
+    for (size_t i = 0; i < pending->futures.size(); ++i) {
+        const auto waitStart = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<PreparedGltfModel> prepared;
+        try {
+            prepared = pending->futures[i].get();
+        } catch (const std::exception &e) {
+            report.errors.push_back(pending->preparePaths[i] + ": " + e.what());
+            LOGE("Failed to prefetch model %s (%s)", pending->preparePaths[i].c_str(), e.what());
+        }
+        const auto waitEnd = std::chrono::high_resolution_clock::now();
+        waitMs += std::chrono::duration<double, std::milli>(waitEnd - waitStart).count();
+        if (!prepared) {
+            continue;
+        }
+
+        commitPreparedGltfModel(*prepared, layout, batch);
+        commitMs += prepared->commitMs;
+        if (batch.recordedBytes >= kMaxUploadBatchBytes) {
+            commitMs += submitUploadBatch(batch, true);
+        }
+        modelIds[prepared->path] = prepared->modelId;
+        committed.push_back(std::move(prepared));
+    }
+    commitMs += submitUploadBatch(batch, false);
+
+    for (auto &prepared: committed) {
+        finalizePreparedGltfModel(*prepared);
+        commitMs += prepared->report.blasBuildMs.value_or(0.0);
+    }
+
+    for (const auto &path: pending->requestedPaths) {
+        if (modelIds.contains(path)) {
+            continue;
+        }
+        if (auto it = loadedModels.find(path); it != loadedModels.end()) {
+            modelIds[path] = it->second;
+        }
+    }
+
+    report.loadedCount = committed.size();
+    report.failedCount = report.errors.size();
+    report.prepareWaitMs = waitMs;
+    report.gpuCommitMs = commitMs;
+    const auto completeEnd = std::chrono::high_resolution_clock::now();
+    report.totalMs = std::chrono::duration<double, std::milli>(completeEnd - pending->startTime).count();
+    LOGI("GLTF prefetch timings (ms) | requested=%zu cached=%zu loaded=%zu failed=%zu wait=%.2f gpuCommit=%.2f total=%.2f",
+         report.requestedCount, report.cachedCount, report.loadedCount, report.failedCount,
+         report.prepareWaitMs.value_or(0.0), report.gpuCommitMs.value_or(0.0), report.totalMs.value_or(0.0));
+
+    if (batchReport) {
+        *batchReport = std::move(report);
+    }
+    return modelIds;
 }
 
 ModelResource *ResourceManager::getModelResource(int id) const {
@@ -812,11 +1065,15 @@ void ResourceManager::bindResources(const vk::raii::CommandBuffer &cmd, int mode
     }
 }
 
-void ResourceManager::recordSkinnedBLASRefit(const vk::raii::CommandBuffer &cmd) const {
+void ResourceManager::recordSkinnedBLASRefit(const vk::raii::CommandBuffer &cmd, const std::vector<int> &posedModelIds) const {
+    if (!gpuResourceRegistry->isRayTracingEnabled() || posedModelIds.empty()) {
+        return;
+    }
     const vk::DeviceSize scratchAlignment =
         VulkanUtils::getAccelerationStructureScratchAlignment(physicalDevice);
 
-    for (auto &model : models) {
+    for (int modelId : posedModelIds) {
+        ModelResource *model = getModelResource(modelId);
         if (!model || !model->hasRuntimeSkinning) {
             continue;
         }
@@ -852,6 +1109,7 @@ void ResourceManager::recordSkinnedBLASRefit(const vk::raii::CommandBuffer &cmd)
 
                 vk::AccelerationStructureGeometryKHR geometry{};
                 geometry.geometryType = vk::GeometryTypeKHR::eTriangles;
+                geometry.flags = GpuResourceRegistry::blasGeometryFlags(*model, prim);
                 auto &triangles = geometry.geometry.triangles;
                 triangles.vertexFormat = vk::Format::eR32G32B32Sfloat;
                 triangles.vertexData.deviceAddress = vertexAddress;
@@ -899,7 +1157,8 @@ void ResourceManager::recordSkinnedBLASRefit(const vk::raii::CommandBuffer &cmd)
     vk::MemoryBarrier2 refitBarrier{
         .srcStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR,
         .srcAccessMask = vk::AccessFlagBits2::eAccelerationStructureWriteKHR,
-        .dstStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits2::eRayTracingShaderKHR,
+        .dstStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits2::eRayTracingShaderKHR |
+                        vk::PipelineStageFlagBits2::eComputeShader,
         .dstAccessMask = vk::AccessFlagBits2::eAccelerationStructureReadKHR};
     vk::DependencyInfo dep{
         .memoryBarrierCount = 1,
@@ -1216,12 +1475,12 @@ void ResourceManager::finalizeProceduralModel(ModelResource *modelRes, const std
     iStagingMem.unmapMemory();
 
     vk::BufferUsageFlags vFlags = vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
-                                  vk::BufferUsageFlagBits::eShaderDeviceAddress | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+                                  vk::BufferUsageFlagBits::eShaderDeviceAddress | gpuResourceRegistry->accelerationStructureInputUsage();
     VulkanUtils::createBuffer(device, physicalDevice, vSize, vFlags, vk::MemoryPropertyFlagBits::eDeviceLocal,
                               modelRes->vertexBuffer);
 
     vk::BufferUsageFlags iFlags = vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
-                                  vk::BufferUsageFlagBits::eShaderDeviceAddress | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+                                  vk::BufferUsageFlagBits::eShaderDeviceAddress | gpuResourceRegistry->accelerationStructureInputUsage();
     VulkanUtils::createBuffer(device, physicalDevice, iSize, iFlags, vk::MemoryPropertyFlagBits::eDeviceLocal,
                               modelRes->indexBuffer);
 
@@ -1252,6 +1511,10 @@ void ResourceManager::finalizeProceduralModel(ModelResource *modelRes, const std
     prim.vertexOffset = 0;
     prim.materialIndex = 0;
     mesh.primitives.push_back(prim);
+    for (const Vertex &v : vertices) {
+        mesh.boundsMin = glm::min(mesh.boundsMin, v.pos);
+        mesh.boundsMax = glm::max(mesh.boundsMax, v.pos);
+    }
     modelRes->meshes.push_back(mesh);
 
     // Build BLAS
@@ -3,6 +3,8 @@
 
 #include "../SceneManagement/SceneNode.h"
 #include "EngineAuxiliary.h"
+#include "PunctualLights.h"
+#include "SkinnedBounds.h"
 #include "VulkanUtils.h"
 #include <fastgltf/types.hpp>
 #include <cstdint>
@@ -84,14 +86,25 @@ struct ModelResource
 	std::vector<SkinData> skins;
 	std::unordered_map<int, int> meshNodeSkinBySourceNode;
 
+	// KHR_lights_punctual lights, and for every glTF node the index of the light it carries (-1 for none)
+	std::vector<Laphria::PunctualLight> lights;
+	std::vector<int>                    nodeLightIndices;
+
 	// One buffer per model for now
 	Laphria::VulkanUtils::VmaBuffer vertexBuffer;
 	Laphria::VulkanUtils::VmaBuffer indexBuffer;
 	Laphria::VulkanUtils::VmaBuffer skinnedVertexBuffer;
+	Laphria::VulkanUtils::VmaBuffer prevSkinnedPositionBuffer;        // float3 per vertex, written by the skinning pass
 	Laphria::VulkanUtils::VmaBuffer skinningInfluenceBuffer;
 	Laphria::VulkanUtils::VmaBuffer skinningJointMatrixBuffer;
 	void                   *skinningJointMatricesMapped = nullptr;
 
+	// Per-joint boxes of the skinned stream, and the box of the pose it holds now (before the node transform,
+	// like the vertices). Culling tests the posed box; the skinning pass moves it only when it dispatches.
+	Laphria::SkinnedBounds skinnedBounds;
+	glm::vec3              skinnedPoseMin{0.0f};
+	glm::vec3              skinnedPoseMax{0.0f};
+
 	// CPU side info to map mesh primitives to buffer offsets
 	std::vector<Laphria::LoadedMesh> meshes;
 
@@ -114,6 +127,9 @@ struct ModelResource
 
 	// Prototype for caching (Scene Graph Hierarchy)
 	SceneNode::Ptr prototype{nullptr};
+
+	// Shared hierarchy for collapsed instances; null for animated and skinned models, which need per-instance nodes
+	std::shared_ptr<const PrefabTemplate> prefabTemplate;
 };
 
 struct ModelImportReport
@@ -133,6 +149,18 @@ struct ModelImportReport
 	std::optional<double>    totalMs;
 };
 
+struct ModelBatchLoadReport
+{
+	size_t                   requestedCount = 0;
+	size_t                   cachedCount = 0;
+	size_t                   loadedCount = 0;
+	size_t                   failedCount = 0;
+	std::vector<std::string> errors;
+	std::optional<double>    prepareWaitMs;        // time the committing thread spent blocked on worker preparation
+	std::optional<double>    gpuCommitMs;          // batched uploads, descriptor sets and BLAS builds
+	std::optional<double>    totalMs;              // beginGltfPrefetch() -> completeGltfPrefetch() return
+};
+
 class GltfImporter;
 class GpuResourceRegistry;
 
@@ -144,7 +172,16 @@ class ResourceManager
 
 	// Load a GLTF model and return the root node of the constructed hierarchy
 	SceneNode::Ptr loadGltfModel(const std::string &path, vk::DescriptorSetLayout layout);
+
+	// Batched model loading. beginGltfPrefetch() returns immediately after starting worker threads that
+	// parse, extract meshes and decode textures for every uncached path; the caller can do other work
+	// meanwhile. completeGltfPrefetch() then commits the results on the calling thread (GPU uploads share
+	// staging batches) and returns the model ID of every requested path that is available.
+	void beginGltfPrefetch(const std::vector<std::string> &paths);
+	std::unordered_map<std::string, int> completeGltfPrefetch(vk::DescriptorSetLayout layout, ModelBatchLoadReport *batchReport = nullptr);
 	void setSkinningDescriptorSetLayout(vk::DescriptorSetLayout layout) const;
+	// False on the raster-only device tier: models get no BLAS and skinned refits are skipped.
+	void setRayTracingEnabled(bool enabled) const;
 	void setTextureColorSpaceModel(TextureColorSpaceModel model);
 
 	// Primitives
@@ -155,6 +192,9 @@ class ResourceManager
 
 	SceneNode::Ptr createCylinderModel(float radius, float height, int slices, vk::DescriptorSetLayout layout);
 
+	// New scene instance of a loaded model: a collapsed prefab when the model has a template, else a full clone
+	[[nodiscard]] SceneNode::Ptr instantiateModel(int modelId) const;
+
 	// Get resource by internal ID (SceneNode will store these ID)
 	[[nodiscard]] ModelResource *getModelResource(int id) const;
 	[[nodiscard]] const ModelImportReport *getLastImportReport() const;
@@ -169,7 +209,8 @@ class ResourceManager
 
 	// Helpers for rendering
 	void bindResources(const vk::raii::CommandBuffer &cmd, int modelId, bool useSkinnedVertices = false) const;
-	void recordSkinnedBLASRefit(const vk::raii::CommandBuffer &cmd) const;
+	// Refits the BLASes of the models the skinning pass posed this frame; the others keep their last pose.
+	void recordSkinnedBLASRefit(const vk::raii::CommandBuffer &cmd, const std::vector<int> &posedModelIds) const;
 
   private:
 	vk::raii::Device         &device;
@@ -204,8 +245,22 @@ class ResourceManager
 		Linear
 	};
 
-	void loadTextures(const fastgltf::Asset &gltf, const std::filesystem::path &modelDir, ModelResource *modelRes,
-	                  TextureLoadStats &stats) const;
+	struct PreparedGltfModel;
+	struct UploadBatch;
+	struct PendingGltfPrefetch;
+
+	std::vector<Laphria::VulkanUtils::TextureUploadPayload> decodeTextures(const fastgltf::Asset &gltf, const std::filesystem::path &modelDir,
+	                                                                       TextureLoadStats &stats) const;
+	void uploadTextures(std::vector<Laphria::VulkanUtils::TextureUploadPayload> &payloads, ModelResource *modelRes, UploadBatch &batch,
+	                    TextureLoadStats &stats) const;
+
+	// Split import pipeline: prepare is CPU-only and thread-safe, commit/finalize must run on the owning thread.
+	[[nodiscard]] std::unique_ptr<PreparedGltfModel> prepareGltfModel(const std::string &path) const;
+	int  commitPreparedGltfModel(PreparedGltfModel &prepared, vk::DescriptorSetLayout layout, UploadBatch &batch);
+	void finalizePreparedGltfModel(PreparedGltfModel &prepared);
+
+	void   beginUploadBatch(UploadBatch &batch) const;
+	double submitUploadBatch(UploadBatch &batch, bool reopen) const;
 
 	bool prepareKTXFromMemory(const unsigned char *data, size_t length, TextureSemanticRole role,
 	                          Laphria::VulkanUtils::TextureUploadPayload &outPayload, std::string &outPathTag,
@@ -216,6 +271,7 @@ class ResourceManager
 	                             const std::optional<Laphria::MaterialData> &materialOverride = std::nullopt) const;
 
 	std::unordered_map<std::string, int> loadedModels;
+	std::unique_ptr<PendingGltfPrefetch> pendingPrefetch;
 	TextureColorSpaceModel textureColorSpaceModel = TextureColorSpaceModel::HardwareSrgb;
 };        // End of ResourceManager class
 
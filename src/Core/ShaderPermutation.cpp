@@ -0,0 +1,48 @@
+#include "ShaderPermutation.h"
+
+#include <algorithm>
+
+namespace Laphria
+{
+SpecializationBlock buildSpecializationBlock(const ShaderPermutation &permutation)
+{
+	SpecializationBlock block;
+	block.values[static_cast<uint32_t>(SpecializationConstant::PtMaxBounces)]           = std::clamp(permutation.ptMaxBounces, 1u, 3u);
+	block.values[static_cast<uint32_t>(SpecializationConstant::TextureColorSpaceModel)] = std::min(permutation.textureColorSpaceModel, 1u);
+	block.values[static_cast<uint32_t>(SpecializationConstant::ShadowCascadeCount)]     = std::clamp(permutation.shadowCascadeCount, 1u, 4u);
+	block.values[static_cast<uint32_t>(SpecializationConstant::PtReprojection)]         = permutation.ptReprojection ? 1u : 0u;
+	for (uint32_t id = 0; id < kSpecializationConstantCount; ++id)
+	{
+		block.entries[id] = {id, id * static_cast<uint32_t>(sizeof(uint32_t)), static_cast<uint32_t>(sizeof(uint32_t))};
+	}
+	return block;
+}
+
+uint32_t permutedPipelinesToRebuild(const ShaderPermutation &from, const ShaderPermutation &to)
+{
+	const SpecializationBlock before = buildSpecializationBlock(from);
+	const SpecializationBlock after  = buildSpecializationBlock(to);
+	auto changed = [&](SpecializationConstant constant) {
+		return before.values[static_cast<uint32_t>(constant)] != after.values[static_cast<uint32_t>(constant)];
+	};
+
+	uint32_t rebuild = 0;
+	if (changed(SpecializationConstant::PtMaxBounces))
+	{
+		rebuild |= kPermutedPathTracer | kPermutedWavefront;
+	}
+	if (changed(SpecializationConstant::TextureColorSpaceModel))
+	{
+		rebuild |= kPermutedRaster | kPermutedPathTracer | kPermutedWavefront | kPermutedClassicRT;
+	}
+	if (changed(SpecializationConstant::ShadowCascadeCount))
+	{
+		rebuild |= kPermutedRaster;
+	}
+	if (changed(SpecializationConstant::PtReprojection))
+	{
+		rebuild |= kPermutedDenoiser;
+	}
+	return rebuild;
+}
+}        // namespace Laphria
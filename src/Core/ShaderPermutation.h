@@ -0,0 +1,61 @@
+#ifndef LAPHRIAENGINE_SHADERPERMUTATION_H
+#define LAPHRIAENGINE_SHADERPERMUTATION_H
+
+#include <array>
+#include <cstdint>
+
+namespace Laphria
+{
+// Specialization constant IDs, mirrored by the [vk::constant_id] declarations in ShaderCommon.slang.
+enum class SpecializationConstant : uint32_t
+{
+	PtMaxBounces           = 0,        // path tracer surface hits per path (1-3): Raygen, wavefront Shade
+	TextureColorSpaceModel = 1,        // TextureColorSpaceModel: every shader that decodes material colours
+	ShadowCascadeCount     = 2,        // raster cascade selection (1-4)
+	PtReprojection         = 3         // 0: the A-Trous input is the raw trace, reprojection did not run
+};
+constexpr uint32_t kSpecializationConstantCount = 4;
+
+// Values baked into the permuted pipelines. Changing one rebuilds the pipelines that read it.
+struct ShaderPermutation
+{
+	uint32_t ptMaxBounces           = 3;
+	uint32_t textureColorSpaceModel = 0;
+	uint32_t shadowCascadeCount     = 4;
+	bool     ptReprojection         = true;
+
+	bool operator==(const ShaderPermutation &) const = default;
+};
+
+struct SpecializationEntry
+{
+	uint32_t constantId = 0;
+	uint32_t offset     = 0;        // bytes into SpecializationBlock::values
+	uint32_t size       = 0;
+};
+
+// One block specializes every stage: IDs a module does not declare are ignored by the driver.
+struct SpecializationBlock
+{
+	std::array<uint32_t, kSpecializationConstantCount>            values{};
+	std::array<SpecializationEntry, kSpecializationConstantCount> entries{};
+};
+
+// Values in constant-ID order, clamped to the ranges the shaders are written for.
+SpecializationBlock buildSpecializationBlock(const ShaderPermutation &permutation);
+
+// Pipeline groups that read specialization constants.
+enum PermutedPipelines : uint32_t
+{
+	kPermutedRaster     = 1u << 0,        // main raster pipeline
+	kPermutedPathTracer = 1u << 1,        // path tracer RT pipeline and its shader binding table
+	kPermutedWavefront  = 1u << 2,        // wavefront path tracer kernels
+	kPermutedClassicRT  = 1u << 3,        // classic RT pipeline and its shader binding table
+	kPermutedDenoiser   = 1u << 4         // reprojection, A-Trous and the passes sharing their layout
+};
+
+// Groups whose pipelines bake a constant that differs between the two permutations.
+uint32_t permutedPipelinesToRebuild(const ShaderPermutation &from, const ShaderPermutation &to);
+}        // namespace Laphria
+
+#endif        // LAPHRIAENGINE_SHADERPERMUTATION_H
@@ -0,0 +1,80 @@
+#include "SkinnedBounds.h"
+
+#include "OcclusionCulling.h"
+
+#include <limits>
+
+namespace Laphria
+{
+void SkinnedBounds::reset(size_t jointCount)
+{
+	jointMin.assign(jointCount, glm::vec3(std::numeric_limits<float>::max()));
+	jointMax.assign(jointCount, glm::vec3(std::numeric_limits<float>::lowest()));
+	hasUnskinned    = false;
+	dropsInfluences = false;
+	vertexCount     = 0;
+}
+
+void SkinnedBounds::addVertex(const glm::vec3 &position, const glm::uvec4 &joints, const glm::vec4 &weights)
+{
+	++vertexCount;
+	// Mirrors the skinning shader: no total weight leaves the vertex in place.
+	if (weights.x + weights.y + weights.z + weights.w <= 1e-6f)
+	{
+		unskinnedMin = hasUnskinned ? glm::min(unskinnedMin, position) : position;
+		unskinnedMax = hasUnskinned ? glm::max(unskinnedMax, position) : position;
+		hasUnskinned = true;
+		return;
+	}
+	for (int i = 0; i < 4; ++i)
+	{
+		if (weights[i] <= 0.0f)
+		{
+			continue;
+		}
+		if (joints[i] >= jointMin.size())
+		{
+			dropsInfluences = true;
+			continue;
+		}
+		jointMin[joints[i]] = glm::min(jointMin[joints[i]], position);
+		jointMax[joints[i]] = glm::max(jointMax[joints[i]], position);
+	}
+}
+
+bool SkinnedBounds::posedBounds(std::span<const glm::mat4> palette, glm::vec3 &outMin, glm::vec3 &outMax) const
+{
+	if (vertexCount == 0)
+	{
+		return false;
+	}
+	outMin = glm::vec3(std::numeric_limits<float>::max());
+	outMax = glm::vec3(std::numeric_limits<float>::lowest());
+	if (hasUnskinned)
+	{
+		outMin = unskinnedMin;
+		outMax = unskinnedMax;
+	}
+	if (dropsInfluences)
+	{
+		outMin = glm::min(outMin, glm::vec3(0.0f));
+		outMax = glm::max(outMax, glm::vec3(0.0f));
+	}
+	for (size_t joint = 0; joint < jointMin.size(); ++joint)
+	{
+		if (jointMin[joint].x > jointMax[joint].x)
+		{
+			continue;
+		}
+		glm::vec3 posedMin = jointMin[joint];
+		glm::vec3 posedMax = jointMax[joint];
+		if (joint < palette.size())
+		{
+			transformBounds(jointMin[joint], jointMax[joint], palette[joint], posedMin, posedMax);
+		}
+		outMin = glm::min(outMin, posedMin);
+		outMax = glm::max(outMax, posedMax);
+	}
+	return outMin.x <= outMax.x;
+}
+}        // namespace Laphria
@@ -0,0 +1,45 @@
+#ifndef LAPHRIAENGINE_SKINNEDBOUNDS_H
+#define LAPHRIAENGINE_SKINNEDBOUNDS_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Laphria
+{
+// Bounds of a mesh posed by the skinning pass (Skinning.slang). A skinned vertex is the weighted mean of its
+// bind position under each of its joints' palette matrices, so it lies in the union of the joint boxes, each
+// holding the bind positions of the vertices weighted to that joint and posed by that joint's matrix alone.
+// The boxes are built once at import; posing them costs one box transform per joint.
+class SkinnedBounds
+{
+  public:
+	// jointCount: size of the palette the skinning pass is dispatched with.
+	void reset(size_t jointCount);
+
+	// joints index the palette, as in the influence buffer; weights need not be normalised.
+	void addVertex(const glm::vec3 &position, const glm::uvec4 &joints, const glm::vec4 &weights);
+
+	[[nodiscard]] bool empty() const
+	{
+		return vertexCount == 0;
+	}
+
+	// Box of the skinned vertices under a palette. Joints past its end are posed by the identity.
+	// Returns false when no vertex was added.
+	bool posedBounds(std::span<const glm::mat4> palette, glm::vec3 &outMin, glm::vec3 &outMax) const;
+
+  private:
+	std::vector<glm::vec3> jointMin;        // min > max for joints no vertex is weighted to
+	std::vector<glm::vec3> jointMax;
+	glm::vec3              unskinnedMin{0.0f};        // vertices without weight keep their bind position
+	glm::vec3              unskinnedMax{0.0f};
+	bool                   hasUnskinned    = false;
+	bool                   dropsInfluences = false;        // weight on joints past the palette pulls toward the origin
+	size_t                 vertexCount     = 0;
+};
+}        // namespace Laphria
+
+#endif        // LAPHRIAENGINE_SKINNEDBOUNDS_H
@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
 #include <optional>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -160,6 +162,8 @@ void UISystem::init(VulkanDevice &dev, GLFWwindow *window,
     poolInfo.pPoolSizes = poolSizes.data();
 
     imguiDescriptorPool = vk::raii::DescriptorPool(dev.logicalDevice, poolInfo);
+    rayTracingAvailable = dev.rayTracingSupported;
+    wavefrontAvailable = dev.rayQuerySupported;
 
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -209,7 +213,7 @@ void UISystem::draw(GLFWwindow *window, Scene &scene, PhysicsSystem &physics,
     drawAssetBrowser(scene, rm, matLayout);
     drawValidationPanel();
     drawSceneHierarchy(scene);
-    drawInspector(rm);
+    drawInspector(scene, rm);
     drawPhysicsUI(scene, physics, rm, matLayout);
     drawSelectedNodeTransformGizmo(camera);
 
@@ -259,8 +263,16 @@ void UISystem::draw(GLFWwindow *window, Scene &scene, PhysicsSystem &physics,
     }
     if (ImGui::BeginPopupModal("Save Scene", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
         ImGui::InputText("Path", scenePath, IM_ARRAYSIZE(scenePath));
+        ImGui::Checkbox("Pretty JSON", &scenePrettyJson);
+        ImGui::Checkbox("Autosave changes", &sceneAutosaveEnabled);
+        if (sceneAutosaveEnabled) {
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(120.0f);
+            ImGui::DragFloat("Interval (s)", &sceneAutosaveIntervalSeconds, 1.0f, 5.0f, 600.0f, "%.0f");
+        }
         if (ImGui::Button("Save", ImVec2(120, 0))) {
-            scene.saveScene(scenePath, rm);
+            scene.saveScene(scenePath, rm, scenePrettyJson);
+            scene.setAutosave(sceneAutosaveEnabled ? std::string(scenePath) : std::string(), sceneAutosaveIntervalSeconds, scenePrettyJson);
             if (hasLoadedProject) {
                 project.sceneOutputPath = scenePath;
             }
@@ -355,6 +367,7 @@ void UISystem::draw(GLFWwindow *window, Scene &scene, PhysicsSystem &physics,
 }
 
 void UISystem::cleanup() {
+    assetIndexer.stop();
     ImGui_ImplVulkan_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -392,10 +405,26 @@ void UISystem::drawMainMenuBar(GLFWwindow *window) {
 void UISystem::drawSceneHierarchy(Scene &scene) {
     ImGui::Begin("Scene Hierarchy");
 
-    if (scene.getRoot()) {
-        drawSceneNode(scene.getRoot(), scene);
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    if (ImGui::InputTextWithHint("##HierarchyFilter", "Filter by name", hierarchyFilter, IM_ARRAYSIZE(hierarchyFilter))) {
+        hierarchyRowsDirty = true;
+    }
+    if (hierarchyRowsDirty || hierarchyRowsVersion != scene.getComponentsVersion()) {
+        rebuildHierarchyRows(scene);
     }
 
+    // Only the rows inside the scrolled region are submitted, so the cost follows the panel height.
+    ImGui::BeginChild("HierarchyRows");
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(hierarchyRows.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            drawSceneNode(hierarchyRows[i], scene);
+        }
+    }
+    clipper.End();
+    ImGui::EndChild();
+
     if (!nodesPendingDeletion.empty()) {
         for (const auto &node: nodesPendingDeletion) {
             scene.deleteNode(node);
@@ -406,17 +435,93 @@ void UISystem::drawSceneHierarchy(Scene &scene) {
     ImGui::End();
 }
 
-void UISystem::drawSceneNode(const SceneNode::Ptr &node, Scene &scene) {
-    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
+void UISystem::rebuildHierarchyRows(Scene &scene) {
+    const bool sameNodes = hierarchyRowsVersion == scene.getComponentsVersion();
+    hierarchyRowsVersion = scene.getComponentsVersion();
+    hierarchyRowsDirty = false;
+    hierarchyRows.clear();
+
+    const SceneNode::Ptr root = scene.getRoot();
+    const std::string filter = toLowerCopy(hierarchyFilter);
+    if (!root || filter.empty()) {
+        hierarchyFilterMatches.clear();
+        appliedHierarchyFilter.clear();
+    } else {
+        // A filter that extends the previous one can only narrow its matches, so refine those instead of
+        // rescanning the scene on every keystroke.
+        const bool refine = sameNodes && !appliedHierarchyFilter.empty() && filter.find(appliedHierarchyFilter) != std::string::npos;
+        std::vector<SceneNode::Ptr> matches;
+        for (const auto &node: refine ? hierarchyFilterMatches : scene.getAllNodes()) {
+            if (toLowerCopy(node->name.str()).find(filter) != std::string::npos) {
+                matches.push_back(node);
+            }
+        }
+        hierarchyFilterMatches = std::move(matches);
+        appliedHierarchyFilter = filter;
+    }
+    if (!root) {
+        return;
+    }
+
+    // While filtering, matches are listed with all their ancestors, expanded.
+    std::unordered_set<const SceneNode *> filterVisible;
+    for (const auto &match: hierarchyFilterMatches) {
+        for (const SceneNode *node = match.get(); node && filterVisible.insert(node).second; node = node->getParent()) {
+        }
+    }
+    if (!filter.empty() && !filterVisible.contains(root.get())) {
+        return;
+    }
+
+    std::vector<HierarchyRow> stack{{root, 0}};
+    while (!stack.empty()) {
+        HierarchyRow row = std::move(stack.back());
+        stack.pop_back();
+
+        if (filter.empty() ? expandedHierarchyNodes.contains(row.node->stableId) : true) {
+            const auto &children = row.node->getChildren();
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                if (filter.empty() || filterVisible.contains(it->get())) {
+                    stack.push_back({*it, row.depth + 1});
+                }
+            }
+        }
+        hierarchyRows.push_back(std::move(row));
+    }
+}
+
+void UISystem::drawSceneNode(const HierarchyRow &row, Scene &scene) {
+    const SceneNode::Ptr &node = row.node;
+    const bool filtering = hierarchyFilter[0] != '\0';
+    const bool leaf = node->getChildren().empty();
+
+    // Rows are flat, so the tree node neither pushes an ID scope nor indents; the row depth does that.
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_NoTreePushOnOpen;
     if (selectedNode == node) {
         flags |= ImGuiTreeNodeFlags_Selected;
     }
-    if (node->getChildren().empty()) {
+    if (leaf) {
         flags |= ImGuiTreeNodeFlags_Leaf;
     }
 
+    const float indent = static_cast<float>(row.depth) * ImGui::GetStyle().IndentSpacing;
+    if (indent > 0.0f) {
+        ImGui::Indent(indent);
+    }
+
+    const bool expanded = filtering || expandedHierarchyNodes.contains(node->stableId);
+    ImGui::SetNextItemOpen(expanded);
     const char *label = node->name.empty() ? "Node" : node->name.c_str();
-    bool opened = ImGui::TreeNodeEx(reinterpret_cast<void *>(reinterpret_cast<intptr_t>(node.get())), flags, "%s", label);
+    const bool opened = ImGui::TreeNodeEx(reinterpret_cast<void *>(reinterpret_cast<intptr_t>(node.get())), flags,
+                                          node->getPrefab() ? "%s [prefab]" : "%s", label);
+    if (!filtering && !leaf && opened != expanded) {
+        if (opened) {
+            expandedHierarchyNodes.insert(node->stableId);
+        } else {
+            expandedHierarchyNodes.erase(node->stableId);
+        }
+        hierarchyRowsDirty = true;
+    }
 
     if (ImGui::IsItemClicked()) {
         selectedNode = node;
@@ -433,12 +538,13 @@ void UISystem::drawSceneNode(const SceneNode::Ptr &node, Scene &scene) {
         if (ImGui::MenuItem("Add Child")) {
             auto child = std::make_shared<SceneNode>("New Node");
             scene.addNode(child, node);
+            expandedHierarchyNodes.insert(node->stableId);
             scene.rebuildOctree();
         }
         if (ImGui::MenuItem("Duplicate")) {
             if (node != scene.getRoot()) {
                 auto clone = node->clone();
-                clone->name += "_Copy";
+                clone->name = Laphria::NodeName::owned(clone->name.str() + "_Copy");
                 if (node->getParent()) {
                     scene.addNode(clone, node->getParent()->shared_from_this());
                 } else {
@@ -448,6 +554,9 @@ void UISystem::drawSceneNode(const SceneNode::Ptr &node, Scene &scene) {
                 scene.rebuildOctree();
             }
         }
+        if (node->getPrefab() && ImGui::MenuItem("Expand Prefab")) {
+            scene.expandPrefab(node);
+        }
         if (ImGui::MenuItem("Mark For Reparent")) {
             if (node != scene.getRoot()) {
                 nodePendingReparent = node;
@@ -460,6 +569,7 @@ void UISystem::drawSceneNode(const SceneNode::Ptr &node, Scene &scene) {
                         oldParent->removeChild(nodePendingReparent);
                     }
                     node->addChild(nodePendingReparent);
+                    scene.updateComponents(nodePendingReparent);
                     scene.rebuildOctree();
                 }
                 nodePendingReparent.reset();
@@ -471,26 +581,33 @@ void UISystem::drawSceneNode(const SceneNode::Ptr &node, Scene &scene) {
         ImGui::EndPopup();
     }
 
-    if (opened) {
-        for (auto &child: node->getChildren()) {
-            drawSceneNode(child, scene);
-        }
-        ImGui::TreePop();
+    if (indent > 0.0f) {
+        ImGui::Unindent(indent);
     }
 }
 
-void UISystem::drawInspector(ResourceManager &rm) {
+void UISystem::drawInspector(Scene &scene, ResourceManager &rm) {
     ImGui::Begin("Inspector");
 
     if (selectedNode) {
-        char nameBuf[128];
-        strncpy_s(nameBuf, selectedNode->name.c_str(), sizeof(nameBuf));
-        if (ImGui::InputText("Name", nameBuf, sizeof(nameBuf))) {
-            selectedNode->name = nameBuf;
+        if (!nameEditActive) {
+            strncpy_s(nameEditBuffer, selectedNode->name.c_str(), sizeof(nameEditBuffer));
+            nameEditNode = selectedNode;
+        }
+        ImGui::InputText("Name", nameEditBuffer, sizeof(nameEditBuffer));
+        nameEditActive = ImGui::IsItemActive();
+        if (ImGui::IsItemDeactivatedAfterEdit()) {
+            const SceneNode::Ptr editedNode = nameEditNode.lock();
+            if (editedNode && editedNode->name.str() != nameEditBuffer) {
+                editedNode->name = Laphria::NodeName::owned(nameEditBuffer);
+                editedNode->markModified();
+                appliedHierarchyFilter.clear();        // the filter matches must be rescanned, not refined
+                hierarchyRowsDirty = true;
+            }
         }
 
         char stableIdBuf[128];
-        strncpy_s(stableIdBuf, selectedNode->stableId.c_str(), sizeof(stableIdBuf));
+        strncpy_s(stableIdBuf, selectedNode->stableId.toString().c_str(), sizeof(stableIdBuf));
         ImGui::InputText("Stable Id", stableIdBuf, sizeof(stableIdBuf), ImGuiInputTextFlags_ReadOnly);
 
         ImGui::Separator();
@@ -543,6 +660,54 @@ void UISystem::drawInspector(ResourceManager &rm) {
         }
 
         ImGui::Separator();
+        if (const auto &prefab = selectedNode->getPrefab(); prefab && prefab->getNodes().size() > 1) {
+            const auto &templateNodes = prefab->getNodes();
+            const auto isOverridden = [&](uint32_t index) {
+                return std::ranges::any_of(selectedNode->getPrefabOverrides(),
+                                           [index](const PrefabTemplate::Override &entry) { return entry.index == index; });
+            };
+            if (ImGui::CollapsingHeader("Prefab Instance", ImGuiTreeNodeFlags_DefaultOpen)) {
+                ImGui::Text("%zu template nodes, %zu overridden on this instance", templateNodes.size(),
+                            selectedNode->getPrefabOverrides().size());
+                if (prefabEditIndex == 0 || prefabEditIndex >= templateNodes.size()) {
+                    prefabEditIndex = 1;
+                }
+                if (ImGui::BeginCombo("Template Node", templateNodes[prefabEditIndex].name.c_str())) {
+                    for (uint32_t i = 1; i < templateNodes.size(); ++i) {
+                        ImGui::PushID(static_cast<int>(i));
+                        const bool selected = (i == prefabEditIndex);
+                        if (ImGui::Selectable(templateNodes[i].name.c_str(), selected)) {
+                            prefabEditIndex = i;
+                        }
+                        if (isOverridden(i)) {
+                            ImGui::SameLine();
+                            ImGui::TextDisabled("(overridden)");
+                        }
+                        if (selected) {
+                            ImGui::SetItemDefaultFocus();
+                        }
+                        ImGui::PopID();
+                    }
+                    ImGui::EndCombo();
+                }
+
+                // Editing a template node stores an override on this instance; the instance stays collapsed.
+                PrefabTemplate::Override local = selectedNode->getPrefabNodeTransform(prefabEditIndex);
+                glm::vec3 localEuler = glm::degrees(glm::eulerAngles(local.rotation));
+                bool edited = ImGui::DragFloat3("Node Position", glm::value_ptr(local.position), 0.1f);
+                if (ImGui::DragFloat3("Node Rotation", glm::value_ptr(localEuler), 0.5f)) {
+                    local.rotation = glm::quat(glm::radians(localEuler));
+                    edited = true;
+                }
+                edited |= ImGui::DragFloat3("Node Scale", glm::value_ptr(local.scale), 0.1f);
+                if (edited) {
+                    selectedNode->setPrefabOverride(local);
+                }
+                if (isOverridden(prefabEditIndex) && ImGui::Button("Revert Node To Template")) {
+                    selectedNode->clearPrefabOverride(prefabEditIndex);
+                }
+            }
+        }
         if (selectedNode->assetRef.path.empty()) {
             ImGui::TextUnformatted("Asset Ref: (none)");
         } else {
@@ -550,7 +715,10 @@ void UISystem::drawInspector(ResourceManager &rm) {
         }
 
         if (ImGui::CollapsingHeader("Animation Preview", ImGuiTreeNodeFlags_DefaultOpen)) {
-            ImGui::Checkbox("Enable Animation Component", &selectedNode->animation.enabled);
+            if (ImGui::Checkbox("Enable Animation Component", &selectedNode->animation.enabled)) {
+                selectedNode->markModified();
+                scene.updateComponents(selectedNode);
+            }
             if (selectedNode->animation.enabled) {
                 if (auto *modelRes = rm.getModelResource(selectedNode->modelId)) {
                     if (modelRes->hasSkins && !modelRes->hasRuntimeSkinning) {
@@ -568,6 +736,7 @@ void UISystem::drawInspector(ResourceManager &rm) {
                                 bool selected = (selectedNode->animation.clipId == clipName);
                                 if (ImGui::Selectable(clipName.c_str(), selected)) {
                                     selectedNode->animation.clipId = clipName;
+                                    selectedNode->markModified();
                                 }
                                 if (selected) {
                                     ImGui::SetItemDefaultFocus();
@@ -586,14 +755,18 @@ void UISystem::drawInspector(ResourceManager &rm) {
                 if (clipDuration <= 0.0f) {
                     clipDuration = 10.0f;
                 }
-                ImGui::SliderFloat("Time (s)", &selectedNode->animation.timeSeconds, 0.0f, clipDuration, "%.2f");
+                bool animationEdited = ImGui::SliderFloat("Time (s)", &selectedNode->animation.timeSeconds, 0.0f, clipDuration, "%.2f");
                 ImGui::Text("Clip Duration: %.2f s", clipDuration);
-                ImGui::SliderFloat("Speed", &selectedNode->animation.speed, -2.0f, 4.0f, "%.2f");
-                ImGui::Checkbox("Loop", &selectedNode->animation.loop);
-                ImGui::Checkbox("Autoplay", &selectedNode->animation.autoplay);
-                ImGui::Checkbox("Playing", &selectedNode->animation.playing);
+                animationEdited |= ImGui::SliderFloat("Speed", &selectedNode->animation.speed, -2.0f, 4.0f, "%.2f");
+                animationEdited |= ImGui::Checkbox("Loop", &selectedNode->animation.loop);
+                animationEdited |= ImGui::Checkbox("Autoplay", &selectedNode->animation.autoplay);
+                animationEdited |= ImGui::Checkbox("Playing", &selectedNode->animation.playing);
                 if (ImGui::Button("Reset Timeline")) {
                     selectedNode->animation.timeSeconds = 0.0f;
+                    animationEdited = true;
+                }
+                if (animationEdited) {
+                    selectedNode->markModified();
                 }
             }
         }
@@ -863,24 +1036,57 @@ void UISystem::drawAssetBrowser(Scene &scene, ResourceManager &rm, vk::Descripto
         ImGui::PopID();
     }
 
+    if (assetListDirty) {
+        restartAssetIndexer();
+        assetListDirty = false;
+    }
+    if (assetIndexer.getVersion() != assetRecordsVersion) {
+        assetRecordsVersion = assetIndexer.getVersion();
+        assetRecords = assetIndexer.getSnapshot();
+        assetRowsDirty = true;
+    }
+
     if (ImGui::Button("Refresh Assets")) {
-        assetListDirty = true;
+        assetIndexer.requestRescan();
     }
     ImGui::SameLine();
-    ImGui::Text("Found: %d", static_cast<int>(cachedAssetFiles.size()));
+    ImGui::Text("Found: %d%s", assetRecords ? static_cast<int>(assetRecords->size()) : 0, assetIndexer.isScanning() ? " (indexing)" : "");
 
-    if (assetListDirty) {
-        refreshAssetCache();
-        assetListDirty = false;
+    if (ImGui::InputTextWithHint("##AssetFilter", "Filter by path", assetFilter, IM_ARRAYSIZE(assetFilter))) {
+        assetRowsDirty = true;
+    }
+    if (assetRowsDirty) {
+        filteredAssetRows.clear();
+        const std::string filter = toLowerCopy(assetFilter);
+        for (size_t i = 0; assetRecords && i < assetRecords->size(); ++i) {
+            if (filter.empty() || toLowerCopy((*assetRecords)[i].path).find(filter) != std::string::npos) {
+                filteredAssetRows.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        assetRowsDirty = false;
     }
 
     ImGui::BeginChild("AssetFiles", ImVec2(0, 220), true);
-    for (const auto &assetPath : cachedAssetFiles) {
-        bool selected = (selectedAssetPath == assetPath);
-        if (ImGui::Selectable(assetPath.c_str(), selected)) {
-            selectedAssetPath = assetPath;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(filteredAssetRows.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const LaphriaEditor::AssetRecord &asset = (*assetRecords)[filteredAssetRows[row]];
+            bool selected = (selectedAssetPath == asset.path);
+            if (ImGui::Selectable(asset.path.c_str(), selected)) {
+                selectedAssetPath = asset.path;
+            }
+            if (ImGui::IsItemHovered()) {
+                if (asset.summaryValid) {
+                    ImGui::SetTooltip("%.1f KiB\n%u meshes, %u textures, %u animations\nhash %016llx", static_cast<double>(asset.size) / 1024.0,
+                                      asset.meshCount, asset.textureCount, asset.animationCount, static_cast<unsigned long long>(asset.contentHash));
+                } else {
+                    ImGui::SetTooltip("%.1f KiB\nglTF JSON could not be read", static_cast<double>(asset.size) / 1024.0);
+                }
+            }
         }
     }
+    clipper.End();
     ImGui::EndChild();
 
     if (ImGui::Button("Import Selected")) {
@@ -914,7 +1120,7 @@ void UISystem::drawAssetBrowser(Scene &scene, ResourceManager &rm, vk::Descripto
     ImGui::SameLine();
     if (ImGui::Button("Save Scene To Project Path")) {
         if (!project.sceneOutputPath.empty()) {
-            scene.saveScene(project.sceneOutputPath, rm);
+            scene.saveScene(project.sceneOutputPath, rm, scenePrettyJson);
             strncpy_s(scenePath, project.sceneOutputPath.c_str(), IM_ARRAYSIZE(scenePath));
         }
     }
@@ -1001,35 +1207,24 @@ void UISystem::drawValidationPanel()
     ImGui::End();
 }
 
-void UISystem::refreshAssetCache() {
-    cachedAssetFiles.clear();
+void UISystem::restartAssetIndexer() {
     std::vector<std::string> roots = project.assetRoots;
     if (roots.empty()) {
         roots.push_back("Assets");
     }
 
+    std::vector<std::filesystem::path> resolvedRoots;
     for (const auto &root : roots) {
-        std::error_code ec;
-        auto resolvedRoot = resolveAssetRootPath(root);
-        if (!resolvedRoot.has_value()) {
-            continue;
-        }
-
-        for (const auto &entry : std::filesystem::recursive_directory_iterator(*resolvedRoot, ec)) {
-            if (ec) {
-                break;
-            }
-            if (!entry.is_regular_file()) {
-                continue;
-            }
-            const std::string extension = toLowerCopy(entry.path().extension().string());
-            if (extension == ".gltf" || extension == ".glb") {
-                cachedAssetFiles.push_back(entry.path().string());
-            }
+        if (auto resolvedRoot = resolveAssetRootPath(root)) {
+            resolvedRoots.push_back(std::move(*resolvedRoot));
         }
     }
-    std::sort(cachedAssetFiles.begin(), cachedAssetFiles.end());
-    cachedAssetFiles.erase(std::unique(cachedAssetFiles.begin(), cachedAssetFiles.end()), cachedAssetFiles.end());
+    std::sort(resolvedRoots.begin(), resolvedRoots.end());
+    resolvedRoots.erase(std::unique(resolvedRoots.begin(), resolvedRoots.end()), resolvedRoots.end());
+
+    // The index lives next to the project file, so reopening the project skips unchanged files.
+    const std::filesystem::path indexPath = std::filesystem::path(projectPath).parent_path() / "asset_index.json";
+    assetIndexer.start(std::move(resolvedRoots), indexPath);
 }
 
 bool UISystem::isDescendant(const SceneNode::Ptr &node, const SceneNode::Ptr &candidateParent) {
@@ -1044,6 +1239,114 @@ bool UISystem::isDescendant(const SceneNode::Ptr &node, const SceneNode::Ptr &ca
     return false;
 }
 
+void UISystem::drawFrameTimeControls() {
+    frameTimeSettings.targetFrameMs = std::clamp(frameTimeSettings.targetFrameMs, 4.0f, 40.0f);
+    frameTimeSettings.textureLodBias = std::clamp(frameTimeSettings.textureLodBias, 0.0f, 2.0f);
+    frameTimeSettings.resolutionScale = std::clamp(frameTimeSettings.resolutionScale, 0.5f, 1.0f);
+
+    const char *modes[] = {"Manual", "Auto Balanced", "Auto Aggressive"};
+    int mode = static_cast<int>(frameTimeSettings.mode);
+    if (ImGui::Combo("Quality Mode", &mode, modes, IM_ARRAYSIZE(modes))) {
+        frameTimeSettings.mode = static_cast<Laphria::FrameTimeMode>(mode);
+    }
+    ImGui::DragFloat("Target Frame (ms)", &frameTimeSettings.targetFrameMs, 0.1f, 4.0f, 40.0f, "%.2f");
+    // Auto modes overwrite these every settle period; in Manual they are plain settings.
+    const char *shadowPeriods[] = {"Every Frame", "Every 2nd Frame", "Every 4th Frame"};
+    int shadowPeriod = (frameTimeSettings.shadowUpdatePeriod >= 4) ? 2 : (frameTimeSettings.shadowUpdatePeriod >= 2) ? 1 : 0;
+    if (ImGui::Combo("Far Cascade Updates", &shadowPeriod, shadowPeriods, IM_ARRAYSIZE(shadowPeriods))) {
+        frameTimeSettings.shadowUpdatePeriod = 1 << shadowPeriod;
+    }
+    ImGui::SliderFloat("Texture LOD Bias", &frameTimeSettings.textureLodBias, 0.0f, 2.0f, "%.2f");
+    // The path tracer has its own resolution scale under "Path Tracer".
+    if (renderMode != RenderMode::PathTracer) {
+        ImGui::SliderFloat("Resolution Scale##frameTime", &frameTimeSettings.resolutionScale, 0.5f, 1.0f, "%.2f");
+        ImGui::Checkbox("Temporal Upscaling", &frameTimeSettings.temporalUpscaling);
+    }
+
+    ImGui::Text("GPU Frame: %.3f ms (smoothed)", frameTimeStats.gpuFrameMs);
+    if (frameTimeStats.predictedMs > 0.0f) {
+        ImGui::Text("Predicted: %.3f ms", frameTimeStats.predictedMs);
+    } else {
+        ImGui::TextUnformatted("Predicted: collecting samples");
+    }
+    if (renderMode == RenderMode::Rasterizer) {
+        ImGui::Text("Shadows: %.3f ms (%u cascades)", frameTimeStats.shadowMs, frameTimeStats.shadowCascadesRendered);
+    }
+    ImGui::Text("Scene: %.3f ms", frameTimeStats.sceneMs);
+
+    if (renderMode == RenderMode::Rasterizer) {
+        ImGui::Checkbox("Occlusion Culling", &occlusionCulling);
+        const RasterCullingStats &culling = rasterCullingStats;
+        if (occlusionCulling) {
+            ImGui::Text("Instances: %u in frustum", culling.frustumInstances);
+            ImGui::Text("Drawn: %u early, %u late; %u occluded", culling.drawnEarly, culling.drawnLate, culling.occluded);
+        }
+        ImGui::Text("Shadow casters culled: %u", culling.shadowCastersCulled);
+    }
+    ImGui::Checkbox("Skip Off-screen Skinning", &offscreenSkinningCulling);
+    ImGui::Text("Skinned models: %u posed, %u skipped", skinningCullingStats.posed, skinningCullingStats.skipped);
+}
+
+void UISystem::drawProgressiveControls() {
+    pathTracerSettings.progressiveSamplesPerFrame = std::clamp(pathTracerSettings.progressiveSamplesPerFrame, 1, 8);
+    pathTracerSettings.progressiveTargetSpp = std::clamp(pathTracerSettings.progressiveTargetSpp, 1, 1 << 20);
+    pathTracerSettings.progressiveNoiseThreshold = std::clamp(pathTracerSettings.progressiveNoiseThreshold, 0.0f, 0.5f);
+
+    // Replaces reprojection and the denoiser with an unbiased running mean that restarts whenever anything moves.
+    ImGui::Checkbox("Progressive Reference", &pathTracerSettings.progressiveReference);
+    if (!pathTracerSettings.progressiveReference) {
+        return;
+    }
+    ImGui::SliderInt("Samples / Frame", &pathTracerSettings.progressiveSamplesPerFrame, 1, 8);
+    ImGui::DragInt("Target SPP", &pathTracerSettings.progressiveTargetSpp, 16.0f, 1, 1 << 20);
+    ImGui::DragFloat("Noise Threshold", &pathTracerSettings.progressiveNoiseThreshold, 0.001f, 0.0f, 0.5f, "%.3f");
+
+    const ProgressiveStats &stats = progressiveStats;
+    const float progress = std::min(1.0f, static_cast<float>(stats.samplesPerPixel) /
+                                              static_cast<float>(std::max(pathTracerSettings.progressiveTargetSpp, 1)));
+    char overlay[64];
+    std::snprintf(overlay, sizeof(overlay), "%u / %d SPP", stats.samplesPerPixel, pathTracerSettings.progressiveTargetSpp);
+    ImGui::ProgressBar(stats.converged ? 1.0f : progress, ImVec2(-1.0f, 0.0f), overlay);
+    ImGui::Text("Samples / sec: %.1f", stats.samplesPerSecond);
+    if (stats.noisyPixelFraction >= 0.0f) {
+        ImGui::Text("Pixels above threshold: %.2f%%", stats.noisyPixelFraction * 100.0f);
+    }
+    if (stats.converged) {
+        ImGui::Text("Converged in %.2f s", stats.elapsedSeconds);
+    } else if (stats.estimatedSecondsRemaining >= 0.0f) {
+        ImGui::Text("Elapsed: %.2f s, remaining: ~%.1f s", stats.elapsedSeconds, stats.estimatedSecondsRemaining);
+    }
+
+    ImGui::InputText("Export Path##progressive", progressiveExportPath, IM_ARRAYSIZE(progressiveExportPath));
+    if (ImGui::Button("Export Progress")) {
+        if (exportProgressiveStats(progressiveExportPath)) {
+            LOGI("Exported progressive stats: %s", progressiveExportPath);
+        } else {
+            LOGI("Failed to export progressive stats: %s", progressiveExportPath);
+        }
+    }
+}
+
+bool UISystem::exportProgressiveStats(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    // Summary first as comment lines, then one CSV row per recorded sample.
+    out << "# target_spp," << pathTracerSettings.progressiveTargetSpp
+        << ",noise_threshold," << pathTracerSettings.progressiveNoiseThreshold
+        << ",samples_per_frame," << pathTracerSettings.progressiveSamplesPerFrame << '\n';
+    out << "# spp," << progressiveStats.samplesPerPixel
+        << ",seconds," << progressiveStats.elapsedSeconds
+        << ",samples_per_second," << progressiveStats.samplesPerSecond
+        << ",converged," << (progressiveStats.converged ? 1 : 0) << '\n';
+    out << "seconds,spp,noisy_pixel_fraction\n";
+    for (const ProgressiveSample &sample: progressiveStats.history) {
+        out << sample.seconds << ',' << sample.samplesPerPixel << ',' << sample.noisyPixelFraction << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
 void UISystem::drawPhysicsUI(Scene &scene, PhysicsSystem &physics,
                              ResourceManager &rm, vk::DescriptorSetLayout matLayout) {
     ImGui::Begin("Engine Controls");
@@ -1051,45 +1354,93 @@ void UISystem::drawPhysicsUI(Scene &scene, PhysicsSystem &physics,
     ImGui::Text("Rendering Backend:");
     if (ImGui::RadioButton("Rasterizer", renderMode == RenderMode::Rasterizer))
         renderMode = RenderMode::Rasterizer;
+    ImGui::BeginDisabled(!rayTracingAvailable);
     ImGui::SameLine();
     if (ImGui::RadioButton("Ray Tracer", renderMode == RenderMode::RayTracer))
         renderMode = RenderMode::RayTracer;
     ImGui::SameLine();
     if (ImGui::RadioButton("Path Tracer##render_mode", renderMode == RenderMode::PathTracer))
         renderMode = RenderMode::PathTracer;
+    ImGui::EndDisabled();
+    if (!rayTracingAvailable) {
+        ImGui::TextColored(ImVec4(1.0f, 0.72f, 0.30f, 1.0f), "Ray tracing not supported by this GPU: raster-only tier.");
+    }
     ImGui::SliderFloat("Exposure", &exposure, 0.1f, 4.0f, "%.2f");
     const char *colorSpaceModels[] = {"Hardware SRGB", "Legacy Manual"};
     int colorSpaceMode = static_cast<int>(textureColorSpaceModel);
     ImGui::Combo("Texture Color Space", &colorSpaceMode, colorSpaceModels, IM_ARRAYSIZE(colorSpaceModels));
     textureColorSpaceModel = static_cast<TextureColorSpaceModel>(colorSpaceMode);
 
+    if (ImGui::CollapsingHeader("Frame Time", ImGuiTreeNodeFlags_DefaultOpen)) {
+        drawFrameTimeControls();
+    }
+
     if (ImGui::CollapsingHeader("Path Tracer##settings", ImGuiTreeNodeFlags_DefaultOpen)) {
         pathTracerSettings.resolutionScale = std::clamp(pathTracerSettings.resolutionScale, 0.5f, 1.0f);
         pathTracerSettings.denoiserIterations = std::clamp(pathTracerSettings.denoiserIterations, 1, 5);
-        pathTracerSettings.targetFrameMs = std::clamp(pathTracerSettings.targetFrameMs, 8.0f, 40.0f);
+        pathTracerSettings.maxSamplesPerPixel = std::clamp(pathTracerSettings.maxSamplesPerPixel, 1, 8);
+        pathTracerSettings.maxBounces = std::clamp(pathTracerSettings.maxBounces, 1, 3);
 
         ImGui::SliderFloat("Resolution Scale", &pathTracerSettings.resolutionScale, 0.5f, 1.0f, "%.2f");
         ImGui::SliderInt("Denoiser Iterations", &pathTracerSettings.denoiserIterations, 1, 5);
-        const char *qualityModes[] = {"Manual", "Auto Balanced", "Auto Aggressive"};
-        int qualityMode = static_cast<int>(pathTracerSettings.qualityMode);
-        if (ImGui::Combo("Quality Mode", &qualityMode, qualityModes, IM_ARRAYSIZE(qualityModes))) {
-            pathTracerSettings.qualityMode = static_cast<PathTracerQualityMode>(qualityMode);
-        }
         ImGui::Checkbox("Reduce Secondary Effects", &pathTracerSettings.reduceSecondaryEffects);
-        ImGui::DragFloat("Target Frame (ms)", &pathTracerSettings.targetFrameMs, 0.1f, 8.0f, 40.0f, "%.2f");
+        // The budget comes from temporal history, so adaptive sampling only applies with reprojection on.
+        ImGui::Checkbox("Adaptive Sampling", &pathTracerSettings.adaptiveSampling);
+        ImGui::SliderInt("Max Samples / Pixel", &pathTracerSettings.maxSamplesPerPixel, 1, 8);
+        ImGui::SliderInt("Max Bounces", &pathTracerSettings.maxBounces, 1, 3);
+        ImGui::BeginDisabled(!wavefrontAvailable);
+        ImGui::Checkbox("Wavefront Tracer", &pathTracerSettings.wavefront);
+        ImGui::EndDisabled();
+        if (!wavefrontAvailable) {
+            pathTracerSettings.wavefront = false;
+            ImGui::SameLine();
+            ImGui::TextDisabled("(needs VK_KHR_ray_query)");
+        } else if (pathTracerSettings.wavefront) {
+            ImGui::SameLine();
+            ImGui::Checkbox("Sort Hits by Material", &pathTracerSettings.sortHitsByMaterial);
+        }
+
+        ImGui::Separator();
+        drawProgressiveControls();
         
         ImGui::Separator();
         ImGui::Text("Debug Toggles:");
         ImGui::Checkbox("Enable Reprojection", &pathTracerSettings.enableReprojection);
         ImGui::Checkbox("Enable Denoiser", &pathTracerSettings.enableDenoiser);
+        ImGui::Checkbox("Tiled Denoiser", &pathTracerSettings.useTiledDenoiser);
 
         ImGui::Separator();
         ImGui::Text("PT Timings (GPU):");
         ImGui::Text("TLAS: %.3f ms", pathTracerPerfStats.tlasBuildMs);
         ImGui::Text("Ray Trace: %.3f ms", pathTracerPerfStats.rayTraceMs);
-        ImGui::Text("Reprojection: %.3f ms", pathTracerPerfStats.reprojectionMs);
-        ImGui::Text("Denoiser: %.3f ms", pathTracerPerfStats.denoiserMs);
+        if (pathTracerSettings.wavefront) {
+            static const char *kernelNames[] = {"Primary", "Generate", "Extend", "Bin", "Scatter", "Shade", "Shadow", "Resolve"};
+            for (int kernel = 0; kernel < IM_ARRAYSIZE(kernelNames); ++kernel) {
+                ImGui::Text("  %s: %.3f ms", kernelNames[kernel], pathTracerPerfStats.wavefrontKernelMs[kernel]);
+            }
+            if (pathTracerPerfStats.wavefrontTimingTruncated) {
+                ImGui::TextColored(ImVec4(1.0f, 0.72f, 0.30f, 1.0f), "  Kernel timings truncated: later dispatches untimed");
+            }
+        }
+        // Last trace time per tracer and bounce count; 0 until that combination has run.
+        const float (&traceMs)[2][3] = pathTracerPerfStats.traceMsByTracer;
+        ImGui::Text("Megakernel 1/2/3 bounces: %.2f / %.2f / %.2f ms", traceMs[0][0], traceMs[0][1], traceMs[0][2]);
+        ImGui::Text("Wavefront  1/2/3 bounces: %.2f / %.2f / %.2f ms", traceMs[1][0], traceMs[1][1], traceMs[1][2]);
+        const bool progressive = pathTracerSettings.progressiveReference;
+        const bool fusedFirstIteration = pathTracerSettings.useTiledDenoiser && pathTracerSettings.enableReprojection &&
+                                         pathTracerSettings.enableDenoiser && pathTracerSettings.denoiserIterations > 1;
+        if (!progressive) {
+            ImGui::Text("%s: %.3f ms", fusedFirstIteration ? "Reprojection + A-Trous 1" : "Reprojection", pathTracerPerfStats.reprojectionMs);
+        }
+        ImGui::Text("%s: %.3f ms", progressive ? "Accumulate" : "Denoiser", pathTracerPerfStats.denoiserMs);
+        const int iterationsShown = (pathTracerSettings.enableDenoiser && !progressive) ? pathTracerSettings.denoiserIterations : 0;
+        for (int iter = fusedFirstIteration ? 1 : 0; iter < iterationsShown; ++iter) {
+            ImGui::Text("  A-Trous %d: %.3f ms", iter + 1, pathTracerPerfStats.denoiserIterationMs[iter]);
+        }
         ImGui::Text("Total: %.3f ms", pathTracerPerfStats.totalFrameMs);
+        if (pathTracerPerfStats.sampleBudgetScale > 0.0f) {
+            ImGui::Text("Sample Budget Scale: %.2f", pathTracerPerfStats.sampleBudgetScale);
+        }
     }
 
     ImGui::Separator();
@@ -1108,14 +1459,15 @@ void UISystem::drawPhysicsUI(Scene &scene, PhysicsSystem &physics,
     }
     ImGui::SameLine();
     if (ImGui::Button("Random Impulse")) {
-        for (auto &node: scene.getAllNodes()) {
-            if (node->physics.enabled && !node->physics.isStatic) {
+        for (const auto &node: scene.getPhysicsBodies()) {
+            if (!node->physics.isStatic) {
                 std::uniform_real_distribution<float> dist(0.0f, 1.0f);
                 float rx = dist(rng);
                 float ry = dist(rng);
                 float rz = dist(rng);
                 glm::vec3 randomDir = glm::normalize(glm::vec3(rx, ry, rz) * 2.0f - 1.0f);
                 node->physics.velocity += randomDir * 15.0f;
+                node->recordTransformChange();
             }
         }
     }
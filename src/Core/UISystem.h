@@ -3,35 +3,84 @@
 
 #include <random>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "../Physics/PhysicsSystem.h"
 #include "../SceneManagement/Scene.h"
+#include "AssetIndexer.h"
 #include "EditorValidation.h"
 #include "EditorProject.h"
+#include "EngineConfig.h"
 #include "Camera.h"
 #include "EngineAuxiliary.h"
+#include "FrameTimeController.h"
 #include "VulkanDevice.h"
 
 // Owns ImGui lifecycle, all editor draw calls, and UI-driven simulation state.
 class UISystem {
 public:
-    enum class PathTracerQualityMode
+    // The frame-time controller owns these knobs (the path tracer uses its own resolution scale, plus its
+    // denoiser iterations) in the auto modes; in Manual they stay where they are set.
+    struct FrameTimeSettings
     {
-        Manual = 0,
-        AutoBalanced = 1,
-        AutoAggressive = 2
+        Laphria::FrameTimeMode mode = Laphria::FrameTimeMode::Manual;
+        float                  targetFrameMs = 16.6f;
+        int                    shadowUpdatePeriod = 1;   // raster: far cascades re-render every Nth frame (1, 2, 4)
+        float                  textureLodBias = 0.0f;
+        float                  resolutionScale = 1.0f;   // raster and classic RT render extent (0.5-1)
+        bool                   temporalUpscaling = true; // below 1: jittered frames reconstructed to native, else a blit
+    };
+
+    struct FrameTimeStats
+    {
+        float    gpuFrameMs = 0.0f;                 // smoothed, whole command buffer
+        float    predictedMs = 0.0f;                // cost model at the current knobs; 0 while it warms up
+        float    shadowMs = 0.0f;
+        float    sceneMs = 0.0f;                    // raster main pass, RT trace or PT trace
+        uint32_t shadowCascadesRendered = 0;
+    };
+
+    // Raster mesh instances of the last read-back frame. Occlusion tests mesh instances (node, prefab template
+    // node, mesh); instances drawn untested count as drawn early.
+    struct RasterCullingStats
+    {
+        uint32_t frustumInstances = 0;       // left by the octree and frustum test
+        uint32_t drawnEarly = 0;             // visible last frame, without bounds, or beyond the candidate limit
+        uint32_t drawnLate = 0;              // newly visible, drawn after the depth pyramid test
+        uint32_t occluded = 0;
+        uint32_t shadowCastersCulled = 0;    // caster draws skipped across the rendered cascades
+    };
+
+    // Skinned models of the last recorded frame. A skipped model is outside the camera and the re-rendered
+    // cascades both in its new pose and in the one its skinned stream holds, so it keeps the latter.
+    struct SkinningCullingStats
+    {
+        uint32_t posed = 0;
+        uint32_t skipped = 0;
     };
 
     struct PathTracerSettings
     {
         float                 resolutionScale = 1.0f;
         int                   denoiserIterations = 1;
-        PathTracerQualityMode qualityMode = PathTracerQualityMode::Manual;
         bool                  reduceSecondaryEffects = false;
-        float                 targetFrameMs = 16.6f;
         bool                  enableReprojection = true;
         bool                  enableDenoiser = true;
+        bool                  useTiledDenoiser = true;   // fused reprojection + shared-memory A-Trous (2+ iterations)
+        bool                  adaptiveSampling = true;   // variance-guided paths per pixel (needs reprojection)
+        int                   maxSamplesPerPixel = 4;
+        int                   maxBounces = 3;            // surface hits per path, the primary hit included
+        // Wavefront tracer: the same paths as a chain of compute kernels over ray queues, shaded in material
+        // order, instead of one ray tracing megakernel.
+        bool                  wavefront = false;
+        bool                  sortHitsByMaterial = true;
+        // Progressive reference mode: accumulates a converged still instead of denoising. The noise threshold is
+        // the relative standard error every pixel must reach; 0 stops at the target SPP only.
+        bool                  progressiveReference = false;
+        int                   progressiveSamplesPerFrame = 4;
+        int                   progressiveTargetSpp = 1024;
+        float                 progressiveNoiseThreshold = 0.01f;
     };
 
     struct PathTracerPerfStats
@@ -40,7 +89,31 @@ public:
         float rayTraceMs = 0.0f;
         float reprojectionMs = 0.0f;
         float denoiserMs = 0.0f;
-        float totalFrameMs = 0.0f;
+        float denoiserIterationMs[5] = {};   // per A-Trous iteration; 0 for iterations not run
+        float sampleBudgetScale = 0.0f;      // adaptive sampling paths per unit of error; 0 when off
+        float totalFrameMs = 0.0f;           // whole command buffer
+        float wavefrontKernelMs[8] = {};     // per Laphria::WavefrontKernel; 0 with the megakernel
+        float traceMsByTracer[2][3] = {};    // last trace time, [megakernel, wavefront][bounces - 1]
+        bool wavefrontTimingTruncated = false; // the timestamp pool ran out before the last dispatch
+    };
+
+    struct ProgressiveSample
+    {
+        float    seconds = 0.0f;
+        uint32_t samplesPerPixel = 0;
+        float    noisyPixelFraction = -1.0f;   // -1 until the first noise count is read back
+    };
+
+    // Filled by EngineCore while progressive mode accumulates; reset whenever the accumulation restarts.
+    struct ProgressiveStats
+    {
+        uint32_t samplesPerPixel = 0;
+        float    elapsedSeconds = 0.0f;
+        float    samplesPerSecond = 0.0f;            // paths per pixel per second
+        float    noisyPixelFraction = -1.0f;
+        float    estimatedSecondsRemaining = -1.0f;  // towards the target SPP; -1 when unknown
+        bool     converged = false;
+        std::vector<ProgressiveSample> history;      // one row every quarter second, plus the final one
     };
 
     // Call after the swapchain has been created (needs colorFormat / depthFormat).
@@ -57,13 +130,22 @@ public:
     // State shared with EngineCore's main loop.
     bool useGPUPhysics = false;
     RenderMode renderMode = RenderMode::Rasterizer;
+    bool rayTracingAvailable = true;        // false on the raster-only device tier: the RT backends are disabled
+    bool wavefrontAvailable = true;         // false without ray queries: the path tracer keeps the megakernel
     TextureColorSpaceModel textureColorSpaceModel = TextureColorSpaceModel::HardwareSrgb;
     bool simulationRunning = false;
     float physicsTime = 0.0f; // updated by EngineCore after each tick
     glm::vec3 lightDirection = glm::vec3(-0.30f, -1.0f, -0.20f);
     float exposure = 1.0f;
+    FrameTimeSettings frameTimeSettings;
+    FrameTimeStats frameTimeStats;
+    bool occlusionCulling = true;        // raster: two-phase depth pyramid culling of mesh instances
+    RasterCullingStats rasterCullingStats;
+    bool offscreenSkinningCulling = true;        // skip the skinning dispatch and BLAS refit of unseen characters
+    SkinningCullingStats skinningCullingStats;
     PathTracerSettings pathTracerSettings;
     PathTracerPerfStats pathTracerPerfStats;
+    ProgressiveStats progressiveStats;
     bool showEditorPanels = true;
 
 private:
@@ -75,11 +157,27 @@ private:
         Scale = 3
     };
 
+    struct HierarchyRow
+    {
+        SceneNode::Ptr node;
+        int depth = 0;
+    };
+
     vk::raii::DescriptorPool imguiDescriptorPool{nullptr};
 
     // Editor state
     SceneNode::Ptr selectedNode{nullptr};
     std::vector<SceneNode::Ptr> nodesPendingDeletion;
+    // The hierarchy panel draws a flattened list of its visible rows through a list clipper. The list is
+    // rebuilt only when the scene's node set, the expanded set or the name filter changes.
+    std::vector<HierarchyRow> hierarchyRows;
+    // Keyed by stable ID: an address can be reused by a node created after the expanded one was deleted.
+    std::unordered_set<Laphria::StableId> expandedHierarchyNodes;
+    std::vector<SceneNode::Ptr> hierarchyFilterMatches;
+    std::string appliedHierarchyFilter;        // lower-cased filter that produced hierarchyFilterMatches
+    char hierarchyFilter[128] = "";
+    uint64_t hierarchyRowsVersion = 0;
+    bool hierarchyRowsDirty = true;
     bool showModelLoadDialog = false;
     char modelLoadPath[512] = "assets/paladin.glb";
     bool showSceneSaveDialog = false;
@@ -87,17 +185,31 @@ private:
     bool showProjectLoadDialog = false;
     bool showProjectSaveDialog = false;
     char scenePath[512] = "scene.json";
+    bool scenePrettyJson = false;        // indented output for diffing; compact is smaller and faster to write
+    bool sceneAutosaveEnabled = false;
+    float sceneAutosaveIntervalSeconds = Laphria::EngineConfig::kDefaultSceneAutosaveIntervalSeconds;
+    char progressiveExportPath[512] = "progressive_stats.csv";
     char projectPath[512] = "project.laphria_project.json";
     char newAssetRootPath[512] = "Assets";
     bool hasLoadedProject = false;
     LaphriaEditor::EditorProject project;
-    bool assetListDirty = true;
-    std::vector<std::string> cachedAssetFiles;
+    bool assetListDirty = true;        // asset roots changed; restarts the indexer
+    LaphriaEditor::AssetIndexer assetIndexer;
+    LaphriaEditor::AssetIndexer::Snapshot assetRecords;
+    std::vector<uint32_t> filteredAssetRows;        // indices into assetRecords that pass assetFilter
+    uint64_t assetRecordsVersion = 0;
+    char assetFilter[128] = "";
+    bool assetRowsDirty = true;
     std::string selectedAssetPath;
     std::vector<std::string> lastImportMessages;
     LaphriaEditor::ValidationReport lastValidationReport;
     bool hasValidationReport = false;
     SceneNode::Ptr nodePendingReparent{nullptr};
+    // Inspector name field, assigned to the node it was loaded from when the edit is committed.
+    char nameEditBuffer[128] = "";
+    std::weak_ptr<SceneNode> nameEditNode;
+    bool nameEditActive = false;
+    uint32_t prefabEditIndex = 1;        // template node of the selected prefab instance shown in the inspector
     std::mt19937 rng{std::random_device{}()};
     TransformGizmoMode transformGizmoMode = TransformGizmoMode::Translate;
     int activeTransformAxis = -1;
@@ -111,20 +223,26 @@ private:
 
     void drawSceneHierarchy(Scene &scene);
 
-    void drawSceneNode(const SceneNode::Ptr &node, Scene &scene);
+    void rebuildHierarchyRows(Scene &scene);
 
-    void drawInspector(ResourceManager &rm);
+    void drawSceneNode(const HierarchyRow &row, Scene &scene);
+
+    void drawInspector(Scene &scene, ResourceManager &rm);
 
     void drawAssetBrowser(Scene &scene, ResourceManager &rm, vk::DescriptorSetLayout matLayout);
     void drawValidationPanel();
 
-    void refreshAssetCache();
+    void restartAssetIndexer();
 
     static bool isDescendant(const SceneNode::Ptr &node, const SceneNode::Ptr &candidateParent);
 
     void drawPhysicsUI(Scene &scene, PhysicsSystem &physics,
                        ResourceManager &rm, vk::DescriptorSetLayout matLayout);
 
+    void drawFrameTimeControls();
+    void drawProgressiveControls();
+    bool exportProgressiveStats(const std::string &path) const;
+
     void drawSelectedNodeTransformGizmo(Camera &camera);
 };
 
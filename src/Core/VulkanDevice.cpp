@@ -22,11 +22,11 @@ VulkanDevice::~VulkanDevice()
 	}
 }
 
-void VulkanDevice::init(GLFWwindow *window)
+void VulkanDevice::init(GLFWwindow *window, bool allowRayTracing)
 {
 	createInstance();
 	createSurface(window);
-	pickPhysicalDevice();
+	pickPhysicalDevice(allowRayTracing);
 	createLogicalDevice();
 	VmaContext::initialize(*instance, *physicalDevice, *logicalDevice);
 }
@@ -72,13 +72,48 @@ void VulkanDevice::createSurface(GLFWwindow *window)
 	surface = vk::raii::SurfaceKHR(instance, _surface);
 }
 
-void VulkanDevice::pickPhysicalDevice()
+bool VulkanDevice::supportsRayTracing(const vk::raii::PhysicalDevice &device) const
+{
+	auto availableExtensions = device.enumerateDeviceExtensionProperties();
+	bool hasAllExtensions    = std::ranges::all_of(rayTracingDeviceExtension, [&](auto const &req) {
+		return std::ranges::any_of(availableExtensions, [&](auto const &avail) {
+			return strcmp(avail.extensionName, req) == 0;
+		});
+	});
+	if (!hasAllExtensions)
+	{
+		return false;
+	}
+
+	// The extensions may be exposed without the features (e.g. acceleration structures on some software drivers).
+	auto featureChain = device.getFeatures2<
+	    vk::PhysicalDeviceFeatures2,
+	    vk::PhysicalDeviceAccelerationStructureFeaturesKHR,
+	    vk::PhysicalDeviceRayTracingPipelineFeaturesKHR>();
+	return featureChain.get<vk::PhysicalDeviceAccelerationStructureFeaturesKHR>().accelerationStructure &&
+	       featureChain.get<vk::PhysicalDeviceRayTracingPipelineFeaturesKHR>().rayTracingPipeline;
+}
+
+bool VulkanDevice::supportsRayQuery(const vk::raii::PhysicalDevice &device)
+{
+	auto availableExtensions = device.enumerateDeviceExtensionProperties();
+	bool hasExtension        = std::ranges::any_of(availableExtensions, [](auto const &avail) {
+		return strcmp(avail.extensionName, vk::KHRRayQueryExtensionName) == 0;
+	});
+	return hasExtension &&
+	       device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceRayQueryFeaturesKHR>()
+	           .get<vk::PhysicalDeviceRayQueryFeaturesKHR>()
+	           .rayQuery;
+}
+
+void VulkanDevice::pickPhysicalDevice(bool allowRayTracing)
 {
 	std::vector<vk::raii::PhysicalDevice> devices = instance.enumeratePhysicalDevices();
 
 	struct ScoredDevice
 	{
 		uint32_t                 score;
+		bool                     rayTracing;
 		vk::raii::PhysicalDevice device;
 	};
 
@@ -111,6 +146,13 @@ void VulkanDevice::pickPhysicalDevice()
 		}
 
 		// ── Scoring (higher is better) ────────────────────────────────────
+		// A ray tracing capable device always wins over one limited to the raster tier.
+		const bool rayTracing = allowRayTracing && supportsRayTracing(device);
+		if (rayTracing)
+		{
+			score += 1000000;
+		}
+
 		// Discrete GPUs are strongly preferred over integrated ones.
 		if (props.deviceType == vk::PhysicalDeviceType::eDiscreteGpu)
 		{
@@ -131,7 +173,7 @@ void VulkanDevice::pickPhysicalDevice()
 			}
 		}
 
-		scoredDevices.push_back({score, device});
+		scoredDevices.push_back({score, rayTracing, device});
 	}
 
 	std::ranges::sort(scoredDevices, [](const auto &a, const auto &b) {
@@ -140,10 +182,22 @@ void VulkanDevice::pickPhysicalDevice()
 
 	if (!scoredDevices.empty())
 	{
-		physicalDevice = std::move(scoredDevices[0].device);
-		auto props     = physicalDevice.getProperties();
+		physicalDevice      = std::move(scoredDevices[0].device);
+		rayTracingSupported = scoredDevices[0].rayTracing;
+		auto props          = physicalDevice.getProperties();
 		LOGI("Selected GPU: %s (Score: %u)", props.deviceName.data(), scoredDevices[0].score);
 
+		if (!rayTracingSupported)
+		{
+			LOGI("Ray tracing unavailable: running the raster-only tier");
+			return;
+		}
+		rayQuerySupported = supportsRayQuery(physicalDevice);
+		if (!rayQuerySupported)
+		{
+			LOGI("Ray queries unavailable: the wavefront path tracer is disabled");
+		}
+
 		// --- Extract Ray Tracing Properties ---
 		// We use getProperties2 with a StructureChain to append the RT properties struct
 		auto propsChain = physicalDevice.getProperties2<
@@ -191,6 +245,7 @@ void VulkanDevice::createLogicalDevice()
 	    vk::PhysicalDeviceBufferDeviceAddressFeatures,
 	    vk::PhysicalDeviceAccelerationStructureFeaturesKHR,
 	    vk::PhysicalDeviceRayTracingPipelineFeaturesKHR,
+	    vk::PhysicalDeviceRayQueryFeaturesKHR,
 	    vk::PhysicalDeviceDescriptorIndexingFeatures>
 	    featureChain;
 
@@ -223,11 +278,34 @@ void VulkanDevice::createLogicalDevice()
 	auto &bdaFeatures               = featureChain.get<vk::PhysicalDeviceBufferDeviceAddressFeatures>();
 	bdaFeatures.bufferDeviceAddress = vk::True;
 
-	auto &asFeatures                 = featureChain.get<vk::PhysicalDeviceAccelerationStructureFeaturesKHR>();
-	asFeatures.accelerationStructure = vk::True;
+	std::vector<const char *> enabledExtensions = requiredDeviceExtension;
+	if (rayTracingSupported)
+	{
+		auto &asFeatures                 = featureChain.get<vk::PhysicalDeviceAccelerationStructureFeaturesKHR>();
+		asFeatures.accelerationStructure = vk::True;
 
-	auto &rtFeatures              = featureChain.get<vk::PhysicalDeviceRayTracingPipelineFeaturesKHR>();
-	rtFeatures.rayTracingPipeline = vk::True;
+		auto &rtFeatures              = featureChain.get<vk::PhysicalDeviceRayTracingPipelineFeaturesKHR>();
+		rtFeatures.rayTracingPipeline = vk::True;
+
+		enabledExtensions.insert(enabledExtensions.end(), rayTracingDeviceExtension.begin(), rayTracingDeviceExtension.end());
+	}
+	else
+	{
+		// Feature structs of extensions that are not enabled must not be chained.
+		featureChain.unlink<vk::PhysicalDeviceAccelerationStructureFeaturesKHR>();
+		featureChain.unlink<vk::PhysicalDeviceRayTracingPipelineFeaturesKHR>();
+	}
+	if (rayQuerySupported)
+	{
+		// Ray queries let the wavefront path tracer's compute kernels trace against the same TLAS.
+		auto &rayQueryFeatures    = featureChain.get<vk::PhysicalDeviceRayQueryFeaturesKHR>();
+		rayQueryFeatures.rayQuery = vk::True;
+		enabledExtensions.push_back(vk::KHRRayQueryExtensionName);
+	}
+	else
+	{
+		featureChain.unlink<vk::PhysicalDeviceRayQueryFeaturesKHR>();
+	}
 
 	float                     queuePriority = 0.5f;
 	vk::DeviceQueueCreateInfo deviceQueueCreateInfo{
@@ -239,8 +317,8 @@ void VulkanDevice::createLogicalDevice()
 	    .pNext                   = &featureChain.get<vk::PhysicalDeviceFeatures2>(),
 	    .queueCreateInfoCount    = 1,
 	    .pQueueCreateInfos       = &deviceQueueCreateInfo,
-	    .enabledExtensionCount   = static_cast<uint32_t>(requiredDeviceExtension.size()),
-	    .ppEnabledExtensionNames = requiredDeviceExtension.data()};
+	    .enabledExtensionCount   = static_cast<uint32_t>(enabledExtensions.size()),
+	    .ppEnabledExtensionNames = enabledExtensions.data()};
 
 	logicalDevice = vk::raii::Device(physicalDevice, deviceCreateInfo);
 	queue         = vk::raii::Queue(logicalDevice, queueIndex, 0);
@@ -255,6 +333,15 @@ vk::Format VulkanDevice::findDepthFormat() const
 	    vk::FormatFeatureFlagBits::eDepthStencilAttachment);
 }
 
+vk::Format VulkanDevice::findAtrousFormat() const
+{
+	// Storage support for the packed format is optional; RGBA16F storage images are required by the spec.
+	return findSupportedFormat(
+	    {vk::Format::eB10G11R11UfloatPack32, vk::Format::eR16G16B16A16Sfloat},
+	    vk::ImageTiling::eOptimal,
+	    vk::FormatFeatureFlagBits::eStorageImage);
+}
+
 vk::Format VulkanDevice::findSupportedFormat(const std::vector<vk::Format> &candidates,
                                              vk::ImageTiling                tiling,
                                              vk::FormatFeatureFlags         features) const
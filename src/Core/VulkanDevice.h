@@ -10,9 +10,12 @@ class VulkanDevice {
 public:
     ~VulkanDevice();
 
-    void init(GLFWwindow *window);
+    // allowRayTracing = false selects the raster-only tier even on a device that supports ray tracing.
+    void init(GLFWwindow *window, bool allowRayTracing = true);
 
     [[nodiscard]] vk::Format findDepthFormat() const;
+    // A-Trous ping-pong storage format: packed B10G11R11 where it supports storage, else the mandatory RGBA16F.
+    [[nodiscard]] vk::Format findAtrousFormat() const;
     [[nodiscard]] vk::Format findSupportedFormat(const std::vector<vk::Format> &candidates,
                                                   vk::ImageTiling tiling,
                                                   vk::FormatFeatureFlags features) const;
@@ -26,13 +29,22 @@ public:
     vk::raii::Device                 logicalDevice{nullptr};
     uint32_t                         queueIndex = ~0u; // ~0 == UINT32_MAX, Vulkan convention
     vk::raii::Queue                  queue{nullptr};
-	// Ray Tracing hardware properties
+	// Capability tier. Without ray tracing only the rasterizer runs: no acceleration structures, RT pipelines,
+	// shader binding tables or wavefront kernels are created, and the RT render modes are unavailable.
+	bool rayTracingSupported = false;
+	// Ray queries from compute shaders, needed by the wavefront path tracer only. Never set without rayTracingSupported;
+	// without it the megakernel path tracer still runs and no wavefront kernels or queues are created.
+	bool rayQuerySupported = false;
+	// Ray Tracing hardware properties (zeroed when rayTracingSupported is false)
 	vk::PhysicalDeviceRayTracingPipelinePropertiesKHR rayTracingProperties;
 
     std::vector<const char *> requiredDeviceExtension = {
         vk::KHRSwapchainExtensionName,
         vk::KHRCreateRenderpass2ExtensionName,
-        vk::EXTDescriptorIndexingExtensionName,
+        vk::EXTDescriptorIndexingExtensionName
+    };
+    // Enabled on top of requiredDeviceExtension when the device supports all of them.
+    std::vector<const char *> rayTracingDeviceExtension = {
     	vk::KHRAccelerationStructureExtensionName,
     	vk::KHRRayTracingPipelineExtensionName,
 		vk::KHRDeferredHostOperationsExtensionName
@@ -41,7 +53,9 @@ public:
 private:
     void createInstance();
     void createSurface(GLFWwindow *window);
-    void pickPhysicalDevice();
+    void pickPhysicalDevice(bool allowRayTracing);
+    [[nodiscard]] bool supportsRayTracing(const vk::raii::PhysicalDevice &device) const;
+    [[nodiscard]] static bool supportsRayQuery(const vk::raii::PhysicalDevice &device);
     void createLogicalDevice();
 
     static std::vector<const char *> getRequiredExtensions();
@@ -623,6 +623,22 @@ vk::raii::ImageView createImageViewArray(const vk::raii::Device &device, vk::Ima
 	return vk::raii::ImageView(device, viewInfo);
 }
 
+vk::raii::ImageView createImageViewMip(const vk::raii::Device &device, vk::Image image, vk::Format format,
+                                       vk::ImageAspectFlags aspectFlags, uint32_t baseMipLevel)
+{
+	vk::ImageViewCreateInfo viewInfo{};
+	viewInfo.image                           = image;
+	viewInfo.viewType                        = vk::ImageViewType::e2D;
+	viewInfo.format                          = format;
+	viewInfo.subresourceRange.aspectMask     = aspectFlags;
+	viewInfo.subresourceRange.baseMipLevel   = baseMipLevel;
+	viewInfo.subresourceRange.levelCount     = 1;
+	viewInfo.subresourceRange.baseArrayLayer = 0;
+	viewInfo.subresourceRange.layerCount     = 1;
+
+	return vk::raii::ImageView(device, viewInfo);
+}
+
 // Records a Vulkan 1.0-style image memory barrier (VkImageMemoryBarrier) for a
 // predefined set of common layout transitions. Uses the older pipelineBarrier() API
 // rather than pipelineBarrier2(), which is reserved for the inline barriers in EngineCore
@@ -682,6 +698,14 @@ void recordImageLayoutTransition(const vk::raii::CommandBuffer &commandBuffer, v
 		sourceStage           = vk::PipelineStageFlagBits::eTopOfPipe;
 		destinationStage      = vk::PipelineStageFlagBits::eComputeShader;
 	}
+	else if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal)
+	{
+		// Gives sampled render targets the layout their descriptor sets declare before their first render.
+		barrier.srcAccessMask = {};
+		barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+		sourceStage           = vk::PipelineStageFlagBits::eTopOfPipe;
+		destinationStage      = vk::PipelineStageFlagBits::eComputeShader;
+	}
 	else
 	{
 		throw std::invalid_argument("unsupported layout transition!");
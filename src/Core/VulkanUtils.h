@@ -123,6 +123,10 @@ vk::raii::ImageView createImageViewLayer(const vk::raii::Device &device, vk::Ima
 vk::raii::ImageView createImageViewArray(const vk::raii::Device &device, vk::Image image, vk::Format format,
                                          vk::ImageAspectFlags aspectFlags, uint32_t layerCount, uint32_t mipLevels = 1);
 
+// Creates a 2D image view of a single mip level, for compute passes that write one level while reading another.
+vk::raii::ImageView createImageViewMip(const vk::raii::Device &device, vk::Image image, vk::Format format,
+                                       vk::ImageAspectFlags aspectFlags, uint32_t baseMipLevel);
+
 void transitionImageLayout(const vk::raii::Device &device, const vk::raii::CommandPool &commandPool, const vk::raii::Queue &queue,
                            vk::Image image, vk::Format format, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, uint32_t mipLevels = 1);
 
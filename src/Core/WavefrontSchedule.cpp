@@ -0,0 +1,75 @@
+#include "WavefrontSchedule.h"
+
+#include <algorithm>
+
+namespace Laphria
+{
+uint32_t wavefrontChunkCount(uint32_t pixelCount, uint32_t chunkCapacity)
+{
+	const uint32_t capacity = std::max(chunkCapacity, 1u);
+	return (pixelCount + capacity - 1) / capacity;
+}
+
+std::vector<WavefrontDispatch> buildWavefrontSchedule(const WavefrontScheduleParams &params)
+{
+	std::vector<WavefrontDispatch> schedule;
+	const uint32_t                 chunkCount = wavefrontChunkCount(params.pixelCount, params.chunkCapacity);
+	const uint32_t                 maxPaths   = std::max(params.maxPathsPerPixel, 1u);
+	const uint32_t                 maxBounces = std::max(params.maxBounces, 1u);
+
+	for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+	{
+		schedule.push_back({WavefrontKernel::Primary, chunk, 0, 0});
+		for (uint32_t path = 0; path < maxPaths; ++path)
+		{
+			// Generate fills the hit queue directly from the stored primary hits, so bounce 0 needs no Extend.
+			schedule.push_back({WavefrontKernel::Generate, chunk, path, 0});
+			for (uint32_t bounce = 0; bounce < maxBounces; ++bounce)
+			{
+				if (bounce > 0)
+				{
+					schedule.push_back({WavefrontKernel::Extend, chunk, path, bounce});
+				}
+				schedule.push_back({WavefrontKernel::Bin, chunk, path, bounce});
+				if (params.sortHits)
+				{
+					schedule.push_back({WavefrontKernel::Scatter, chunk, path, bounce});
+				}
+				schedule.push_back({WavefrontKernel::Shade, chunk, path, bounce});
+				schedule.push_back({WavefrontKernel::Shadow, chunk, path, bounce});
+			}
+		}
+		schedule.push_back({WavefrontKernel::Resolve, chunk, 0, 0});
+	}
+	return schedule;
+}
+
+size_t wavefrontScheduleLength(const WavefrontScheduleParams &params)
+{
+	const size_t maxPaths   = std::max(params.maxPathsPerPixel, 1u);
+	const size_t maxBounces = std::max(params.maxBounces, 1u);
+	// Per bounce Bin, Shade and Shadow, plus Scatter when sorting and Extend after the first bounce.
+	const size_t perPath  = 1 + maxBounces * (params.sortHits ? 4 : 3) + (maxBounces - 1);
+	const size_t perChunk = 2 + maxPaths * perPath;
+	return static_cast<size_t>(wavefrontChunkCount(params.pixelCount, params.chunkCapacity)) * perChunk;
+}
+
+std::array<uint64_t, kWavefrontKernelCount> sumWavefrontKernelTicks(const std::vector<WavefrontDispatch> &schedule,
+                                                                    const std::vector<uint64_t>          &timestamps)
+{
+	std::array<uint64_t, kWavefrontKernelCount> ticks{};
+	const size_t                                 timed = std::min(schedule.size() + 1, timestamps.size());
+	for (size_t i = 1; i < timed; ++i)
+	{
+		if (timestamps[i - 1] == 0 || timestamps[i] == 0)
+		{
+			break;
+		}
+		if (timestamps[i] > timestamps[i - 1])
+		{
+			ticks[static_cast<uint32_t>(schedule[i - 1].kernel)] += timestamps[i] - timestamps[i - 1];
+		}
+	}
+	return ticks;
+}
+}        // namespace Laphria
@@ -0,0 +1,58 @@
+#ifndef LAPHRIAENGINE_WAVEFRONTSCHEDULE_H
+#define LAPHRIAENGINE_WAVEFRONTSCHEDULE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Laphria
+{
+// Compute kernels of the wavefront path tracer (WavefrontPathTracer.slang), in pipeline order.
+enum class WavefrontKernel : uint32_t
+{
+	Primary  = 0,        // camera rays, G-buffer, motion vectors, primary emission and sun; stores the primary hit
+	Generate = 1,        // starts path p of every pixel whose budget exceeds p at its primary hit
+	Extend   = 2,        // traces the path queue; hits go to the hit queue, misses add sky radiance
+	Bin      = 3,        // material bin histogram → bin offsets, indirect arguments of the hit queue
+	Scatter  = 4,        // hit queue indices sorted by material bin
+	Shade    = 5,        // material evaluation, light samples and the continuation ray of each hit
+	Shadow   = 6,        // occlusion rays of the light samples
+	Resolve  = 7         // primary radiance + mean path radiance → noisy colour
+};
+constexpr uint32_t kWavefrontKernelCount = 8;
+
+struct WavefrontDispatch
+{
+	WavefrontKernel kernel    = WavefrontKernel::Primary;
+	uint32_t        chunk     = 0;        // pixel range [chunk * chunkCapacity, +chunkCapacity)
+	uint32_t        pathIndex = 0;        // Generate and the bounces after it
+	uint32_t        bounce    = 0;        // 0 shades the primary hit
+};
+
+struct WavefrontScheduleParams
+{
+	uint32_t pixelCount       = 0;
+	uint32_t chunkCapacity    = 1;        // paths the queues hold; one path per pixel of a chunk
+	uint32_t maxPathsPerPixel = 1;        // upper bound of the sample budget
+	uint32_t maxBounces       = 3;        // surface hits per path, the primary hit included
+	bool     sortHits         = true;
+};
+
+uint32_t wavefrontChunkCount(uint32_t pixelCount, uint32_t chunkCapacity);
+
+// Every dispatch of one frame, in recording order. The queue sizes are only known on the GPU, so the schedule
+// covers the worst case and the kernels after Generate run through indirect arguments that may be empty.
+std::vector<WavefrontDispatch> buildWavefrontSchedule(const WavefrontScheduleParams &params);
+
+// Number of dispatches buildWavefrontSchedule(params) returns, without building it.
+size_t wavefrontScheduleLength(const WavefrontScheduleParams &params);
+
+// GPU ticks per kernel. timestamps[0] is written before the first dispatch of schedule and timestamps[i + 1]
+// after dispatch i; the span ending at a timestamp is charged to that dispatch's kernel. A zero (unavailable
+// or never written) timestamp ends the breakdown.
+std::array<uint64_t, kWavefrontKernelCount> sumWavefrontKernelTicks(const std::vector<WavefrontDispatch> &schedule,
+                                                                    const std::vector<uint64_t>          &timestamps);
+}        // namespace Laphria
+
+#endif        // LAPHRIAENGINE_WAVEFRONTSCHEDULE_H
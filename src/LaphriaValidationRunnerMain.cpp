@@ -1,5 +1,8 @@
 #include "Core/EditorValidation.h"
+#include "SceneManagement/SceneBinaryFormat.h"
+#include "SceneManagement/SceneJsonStream.h"
 
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -13,6 +16,9 @@ struct Options
     bool        validateProject = false;
     bool        validateScene = false;
     bool        sceneExplicitlyProvided = false;
+    std::string convertInputPath;
+    std::string convertOutputPath;
+    bool        prettyJson = false;
 };
 
 void printUsage()
@@ -22,6 +28,10 @@ void printUsage()
               << "  --scene <path>          Scene file path (.json)\n"
               << "  --validate-project      Validate only project content\n"
               << "  --validate-scene        Validate only scene content\n"
+              << "  --convert-scene <path>  Convert a scene between JSON and binary (.laphria_scene);\n"
+              << "                          the direction follows the input file's format\n"
+              << "  --output <path>         Output path for --convert-scene\n"
+              << "  --pretty                Indent JSON written by --convert-scene\n"
               << "  --help                  Show this help\n";
 }
 
@@ -49,6 +59,18 @@ Options parseArgs(int argc, char **argv)
         {
             options.validateScene = true;
         }
+        else if (arg == "--convert-scene" && i + 1 < argc)
+        {
+            options.convertInputPath = argv[++i];
+        }
+        else if (arg == "--output" && i + 1 < argc)
+        {
+            options.convertOutputPath = argv[++i];
+        }
+        else if (arg == "--pretty")
+        {
+            options.prettyJson = true;
+        }
         else if (arg == "--help")
         {
             printUsage();
@@ -60,6 +82,11 @@ Options parseArgs(int argc, char **argv)
         }
     }
 
+    if (!options.convertInputPath.empty() && options.convertOutputPath.empty())
+    {
+        throw std::runtime_error("--convert-scene requires --output <path>");
+    }
+
     if (!options.validateProject && !options.validateScene)
     {
         options.validateProject = true;
@@ -79,6 +106,57 @@ void printReport(const LaphriaEditor::ValidationReport &report)
                   << message.file << " | " << message.fieldPath << " | " << message.message << '\n';
     }
 }
+// JSON <-> binary scene conversion. Fields the binary format cannot hold are listed so the loss is visible.
+int convertScene(const Options &options)
+{
+    using namespace Laphria::SceneBinary;
+
+    std::string error;
+    if (isBinarySceneFile(options.convertInputPath))
+    {
+        BinarySceneView view;
+        if (!view.open(options.convertInputPath, error))
+        {
+            std::cerr << error << '\n';
+            return EXIT_FAILURE;
+        }
+
+        std::ofstream output(options.convertOutputPath);
+        if (!output.is_open())
+        {
+            std::cerr << "Failed to open output file: " << options.convertOutputPath << '\n';
+            return EXIT_FAILURE;
+        }
+        if (!Laphria::SceneJson::writeBinarySceneAsJson(view, output, options.prettyJson))
+        {
+            std::cerr << "Failed to write scene JSON: " << options.convertOutputPath << '\n';
+            return EXIT_FAILURE;
+        }
+        std::cout << "Converted binary scene (" << view.nodeCount() << " nodes) to JSON: " << options.convertOutputPath << '\n';
+        return EXIT_SUCCESS;
+    }
+
+    std::ifstream input(options.convertInputPath);
+    if (!input.is_open())
+    {
+        std::cerr << "Failed to open scene file: " << options.convertInputPath << '\n';
+        return EXIT_FAILURE;
+    }
+
+    BinarySceneBuilder       builder;
+    std::vector<std::string> droppedKeys;
+    if (!Laphria::SceneJson::readSceneIntoBinary(input, builder, droppedKeys, error) || !builder.writeFile(options.convertOutputPath, error))
+    {
+        std::cerr << error << '\n';
+        return EXIT_FAILURE;
+    }
+    for (const auto &key : droppedKeys)
+    {
+        std::cout << "[warning] " << options.convertInputPath << " | " << key << " | Field is not stored in the binary scene format.\n";
+    }
+    std::cout << "Converted JSON scene (" << builder.nodeCount() << " nodes) to binary: " << options.convertOutputPath << '\n';
+    return EXIT_SUCCESS;
+}
 }        // namespace
 
 int main(int argc, char **argv)
@@ -86,6 +164,11 @@ int main(int argc, char **argv)
     try
     {
         const Options options = parseArgs(argc, argv);
+        if (!options.convertInputPath.empty())
+        {
+            return convertScene(options);
+        }
+
         LaphriaEditor::ValidationReport report;
 
         if (options.validateProject && options.validateScene)
@@ -32,6 +32,8 @@ PhysicsSystem::PhysicsSystem() {
 }
 
 void PhysicsSystem::updateCPU(const std::vector<SceneNode::Ptr> &nodes, float deltaTime) {
+    gpuStateValid = false;
+
     // 1. Integration (Move objects)
     for (auto &node: nodes) {
         if (!node->physics.enabled || node->physics.isStatic) continue;
@@ -56,7 +58,7 @@ void PhysicsSystem::integrate(const SceneNode::Ptr &node, float dt) const {
     // x += v * dt
     glm::vec3 pos = node->getPosition();
     pos += phys.velocity * dt;
-    node->setPosition(pos);
+    node->setSimulatedPosition(pos);
 
     // Reset acceleration
     phys.acceleration = glm::vec3(0.0f);
@@ -94,7 +96,7 @@ void PhysicsSystem::checkBoundaries(const SceneNode::Ptr &node) {
         }
     }
 
-    node->setPosition(pos);
+    node->setSimulatedPosition(pos);
 }
 
 void PhysicsSystem::resolveCollisions(const std::vector<SceneNode::Ptr> &nodes) {
@@ -262,8 +264,8 @@ void PhysicsSystem::solveContact(const SceneNode::Ptr &a, const SceneNode::Ptr &
     constexpr float slop = 0.01f;
     glm::vec3 correction = std::max(penetration - slop, 0.0f) / totalInvMass * percent * normal;
 
-    if (!physA.isStatic) a->setPosition(a->getPosition() + correction * invMassA);
-    if (!physB.isStatic) b->setPosition(b->getPosition() - correction * invMassB);
+    if (!physA.isStatic) a->setSimulatedPosition(a->getPosition() + correction * invMassA);
+    if (!physB.isStatic) b->setSimulatedPosition(b->getPosition() - correction * invMassB);
 
     // 2. Velocity Impulse (coefficient-of-restitution impulse formula)
     // j = -(1 + e) * (v_rel · n) / (1/mA + 1/mB)
@@ -311,29 +313,49 @@ void PhysicsSystem::createSSBO(const vk::raii::Device &device, const vk::raii::P
     currentSSBOSize = size;
 }
 
-void PhysicsSystem::updateSSBO(const std::vector<SceneNode::Ptr> &nodes) {
-    hostPhysicsObjects.clear();
+PhysicsObject PhysicsSystem::makePhysicsObject(const SceneNode &node) {
+    PhysicsObject obj{};
+    obj.position = node.getPosition();
+    obj.velocity = node.physics.velocity;
+    if (node.physics.isStatic) {
+        obj.mass = 0.0f; // Infinite mass
+        obj.active = node.physics.enabled ? 1 : 0;
+    } else {
+        obj.mass = node.physics.mass;
+        obj.active = node.physics.enabled ? 1 : 0;
+    }
 
-    for (auto &node: nodes) {
-        PhysicsObject obj{};
-        obj.position = node->getPosition();
-        obj.velocity = node->physics.velocity;
-        if (node->physics.isStatic) {
-            obj.mass = 0.0f; // Infinite mass
-            obj.active = node->physics.enabled ? 1 : 0;
-        } else {
-            obj.mass = node->physics.mass;
-            obj.active = node->physics.enabled ? 1 : 0;
-        }
+    obj.radius = node.physics.radius;
+    obj.halfExtents = node.physics.halfExtents;
+    obj.type = static_cast<int>(node.physics.colliderType);
+    obj.restitution = node.physics.restitution;
+    obj.friction = node.physics.friction;
+    return obj;
+}
 
-        obj.radius = node->physics.radius;
-        obj.halfExtents = node->physics.halfExtents;
-        obj.type = static_cast<int>(node->physics.colliderType);
-        obj.restitution = node->physics.restitution;
-        obj.friction = node->physics.friction;
+void PhysicsSystem::updateSSBO(const std::vector<SceneNode::Ptr> &nodes, uint64_t bodiesVersion, const std::vector<SceneNode *> *changedNodes) {
+    // Same bodies as the last upload: the mapped SSBO already holds the last step's results, so only the
+    // entries edited on the host since then are rewritten.
+    if (gpuStateValid && changedNodes && bodiesVersion == uploadedBodiesVersion && hostPhysicsObjects.size() == nodes.size()) {
+        auto *gpuObjs = static_cast<PhysicsObject *>(physicsSSBOMapped);
+        for (const SceneNode *node: *changedNodes) {
+            const auto it = ssboSlots.find(node);
+            if (it != ssboSlots.end()) {
+                hostPhysicsObjects[it->second] = makePhysicsObject(*node);
+                gpuObjs[it->second] = hostPhysicsObjects[it->second];
+            }
+        }
+        return;
+    }
 
-        hostPhysicsObjects.push_back(obj);
+    hostPhysicsObjects.clear();
+    ssboSlots.clear();
+    for (const auto &node: nodes) {
+        ssboSlots.emplace(node.get(), static_cast<uint32_t>(hostPhysicsObjects.size()));
+        hostPhysicsObjects.push_back(makePhysicsObject(*node));
     }
+    uploadedBodiesVersion = bodiesVersion;
+    gpuStateValid = true;
 
     if (hostPhysicsObjects.empty()) return;
 
@@ -355,14 +377,15 @@ void PhysicsSystem::updateSSBO(const std::vector<SceneNode::Ptr> &nodes) {
 //   Stage 1 — Collision resolution: naïve O(N²) broadphase + impulse response.
 // A memory barrier separates the two stages so stage 1 sees the updated positions from stage 0.
 // A final Compute→Host barrier ensures the host-coherent SSBO is readable after the queue drains.
-void PhysicsSystem::updateGPU(std::vector<SceneNode::Ptr> &nodes, float deltaTime,
+void PhysicsSystem::updateGPU(const std::vector<SceneNode::Ptr> &nodes, uint64_t bodiesVersion, const std::vector<SceneNode *> *changedNodes,
+                              float deltaTime,
                               const vk::raii::CommandBuffer &cmd,
                               const vk::raii::PipelineLayout &layout,
                               const vk::raii::Pipeline &pipeline,
                               const vk::raii::DescriptorSet &descriptorSet) {
     if (!physicsSSBOMapped) return; // Must be initialized externally or via better design
 
-    updateSSBO(nodes); // Serialize SceneNode state → host-coherent SSBO
+    updateSSBO(nodes, bodiesVersion, changedNodes); // Serialize SceneNode state → host-coherent SSBO
 
     cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline);
     cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *layout, 0, {*descriptorSet}, nullptr);
@@ -431,17 +454,20 @@ void PhysicsSystem::updateGPU(std::vector<SceneNode::Ptr> &nodes, float deltaTim
 // Reads physics results back from the host-coherent SSBO (after the queue has drained)
 // and updates SceneNode positions/velocities to match.
 // The SSBO memory is host-coherent, so no explicit cache invalidation is needed.
-void PhysicsSystem::syncFromGPU(std::vector<SceneNode::Ptr> &nodes) const {
+void PhysicsSystem::syncFromGPU(const std::vector<SceneNode::Ptr> &nodes) const {
     if (!physicsSSBOMapped || nodes.empty()) return;
 
     PhysicsObject *gpuObjs = static_cast<PhysicsObject *>(physicsSSBOMapped);
 
     for (size_t i = 0; i < nodes.size() && i < hostPhysicsObjects.size(); i++) {
         PhysicsObject &obj = gpuObjs[i];
-        SceneNode::Ptr &node = nodes[i];
+        const SceneNode::Ptr &node = nodes[i];
 
         if (obj.active) {
-            node->setPosition(obj.position);
+            // Resting bodies keep their transform, so they stay out of the scene's transform journal.
+            if (node->getPosition() != obj.position) {
+                node->setSimulatedPosition(obj.position);
+            }
             node->physics.velocity = obj.velocity;
             // Update other props if needed
         }
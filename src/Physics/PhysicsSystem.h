@@ -3,6 +3,7 @@
 
 #include "../SceneManagement/SceneNode.h"
 #include "../Core/EngineConfig.h"
+#include <unordered_map>
 #include <vector>
 #include <vulkan/vulkan_raii.hpp>
 
@@ -17,14 +18,17 @@ public:
     // CPU Logic
     void updateCPU(const std::vector<SceneNode::Ptr> &nodes, float deltaTime);
 
-    // GPU Logic
-    void updateGPU(std::vector<SceneNode::Ptr> &nodes, float deltaTime,
+    // GPU Logic. The SSBO keeps the previous step's results, so only the bodies in changedNodes (changed on
+    // the host since the last call) are rewritten. Everything is uploaded when changedNodes is null, when
+    // bodiesVersion differs from the last upload, or after a CPU step.
+    void updateGPU(const std::vector<SceneNode::Ptr> &nodes, uint64_t bodiesVersion, const std::vector<SceneNode *> *changedNodes,
+                   float deltaTime,
                    const vk::raii::CommandBuffer &cmd,
                    const vk::raii::PipelineLayout &layout,
                    const vk::raii::Pipeline &pipeline,
                    const vk::raii::DescriptorSet &descriptorSet);
 
-    void syncFromGPU(std::vector<SceneNode::Ptr> &nodes) const;
+    void syncFromGPU(const std::vector<SceneNode::Ptr> &nodes) const;
 
     // Configuration
     void setGravity(const glm::vec3 &g) { gravity = g; }
@@ -70,8 +74,12 @@ private:
     vk::raii::DeviceMemory physicsSSBOMemory{nullptr};
     void *physicsSSBOMapped{nullptr};
     size_t currentSSBOSize = 0;
+    std::unordered_map<const SceneNode *, uint32_t> ssboSlots;
+    uint64_t uploadedBodiesVersion = 0;
+    bool gpuStateValid = false;
 
-    void updateSSBO(const std::vector<SceneNode::Ptr> &nodes);
+    static PhysicsObject makePhysicsObject(const SceneNode &node);
+    void updateSSBO(const std::vector<SceneNode::Ptr> &nodes, uint64_t bodiesVersion, const std::vector<SceneNode *> *changedNodes);
 };
 
 #endif // LAPHRIAENGINE_PHYSICSSYSTEM_H
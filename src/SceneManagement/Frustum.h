@@ -30,6 +30,25 @@ struct Frustum
 		return true;
 	}
 
+	// Conservative box test: false only when the box lies fully outside one of the first planeCount planes
+	// (left, right, bottom, top, near, far order; 4 tests the sides only).
+	[[nodiscard]] bool intersectsBox(const glm::vec3 &boxMin, const glm::vec3 &boxMax, size_t planeCount = 6) const
+	{
+		for (size_t i = 0; i < planeCount && i < planes.size(); ++i)
+		{
+			const glm::vec4 &plane = planes[i];
+			// Corner farthest along the plane normal.
+			const glm::vec3 positive{plane.x >= 0.0f ? boxMax.x : boxMin.x,
+			                         plane.y >= 0.0f ? boxMax.y : boxMin.y,
+			                         plane.z >= 0.0f ? boxMax.z : boxMin.z};
+			if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
 	static Frustum fromViewProjection(const glm::mat4 &viewProjection)
 	{
 		Frustum frustum{};
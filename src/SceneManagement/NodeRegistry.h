@@ -0,0 +1,57 @@
+#ifndef LAPHRIAENGINE_NODEREGISTRY_H
+#define LAPHRIAENGINE_NODEREGISTRY_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "SceneNode.h"
+
+namespace Laphria {
+    // Dense list of the scene nodes that carry one component (a model, a physics body, an animation).
+    // Systems iterate it instead of filtering every scene node each frame. Removal moves the last entry
+    // into the freed slot, so the order is only stable while membership does not change.
+    class NodeRegistry {
+    public:
+        // Adds or removes node so that its membership matches member.
+        void update(const SceneNode::Ptr &node, bool member) {
+            const auto it = slots.find(node.get());
+            if (member && it == slots.end()) {
+                slots.emplace(node.get(), static_cast<uint32_t>(nodes.size()));
+                nodes.push_back(node);
+            } else if (!member && it != slots.end()) {
+                erase(it);
+            }
+        }
+
+        void remove(const SceneNode *node) {
+            if (const auto it = slots.find(node); it != slots.end()) {
+                erase(it);
+            }
+        }
+
+        void clear() {
+            nodes.clear();
+            slots.clear();
+        }
+
+        const std::vector<SceneNode::Ptr> &getNodes() const { return nodes; }
+
+    private:
+        using SlotMap = std::unordered_map<const SceneNode *, uint32_t>;
+
+        void erase(SlotMap::iterator it) {
+            const uint32_t slot = it->second;
+            slots.erase(it);
+            if (slot + 1 != nodes.size()) {
+                nodes[slot] = std::move(nodes.back());
+                slots[nodes[slot].get()] = slot;
+            }
+            nodes.pop_back();
+        }
+
+        std::vector<SceneNode::Ptr> nodes;
+        SlotMap slots;
+    };
+} // namespace Laphria
+
+#endif //LAPHRIAENGINE_NODEREGISTRY_H
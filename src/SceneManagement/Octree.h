@@ -4,6 +4,7 @@
 #include <vector>
 #include <array>
 #include <memory>
+#include <unordered_map>
 #include <glm/glm.hpp>
 #include "SceneNode.h"
 
@@ -31,62 +32,70 @@ namespace Laphria {
     // Loose octree for spatial indexing of SceneNodes.
     // Subdivides a node into 8 equal children when it reaches 'capacity' entries.
     // Nodes that do not fit into any child (e.g. on a boundary) remain in the parent.
-    // Usage: insert all scene nodes after each frame update, then query with a view frustum AABB.
+    // Collapsed prefab instances draw a whole model from one node, so they are indexed by their world-space
+    // template bounds instead of their origin; boxes reaching outside the root are kept on a list every query tests.
+    // Usage: insert all scene nodes, move the ones whose transform changed with remove + insert after each
+    // frame update, then query with a view frustum AABB.
     class Octree {
     public:
         Octree(const AABB &boundary, int capacity = 4) : boundary(boundary), capacity(capacity) {
         }
 
-        // Inserts node if its world position falls within this node's boundary.
-        // Returns false if the position is outside (caller should not retry on a parent).
+        // Inserts node (re-inserting it if already present) if its world position, or its prefab bounds, fall
+        // within this node's boundary. Returns false if a position is outside (caller should not retry on a parent).
         bool insert(const SceneNode::Ptr &node) {
-            if (!boundary.contains(node->getWorldPosition())) {
-                return false;
-            }
-
-            if (nodes.size() < capacity && children[0] == nullptr) {
-                nodes.push_back(node);
-                return true;
+            remove(node.get());
+            Entry entry{node};
+            glm::vec3 boundsMin;
+            glm::vec3 boundsMax;
+            if (node->getPrefabWorldBounds(boundsMin, boundsMax)) {
+                entry.bounds = AABB{boundsMin, boundsMax};
+                entry.hasBounds = true;
             }
-
-            if (children[0] == nullptr) {
-                subdivide();
-            }
-
-            for (auto &child: children) {
-                if (child->insert(node)) {
-                    return true;
+            Octree *cell = insertIntoCell(entry);
+            if (cell == nullptr) {
+                if (!entry.hasBounds) {
+                    return false;
                 }
+                oversized.push_back(std::move(entry));
             }
-
-            // Node does not fit into any child (world-position on octant boundary); keep here.
-            nodes.push_back(node);
+            locations[node.get()] = cell;
             return true;
         }
 
-        // Appends to 'found' all nodes whose world position falls inside 'range'.
-        void query(const AABB &range, std::vector<SceneNode::Ptr> &found) const {
-            if (!boundary.intersects(range)) {
-                return;
+        // Removes node from the cell it was inserted into, wherever it has moved since.
+        bool remove(const SceneNode *node) {
+            const auto it = locations.find(node);
+            if (it == locations.end()) {
+                return false;
             }
-
-            for (const auto &node: nodes) {
-                if (range.contains(node->getWorldPosition())) {
-                    // Simple point check
-                    found.push_back(node);
+            auto &cellEntries = it->second ? it->second->nodes : oversized;
+            for (size_t i = 0; i < cellEntries.size(); ++i) {
+                if (cellEntries[i].node.get() == node) {
+                    cellEntries[i] = std::move(cellEntries.back());
+                    cellEntries.pop_back();
+                    break;
                 }
             }
+            locations.erase(it);
+            return true;
+        }
 
-            if (children[0] != nullptr) {
-                for (const auto &child: children) {
-                    child->query(range, found);
+        // Appends to 'found' all nodes whose world position, or prefab bounds, fall inside 'range'.
+        void query(const AABB &range, std::vector<SceneNode::Ptr> &found) const {
+            for (const auto &entry: oversized) {
+                if (range.intersects(entry.bounds)) {
+                    found.push_back(entry.node);
                 }
             }
+            queryCell(range, found);
         }
 
         // Clear the tree
         void clear() {
             nodes.clear();
+            oversized.clear();
+            locations.clear();
             for (auto &child: children) {
                 child = nullptr;
             }
@@ -95,11 +104,69 @@ namespace Laphria {
         const AABB &getBounds() const { return boundary; }
 
     private:
+        struct Entry {
+            SceneNode::Ptr node;
+            AABB bounds{};
+            bool hasBounds = false;        // bounds hold the prefab box; otherwise the live world position is used
+        };
+
         AABB boundary;
         int capacity;
-        std::vector<SceneNode::Ptr> nodes;
+        std::vector<Entry> nodes;
         std::array<std::unique_ptr<Octree>, 8> children;
+        std::unordered_map<const SceneNode *, Octree *> locations;        // root only: the cell holding each node, null for oversized
+        std::vector<Entry> oversized;        // root only: prefab boxes not contained by the boundary
+
+        bool fits(const Entry &entry) const {
+            if (entry.hasBounds) {
+                return boundary.contains(entry.bounds.min) && boundary.contains(entry.bounds.max);
+            }
+            return boundary.contains(entry.node->getWorldPosition());
+        }
+
+        void queryCell(const AABB &range, std::vector<SceneNode::Ptr> &found) const {
+            if (!boundary.intersects(range)) {
+                return;
+            }
+
+            for (const auto &entry: nodes) {
+                if (entry.hasBounds ? range.intersects(entry.bounds) : range.contains(entry.node->getWorldPosition())) {
+                    found.push_back(entry.node);
+                }
+            }
+
+            if (children[0] != nullptr) {
+                for (const auto &child: children) {
+                    child->queryCell(range, found);
+                }
+            }
+        }
+
+        // Returns the cell that now holds entry, or null if it does not fit inside this boundary.
+        Octree *insertIntoCell(const Entry &entry) {
+            if (!fits(entry)) {
+                return nullptr;
+            }
+
+            if (nodes.size() < capacity && children[0] == nullptr) {
+                nodes.push_back(entry);
+                return this;
+            }
 
+            if (children[0] == nullptr) {
+                subdivide();
+            }
+
+            for (auto &child: children) {
+                if (Octree *cell = child->insertIntoCell(entry)) {
+                    return cell;
+                }
+            }
+
+            // Entry does not fit into any child (on an octant boundary, or a box spanning octants); keep here.
+            nodes.push_back(entry);
+            return this;
+        }
         void subdivide() {
             glm::vec3 min = boundary.min;
             glm::vec3 max = boundary.max;
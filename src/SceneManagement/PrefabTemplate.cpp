@@ -0,0 +1,106 @@
+#include "PrefabTemplate.h"
+#include "SceneNode.h"
+#include "../Core/OcclusionCulling.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+namespace
+{
+void addRootBounds(const PrefabTemplate::Node &node, const glm::mat4 &rootFromNode, glm::vec3 &rootMin, glm::vec3 &rootMax)
+{
+	if (node.boundsMin.x > node.boundsMax.x)
+	{
+		return;
+	}
+	glm::vec3 nodeMin;
+	glm::vec3 nodeMax;
+	Laphria::transformBounds(node.boundsMin, node.boundsMax, rootFromNode, nodeMin, nodeMax);
+	rootMin = glm::min(rootMin, nodeMin);
+	rootMax = glm::max(rootMax, nodeMax);
+}
+
+glm::mat4 composeLocal(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+{
+	return glm::translate(glm::mat4(1.0f), position) * glm::toMat4(rotation) * glm::scale(glm::mat4(1.0f), scale);
+}
+}        // namespace
+
+std::shared_ptr<const PrefabTemplate> PrefabTemplate::build(const SceneNode &prototype, std::span<const MeshBounds> meshBounds)
+{
+	auto prefab = std::make_shared<PrefabTemplate>();
+
+	std::vector<std::pair<const SceneNode *, int32_t>> stack{{&prototype, -1}};
+	while (!stack.empty())
+	{
+		const auto [source, parentIndex] = stack.back();
+		stack.pop_back();
+
+		Node node{};
+		node.parent          = parentIndex;
+		node.name            = source->name;
+		node.position        = source->getPosition();
+		node.rotation        = source->getRotation();
+		node.scale           = source->getScale();
+		node.meshIndices     = source->getMeshIndices();
+		node.sourceNodeIndex = source->sourceNodeIndex;
+		if (parentIndex >= 0)
+		{
+			node.rootFromNode = prefab->nodes[parentIndex].rootFromNode * source->getLocalTransform();
+		}
+		for (const int meshIndex : node.meshIndices)
+		{
+			if (meshIndex >= 0 && static_cast<size_t>(meshIndex) < meshBounds.size() &&
+			    meshBounds[meshIndex].min.x <= meshBounds[meshIndex].max.x)
+			{
+				node.boundsMin = glm::min(node.boundsMin, meshBounds[meshIndex].min);
+				node.boundsMax = glm::max(node.boundsMax, meshBounds[meshIndex].max);
+			}
+		}
+		addRootBounds(node, node.rootFromNode, prefab->rootBoundsMin, prefab->rootBoundsMax);
+
+		const auto index = static_cast<int32_t>(prefab->nodes.size());
+		prefab->nodes.push_back(std::move(node));
+
+		// Reverse push keeps siblings in order.
+		const auto &children = source->getChildren();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			stack.emplace_back(it->get(), index);
+		}
+	}
+	return prefab;
+}
+
+bool PrefabTemplate::resolve(std::span<const Override> overrides, std::vector<glm::mat4> &rootFromNode, glm::vec3 &outMin,
+                             glm::vec3 &outMax) const
+{
+	rootFromNode.resize(nodes.size());
+	outMin = glm::vec3(std::numeric_limits<float>::max());
+	outMax = glm::vec3(std::numeric_limits<float>::lowest());
+
+	// Pre-order: a node is recomposed when it is overridden or below one, otherwise the template's matrix holds.
+	std::vector<bool> moved(nodes.size(), false);
+	auto              nextOverride = overrides.begin();
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		const Node &node = nodes[i];
+		if (nextOverride != overrides.end() && nextOverride->index == i)
+		{
+			const glm::mat4 local = composeLocal(nextOverride->position, nextOverride->rotation, nextOverride->scale);
+			rootFromNode[i] = rootFromNode[node.parent] * local;
+			moved[i] = true;
+			++nextOverride;
+		}
+		else if (node.parent >= 0 && moved[node.parent])
+		{
+			rootFromNode[i] = rootFromNode[node.parent] * composeLocal(node.position, node.rotation, node.scale);
+			moved[i] = true;
+		}
+		else
+		{
+			rootFromNode[i] = node.rootFromNode;
+		}
+		addRootBounds(node, rootFromNode[i], outMin, outMax);
+	}
+	return outMin.x <= outMax.x;
+}
@@ -0,0 +1,82 @@
+#ifndef LAPHRIAENGINE_PREFABTEMPLATE_H
+#define LAPHRIAENGINE_PREFABTEMPLATE_H
+#include "Symbol.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+class SceneNode;
+
+// Immutable, flattened copy of a model's node hierarchy, shared by every collapsed instance of the model.
+// A collapsed instance is a single SceneNode that carries the template root's own state (its transform places
+// the instance) and renders the remaining template nodes through rootFromNode, so spawning N copies of a
+// model costs N scene nodes instead of N times the hierarchy. Edits to other template nodes are stored on
+// the instance as Overrides keyed by template index.
+class PrefabTemplate
+{
+  public:
+	// Object-space bounds of one model mesh; min > max when the mesh has none.
+	struct MeshBounds
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	struct Node
+	{
+		int32_t           parent = -1;        // template index, -1 for the root
+		Laphria::NodeName name;
+		glm::vec3         position{0.0f};
+		glm::quat         rotation{1.0f, 0.0f, 0.0f, 0.0f};
+		glm::vec3         scale{1.0f};
+		glm::mat4         rootFromNode{1.0f};        // transform relative to the instance root (identity for the root)
+		std::vector<int>  meshIndices;
+		int               sourceNodeIndex = -1;
+		glm::vec3         boundsMin{std::numeric_limits<float>::max()};        // union of meshIndices' bounds in node space
+		glm::vec3         boundsMax{std::numeric_limits<float>::lowest()};
+	};
+
+	// One instance's local transform for a template node, replacing the template's. Never the root (index 0),
+	// whose transform is the instance node's own.
+	struct Override
+	{
+		uint32_t  index = 0;
+		glm::vec3 position{0.0f};
+		glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+		glm::vec3 scale{1.0f};
+	};
+
+	// Flattens prototype in pre-order, so parents precede their children. meshBounds is indexed by mesh index
+	// and may be empty, in which case the template has no bounds.
+	static std::shared_ptr<const PrefabTemplate> build(const SceneNode &prototype, std::span<const MeshBounds> meshBounds = {});
+
+	const std::vector<Node> &getNodes() const
+	{
+		return nodes;
+	}
+
+	// Combined mesh bounds of every template node relative to the instance root, for culling collapsed
+	// instances. Returns false when no template mesh has bounds.
+	bool getRootBounds(glm::vec3 &outMin, glm::vec3 &outMax) const
+	{
+		outMin = rootBoundsMin;
+		outMax = rootBoundsMax;
+		return rootBoundsMin.x <= rootBoundsMax.x;
+	}
+
+	// rootFromNode of every template node with overrides (sorted by index, all in range) applied to their
+	// subtrees, and the combined root-space bounds under them. Returns false when no template mesh has bounds.
+	bool resolve(std::span<const Override> overrides, std::vector<glm::mat4> &rootFromNode, glm::vec3 &outMin,
+	             glm::vec3 &outMax) const;
+
+  private:
+	std::vector<Node> nodes;
+	glm::vec3         rootBoundsMin{std::numeric_limits<float>::max()};
+	glm::vec3         rootBoundsMax{std::numeric_limits<float>::lowest()};
+};
+
+#endif        // LAPHRIAENGINE_PREFABTEMPLATE_H
@@ -1,14 +1,20 @@
 #include "Scene.h"
+#include "../Core/EngineConfig.h"
 #include "../Core/ResourceManager.h"
+#include "SceneBinaryFormat.h"
+#include "SceneJournal.h"
+#include "SceneJsonStream.h"
 #include "SceneNode.h"
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <map>
-#include <nlohmann/json.hpp>
 #include <random>
+#include <sstream>
 #include <cmath>
+#include <unordered_map>
 #include <unordered_set>
 
 using namespace Laphria;
@@ -106,8 +112,11 @@ glm::quat sampleQuatTrack(const ModelResource::AnimationTrackQuat &track, float
 Scene::Scene()
 {
 	root = std::make_shared<SceneNode>("Root");
+	sceneWriter = std::make_unique<Laphria::SceneJournal::AsyncSceneWriter>(Laphria::EngineConfig::kSceneJournalCompactBytes);
 }
 
+Scene::~Scene() = default;
+
 void Scene::init(Laphria::AABB worldBounds)
 {
 	octree = std::make_unique<Laphria::Octree>(worldBounds);
@@ -123,7 +132,11 @@ void Scene::addNode(const SceneNode::Ptr &node, const SceneNode::Ptr &parent)
 	{
 		root->addChild(node);
 	}
+	registerSubtree(node);
+}
 
+void Scene::registerSubtree(const SceneNode::Ptr &node)
+{
 	// Add to flat list (and children recursively if any)
 	std::vector<SceneNode::Ptr> stack;
 	stack.push_back(node);
@@ -131,7 +144,7 @@ void Scene::addNode(const SceneNode::Ptr &node, const SceneNode::Ptr &parent)
 	{
 		auto n = stack.back();
 		stack.pop_back();
-		allNodes.push_back(n);
+		registerNode(n);
 		for (const auto &c : n->getChildren())
 			stack.push_back(c);
 	}
@@ -179,6 +192,7 @@ void Scene::deleteNode(const SceneNode::Ptr &node)
 	for (const auto &n : toRemove)
 	{
 		toRemoveSet.insert(n.get());
+		unregisterNode(n);
 	}
 	std::erase_if(allNodes, [&](const SceneNode::Ptr &n) {
 		return toRemoveSet.contains(n.get());
@@ -187,10 +201,88 @@ void Scene::deleteNode(const SceneNode::Ptr &node)
 	if (node->getParent())
 	{
 		node->getParent()->removeChild(node);
+		removedSinceSave.push_back(node->stableId);
 		rebuildOctree();
 	}
 }
 
+void Scene::expandPrefab(const SceneNode::Ptr &node)
+{
+	if (!node || !node->getPrefab())
+		return;
+
+	// Children added under the instance by hand are already registered; the template nodes are appended after them.
+	const size_t firstExpanded = node->getChildren().size();
+	node->expandPrefab();
+	const auto &children = node->getChildren();
+	for (size_t i = firstExpanded; i < children.size(); ++i)
+	{
+		registerSubtree(children[i]);
+	}
+}
+
+void Scene::updateComponents(const SceneNode::Ptr &node)
+{
+	if (!node)
+		return;
+
+	renderables.update(node, node->modelId >= 0);
+	physicsBodies.update(node, node->physics.enabled);
+	animatedNodes.update(node, node->animation.enabled);
+	++componentsVersion;
+}
+
+void Scene::registerNode(const SceneNode::Ptr &node)
+{
+	allNodes.push_back(node);
+	transformJournal.track(*node);
+	node->recordTransformChange();        // new nodes enter the octree and the TLAS on the next drain
+	updateComponents(node);
+}
+
+void Scene::unregisterNode(const SceneNode::Ptr &node)
+{
+	transformJournal.untrack(*node);
+	renderables.remove(node.get());
+	physicsBodies.remove(node.get());
+	animatedNodes.remove(node.get());
+	++componentsVersion;
+}
+
+void Scene::clearNodes()
+{
+	transformJournal.untrackAll();
+	changedNodes.clear();
+	allNodes.clear();
+	renderables.clear();
+	physicsBodies.clear();
+	animatedNodes.clear();
+	++componentsVersion;
+}
+
+const std::vector<SceneNode::Ptr> &Scene::getSkinnedInstances(const ResourceManager &resourceManager) const
+{
+	if (skinnedInstancesVersion != componentsVersion)
+	{
+		skinnedInstances.clear();
+		for (const auto &node : renderables.getNodes())
+		{
+			const ModelResource *modelRes = resourceManager.getModelResource(node->modelId);
+			if (!modelRes || !modelRes->hasRuntimeSkinning)
+			{
+				continue;
+			}
+			const SceneNode *parent = node->getParent();
+			if (parent == nullptr || parent->modelId != node->modelId)
+			{
+				skinnedInstances.push_back(node);
+			}
+		}
+		skinnedInstancesVersion = componentsVersion;
+	}
+	return skinnedInstances;
+}
+
 void Scene::rebuildOctree() const
 {
 	if (!octree || !root)
@@ -236,205 +328,732 @@ void Scene::loadModel(const std::string &path, ResourceManager &resourceManager,
 	addNode(node, parent);
 }
 
-void serializeNode(const SceneNode::Ptr &node, nlohmann::json &j, ResourceManager &resourceManager)
+namespace
+{
+struct PendingModelBinding
 {
-	j["id"] = node->stableId;
-	j["name"] = node->name;
+	SceneNode  *node = nullptr;
+	std::string modelPath;        // empty: drops earlier bindings of the node
+	bool        prefabInstance = false;
+};
 
-	// Transform
-	glm::vec3 pos = node->getPosition();
-	glm::quat rot = node->getRotation();
-	glm::vec3 scl = node->getScale();
+double elapsedMs(std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end)
+{
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
 
-	j["position"] = {pos.x, pos.y, pos.z};
-	j["rotation"] = {rot.w, rot.x, rot.y, rot.z};        // w, x, y, z
-	j["scale"]    = {scl.x, scl.y, scl.z};
+// Gathers the serialized fields of a single node. Shared by the JSON and binary writers.
+void collectNodeFields(const SceneNode &node, Laphria::SceneJson::NodeFields &fields, const ResourceManager &resourceManager)
+{
+	using namespace Laphria::SceneBinary;
+
+	fields.reset();
+	fields.flags = kNodeHasId | kNodeHasName | kNodeHasPosition | kNodeHasRotation | kNodeHasScale | kNodeHasMeshIndices | kNodeHasChildrenArray;
+	fields.id = node.stableId.toString();
+	fields.name = node.name.str();
+
+	// Transform
+	const glm::vec3 pos = node.getPosition();
+	const glm::quat rot = node.getRotation();
+	const glm::vec3 scl = node.getScale();
+	std::copy_n(&pos.x, 3, fields.position);
+	fields.rotation[0] = rot.w;        // w, x, y, z
+	fields.rotation[1] = rot.x;
+	fields.rotation[2] = rot.y;
+	fields.rotation[3] = rot.z;
+	std::copy_n(&scl.x, 3, fields.scale);
 
 	// Model Ref
-	if (node->modelId != -1)
+	if (node.modelId != -1)
 	{
-		if (auto *res = resourceManager.getModelResource(node->modelId))
+		if (auto *res = resourceManager.getModelResource(node.modelId))
 		{
-			j["modelPath"] = res->path;
+			fields.modelPath = res->path;
+			fields.flags |= kNodeHasModelPath;
 		}
 	}
-	if (!node->assetRef.path.empty())
+	if (!node.assetRef.path.empty())
 	{
-		j["asset_ref"] = {
-		    {"path", node->assetRef.path},
-		    {"variant", node->assetRef.variant}};
+		fields.assetPath = node.assetRef.path.str();
+		fields.assetVariant = node.assetRef.variant.str();
+		fields.flags |= kNodeHasAssetRef | kNodeHasAssetRefPath | kNodeHasAssetRefVariant;
 	}
 
 	// Mesh Indices
-	j["meshIndices"] = node->getMeshIndices();
-	if (node->sourceNodeIndex >= 0)
+	fields.meshIndices.assign(node.getMeshIndices().begin(), node.getMeshIndices().end());
+	if (node.sourceNodeIndex >= 0)
 	{
-		j["asset_node_index"] = node->sourceNodeIndex;
+		fields.assetNodeIndex = node.sourceNodeIndex;
+		fields.flags |= kNodeHasAssetNodeIndex;
 	}
-	if (node->animation.enabled)
+	if (node.getPrefab())
 	{
-		j["animation_component"] = {
-		    {"clip_id", node->animation.clipId},
-		    {"time_seconds", node->animation.timeSeconds},
-		    {"speed", node->animation.speed},
-		    {"loop", node->animation.loop},
-		    {"autoplay", node->animation.autoplay},
-		    {"playing", node->animation.playing}};
+		fields.flags |= kNodeHasPrefabInstance | kNodePrefabInstance;
 	}
-
-	// Children
-	j["children"] = nlohmann::json::array();
-	for (const auto &child : node->getChildren())
+	if (!node.getPrefabOverrides().empty())
+	{
+		fields.flags |= kNodeHasPrefabOverrides;
+		for (const auto &nodeOverride : node.getPrefabOverrides())
+		{
+			auto &entry = fields.prefabOverrides.emplace_back();
+			entry.templateIndex = nodeOverride.index;
+			std::copy_n(&nodeOverride.position.x, 3, entry.position);
+			entry.rotation[0] = nodeOverride.rotation.w;        // w, x, y, z
+			entry.rotation[1] = nodeOverride.rotation.x;
+			entry.rotation[2] = nodeOverride.rotation.y;
+			entry.rotation[3] = nodeOverride.rotation.z;
+			std::copy_n(&nodeOverride.scale.x, 3, entry.scale);
+		}
+	}
+	if (node.animation.enabled)
 	{
-		nlohmann::json childJ;
-		serializeNode(child, childJ, resourceManager);
-		j["children"].push_back(childJ);
+		fields.hasAnimation = true;
+		fields.animation.clipId = node.animation.clipId.str();
+		fields.animation.timeSeconds = node.animation.timeSeconds;
+		fields.animation.speed = node.animation.speed;
+		fields.animation.flags = kAnimationHasClipId | kAnimationHasTime | kAnimationHasSpeed | kAnimationHasLoop | kAnimationHasAutoplay | kAnimationHasPlaying;
+		fields.animation.flags |= node.animation.loop ? kAnimationLoop : 0u;
+		fields.animation.flags |= node.animation.autoplay ? kAnimationAutoplay : 0u;
+		fields.animation.flags |= node.animation.playing ? kAnimationPlaying : 0u;
 	}
 }
 
-void Scene::saveScene(const std::string &path, ResourceManager &resourceManager) const
+// Inverse of collectNodeFields. Model references are recorded in pendingModels and resolved once the
+// prefetched models have been committed, so nodes can be built while worker threads are still importing.
+void applyNodeFields(SceneNode &node, const Laphria::SceneJson::NodeFields &fields, std::vector<PendingModelBinding> &pendingModels)
 {
-	if (!root)
-		return;
+	using namespace Laphria::SceneBinary;
+
+	if (fields.flags & kNodeHasName)
+		node.name = fields.name;
+	if (fields.flags & kNodeHasId)
+		node.stableId = Laphria::StableId::parse(fields.id);
+
+	// Transform
+	if (fields.flags & kNodeHasPosition)
+		node.setPosition(glm::vec3(fields.position[0], fields.position[1], fields.position[2]));
+	if (fields.flags & kNodeHasRotation)
+		node.setRotation(glm::quat(fields.rotation[0], fields.rotation[1], fields.rotation[2], fields.rotation[3]));
+	if (fields.flags & kNodeHasScale)
+		node.setScale(glm::vec3(fields.scale[0], fields.scale[1], fields.scale[2]));
+
+	// Model
+	if (fields.flags & kNodeHasModelPath)
+	{
+		pendingModels.push_back(PendingModelBinding{
+		    .node = &node, .modelPath = fields.modelPath, .prefabInstance = (fields.flags & kNodePrefabInstance) != 0});
+	}
+	if (fields.flags & kNodeHasAssetRef)
+	{
+		if (fields.flags & kNodeHasAssetRefPath)
+			node.assetRef.path = fields.assetPath;
+		node.assetRef.variant = (fields.flags & kNodeHasAssetRefVariant) ? Laphria::Symbol(fields.assetVariant) : Laphria::Symbol("default");
+	}
+
+	// Mesh Indices
+	if (fields.flags & kNodeHasMeshIndices)
+		node.meshIndices.assign(fields.meshIndices.begin(), fields.meshIndices.end());
+	if (fields.flags & kNodeHasAssetNodeIndex)
+		node.sourceNodeIndex = fields.assetNodeIndex;
+	if (fields.flags & kNodeHasPrefabOverrides)
+	{
+		// Kept on the node until the pending model binding sets the template, which drops entries outside it.
+		std::vector<PrefabTemplate::Override> overrides;
+		overrides.reserve(fields.prefabOverrides.size());
+		for (const auto &entry : fields.prefabOverrides)
+		{
+			overrides.push_back(PrefabTemplate::Override{
+			    .index = entry.templateIndex,
+			    .position = glm::vec3(entry.position[0], entry.position[1], entry.position[2]),
+			    .rotation = glm::quat(entry.rotation[0], entry.rotation[1], entry.rotation[2], entry.rotation[3]),
+			    .scale = glm::vec3(entry.scale[0], entry.scale[1], entry.scale[2])});
+		}
+		node.setPrefabOverrides(std::move(overrides));
+	}
+	if (fields.hasAnimation)
+	{
+		const auto &anim = fields.animation;
+		node.animation.enabled = true;
+		node.animation.clipId = (anim.flags & kAnimationHasClipId) ? Laphria::Symbol(anim.clipId) : Laphria::Symbol();
+		node.animation.timeSeconds = (anim.flags & kAnimationHasTime) ? anim.timeSeconds : 0.0f;
+		node.animation.speed = (anim.flags & kAnimationHasSpeed) ? anim.speed : 1.0f;
+		node.animation.loop = (anim.flags & kAnimationHasLoop) ? (anim.flags & kAnimationLoop) != 0 : true;
+		node.animation.autoplay = (anim.flags & kAnimationHasAutoplay) ? (anim.flags & kAnimationAutoplay) != 0 : true;
+		node.animation.playing = (anim.flags & kAnimationHasPlaying) ? (anim.flags & kAnimationPlaying) != 0 : true;
+	}
+	// Legacy gameplay components are intentionally ignored on load.
+}
 
-	nlohmann::json rootJ;
-	serializeNode(root, rootJ, resourceManager);
+// Flattens the hierarchy into the binary node tables in pre-order.
+void buildBinaryScene(const SceneNode::Ptr &rootNode, Laphria::SceneBinary::BinarySceneBuilder &builder, const ResourceManager &resourceManager)
+{
+	Laphria::SceneJson::NodeFields                    fields;
+	std::vector<std::pair<const SceneNode *, int32_t>> stack{{rootNode.get(), -1}};
+	while (!stack.empty())
+	{
+		const auto [node, parentIndex] = stack.back();
+		stack.pop_back();
 
-	std::ofstream o(path);
-	o << std::setw(4) << rootJ << std::endl;
+		const uint32_t index = builder.addNode(parentIndex);
+		collectNodeFields(*node, fields, resourceManager);
+		Laphria::SceneJson::storeNodeFields(builder, index, fields);
 
-	std::cout << "Saved scene to " << path << std::endl;
+		// Reverse push keeps siblings in order.
+		const auto &children = node->getChildren();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			stack.emplace_back(it->get(), static_cast<int32_t>(index));
+		}
+	}
 }
 
-SceneNode::Ptr deserializeNode(const nlohmann::json &j, ResourceManager &resourceManager,
-                               std::map<std::string, int> &pathCache,
-                               vk::DescriptorSetLayout     layout)
+// Streams the hierarchy depth-first; only the ancestor chain of the current node is held.
+bool writeJsonScene(const SceneNode::Ptr &rootNode, std::ostream &output, bool pretty, const ResourceManager &resourceManager)
 {
-	auto node = std::make_shared<SceneNode>(j.value("name", "Node"));
-	node->stableId = j.value("id", node->stableId);
+	Laphria::SceneJson::SceneJsonWriter writer(output, pretty);
+	Laphria::SceneJson::NodeFields      fields;
 
-	// Transform
-	if (j.contains("position"))
+	collectNodeFields(*rootNode, fields, resourceManager);
+	writer.beginNode(fields);
+	std::vector<std::pair<const SceneNode *, size_t>> stack{{rootNode.get(), 0}};
+	while (!stack.empty())
 	{
-		auto p = j["position"];
-		node->setPosition(glm::vec3(p[0], p[1], p[2]));
+		auto &[node, nextChild] = stack.back();
+		if (nextChild < node->getChildren().size())
+		{
+			const SceneNode *child = node->getChildren()[nextChild++].get();
+			collectNodeFields(*child, fields, resourceManager);
+			writer.beginNode(fields);
+			stack.emplace_back(child, 0);
+		}
+		else
+		{
+			writer.endNode();
+			stack.pop_back();
+		}
 	}
-	if (j.contains("rotation"))
+	return writer.finish();
+}
+
+// First JSON pass: collects every distinct modelPath in document order so the models can be prefetched up front.
+class SceneModelPathCollector final : public Laphria::SceneJson::SceneReadHandler
+{
+  public:
+	bool beginNode(uint32_t, int32_t) override
 	{
-		auto r = j["rotation"];
-		node->setRotation(glm::quat(r[0], r[1], r[2], r[3]));
+		return true;
 	}
-	if (j.contains("scale"))
+
+	bool endNode(uint32_t, const Laphria::SceneJson::NodeFields &fields) override
 	{
-		auto s = j["scale"];
-		node->setScale(glm::vec3(s[0], s[1], s[2]));
+		if ((fields.flags & Laphria::SceneBinary::kNodeHasModelPath) && seen.insert(fields.modelPath).second)
+		{
+			paths.push_back(fields.modelPath);
+		}
+		return true;
 	}
 
-	// Model
-	if (j.contains("modelPath"))
+	void onError(const std::string &fieldPath, const std::string &message) override
 	{
-		std::string modelPath = j["modelPath"];
+		std::cerr << "Scene parse error: " << fieldPath << " | " << message << std::endl;
+	}
+
+	std::vector<std::string> paths;
 
-		int modelId = -1;
+  private:
+	std::unordered_set<std::string> seen;
+};
 
-		// Cache Check
-		auto it = pathCache.find(modelPath);
-		if (it != pathCache.end())
+// Second JSON pass: creates nodes as the reader opens them and fills them in once their fields are complete.
+class SceneNodeStreamBuilder final : public Laphria::SceneJson::SceneReadHandler
+{
+  public:
+	explicit SceneNodeStreamBuilder(std::vector<PendingModelBinding> &pendingModels) :
+	    pendingModels(pendingModels)
+	{
+	}
+
+	bool beginNode(uint32_t, int32_t) override
+	{
+		auto node = std::make_shared<SceneNode>("Node");
+		if (openNodes.empty())
 		{
-			modelId = it->second;
+			root = node;
 		}
 		else
 		{
-			// Load if not in cache
-			try
+			openNodes.back()->addChild(node);
+		}
+		openNodes.push_back(node.get());
+		return true;
+	}
+
+	bool endNode(uint32_t, const Laphria::SceneJson::NodeFields &fields) override
+	{
+		applyNodeFields(*openNodes.back(), fields, pendingModels);
+		missingIdCount += (fields.flags & Laphria::SceneBinary::kNodeHasId) == 0 ? 1 : 0;
+		openNodes.pop_back();
+		return true;
+	}
+
+	void onError(const std::string &fieldPath, const std::string &message) override
+	{
+		std::cerr << "Scene parse error: " << fieldPath << " | " << message << std::endl;
+	}
+
+	SceneNode::Ptr root;
+	size_t         missingIdCount = 0;
+
+  private:
+	std::vector<PendingModelBinding> &pendingModels;
+	std::vector<SceneNode *>          openNodes;
+};
+
+std::vector<std::string> collectBinarySceneModelPaths(const Laphria::SceneBinary::BinarySceneView &view)
+{
+	std::vector<std::string>             paths;
+	std::unordered_set<std::string_view> seen;
+	for (const auto &record : view.nodes())
+	{
+		if ((record.flags & Laphria::SceneBinary::kNodeHasModelPath) == 0)
+		{
+			continue;
+		}
+		const std::string_view modelPath = view.string(record.modelPath);
+		if (seen.insert(modelPath).second)
+		{
+			paths.emplace_back(modelPath);
+		}
+	}
+	return paths;
+}
+
+// Binary counterpart of SceneNodeStreamBuilder: one linear pass over the mapped node table.
+SceneNode::Ptr buildNodesFromBinary(const Laphria::SceneBinary::BinarySceneView &view, std::vector<PendingModelBinding> &pendingModels,
+                                    size_t &missingIdCount)
+{
+	std::vector<SceneNode::Ptr>    nodes;
+	Laphria::SceneJson::NodeFields fields;
+	nodes.reserve(view.nodeCount());
+	for (const auto &record : view.nodes())
+	{
+		auto node = std::make_shared<SceneNode>("Node");
+		Laphria::SceneJson::nodeFieldsFromRecord(view, record, fields);
+		applyNodeFields(*node, fields, pendingModels);
+		missingIdCount += (record.flags & Laphria::SceneBinary::kNodeHasId) == 0 ? 1 : 0;
+
+		// Pre-order tables guarantee the parent already exists and siblings arrive in order.
+		if (record.parentIndex >= 0)
+		{
+			nodes[record.parentIndex]->addChild(node);
+		}
+		nodes.push_back(std::move(node));
+	}
+	return nodes.empty() ? nullptr : nodes.front();
+}
+
+// Copies the nodes modified after sinceRevision (every node for a snapshot) in pre-order, so a new node's
+// parent is either part of the same change set, ahead of it, or already saved.
+Laphria::SceneJournal::ChangeSet captureSceneChanges(const SceneNode &rootNode, uint64_t sinceRevision, bool fullSnapshot,
+                                                     const ResourceManager &resourceManager)
+{
+	Laphria::SceneJournal::ChangeSet changes;
+	std::vector<const SceneNode *>   stack{&rootNode};
+	while (!stack.empty())
+	{
+		const SceneNode *node = stack.back();
+		stack.pop_back();
+		if (fullSnapshot || node->getRevision() > sinceRevision)
+		{
+			auto &change = changes.upserts.emplace_back();
+			change.parentId = node->getParent() ? node->getParent()->stableId.toString() : std::string();
+			collectNodeFields(*node, change.fields, resourceManager);
+		}
+
+		const auto &children = node->getChildren();
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
+		{
+			stack.push_back(it->get());
+		}
+	}
+	return changes;
+}
+
+void appendJournalModelPaths(const std::vector<Laphria::SceneJournal::ChangeSet> &journal, std::vector<std::string> &modelPaths)
+{
+	std::unordered_set<std::string> seen(modelPaths.begin(), modelPaths.end());
+	for (const auto &changes : journal)
+	{
+		for (const auto &change : changes.upserts)
+		{
+			if ((change.fields.flags & Laphria::SceneBinary::kNodeHasModelPath) && seen.insert(change.fields.modelPath).second)
+			{
+				modelPaths.push_back(change.fields.modelPath);
+			}
+		}
+	}
+}
+
+// Applies journal entries to the loaded hierarchy with the rules of SceneJournal::SceneDocument::apply.
+// Removed subtrees are moved to discardedNodes so pending model bindings never dangle.
+void replayJournal(SceneNode &rootNode, const std::vector<Laphria::SceneJournal::ChangeSet> &journal,
+                   std::vector<PendingModelBinding> &pendingModels, std::vector<SceneNode::Ptr> &discardedNodes)
+{
+	std::unordered_map<Laphria::StableId, SceneNode *> nodesById;
+	std::vector<SceneNode *>                           stack{&rootNode};
+	while (!stack.empty())
+	{
+		SceneNode *node = stack.back();
+		stack.pop_back();
+		nodesById[node->stableId] = node;
+		for (const auto &child : node->getChildren())
+		{
+			stack.push_back(child.get());
+		}
+	}
+
+	for (const auto &changes : journal)
+	{
+		for (const auto &change : changes.upserts)
+		{
+			SceneNode *parent = nullptr;
+			if (!change.parentId.empty())
 			{
-				// loadGltfModel returns a root node. We only want the Resource ID.
-				// The returned node structure is discarded because we reconstruct from JSON.
-				auto modelRoot       = resourceManager.loadGltfModel(modelPath, layout);
-				modelId              = modelRoot->modelId;        // Extract ID from the loaded node
-				pathCache[modelPath] = modelId;
+				const auto parentIt = nodesById.find(Laphria::StableId::parse(change.parentId));
+				if (parentIt == nodesById.end())
+				{
+					continue;
+				}
+				parent = parentIt->second;
+			}
+
+			const Laphria::StableId id = Laphria::StableId::parse(change.fields.id);
+			const auto it = nodesById.find(id);
+			SceneNode *node = it != nodesById.end() ? it->second : nullptr;
+			if (!parent && node != &rootNode)
+			{
+				std::cerr << "Scene journal replaces the root node; entry skipped." << std::endl;
+				continue;
 			}
-			catch (const std::exception &e)
+			if (!node)
 			{
-				std::cerr << "Failed to load model during deserialization: " << modelPath << " (" << e.what() << ")" << std::endl;
+				auto created = std::make_shared<SceneNode>("Node");
+				parent->addChild(created);
+				node = created.get();
+				nodesById[id] = node;
 			}
+			else
+			{
+				// Entries carry the complete node, so optional state absent from the entry is cleared.
+				pendingModels.push_back(PendingModelBinding{.node = node});
+				node->assetRef = {};
+				node->animation = {};
+				node->sourceNodeIndex = -1;
+				node->setPrefabOverrides({});
+				if (parent && node->getParent() != parent)
+				{
+					const SceneNode::Ptr moved = node->shared_from_this();
+					if (node->getParent())
+					{
+						node->getParent()->removeChild(moved);
+					}
+					parent->addChild(moved);
+				}
+			}
+			applyNodeFields(*node, change.fields, pendingModels);
 		}
 
-		if (modelId != -1)
+		for (const auto &id : changes.removedIds)
 		{
-			node->modelId = modelId;
-			if (node->assetRef.path.empty())
+			const auto it = nodesById.find(Laphria::StableId::parse(id));
+			if (it == nodesById.end() || it->second == &rootNode || !it->second->getParent())
+			{
+				continue;
+			}
+			SceneNode::Ptr removed = it->second->shared_from_this();
+			removed->getParent()->removeChild(removed);
+			stack.push_back(removed.get());
+			while (!stack.empty())
 			{
-				node->assetRef.path = modelPath;
-				node->assetRef.variant = "default";
+				SceneNode *node = stack.back();
+				stack.pop_back();
+				nodesById.erase(node->stableId);
+				for (const auto &child : node->getChildren())
+				{
+					stack.push_back(child.get());
+				}
 			}
+			discardedNodes.push_back(std::move(removed));
 		}
 	}
-	if (j.contains("asset_ref") && j["asset_ref"].is_object())
-	{
-		const auto &assetRef = j["asset_ref"];
-		node->assetRef.path = assetRef.value("path", node->assetRef.path);
-		node->assetRef.variant = assetRef.value("variant", std::string("default"));
-	}
+}
+}        // namespace
 
-	// Mesh Indices
-	if (j.contains("meshIndices"))
+void Scene::saveScene(const std::string &path, ResourceManager &resourceManager, bool prettyJson)
+{
+	if (!root)
+		return;
+
+	// Background writes still queued for this file must not land on top of the full save.
+	flushPendingSaves();
+
+	if (std::filesystem::path(path).extension() == Laphria::SceneBinary::kFileExtension)
 	{
-		node->meshIndices = j["meshIndices"].get<std::vector<int>>();
+		Laphria::SceneBinary::BinarySceneBuilder builder;
+		buildBinaryScene(root, builder, resourceManager);
+		std::string error;
+		if (!builder.writeFile(path, error))
+		{
+			std::cerr << error << std::endl;
+			return;
+		}
+		std::cout << "Saved binary scene to " << path << " (" << builder.nodeCount() << " nodes)" << std::endl;
 	}
-	if (j.contains("asset_node_index"))
+	else
 	{
-		node->sourceNodeIndex = j["asset_node_index"].get<int>();
+		std::ofstream o(path);
+		if (!o.is_open() || !writeJsonScene(root, o, prettyJson, resourceManager))
+		{
+			std::cerr << "Failed to write scene file: " << path << std::endl;
+			return;
+		}
+		std::cout << "Saved scene to " << path << std::endl;
 	}
-	if (j.contains("animation_component") && j["animation_component"].is_object())
+
+	// The new base already contains every journaled change.
+	std::error_code ec;
+	std::filesystem::remove(Laphria::SceneJournal::journalPathFor(path), ec);
+	resetSaveTracking(path);
+}
+
+void Scene::saveSceneIncremental(const std::string &path, ResourceManager &resourceManager, bool prettyJson)
+{
+	if (!root)
+		return;
+
+	reportBackgroundSaveErrors();
+	if (journalBasePath != path)
 	{
-		const auto &anim = j["animation_component"];
-		node->animation.enabled = true;
-		node->animation.clipId = anim.value("clip_id", std::string());
-		node->animation.timeSeconds = anim.value("time_seconds", 0.0f);
-		node->animation.speed = anim.value("speed", 1.0f);
-		node->animation.loop = anim.value("loop", true);
-		node->animation.autoplay = anim.value("autoplay", true);
-		node->animation.playing = anim.value("playing", true);
+		sceneWriter->submitSnapshot(path, captureSceneChanges(*root, savedRevision, true, resourceManager), prettyJson);
 	}
-	// Legacy gameplay components are intentionally ignored on load.
-
-	// Children
-	if (j.contains("children"))
+	else
 	{
-		for (const auto &childJ : j["children"])
+		auto changes = captureSceneChanges(*root, savedRevision, false, resourceManager);
+		changes.removedIds.reserve(removedSinceSave.size());
+		for (const Laphria::StableId id : removedSinceSave)
 		{
-			node->addChild(deserializeNode(childJ, resourceManager, pathCache, layout));
+			changes.removedIds.push_back(id.toString());
+		}
+		if (!changes.empty())
+		{
+			sceneWriter->submitChanges(path, std::move(changes), prettyJson);
 		}
 	}
+	resetSaveTracking(path);
+}
+
+void Scene::setAutosave(const std::string &path, float intervalSeconds, bool prettyJson)
+{
+	autosavePath = path;
+	autosaveIntervalSeconds = intervalSeconds;
+	autosaveElapsedSeconds = 0.0f;
+	autosavePrettyJson = prettyJson;
+}
+
+void Scene::updateAutosave(float deltaTime, ResourceManager &resourceManager)
+{
+	if (autosavePath.empty())
+		return;
+
+	autosaveElapsedSeconds += deltaTime;
+	// While the previous save is still being written the tick is skipped; its changes go into the next one.
+	if (autosaveElapsedSeconds < autosaveIntervalSeconds || sceneWriter->busy())
+		return;
 
-	return node;
+	autosaveElapsedSeconds = 0.0f;
+	saveSceneIncremental(autosavePath, resourceManager, autosavePrettyJson);
+}
+
+void Scene::flushPendingSaves()
+{
+	sceneWriter->waitIdle();
+	reportBackgroundSaveErrors();
+}
+
+void Scene::resetSaveTracking(const std::string &basePath)
+{
+	journalBasePath = basePath;
+	savedRevision = SceneNode::latestRevision();
+	removedSinceSave.clear();
+}
+
+void Scene::reportBackgroundSaveErrors()
+{
+	const std::vector<std::string> errors = sceneWriter->takeErrors();
+	for (const auto &error : errors)
+	{
+		std::cerr << "Background scene save failed: " << error << std::endl;
+	}
+	if (!errors.empty())
+	{
+		// The journal may be missing entries; the next incremental save rewrites the whole scene.
+		journalBasePath.clear();
+	}
 }
 
 void Scene::loadScene(const std::string &path, ResourceManager &resourceManager, vk::DescriptorSetLayout layout)
 {
-	std::ifstream i(path);
-	if (!i.is_open())
+	// Autosaves still queued for this file have to land before it is read.
+	flushPendingSaves();
+
+	const auto loadStart = std::chrono::high_resolution_clock::now();
+	SceneLoadReport report{};
+	report.scenePath = path;
+
+	// Binary scenes are mapped and validated in place. JSON scenes are streamed twice (model scan, then
+	// node construction) so the document is never held in memory.
+	report.binaryFormat = Laphria::SceneBinary::isBinarySceneFile(path);
+	Laphria::SceneBinary::BinarySceneView binaryView;
+	std::vector<std::string> modelPaths;
+	if (report.binaryFormat)
 	{
-		std::cerr << "Failed to open scene file: " << path << std::endl;
-		return;
+		std::string error;
+		if (!binaryView.open(path, error))
+		{
+			std::cerr << "Failed to open binary scene file: " << error << std::endl;
+			return;
+		}
+	}
+	const auto parseEnd = std::chrono::high_resolution_clock::now();
+	report.parseMs = elapsedMs(loadStart, parseEnd);
+
+	// Scan pass: start importing every referenced model before touching the hierarchy.
+	if (report.binaryFormat)
+	{
+		modelPaths = collectBinarySceneModelPaths(binaryView);
+	}
+	else
+	{
+		std::ifstream i(path);
+		if (!i.is_open())
+		{
+			std::cerr << "Failed to open scene file: " << path << std::endl;
+			return;
+		}
+		SceneModelPathCollector collector;
+		if (!Laphria::SceneJson::readScene(i, collector))
+		{
+			throw std::runtime_error("Failed to parse scene file: " + path);
+		}
+		modelPaths = std::move(collector.paths);
 	}
 
-	nlohmann::json j;
-	i >> j;
+	// Changes saved incrementally since the base was written; their models are prefetched with the rest.
+	std::vector<Laphria::SceneJournal::ChangeSet> journal;
+	std::string journalError;
+	const bool journalValid = Laphria::SceneJournal::readJournal(path, journal, journalError);
+	if (!journalValid)
+	{
+		std::cerr << "Ignoring scene journal: " << journalError << std::endl;
+		journal.clear();
+	}
+	appendJournalModelPaths(journal, modelPaths);
+	report.journalEntryCount = journal.size();
+	report.modelPathCount = modelPaths.size();
+	resourceManager.beginGltfPrefetch(modelPaths);
+	const auto scanEnd = std::chrono::high_resolution_clock::now();
+	report.scanMs = elapsedMs(parseEnd, scanEnd);
 
 	// Clear current scene
 	root = nullptr;
-	allNodes.clear();
+	clearNodes();
 	if (octree)
 		octree->clear();
-
-	// Temp path cache for this load session
-	std::map<std::string, int> pathCache;
+	autosavePath.clear();
 
 	std::cout << "Loading scene from " << path << std::endl;
 
-	root = deserializeNode(j, resourceManager, pathCache, layout);
+	// Node hierarchy is built on this thread while the model workers run.
+	std::vector<PendingModelBinding> pendingModels;
+	size_t missingIdCount = 0;
+	if (report.binaryFormat)
+	{
+		root = buildNodesFromBinary(binaryView, pendingModels, missingIdCount);
+	}
+	else
+	{
+		std::ifstream i(path);
+		SceneNodeStreamBuilder builder(pendingModels);
+		if (!Laphria::SceneJson::readScene(i, builder))
+		{
+			// The file changed between passes; keep what was read so the prefetch below still completes.
+			std::cerr << "Scene file changed while loading: " << path << std::endl;
+		}
+		root = builder.root ? builder.root : std::make_shared<SceneNode>("Root");
+		missingIdCount = builder.missingIdCount;
+	}
+	std::vector<SceneNode::Ptr> discardedNodes;
+	if (root && !journal.empty())
+	{
+		replayJournal(*root, journal, pendingModels, discardedNodes);
+	}
+	const auto hierarchyEnd = std::chrono::high_resolution_clock::now();
+	report.hierarchyMs = elapsedMs(scanEnd, hierarchyEnd);
+
+	ModelBatchLoadReport modelReport{};
+	const std::unordered_map<std::string, int> modelIds = resourceManager.completeGltfPrefetch(layout, &modelReport);
+	const auto modelsEnd = std::chrono::high_resolution_clock::now();
+	report.cachedModelCount = modelReport.cachedCount;
+	report.failedModelCount = modelReport.failedCount;
+	report.modelWaitMs = modelReport.prepareWaitMs;
+	report.gpuUploadMs = modelReport.gpuCommitMs;
+	for (const auto &error : modelReport.errors)
+	{
+		std::cerr << "Failed to load model during deserialization: " << error << std::endl;
+	}
+
+	// Journal replay appends bindings after the base file's, so the last binding of each node wins.
+	std::unordered_set<const SceneNode *> boundNodes;
+	for (auto bindingIt = pendingModels.rbegin(); bindingIt != pendingModels.rend(); ++bindingIt)
+	{
+		const auto &binding = *bindingIt;
+		if (!boundNodes.insert(binding.node).second)
+		{
+			continue;
+		}
+		const auto it = modelIds.find(binding.modelPath);
+		if (it == modelIds.end())
+		{
+			continue;
+		}
+		binding.node->modelId = it->second;
+		if (binding.prefabInstance)
+		{
+			const ModelResource *model = resourceManager.getModelResource(it->second);
+			if (model && model->prefabTemplate)
+			{
+				binding.node->setPrefab(model->prefabTemplate);
+			}
+			else if (model && model->prototype)
+			{
+				// The model can no longer be instanced (it gained animation or skinning); materialize its hierarchy.
+				// Template overrides have nothing left to apply to.
+				for (const auto &child : model->prototype->getChildren())
+				{
+					binding.node->addChild(child->clone());
+				}
+				binding.node->setPrefabOverrides({});
+			}
+		}
+		if (binding.node->assetRef.path.empty())
+		{
+			binding.node->assetRef.path = binding.modelPath;
+		}
+		if (binding.node->assetRef.variant.empty())
+		{
+			binding.node->assetRef.variant = "default";
+		}
+	}
 
 	// Rebuild the flat node cache used by systems that iterate scene nodes directly
 	// (e.g. TLAS construction for RT/PT paths).
@@ -446,7 +1065,7 @@ void Scene::loadScene(const std::string &path, ResourceManager &resourceManager,
 		{
 			auto n = stack.back();
 			stack.pop_back();
-			allNodes.push_back(n);
+			registerNode(n);
 			for (const auto &c : n->getChildren())
 			{
 				stack.push_back(c);
@@ -455,15 +1074,29 @@ void Scene::loadScene(const std::string &path, ResourceManager &resourceManager,
 	}
 
 	rebuildOctree();
+
+	const auto loadEnd = std::chrono::high_resolution_clock::now();
+	report.nodeCount = allNodes.size();
+	report.finalizeMs = elapsedMs(modelsEnd, loadEnd);
+	report.totalMs = elapsedMs(loadStart, loadEnd);
+	std::ostringstream timings;
+	timings << std::fixed << std::setprecision(2)
+	        << "Scene load timings (ms) | format=" << (report.binaryFormat ? "binary" : "json") << " nodes=" << report.nodeCount << " models=" << report.modelPathCount
+	        << " journal=" << report.journalEntryCount << " cached=" << report.cachedModelCount << " failed=" << report.failedModelCount
+	        << " parse=" << report.parseMs.value_or(0.0) << " scan=" << report.scanMs.value_or(0.0)
+	        << " hierarchy=" << report.hierarchyMs.value_or(0.0) << " modelWait=" << report.modelWaitMs.value_or(0.0)
+	        << " gpuUpload=" << report.gpuUploadMs.value_or(0.0) << " finalize=" << report.finalizeMs.value_or(0.0)
+	        << " total=" << report.totalMs.value_or(0.0);
+	std::cout << timings.str() << std::endl;
+	lastLoadReport = std::move(report);
+
+	// Nodes without a stored ID received fresh ones, which an existing journal could not refer to.
+	resetSaveTracking(journalValid && missingIdCount == 0 ? path : std::string());
 }
 
 void Scene::update(float deltaTime, const ResourceManager &resourceManager) const {
-	for (const auto &node : allNodes)
+	for (const auto &node : animatedNodes.getNodes())
 	{
-		if (!node || !node->animation.enabled)
-		{
-			continue;
-		}
 		auto *modelResource = resourceManager.getModelResource(node->modelId);
 		if (!modelResource || modelResource->animationClips.empty())
 		{
@@ -542,9 +1175,49 @@ void Scene::updateWorldTransforms() const {
 	root->updateWorldTransformRecursive(glm::mat4(1.0f), false);
 }
 
-void Scene::syncSpatialIndex() const {
+void Scene::syncSpatialIndex()
+{
 	updateWorldTransforms();
-	rebuildOctree();
+
+	changedNodes.clear();
+	transformJournal.drain([this](SceneNode &node) {
+		changedNodes.push_back(node.shared_from_this());
+	});
+	++transformChangeFrame;
+
+	if (!octree || changedNodes.empty())
+		return;
+
+	// Past a quarter of the scene, one rebuild is cheaper than moving the nodes one at a time.
+	if (changedNodes.size() * 4 > allNodes.size())
+	{
+		rebuildOctree();
+		return;
+	}
+	for (const auto &node : changedNodes)
+	{
+		octree->insert(node);
+	}
+}
+
+bool Scene::collectTransformChangesSince(uint64_t sinceFrame, std::vector<SceneNode *> &changed) const
+{
+	changed.clear();
+	if (sinceFrame + 1 == transformChangeFrame)
+	{
+		for (const auto &node : changedNodes)
+		{
+			changed.push_back(node.get());
+		}
+	}
+	else if (sinceFrame != transformChangeFrame)
+	{
+		return false;
+	}
+	transformJournal.forEachPending([&](SceneNode &node) {
+		changed.push_back(&node);
+	});
+	return true;
 }
 
 void Scene::setFreezeCulling(bool freeze)
@@ -555,24 +1228,47 @@ void Scene::setFreezeCulling(bool freeze)
 void Scene::draw(const vk::raii::CommandBuffer &cmd, const vk::raii::PipelineLayout &pipelineLayout,
                  const ResourceManager &resourceManager, const Laphria::AABB &cullBounds, const Laphria::Frustum &frustum) const
 {
+	std::vector<SceneNode::Ptr> visibleNodes;
+	collectVisibleNodes(cullBounds, frustum, visibleNodes);
+	for (const auto &node : visibleNodes)
+	{
+		drawNode(node, cmd, pipelineLayout, resourceManager);
+	}
+}
+
+void Scene::collectVisibleNodes(const Laphria::AABB &cullBounds, const Laphria::Frustum &frustum, std::vector<SceneNode::Ptr> &out) const
+{
+	out.clear();
 	if (!root || !octree)
 		return;
 
 	// 1. Cull against octree — freeze culling snapshots the bounds for debugging
-	std::vector<SceneNode::Ptr> visibleNodes;
+	std::vector<SceneNode::Ptr> candidates;
 	if (freezeCulling)
 	{
 		// Keep using the bounds that were active when freeze was first applied
-		octree->query(frozenCullBounds, visibleNodes);
+		octree->query(frozenCullBounds, candidates);
 	}
 	else
 	{
 		frozenCullBounds = cullBounds;        // Keep snapshot up-to-date for when freeze is toggled
-		octree->query(cullBounds, visibleNodes);
+		octree->query(cullBounds, candidates);
 	}
 
-	for (const auto &node : visibleNodes)
+	for (const auto &node : candidates)
 	{
+		// A collapsed prefab instance draws its whole template, so it is tested with the template's bounds.
+		glm::vec3 worldMin;
+		glm::vec3 worldMax;
+		if (node->getPrefabWorldBounds(worldMin, worldMax))
+		{
+			if (frustum.intersectsBox(worldMin, worldMax))
+			{
+				out.push_back(node);
+			}
+			continue;
+		}
+
 		// Keep frustum culling slightly conservative in raster mode so model origins
 		// near/behind the near plane do not pop entire meshes out.
 		constexpr float kFrustumCullMargin = 2.0f;
@@ -580,16 +1276,13 @@ void Scene::draw(const vk::raii::CommandBuffer &cmd, const vk::raii::PipelineLay
 		{
 			continue;
 		}
-		drawNode(node, cmd, pipelineLayout, resourceManager);
+		out.push_back(node);
 	}
 }
 
 void Scene::drawNode(const SceneNode::Ptr &node, const vk::raii::CommandBuffer &cmd, const vk::raii::PipelineLayout &graphicsPipelineLayout,
                      const ResourceManager &resourceManager)
 {
-	// Compute global transform efficiently
-	glm::mat4 globalTransform = node->getWorldTransform();
-
 	// Draw if it has a model
 	if (node->modelId != -1)
 	{
@@ -605,25 +1298,28 @@ void Scene::drawNode(const SceneNode::Ptr &node, const vk::raii::CommandBuffer &
 				                       nullptr);
 			}
 
-			for (int meshIdx : node->getMeshIndices())
-			{
-				if (meshIdx >= 0 && meshIdx < modelRes->meshes.size())
+			// A collapsed prefab instance also draws its template nodes, all from the same bound buffers.
+			node->forEachMeshInstance([&](const glm::mat4 &globalTransform, const std::vector<int> &meshIndices) {
+				for (int meshIdx : meshIndices)
 				{
-					const auto &mesh = modelRes->meshes[meshIdx];
-					for (const auto &primitive : mesh.primitives)
+					if (meshIdx >= 0 && meshIdx < modelRes->meshes.size())
 					{
-						ScenePushConstants pc{};
-						pc.modelMatrix   = globalTransform;
-						pc.materialIndex = primitive.flatPrimitiveIndex;
-						cmd.pushConstants<Laphria::ScenePushConstants>(*graphicsPipelineLayout,
-						                                               vk::ShaderStageFlagBits::eVertex |
-						                                                   vk::ShaderStageFlagBits::eFragment,
-						                                               0, pc);
-
-						cmd.drawIndexed(primitive.indexCount, 1, primitive.firstIndex, primitive.vertexOffset, 0);
+						const auto &mesh = modelRes->meshes[meshIdx];
+						for (const auto &primitive : mesh.primitives)
+						{
+							ScenePushConstants pc{};
+							pc.modelMatrix   = globalTransform;
+							pc.materialIndex = primitive.flatPrimitiveIndex;
+							cmd.pushConstants<Laphria::ScenePushConstants>(*graphicsPipelineLayout,
+							                                               vk::ShaderStageFlagBits::eVertex |
+							                                                   vk::ShaderStageFlagBits::eFragment,
+							                                               0, pc);
+
+							cmd.drawIndexed(primitive.indexCount, 1, primitive.firstIndex, primitive.vertexOffset, 0);
+						}
 					}
 				}
-			}
+			});
 		}
 	}
 }
@@ -634,7 +1330,7 @@ void Scene::drawNode(const SceneNode::Ptr &node, const vk::raii::CommandBuffer &
 
 void Scene::clearScene()
 {
-	allNodes.clear();
+	clearNodes();
 	sphereModelId   = -1;
 	cubeModelId     = -1;
 	cylinderModelId = -1;
@@ -642,7 +1338,8 @@ void Scene::clearScene()
 	if (root)
 	{
 		root = std::make_shared<SceneNode>("Root");
-		allNodes.clear();
+		autosavePath.clear();
+		resetSaveTracking(std::string());
 
 		// Re-init octree
 		if (octree)
@@ -2,13 +2,40 @@
 #define LAPHRIAENGINE_SCENE_H
 
 #include "Frustum.h"
+#include "NodeRegistry.h"
 #include "SceneNode.h"
 #include "Octree.h"
+#include "TransformJournal.h"
 #include <vulkan/vulkan_raii.hpp>
+#include <optional>
 #include <string>
 
 // Forward declaration
 class ResourceManager;
+namespace Laphria::SceneJournal
+{
+class AsyncSceneWriter;
+}
+
+// Phase breakdown of the last Scene::loadScene call. Model preparation runs on worker threads while the
+// node hierarchy is built, so hierarchyMs and the workers overlap; modelWaitMs is only the remaining stall.
+struct SceneLoadReport
+{
+    std::string           scenePath;
+    size_t                nodeCount = 0;
+    size_t                journalEntryCount = 0;        // incremental-save entries replayed onto the base file
+    size_t                modelPathCount = 0;
+    size_t                cachedModelCount = 0;
+    size_t                failedModelCount = 0;
+    bool                  binaryFormat = false;
+    std::optional<double> parseMs;            // binary scenes: map + table validation (JSON is parsed while streaming)
+    std::optional<double> scanMs;             // referenced model path collection (first streaming pass for JSON)
+    std::optional<double> hierarchyMs;        // node construction
+    std::optional<double> modelWaitMs;        // blocked on worker-thread parse/extraction/decode
+    std::optional<double> gpuUploadMs;        // batched GPU commit of the prefetched models
+    std::optional<double> finalizeMs;         // model ID fix-up, flat node list and octree rebuild
+    std::optional<double> totalMs;
+};
 
 // Manages the scene graph (hierarchy of SceneNodes), an octree for spatial culling,
 // and convenience methods for model loading, serialization, and physics scenarios.
@@ -17,7 +44,7 @@ class Scene {
 public:
     Scene();
 
-    ~Scene() = default;
+    ~Scene();        // finishes queued background saves
 
     // Must be called before any nodes are added. worldBounds defines the octree's spatial extent.
     void init(Laphria::AABB worldBounds);
@@ -30,8 +57,22 @@ public:
     const std::vector<SceneNode::Ptr> &getAllNodes() const { return allNodes; }
     std::vector<SceneNode::Ptr> &getAllNodes() { return allNodes; }
 
+    // Per-component node lists, so systems do not filter getAllNodes() every frame.
+    const std::vector<SceneNode::Ptr> &getRenderables() const { return renderables.getNodes(); }        // modelId >= 0
+    const std::vector<SceneNode::Ptr> &getPhysicsBodies() const { return physicsBodies.getNodes(); }    // physics.enabled
+    const std::vector<SceneNode::Ptr> &getAnimatedNodes() const { return animatedNodes.getNodes(); }    // animation.enabled
+    // Instance roots of models with runtime skinning; rebuilt from the renderables only after they change.
+    const std::vector<SceneNode::Ptr> &getSkinnedInstances(const ResourceManager &resourceManager) const;
+
+    // Re-evaluates the registries for one node already in the scene. Call after changing its modelId,
+    // physics.enabled or animation.enabled, or after reparenting it.
+    void updateComponents(const SceneNode::Ptr &node);
+
     void deleteNode(const SceneNode::Ptr &node);
 
+    // Turns a collapsed prefab instance into regular child nodes so they can be edited one by one.
+    void expandPrefab(const SceneNode::Ptr &node);
+
     // Scenarios
     void createPhysicsScenario(int type, ResourceManager &rm, vk::DescriptorSetLayout layout);
 
@@ -39,15 +80,41 @@ public:
 
     void rebuildOctree() const;
     void updateWorldTransforms() const;
-    void syncSpatialIndex() const;
+    // Once per frame: drains the transform journal and moves only the changed nodes in the octree.
+    void syncSpatialIndex();
+
+    // Nodes drained by the last syncSpatialIndex call, and how many drains have happened so far.
+    const std::vector<SceneNode::Ptr> &getChangedNodes() const { return changedNodes; }
+    uint64_t getTransformChangeFrame() const { return transformChangeFrame; }
+    // Nodes whose transform changed after drain number sinceFrame, for consumers that run before the drain
+    // (the last drained list if it came after sinceFrame, plus the pending entries). Returns false when the
+    // caller has missed a drain and has to treat every node as changed.
+    bool collectTransformChangesSince(uint64_t sinceFrame, std::vector<SceneNode *> &changed) const;
+    // Changes whenever a registry gains or loses a node.
+    uint64_t getComponentsVersion() const { return componentsVersion; }
 
     // Resource Loading
     void loadModel(const std::string &path, ResourceManager &resourceManager, vk::DescriptorSetLayout layout, const SceneNode::Ptr &parent = nullptr);
 
-    // Serialization
-    void saveScene(const std::string &path, ResourceManager &resourceManager) const;
+    // Serialization. Paths ending in SceneBinary::kFileExtension are written in the binary scene format,
+    // anything else as streamed JSON (compact unless prettyJson); loadScene detects the format from the file header.
+    void saveScene(const std::string &path, ResourceManager &resourceManager, bool prettyJson = false);
+
+    // Incremental save: copies only the nodes modified since the last save (SceneNode revisions) on this thread
+    // and appends them to <path>.journal on a background writer, which folds the journal into the base file once it
+    // passes EngineConfig::kSceneJournalCompactBytes. Until this scene has a base at path (saved or loaded there)
+    // the call queues a full snapshot instead, written on the same worker.
+    void saveSceneIncremental(const std::string &path, ResourceManager &resourceManager, bool prettyJson = false);
+
+    // Autosave runs saveSceneIncremental every intervalSeconds from updateAutosave; an empty path disables it.
+    // Loading or clearing the scene disables it too, so a different scene never overwrites the autosave target.
+    void setAutosave(const std::string &path, float intervalSeconds, bool prettyJson = false);
+    void updateAutosave(float deltaTime, ResourceManager &resourceManager);
+    [[nodiscard]] const std::string &getAutosavePath() const { return autosavePath; }
+    void flushPendingSaves();
 
     void loadScene(const std::string &path, ResourceManager &resourceManager, vk::DescriptorSetLayout layout);
+    [[nodiscard]] const SceneLoadReport *getLastLoadReport() const { return lastLoadReport ? &*lastLoadReport : nullptr; }
 
     // Runtime
     void update(float deltaTime, const ResourceManager &resourceManager) const;
@@ -55,16 +122,45 @@ public:
     // Draws all nodes whose world position falls within cullBounds (octree-accelerated query).
     void draw(const vk::raii::CommandBuffer &cmd, const vk::raii::PipelineLayout &pipelineLayout, const ResourceManager &resourceManager,
               const Laphria::AABB &cullBounds, const Laphria::Frustum &frustum) const;
+    // The nodes draw() would submit, for passes that record their own draws (raster occlusion culling).
+    void collectVisibleNodes(const Laphria::AABB &cullBounds, const Laphria::Frustum &frustum, std::vector<SceneNode::Ptr> &out) const;
 
     // When freeze is true, the culling AABB is locked to its current value for debugging.
     void setFreezeCulling(bool freeze);
 
 private:
+    Laphria::TransformJournal transformJournal;        // declared first: outlives every node below
+    std::vector<SceneNode::Ptr> changedNodes;
+    uint64_t transformChangeFrame = 0;
     SceneNode::Ptr root;
     std::vector<SceneNode::Ptr> allNodes;
     std::unique_ptr<Laphria::Octree> octree;
+    Laphria::NodeRegistry renderables;
+    Laphria::NodeRegistry physicsBodies;
+    Laphria::NodeRegistry animatedNodes;
+    mutable std::vector<SceneNode::Ptr> skinnedInstances;
+    uint64_t componentsVersion = 1;
+    mutable uint64_t skinnedInstancesVersion = 0;
     bool freezeCulling = false;
     mutable Laphria::AABB frozenCullBounds{{0,0,0},{0,0,0}};
+    std::optional<SceneLoadReport> lastLoadReport;
+
+    // Incremental save state
+    std::unique_ptr<Laphria::SceneJournal::AsyncSceneWriter> sceneWriter;
+    std::string journalBasePath;                // file whose base matches this hierarchy; empty forces a full snapshot
+    uint64_t savedRevision = 0;                 // nodes with a newer SceneNode revision go into the next journal entry
+    std::vector<Laphria::StableId> removedSinceSave;  // stable IDs of subtrees deleted since the last save
+    std::string autosavePath;
+    float autosaveIntervalSeconds = 0.0f;
+    float autosaveElapsedSeconds = 0.0f;
+    bool autosavePrettyJson = false;
+
+    void registerSubtree(const SceneNode::Ptr &node);
+    void registerNode(const SceneNode::Ptr &node);
+    void unregisterNode(const SceneNode::Ptr &node);
+    void clearNodes();
+    void resetSaveTracking(const std::string &basePath);
+    void reportBackgroundSaveErrors();
 
     // Cached Model IDs for physics primitives
     int sphereModelId = -1;
@@ -0,0 +1,418 @@
+#include "SceneBinaryFormat.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace Laphria::SceneBinary
+{
+namespace
+{
+constexpr uint64_t kTableAlignment = 8;
+
+uint64_t alignUp(uint64_t value)
+{
+    return (value + kTableAlignment - 1) & ~(kTableAlignment - 1);
+}
+
+bool tableInBounds(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+{
+    if (offset % kTableAlignment != 0 || offset > fileSize)
+    {
+        return false;
+    }
+    return count <= (fileSize - offset) / elementSize;
+}
+
+}        // namespace
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        mappedData = std::exchange(other.mappedData, nullptr);
+        mappedSize = std::exchange(other.mappedSize, 0);
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string &path, std::string &error)
+{
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        error = "Failed to open file: " + path;
+        return false;
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        error = "File is empty or unreadable: " + path;
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        error = "Failed to create file mapping: " + path;
+        return false;
+    }
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        error = "Failed to map file: " + path;
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedData = static_cast<const uint8_t *>(view);
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        error = "Failed to open file: " + path;
+        return false;
+    }
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        ::close(fd);
+        error = "File is empty or unreadable: " + path;
+        return false;
+    }
+    void *view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);        // the mapping keeps its own reference to the file
+    if (view == MAP_FAILED)
+    {
+        error = "Failed to map file: " + path;
+        return false;
+    }
+    mappedData = static_cast<const uint8_t *>(view);
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (mappedData)
+    {
+        UnmapViewOfFile(mappedData);
+    }
+    if (mappingHandle)
+    {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle)
+    {
+        CloseHandle(fileHandle);
+    }
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    if (mappedData)
+    {
+        munmap(const_cast<uint8_t *>(mappedData), mappedSize);
+    }
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+bool BinarySceneView::open(const std::string &path, std::string &error)
+{
+    if (!mapping.open(path, error))
+    {
+        return false;
+    }
+    bytes = mapping.data();
+    byteCount = mapping.size();
+    if (!validate(error))
+    {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+bool BinarySceneView::openMemory(const uint8_t *data, size_t size, std::string &error)
+{
+    mapping.close();
+    bytes = data;
+    byteCount = size;
+    return validate(error);
+}
+
+bool BinarySceneView::validate(std::string &error)
+{
+    header = nullptr;
+    if (!bytes || byteCount < kFileHeaderSizeV2 || reinterpret_cast<uintptr_t>(bytes) % kTableAlignment != 0)
+    {
+        error = "Binary scene is truncated or misaligned.";
+        return false;
+    }
+    const auto *candidate = reinterpret_cast<const FileHeader *>(bytes);
+    if (std::memcmp(candidate->magic, kMagic, sizeof(kMagic)) != 0)
+    {
+        error = "Not a binary scene file.";
+        return false;
+    }
+    if (candidate->version == 0 || candidate->version > kVersion)
+    {
+        error = "Unsupported binary scene version " + std::to_string(candidate->version) + ".";
+        return false;
+    }
+    const bool     hasOverrideTable = candidate->version >= 3;
+    const uint32_t overrideCount = hasOverrideTable ? candidate->prefabOverrideCount : 0u;
+    if (hasOverrideTable && (byteCount < sizeof(FileHeader) ||
+                             !tableInBounds(candidate->prefabOverridesOffset, overrideCount, sizeof(PrefabOverrideRecord), byteCount)))
+    {
+        error = "Binary scene table layout is out of bounds.";
+        return false;
+    }
+    if (candidate->fileSize != byteCount || candidate->nodeCount == 0 ||
+        !tableInBounds(candidate->nodesOffset, candidate->nodeCount, sizeof(NodeRecord), byteCount) ||
+        !tableInBounds(candidate->meshIndicesOffset, candidate->meshIndexCount, sizeof(int32_t), byteCount) ||
+        !tableInBounds(candidate->animationsOffset, candidate->animationCount, sizeof(AnimationRecord), byteCount) ||
+        !tableInBounds(candidate->stringsOffset, candidate->stringBytes, 1, byteCount))
+    {
+        error = "Binary scene table layout is out of bounds.";
+        return false;
+    }
+
+    const auto *nodeRecords = reinterpret_cast<const NodeRecord *>(bytes + candidate->nodesOffset);
+    const auto *animationRecords = reinterpret_cast<const AnimationRecord *>(bytes + candidate->animationsOffset);
+    const auto *overrideRecords =
+        hasOverrideTable ? reinterpret_cast<const PrefabOverrideRecord *>(bytes + candidate->prefabOverridesOffset) : nullptr;
+    const auto  stringInBounds = [&](StringRef ref) {
+        return ref.offset <= candidate->stringBytes && ref.length <= candidate->stringBytes - ref.offset;
+    };
+
+    for (uint32_t i = 0; i < candidate->animationCount; ++i)
+    {
+        if (!stringInBounds(animationRecords[i].clipId))
+        {
+            error = "Animation record " + std::to_string(i) + " has an invalid clip id.";
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < candidate->nodeCount; ++i)
+    {
+        const NodeRecord &node = nodeRecords[i];
+        const bool parentValid = (i == 0) ? node.parentIndex == -1 : (node.parentIndex >= 0 && static_cast<uint32_t>(node.parentIndex) < i);
+        const bool stringsValid = stringInBounds(node.id) && stringInBounds(node.name) && stringInBounds(node.modelPath) &&
+                                  stringInBounds(node.assetPath) && stringInBounds(node.assetVariant);
+        const bool meshValid = node.meshIndexFirst <= candidate->meshIndexCount &&
+                               node.meshIndexCount <= candidate->meshIndexCount - node.meshIndexFirst;
+        const bool animationValid = node.animationIndex == -1 ||
+                                    (node.animationIndex >= 0 && static_cast<uint32_t>(node.animationIndex) < candidate->animationCount);
+        if (!parentValid || !stringsValid || !meshValid || !animationValid)
+        {
+            error = "Node record " + std::to_string(i) + " references data outside the file.";
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < overrideCount; ++i)
+    {
+        const PrefabOverrideRecord &record = overrideRecords[i];
+        if (record.nodeIndex >= candidate->nodeCount || record.templateIndex == 0 ||
+            (i > 0 && record.nodeIndex < overrideRecords[i - 1].nodeIndex))
+        {
+            error = "Prefab override record " + std::to_string(i) + " is out of order or references a missing node.";
+            return false;
+        }
+    }
+
+    header = candidate;
+    nodeTable = nodeRecords;
+    meshIndexTable = reinterpret_cast<const int32_t *>(bytes + candidate->meshIndicesOffset);
+    animationTable = animationRecords;
+    prefabOverrideTable = overrideRecords;
+    prefabOverrideCount = overrideCount;
+    stringTable = reinterpret_cast<const char *>(bytes + candidate->stringsOffset);
+    return true;
+}
+
+std::span<const int32_t> BinarySceneView::meshIndices(const NodeRecord &node) const
+{
+    return {meshIndexTable + node.meshIndexFirst, node.meshIndexCount};
+}
+
+const AnimationRecord *BinarySceneView::animation(const NodeRecord &node) const
+{
+    return node.animationIndex >= 0 ? &animationTable[node.animationIndex] : nullptr;
+}
+
+std::span<const PrefabOverrideRecord> BinarySceneView::prefabOverrides(const NodeRecord &node) const
+{
+    if (!(node.flags & kNodeHasPrefabOverrides))
+    {
+        return {};
+    }
+    const auto nodeIndex = static_cast<uint32_t>(&node - nodeTable);
+    const auto records = std::ranges::equal_range(std::span(prefabOverrideTable, prefabOverrideCount), nodeIndex, {},
+                                                  &PrefabOverrideRecord::nodeIndex);
+    return {records.begin(), records.end()};
+}
+
+std::string_view BinarySceneView::string(StringRef ref) const
+{
+    return {stringTable + ref.offset, ref.length};
+}
+
+uint32_t BinarySceneBuilder::addNode(int32_t parentIndex)
+{
+    NodeRecord record{};
+    record.parentIndex = parentIndex;
+    nodeRecords.push_back(record);
+    return static_cast<uint32_t>(nodeRecords.size() - 1);
+}
+
+StringRef BinarySceneBuilder::addString(std::string_view value)
+{
+    std::string key(value);
+    if (const auto it = stringLookup.find(key); it != stringLookup.end())
+    {
+        return it->second;
+    }
+    const StringRef ref{.offset = static_cast<uint32_t>(stringTable.size()), .length = static_cast<uint32_t>(value.size())};
+    stringTable.append(value);
+    stringLookup.emplace(std::move(key), ref);
+    return ref;
+}
+
+void BinarySceneBuilder::setMeshIndices(uint32_t nodeIndex, std::span<const int32_t> indices)
+{
+    NodeRecord &record = nodeRecords[nodeIndex];
+    record.flags |= kNodeHasMeshIndices;
+    record.meshIndexFirst = static_cast<uint32_t>(meshIndexPool.size());
+    record.meshIndexCount = static_cast<uint32_t>(indices.size());
+    meshIndexPool.insert(meshIndexPool.end(), indices.begin(), indices.end());
+}
+
+void BinarySceneBuilder::setAnimation(uint32_t nodeIndex, const AnimationRecord &record)
+{
+    nodeRecords[nodeIndex].animationIndex = static_cast<int32_t>(animationRecords.size());
+    animationRecords.push_back(record);
+}
+
+void BinarySceneBuilder::addPrefabOverride(uint32_t nodeIndex, const PrefabOverrideRecord &record)
+{
+    nodeRecords[nodeIndex].flags |= kNodeHasPrefabOverrides;
+    PrefabOverrideRecord stored = record;
+    stored.nodeIndex = nodeIndex;
+    prefabOverrideRecords.push_back(stored);
+}
+
+std::vector<uint8_t> BinarySceneBuilder::serialize() const
+{
+    // Readers look the records up by node; JSON input stores nodes once their children are done.
+    std::vector<PrefabOverrideRecord> overrides = prefabOverrideRecords;
+    std::ranges::stable_sort(overrides, {}, &PrefabOverrideRecord::nodeIndex);
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.nodeCount = static_cast<uint32_t>(nodeRecords.size());
+    header.meshIndexCount = static_cast<uint32_t>(meshIndexPool.size());
+    header.animationCount = static_cast<uint32_t>(animationRecords.size());
+    header.stringBytes = static_cast<uint32_t>(stringTable.size());
+    header.prefabOverrideCount = static_cast<uint32_t>(overrides.size());
+    header.nodesOffset = alignUp(sizeof(FileHeader));
+    header.meshIndicesOffset = alignUp(header.nodesOffset + sizeof(NodeRecord) * nodeRecords.size());
+    header.animationsOffset = alignUp(header.meshIndicesOffset + sizeof(int32_t) * meshIndexPool.size());
+    header.prefabOverridesOffset = alignUp(header.animationsOffset + sizeof(AnimationRecord) * animationRecords.size());
+    header.stringsOffset = alignUp(header.prefabOverridesOffset + sizeof(PrefabOverrideRecord) * overrides.size());
+    header.fileSize = header.stringsOffset + stringTable.size();
+
+    std::vector<uint8_t> output(header.fileSize, 0);
+    std::memcpy(output.data(), &header, sizeof(header));
+    if (!nodeRecords.empty())
+    {
+        std::memcpy(output.data() + header.nodesOffset, nodeRecords.data(), sizeof(NodeRecord) * nodeRecords.size());
+    }
+    if (!meshIndexPool.empty())
+    {
+        std::memcpy(output.data() + header.meshIndicesOffset, meshIndexPool.data(), sizeof(int32_t) * meshIndexPool.size());
+    }
+    if (!animationRecords.empty())
+    {
+        std::memcpy(output.data() + header.animationsOffset, animationRecords.data(), sizeof(AnimationRecord) * animationRecords.size());
+    }
+    if (!overrides.empty())
+    {
+        std::memcpy(output.data() + header.prefabOverridesOffset, overrides.data(), sizeof(PrefabOverrideRecord) * overrides.size());
+    }
+    if (!stringTable.empty())
+    {
+        std::memcpy(output.data() + header.stringsOffset, stringTable.data(), stringTable.size());
+    }
+    return output;
+}
+
+bool BinarySceneBuilder::writeFile(const std::string &path, std::string &error) const
+{
+    const std::vector<uint8_t> output = serialize();
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+        error = "Failed to open file for writing: " + path;
+        return false;
+    }
+    stream.write(reinterpret_cast<const char *>(output.data()), static_cast<std::streamsize>(output.size()));
+    if (!stream)
+    {
+        error = "Failed to write binary scene: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool isBinarySceneFile(const std::string &path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    char          magic[sizeof(kMagic)] = {};
+    if (!stream.read(magic, sizeof(magic)))
+    {
+        return false;
+    }
+    return std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+}        // namespace Laphria::SceneBinary
@@ -0,0 +1,211 @@
+#ifndef LAPHRIAENGINE_SCENEBINARYFORMAT_H
+#define LAPHRIAENGINE_SCENEBINARYFORMAT_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Binary scene format (.laphria_scene).
+//
+// The file is a header followed by flat, 8-byte aligned tables that can be used directly from a memory
+// mapping: node records in pre-order (a parent always precedes its children, and siblings keep their
+// order), a mesh index pool, animation component records, prefab override records sorted by node and one
+// de-duplicated string table.
+// JSON remains the interchange format; the streaming converters in SceneJsonStream.h round-trip every
+// field Scene::loadScene reads. Transform values are stored as 32-bit floats, the precision the engine uses.
+namespace Laphria::SceneBinary
+{
+static_assert(std::endian::native == std::endian::little, "Binary scene files are little-endian and mapped without byte swapping.");
+
+constexpr char     kMagic[8] = {'L', 'P', 'H', 'S', 'C', 'N', 'B', '\0'};
+constexpr uint32_t kVersion = 3;        // 2: prefab instance flags; 3: prefab override table. Older versions are still accepted
+constexpr const char *kFileExtension = ".laphria_scene";
+
+struct StringRef
+{
+    uint32_t offset = 0;        // byte offset into the string table
+    uint32_t length = 0;
+};
+
+enum NodeFlags : uint32_t
+{
+    kNodeHasId = 1u << 0,
+    kNodeHasName = 1u << 1,
+    kNodeHasPosition = 1u << 2,
+    kNodeHasRotation = 1u << 3,
+    kNodeHasScale = 1u << 4,
+    kNodeHasModelPath = 1u << 5,
+    kNodeHasAssetRef = 1u << 6,
+    kNodeHasAssetRefPath = 1u << 7,
+    kNodeHasAssetRefVariant = 1u << 8,
+    kNodeHasMeshIndices = 1u << 9,
+    kNodeHasAssetNodeIndex = 1u << 10,
+    kNodeHasChildrenArray = 1u << 11,
+    kNodeHasPrefabInstance = 1u << 12,
+    kNodePrefabInstance = 1u << 13,        // collapsed prefab instance: children come from the model's template
+    kNodeHasPrefabOverrides = 1u << 14
+};
+
+enum AnimationFlags : uint32_t
+{
+    kAnimationLoop = 1u << 0,
+    kAnimationAutoplay = 1u << 1,
+    kAnimationPlaying = 1u << 2,
+    kAnimationHasClipId = 1u << 3,
+    kAnimationHasTime = 1u << 4,
+    kAnimationHasSpeed = 1u << 5,
+    kAnimationHasLoop = 1u << 6,
+    kAnimationHasAutoplay = 1u << 7,
+    kAnimationHasPlaying = 1u << 8
+};
+
+struct FileHeader
+{
+    char     magic[8];
+    uint32_t version = kVersion;
+    uint32_t nodeCount = 0;
+    uint32_t meshIndexCount = 0;
+    uint32_t animationCount = 0;
+    uint32_t stringBytes = 0;
+    uint32_t prefabOverrideCount = 0;        // reserved (0) before version 3
+    uint64_t nodesOffset = 0;
+    uint64_t meshIndicesOffset = 0;
+    uint64_t animationsOffset = 0;
+    uint64_t stringsOffset = 0;
+    uint64_t fileSize = 0;
+    uint64_t prefabOverridesOffset = 0;        // version 3; earlier headers end before this field
+};
+
+struct NodeRecord
+{
+    int32_t   parentIndex = -1;        // -1 only for the root (record 0)
+    uint32_t  flags = 0;
+    StringRef id;
+    StringRef name;
+    StringRef modelPath;
+    StringRef assetPath;
+    StringRef assetVariant;
+    float     position[3] = {0.0f, 0.0f, 0.0f};
+    float     rotation[4] = {1.0f, 0.0f, 0.0f, 0.0f};        // w, x, y, z
+    float     scale[3] = {1.0f, 1.0f, 1.0f};
+    int32_t   assetNodeIndex = -1;
+    uint32_t  meshIndexFirst = 0;
+    uint32_t  meshIndexCount = 0;
+    int32_t   animationIndex = -1;
+};
+
+struct AnimationRecord
+{
+    StringRef clipId;
+    float     timeSeconds = 0.0f;
+    float     speed = 1.0f;
+    uint32_t  flags = 0;
+    uint32_t  reserved = 0;
+};
+
+// Transform of one template node on one collapsed prefab instance (SceneNode::getPrefabOverrides).
+struct PrefabOverrideRecord
+{
+    uint32_t nodeIndex = 0;
+    uint32_t templateIndex = 0;
+    float    position[3] = {0.0f, 0.0f, 0.0f};
+    float    rotation[4] = {1.0f, 0.0f, 0.0f, 0.0f};        // w, x, y, z
+    float    scale[3] = {1.0f, 1.0f, 1.0f};
+};
+
+constexpr size_t kFileHeaderSizeV2 = 72;        // version 1 and 2 headers stop before prefabOverridesOffset
+static_assert(sizeof(FileHeader) == 80, "FileHeader layout is part of the file format.");
+static_assert(sizeof(NodeRecord) == 104, "NodeRecord layout is part of the file format.");
+static_assert(sizeof(AnimationRecord) == 24, "AnimationRecord layout is part of the file format.");
+static_assert(sizeof(PrefabOverrideRecord) == 48, "PrefabOverrideRecord layout is part of the file format.");
+
+// Read-only file mapping (mmap / MapViewOfFile). Move-only; unmaps on destruction.
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    bool open(const std::string &path, std::string &error);
+    void close();
+
+    [[nodiscard]] const uint8_t *data() const { return mappedData; }
+    [[nodiscard]] size_t         size() const { return mappedSize; }
+
+  private:
+    const uint8_t *mappedData = nullptr;
+    size_t         mappedSize = 0;
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#endif
+};
+
+// Validated, zero-copy view over a binary scene. open() maps the file and checks the header and every
+// table reference once, so the accessors never need to bounds-check again.
+class BinarySceneView
+{
+  public:
+    bool open(const std::string &path, std::string &error);
+    bool openMemory(const uint8_t *bytes, size_t size, std::string &error);
+
+    [[nodiscard]] uint32_t                              nodeCount() const { return header ? header->nodeCount : 0u; }
+    [[nodiscard]] std::span<const NodeRecord>           nodes() const { return {nodeTable, nodeCount()}; }
+    [[nodiscard]] std::span<const int32_t>              meshIndices(const NodeRecord &node) const;
+    [[nodiscard]] const AnimationRecord                *animation(const NodeRecord &node) const;
+    [[nodiscard]] std::span<const PrefabOverrideRecord> prefabOverrides(const NodeRecord &node) const;
+    [[nodiscard]] std::string_view                      string(StringRef ref) const;
+
+  private:
+    bool validate(std::string &error);
+
+    MappedFile                  mapping;
+    const uint8_t              *bytes = nullptr;
+    size_t                      byteCount = 0;
+    const FileHeader           *header = nullptr;
+    const NodeRecord           *nodeTable = nullptr;
+    const int32_t              *meshIndexTable = nullptr;
+    const AnimationRecord      *animationTable = nullptr;
+    const PrefabOverrideRecord *prefabOverrideTable = nullptr;        // sorted by nodeIndex
+    uint32_t                    prefabOverrideCount = 0;
+    const char                 *stringTable = nullptr;
+};
+
+// Accumulates the flat tables in memory and writes them out in one pass. Nodes must be added in pre-order.
+class BinarySceneBuilder
+{
+  public:
+    uint32_t    addNode(int32_t parentIndex);
+    NodeRecord &node(uint32_t index) { return nodeRecords[index]; }
+    StringRef   addString(std::string_view value);
+    void        setMeshIndices(uint32_t nodeIndex, std::span<const int32_t> indices);
+    void        setAnimation(uint32_t nodeIndex, const AnimationRecord &record);
+    void        addPrefabOverride(uint32_t nodeIndex, const PrefabOverrideRecord &record);        // any node order
+
+    [[nodiscard]] uint32_t             nodeCount() const { return static_cast<uint32_t>(nodeRecords.size()); }
+    [[nodiscard]] std::vector<uint8_t> serialize() const;
+    bool                               writeFile(const std::string &path, std::string &error) const;
+
+  private:
+    std::vector<NodeRecord>                        nodeRecords;
+    std::vector<int32_t>                           meshIndexPool;
+    std::vector<AnimationRecord>                   animationRecords;
+    std::vector<PrefabOverrideRecord>              prefabOverrideRecords;
+    std::string                                    stringTable;
+    std::unordered_map<std::string, StringRef>     stringLookup;
+};
+
+// True when the file starts with the binary scene magic. Used to pick the loader independent of the extension.
+bool isBinarySceneFile(const std::string &path);
+}        // namespace Laphria::SceneBinary
+
+#endif        // LAPHRIAENGINE_SCENEBINARYFORMAT_H
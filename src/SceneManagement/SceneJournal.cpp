@@ -0,0 +1,622 @@
+#include "SceneJournal.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+namespace Laphria::SceneJournal
+{
+namespace
+{
+using json = nlohmann::json;
+using namespace Laphria::SceneBinary;
+using Laphria::SceneJson::NodeFields;
+
+std::string quoted(const std::string &value)
+{
+    return json(value).dump(-1, ' ', false, json::error_handler_t::replace);
+}
+
+// A change carries a single node, so it is written as a childless scene document.
+std::string nodeObject(const NodeFields &fields)
+{
+    NodeFields node = fields;
+    node.flags &= ~kNodeHasChildrenArray;
+    std::ostringstream                  stream;
+    Laphria::SceneJson::SceneJsonWriter writer(stream);
+    writer.beginNode(node);
+    writer.finish();
+    std::string text = stream.str();
+    if (!text.empty() && text.back() == '\n')
+    {
+        text.pop_back();
+    }
+    return text;
+}
+
+class SingleNodeReader final : public Laphria::SceneJson::SceneReadHandler
+{
+  public:
+    explicit SingleNodeReader(NodeFields &fields) :
+        fields(fields)
+    {
+    }
+
+    bool beginNode(uint32_t index, int32_t) override
+    {
+        return index == 0;
+    }
+
+    bool endNode(uint32_t, const NodeFields &nodeFields) override
+    {
+        fields = nodeFields;
+        return true;
+    }
+
+    void onError(const std::string &fieldPath, const std::string &message) override
+    {
+        if (error.empty())
+        {
+            error = fieldPath + ": " + message;
+        }
+    }
+
+    std::string error;
+
+  private:
+    NodeFields &fields;
+};
+
+bool parseChangeSet(const std::string &line, ChangeSet &changes, std::string &error)
+{
+    const json entry = json::parse(line, nullptr, false);
+    if (!entry.is_object() || !entry.contains("removed") || !entry["removed"].is_array() || !entry.contains("upserts") ||
+        !entry["upserts"].is_array())
+    {
+        error = "Malformed journal entry.";
+        return false;
+    }
+    for (const auto &id : entry["removed"])
+    {
+        if (!id.is_string())
+        {
+            error = "Journal removal must be a node ID string.";
+            return false;
+        }
+        changes.removedIds.push_back(id.get<std::string>());
+    }
+    for (const auto &upsert : entry["upserts"])
+    {
+        if (!upsert.is_object() || !upsert.contains("parent") || !upsert["parent"].is_string() || !upsert.contains("node") ||
+            !upsert["node"].is_object())
+        {
+            error = "Malformed journal upsert.";
+            return false;
+        }
+        NodeChange change;
+        change.parentId = upsert["parent"].get<std::string>();
+        std::istringstream nodeStream(upsert["node"].dump());
+        SingleNodeReader   reader(change.fields);
+        if (!Laphria::SceneJson::readScene(nodeStream, reader))
+        {
+            error = reader.error.empty() ? "Malformed journal node." : reader.error;
+            return false;
+        }
+        changes.upserts.push_back(std::move(change));
+    }
+    return true;
+}
+
+// Cuts an entry that was interrupted mid-write so the next append starts on a fresh line. Runs before every
+// append, so the common case reads only the last byte; the torn line is scanned backward block by block.
+bool dropTornTail(const std::string &path, std::string &error)
+{
+    std::error_code ec;
+    const auto      size = std::filesystem::file_size(path, ec);
+    if (ec || size == 0)
+    {
+        return true;
+    }
+    std::ifstream stream(path, std::ios::binary);
+    char          last = '\0';
+    if (!stream.seekg(static_cast<std::streamoff>(size - 1)) || !stream.get(last))
+    {
+        error = "Failed to read scene journal: " + path;
+        return false;
+    }
+    if (last == '\n')
+    {
+        return true;
+    }
+
+    constexpr uintmax_t kScanBlockBytes = 4096;
+    uintmax_t           keep = 0;        // no newline at all: the only entry is torn
+    std::string         block;
+    for (uintmax_t end = size - 1; end > 0 && keep == 0;)
+    {
+        const uintmax_t begin = end > kScanBlockBytes ? end - kScanBlockBytes : 0;
+        block.resize(static_cast<size_t>(end - begin));
+        if (!stream.seekg(static_cast<std::streamoff>(begin)) || !stream.read(block.data(), static_cast<std::streamsize>(block.size())))
+        {
+            error = "Failed to read scene journal: " + path;
+            return false;
+        }
+        if (const size_t newline = block.find_last_of('\n'); newline != std::string::npos)
+        {
+            keep = begin + newline + 1;
+        }
+        end = begin;
+    }
+    stream.close();
+    std::filesystem::resize_file(path, keep, ec);
+    if (ec)
+    {
+        error = "Failed to repair scene journal: " + path;
+        return false;
+    }
+    return true;
+}
+
+class DocumentLoadHandler final : public Laphria::SceneJson::SceneReadHandler
+{
+  public:
+    explicit DocumentLoadHandler(std::vector<std::pair<int32_t, NodeFields>> &loaded) :
+        loaded(loaded)
+    {
+    }
+
+    bool beginNode(uint32_t, int32_t parentIndex) override
+    {
+        loaded.emplace_back(parentIndex, NodeFields{});
+        return true;
+    }
+
+    bool endNode(uint32_t index, const NodeFields &fields) override
+    {
+        loaded[index].second = fields;
+        return true;
+    }
+
+    void onError(const std::string &fieldPath, const std::string &message) override
+    {
+        if (error.empty())
+        {
+            error = fieldPath + ": " + message;
+        }
+    }
+
+    std::string error;
+
+  private:
+    std::vector<std::pair<int32_t, NodeFields>> &loaded;
+};
+}        // namespace
+
+std::string journalPathFor(const std::string &scenePath)
+{
+    return scenePath + kJournalSuffix;
+}
+
+bool appendChangeSet(const std::string &scenePath, const ChangeSet &changes, std::string &error)
+{
+    std::string line = "{\"removed\":[";
+    for (size_t i = 0; i < changes.removedIds.size(); ++i)
+    {
+        line += (i > 0 ? "," : "") + quoted(changes.removedIds[i]);
+    }
+    line += "],\"upserts\":[";
+    for (size_t i = 0; i < changes.upserts.size(); ++i)
+    {
+        const NodeChange &change = changes.upserts[i];
+        line += i > 0 ? ",{\"parent\":" : "{\"parent\":";
+        line += quoted(change.parentId);
+        line += ",\"node\":" + nodeObject(change.fields) + "}";
+    }
+    line += "]}\n";
+
+    const std::string path = journalPathFor(scenePath);
+    if (!dropTornTail(path, error))
+    {
+        return false;
+    }
+    std::ofstream stream(path, std::ios::binary | std::ios::app);
+    if (!stream.is_open())
+    {
+        error = "Failed to open scene journal: " + path;
+        return false;
+    }
+    stream.write(line.data(), static_cast<std::streamsize>(line.size()));
+    stream.flush();
+    if (!stream)
+    {
+        error = "Failed to append to scene journal: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool readJournal(const std::string &scenePath, std::vector<ChangeSet> &entries, std::string &error)
+{
+    const std::string path = journalPathFor(scenePath);
+    std::ifstream     stream(path, std::ios::binary);
+    if (!stream.is_open())
+    {
+        return true;        // no journal: the base is current
+    }
+
+    std::string line;
+    size_t      lineNumber = 0;
+    while (std::getline(stream, line))
+    {
+        ++lineNumber;
+        if (stream.eof())
+        {
+            break;        // no trailing newline: the last append was interrupted
+        }
+        ChangeSet changes;
+        if (!parseChangeSet(line, changes, error))
+        {
+            error = path + ":" + std::to_string(lineNumber) + ": " + error;
+            return false;
+        }
+        entries.push_back(std::move(changes));
+    }
+    return true;
+}
+
+bool SceneDocument::load(const std::string &path, std::string &error)
+{
+    nodes.clear();
+    idLookup.clear();
+    rootIndex = -1;
+
+    std::vector<std::pair<int32_t, NodeFields>> loaded;
+    if (isBinarySceneFile(path))
+    {
+        BinarySceneView view;
+        if (!view.open(path, error))
+        {
+            return false;
+        }
+        loaded.reserve(view.nodeCount());
+        for (const auto &record : view.nodes())
+        {
+            loaded.emplace_back(record.parentIndex, NodeFields{});
+            Laphria::SceneJson::nodeFieldsFromRecord(view, record, loaded.back().second);
+        }
+    }
+    else
+    {
+        std::ifstream stream(path);
+        if (!stream.is_open())
+        {
+            error = "Failed to open scene file: " + path;
+            return false;
+        }
+        DocumentLoadHandler handler(loaded);
+        if (!Laphria::SceneJson::readScene(stream, handler))
+        {
+            error = handler.error.empty() ? "Failed to read scene file: " + path : handler.error;
+            return false;
+        }
+    }
+
+    nodes.resize(loaded.size());
+    for (uint32_t i = 0; i < loaded.size(); ++i)
+    {
+        Node &node = nodes[i];
+        node.fields = std::move(loaded[i].second);
+        node.parent = loaded[i].first;
+        if (node.parent >= 0)
+        {
+            nodes[node.parent].children.push_back(i);
+        }
+        if (node.fields.flags & kNodeHasId)
+        {
+            idLookup[node.fields.id] = i;
+        }
+    }
+    rootIndex = nodes.empty() ? -1 : 0;
+    return true;
+}
+
+void SceneDocument::detach(uint32_t index)
+{
+    Node &node = nodes[index];
+    if (node.parent >= 0)
+    {
+        std::erase(nodes[node.parent].children, index);
+        node.parent = -1;
+    }
+}
+
+void SceneDocument::removeSubtree(uint32_t index)
+{
+    detach(index);
+    std::vector<uint32_t> stack{index};
+    while (!stack.empty())
+    {
+        Node &node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.fields.flags & kNodeHasId)
+        {
+            idLookup.erase(node.fields.id);
+        }
+        stack.insert(stack.end(), node.children.begin(), node.children.end());
+        node.children.clear();
+    }
+}
+
+bool SceneDocument::apply(const ChangeSet &changes, std::string &error)
+{
+    for (const auto &change : changes.upserts)
+    {
+        if ((change.fields.flags & kNodeHasId) == 0)
+        {
+            error = "Journal node has no ID.";
+            return false;
+        }
+
+        int32_t parentIndex = -1;
+        if (!change.parentId.empty())
+        {
+            // A missing parent was removed by a later entry. That only happens when a journal is replayed onto
+            // a base it was already folded into (compaction interrupted before the journal was deleted);
+            // skipping keeps that replay equivalent to the compacted scene.
+            const auto parentIt = idLookup.find(change.parentId);
+            if (parentIt == idLookup.end())
+            {
+                continue;
+            }
+            parentIndex = static_cast<int32_t>(parentIt->second);
+        }
+
+        uint32_t   index = static_cast<uint32_t>(nodes.size());
+        const auto it = idLookup.find(change.fields.id);
+        if (it != idLookup.end())
+        {
+            index = it->second;
+        }
+        if (parentIndex < 0 && rootIndex >= 0 && static_cast<int32_t>(index) != rootIndex)
+        {
+            error = "Journal replaces the scene root: " + change.fields.id;
+            return false;
+        }
+        if (it == idLookup.end())
+        {
+            nodes.emplace_back();
+            idLookup.emplace(change.fields.id, index);
+        }
+        nodes[index].fields = change.fields;
+        nodes[index].fields.flags |= kNodeHasChildrenArray;
+
+        if (parentIndex < 0)
+        {
+            rootIndex = static_cast<int32_t>(index);
+        }
+        else if (nodes[index].parent != parentIndex)
+        {
+            detach(index);
+            nodes[parentIndex].children.push_back(index);
+            nodes[index].parent = parentIndex;
+        }
+    }
+
+    for (const auto &id : changes.removedIds)
+    {
+        const auto it = idLookup.find(id);
+        if (it != idLookup.end() && static_cast<int32_t>(it->second) != rootIndex)
+        {
+            removeSubtree(it->second);
+        }
+    }
+    return true;
+}
+
+bool SceneDocument::write(const std::string &path, bool pretty, std::string &error) const
+{
+    if (rootIndex < 0)
+    {
+        error = "Scene document is empty.";
+        return false;
+    }
+
+    const std::string tempPath = path + ".tmp";
+    if (std::filesystem::path(path).extension() == kFileExtension)
+    {
+        BinarySceneBuilder                        builder;
+        std::vector<std::pair<uint32_t, int32_t>> stack{{static_cast<uint32_t>(rootIndex), -1}};
+        while (!stack.empty())
+        {
+            const auto [index, parentIndex] = stack.back();
+            stack.pop_back();
+            const uint32_t built = builder.addNode(parentIndex);
+            Laphria::SceneJson::storeNodeFields(builder, built, nodes[index].fields);
+            const auto &children = nodes[index].children;
+            for (auto child = children.rbegin(); child != children.rend(); ++child)
+            {
+                stack.emplace_back(*child, static_cast<int32_t>(built));
+            }
+        }
+        if (!builder.writeFile(tempPath, error))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        std::ofstream stream(tempPath, std::ios::trunc);
+        if (!stream.is_open())
+        {
+            error = "Failed to open file for writing: " + tempPath;
+            return false;
+        }
+        Laphria::SceneJson::SceneJsonWriter writer(stream, pretty);
+        writer.beginNode(nodes[rootIndex].fields);
+        std::vector<std::pair<uint32_t, size_t>> stack{{static_cast<uint32_t>(rootIndex), 0}};
+        while (!stack.empty())
+        {
+            auto &[index, nextChild] = stack.back();
+            if (nextChild < nodes[index].children.size())
+            {
+                const uint32_t child = nodes[index].children[nextChild++];
+                writer.beginNode(nodes[child].fields);
+                stack.emplace_back(child, 0);
+            }
+            else
+            {
+                writer.endNode();
+                stack.pop_back();
+            }
+        }
+        if (!writer.finish())
+        {
+            error = "Failed to write scene file: " + tempPath;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+    {
+        error = "Failed to replace scene file " + path + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+bool compact(const std::string &scenePath, bool pretty, std::string &error)
+{
+    SceneDocument          document;
+    std::vector<ChangeSet> entries;
+    if (!document.load(scenePath, error) || !readJournal(scenePath, entries, error))
+    {
+        return false;
+    }
+    for (const auto &changes : entries)
+    {
+        if (!document.apply(changes, error))
+        {
+            return false;
+        }
+    }
+    if (!document.write(scenePath, pretty, error))
+    {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::remove(journalPathFor(scenePath), ec);
+    return true;
+}
+
+AsyncSceneWriter::AsyncSceneWriter(uint64_t compactionThresholdBytes) :
+    compactionThresholdBytes(compactionThresholdBytes), worker(&AsyncSceneWriter::run, this)
+{
+}
+
+AsyncSceneWriter::~AsyncSceneWriter()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+void AsyncSceneWriter::submitChanges(const std::string &scenePath, ChangeSet changes, bool pretty)
+{
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back(Job{.scenePath = scenePath, .changes = std::move(changes), .snapshot = false, .pretty = pretty});
+    }
+    wake.notify_one();
+}
+
+void AsyncSceneWriter::submitSnapshot(const std::string &scenePath, ChangeSet snapshot, bool pretty)
+{
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back(Job{.scenePath = scenePath, .changes = std::move(snapshot), .snapshot = true, .pretty = pretty});
+    }
+    wake.notify_one();
+}
+
+void AsyncSceneWriter::waitIdle()
+{
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this] { return jobs.empty() && !working; });
+}
+
+bool AsyncSceneWriter::busy()
+{
+    std::lock_guard lock(mutex);
+    return working || !jobs.empty();
+}
+
+std::vector<std::string> AsyncSceneWriter::takeErrors()
+{
+    std::lock_guard lock(mutex);
+    return std::exchange(errors, {});
+}
+
+void AsyncSceneWriter::run()
+{
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty())
+        {
+            return;        // stopping, and every queued write has finished
+        }
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        working = true;
+        lock.unlock();
+        execute(job);
+        lock.lock();
+        working = false;
+        if (jobs.empty())
+        {
+            idle.notify_all();
+        }
+    }
+}
+
+void AsyncSceneWriter::execute(const Job &job)
+{
+    std::string error;
+    bool        ok = true;
+    if (job.snapshot)
+    {
+        SceneDocument document;
+        ok = document.apply(job.changes, error) && document.write(job.scenePath, job.pretty, error);
+        if (ok)
+        {
+            std::error_code ec;
+            std::filesystem::remove(journalPathFor(job.scenePath), ec);
+        }
+    }
+    else
+    {
+        ok = appendChangeSet(job.scenePath, job.changes, error);
+        std::error_code ec;
+        if (ok && std::filesystem::file_size(journalPathFor(job.scenePath), ec) >= compactionThresholdBytes && !ec)
+        {
+            ok = compact(job.scenePath, job.pretty, error);
+        }
+    }
+
+    if (!ok)
+    {
+        std::lock_guard lock(mutex);
+        errors.push_back(job.scenePath + ": " + error);
+    }
+}
+}        // namespace Laphria::SceneJournal
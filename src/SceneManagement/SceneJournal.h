@@ -0,0 +1,129 @@
+#ifndef LAPHRIAENGINE_SCENEJOURNAL_H
+#define LAPHRIAENGINE_SCENEJOURNAL_H
+
+#include "SceneJsonStream.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Incremental scene saves.
+//
+// A saved scene is a base file (JSON or binary) plus an optional append-only journal next to it
+// (<scene path>.journal). Each journal line is one compact JSON change set holding the subtrees removed
+// since the previous entry and the nodes whose fields or parent changed, so a save costs O(changes).
+// Scene::loadScene replays the journal on top of the base. Compaction folds the journal back into a new
+// base; it works on the files alone, so it can run off the main thread.
+namespace Laphria::SceneJournal
+{
+constexpr const char *kJournalSuffix = ".journal";
+
+// A created or modified node; parentId is empty for the root. A node that is new or has a new parent is
+// appended to the parent's children, as SceneNode::addChild does, so sibling order survives replay.
+struct NodeChange
+{
+    std::string                    parentId;
+    Laphria::SceneJson::NodeFields fields;        // children are not part of a change
+};
+
+// One journal entry. Upserts apply first, in pre-order so that a new node's parent always exists by the
+// time the node is applied; then each removed ID drops its subtree. Upserting first keeps nodes that were
+// moved out of a subtree before it was deleted.
+struct ChangeSet
+{
+    std::vector<std::string> removedIds;
+    std::vector<NodeChange>  upserts;
+
+    [[nodiscard]] bool empty() const { return removedIds.empty() && upserts.empty(); }
+};
+
+std::string journalPathFor(const std::string &scenePath);
+
+// Appends one line and flushes. The entry is written with a single stream write so an interrupted save
+// leaves at most one torn line at the end of the file.
+bool appendChangeSet(const std::string &scenePath, const ChangeSet &changes, std::string &error);
+
+// Reads every entry of the scene's journal. A missing journal yields no entries; a torn final line is
+// dropped, any other malformed line is an error.
+bool readJournal(const std::string &scenePath, std::vector<ChangeSet> &entries, std::string &error);
+
+// Flat, editable copy of a saved scene used to apply change sets without building SceneNodes.
+class SceneDocument
+{
+  public:
+    bool load(const std::string &path, std::string &error);
+    bool apply(const ChangeSet &changes, std::string &error);
+
+    // Writes through a temporary file that replaces path once complete; the format follows the extension
+    // like Scene::saveScene.
+    bool write(const std::string &path, bool pretty, std::string &error) const;
+
+    [[nodiscard]] size_t nodeCount() const { return idLookup.size(); }
+
+  private:
+    struct Node
+    {
+        Laphria::SceneJson::NodeFields fields;
+        int32_t                        parent = -1;
+        std::vector<uint32_t>          children;
+    };
+
+    void detach(uint32_t index);
+    void removeSubtree(uint32_t index);
+
+    std::vector<Node>                         nodes;        // removed nodes stay as unreachable slots
+    int32_t                                   rootIndex = -1;
+    std::unordered_map<std::string, uint32_t> idLookup;
+};
+
+// Folds the journal into a new base file and deletes the journal.
+bool compact(const std::string &scenePath, bool pretty, std::string &error);
+
+// Runs scene writes on one background thread, in submission order: journal appends, full snapshots (a
+// change set that rebuilds the scene from an empty document) and the compaction that follows an append
+// once the journal outgrows compactionThresholdBytes.
+class AsyncSceneWriter
+{
+  public:
+    explicit AsyncSceneWriter(uint64_t compactionThresholdBytes);
+    ~AsyncSceneWriter();        // finishes queued writes
+    AsyncSceneWriter(const AsyncSceneWriter &) = delete;
+    AsyncSceneWriter &operator=(const AsyncSceneWriter &) = delete;
+
+    void submitChanges(const std::string &scenePath, ChangeSet changes, bool pretty);
+    void submitSnapshot(const std::string &scenePath, ChangeSet snapshot, bool pretty);
+    void waitIdle();
+
+    [[nodiscard]] bool       busy();
+    std::vector<std::string> takeErrors();
+
+  private:
+    struct Job
+    {
+        std::string scenePath;
+        ChangeSet   changes;
+        bool        snapshot = false;
+        bool        pretty = false;
+    };
+
+    void run();
+    void execute(const Job &job);
+
+    const uint64_t           compactionThresholdBytes;
+    std::mutex               mutex;
+    std::condition_variable  wake;
+    std::condition_variable  idle;
+    std::deque<Job>          jobs;
+    std::vector<std::string> errors;
+    bool                     working = false;
+    bool                     stopping = false;
+    std::thread              worker;
+};
+}        // namespace Laphria::SceneJournal
+
+#endif        // LAPHRIAENGINE_SCENEJOURNAL_H
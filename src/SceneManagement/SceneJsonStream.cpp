@@ -0,0 +1,1076 @@
+#include "SceneJsonStream.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+namespace Laphria::SceneJson
+{
+namespace
+{
+using json = nlohmann::json;
+using namespace Laphria::SceneBinary;
+
+enum class FrameKind
+{
+    Node,
+    Children,
+    FloatArray,
+    MeshIndices,
+    AssetRef,
+    Animation,
+    PrefabOverrides,
+    PrefabOverride,
+    Skip
+};
+
+struct Frame
+{
+    FrameKind kind = FrameKind::Skip;
+    size_t    pathLength = 0;        // path length before this frame's segment was appended
+    uint32_t  nodeIndex = 0;         // Node/Children: owning node
+    size_t    fieldsDepth = 0;       // Node: slot in the per-depth NodeFields stack
+    size_t    elementCount = 0;      // arrays: elements seen so far
+    float    *floatTarget = nullptr;
+    size_t    expectedCount = 0;
+};
+
+struct Scalar
+{
+    enum class Type
+    {
+        Null,
+        Boolean,
+        Integer,
+        Float,
+        String
+    };
+
+    Type               type = Type::Null;
+    bool               boolValue = false;
+    int64_t            intValue = 0;
+    double             floatValue = 0.0;
+    const std::string *stringValue = nullptr;
+
+    [[nodiscard]] bool  isNumber() const { return type == Type::Integer || type == Type::Float; }
+    [[nodiscard]] float asFloat() const { return type == Type::Integer ? static_cast<float>(intValue) : static_cast<float>(floatValue); }
+};
+
+// Expected value type for every schema key, keyed by the frame the key appears in. nullptr means unknown key.
+const char *expectedTypeMessage(FrameKind frame, const std::string &key)
+{
+    static const std::unordered_map<std::string, const char *> nodeKeys = {
+        {"id", "Expected a string."},
+        {"name", "Expected a string."},
+        {"modelPath", "Expected a string."},
+        {"position", "Expected an array of 3 numbers."},
+        {"rotation", "Expected an array of 4 numbers."},
+        {"scale", "Expected an array of 3 numbers."},
+        {"meshIndices", "Expected an array of integers."},
+        {"asset_node_index", "Expected an integer."},
+        {"prefab_instance", "Expected a boolean."},
+        {"prefab_overrides", "Expected an array of objects."},
+        {"asset_ref", "Expected an object."},
+        {"animation_component", "Expected an object."},
+        {"children", "Expected an array."}};
+    static const std::unordered_map<std::string, const char *> assetRefKeys = {
+        {"path", "Expected a string."},
+        {"variant", "Expected a string."}};
+    static const std::unordered_map<std::string, const char *> animationKeys = {
+        {"clip_id", "Expected a string."},
+        {"time_seconds", "Expected a number."},
+        {"speed", "Expected a number."},
+        {"loop", "Expected a boolean."},
+        {"autoplay", "Expected a boolean."},
+        {"playing", "Expected a boolean."}};
+    static const std::unordered_map<std::string, const char *> prefabOverrideKeys = {
+        {"node", "Expected an integer above 0."},
+        {"position", "Expected an array of 3 numbers."},
+        {"rotation", "Expected an array of 4 numbers."},
+        {"scale", "Expected an array of 3 numbers."}};
+
+    const auto &keys = (frame == FrameKind::Node)           ? nodeKeys
+                       : (frame == FrameKind::AssetRef)       ? assetRefKeys
+                       : (frame == FrameKind::PrefabOverride) ? prefabOverrideKeys
+                                                              : animationKeys;
+    const auto  it = keys.find(key);
+    return it != keys.end() ? it->second : nullptr;
+}
+
+// SAX consumer for the scene schema. All state lives in explicit stacks sized by nesting depth.
+class SceneSaxReader final : public json::json_sax_t
+{
+  public:
+    SceneSaxReader(SceneReadHandler &handler, bool continueAfterErrors) :
+        handler(handler), continueAfterErrors(continueAfterErrors)
+    {
+    }
+
+    [[nodiscard]] bool succeeded() const { return errorCount == 0 && sawRootNode; }
+
+    bool null() override { return scalar(Scalar{}); }
+
+    bool boolean(bool value) override
+    {
+        return scalar(Scalar{.type = Scalar::Type::Boolean, .boolValue = value});
+    }
+
+    bool number_integer(number_integer_t value) override
+    {
+        return scalar(Scalar{.type = Scalar::Type::Integer, .intValue = value});
+    }
+
+    bool number_unsigned(number_unsigned_t value) override
+    {
+        if (value > static_cast<number_unsigned_t>(std::numeric_limits<int64_t>::max()))
+        {
+            return scalar(Scalar{.type = Scalar::Type::Float, .floatValue = static_cast<double>(value)});
+        }
+        return scalar(Scalar{.type = Scalar::Type::Integer, .intValue = static_cast<int64_t>(value)});
+    }
+
+    bool number_float(number_float_t value, const string_t &) override
+    {
+        return scalar(Scalar{.type = Scalar::Type::Float, .floatValue = value});
+    }
+
+    bool string(string_t &value) override
+    {
+        return scalar(Scalar{.type = Scalar::Type::String, .stringValue = &value});
+    }
+
+    bool binary(binary_t &) override
+    {
+        return scalar(Scalar{});
+    }
+
+    bool key(string_t &value) override
+    {
+        currentKey = value;
+        return true;
+    }
+
+    bool start_object(std::size_t) override
+    {
+        if (frames.empty())
+        {
+            return beginNode(-1, "$");
+        }
+
+        const FrameKind kind = frames.back().kind;
+        switch (kind)
+        {
+        case FrameKind::Skip:
+            pushFrame(FrameKind::Skip, "");
+            return true;
+        case FrameKind::Children:
+        {
+            const uint32_t parentIndex = frames.back().nodeIndex;
+            const size_t   childOrdinal = frames.back().elementCount++;
+            return beginNode(static_cast<int32_t>(parentIndex), "[" + std::to_string(childOrdinal) + "]");
+        }
+        case FrameKind::PrefabOverrides:
+            fields().prefabOverrides.emplace_back();
+            pushFrame(FrameKind::PrefabOverride, "[" + std::to_string(frames.back().elementCount++) + "]");
+            return true;
+        case FrameKind::Node:
+            if (currentKey == "asset_ref")
+            {
+                fields().flags |= kNodeHasAssetRef;
+                pushFrame(FrameKind::AssetRef, "." + currentKey);
+                return true;
+            }
+            if (currentKey == "animation_component")
+            {
+                fields().hasAnimation = true;
+                pushFrame(FrameKind::Animation, "." + currentKey);
+                return true;
+            }
+            return unexpectedContainer(kind);
+        case FrameKind::AssetRef:
+        case FrameKind::Animation:
+        case FrameKind::PrefabOverride:
+            return unexpectedContainer(kind);
+        case FrameKind::FloatArray:
+        case FrameKind::MeshIndices:
+            return unexpectedArrayElement();
+        }
+        return true;
+    }
+
+    bool end_object() override
+    {
+        const Frame frame = frames.back();
+        if (frame.kind == FrameKind::PrefabOverride && fields().prefabOverrides.back().templateIndex == 0)
+        {
+            // The root's transform is the instance node's own, so every override names a node below it.
+            fields().prefabOverrides.pop_back();
+            if (!reportError(path + ".node", "Expected an integer above 0."))
+            {
+                return false;
+            }
+        }
+        popFrame();
+        if (frame.kind != FrameKind::Node)
+        {
+            return true;
+        }
+        const bool accepted = handler.endNode(frame.nodeIndex, fieldStack[frame.fieldsDepth]);
+        --nodeDepth;
+        return accepted;
+    }
+
+    bool start_array(std::size_t) override
+    {
+        if (frames.empty())
+        {
+            if (!reportError("$", "Scene file must be a JSON object."))
+            {
+                return false;
+            }
+            pushFrame(FrameKind::Skip, "$");
+            return true;
+        }
+
+        const FrameKind kind = frames.back().kind;
+        switch (kind)
+        {
+        case FrameKind::Skip:
+            pushFrame(FrameKind::Skip, "");
+            return true;
+        case FrameKind::Children:
+        {
+            const std::string elementPath = path + "[" + std::to_string(frames.back().elementCount++) + "]";
+            if (!reportError(elementPath, "Scene node must be an object."))
+            {
+                return false;
+            }
+            pushFrame(FrameKind::Skip, "");
+            return true;
+        }
+        case FrameKind::Node:
+        {
+            NodeFields &nodeFields = fields();
+            if (currentKey == "children")
+            {
+                const uint32_t nodeIndex = frames.back().nodeIndex;
+                nodeFields.flags |= kNodeHasChildrenArray;
+                pushFrame(FrameKind::Children, "." + currentKey);
+                frames.back().nodeIndex = nodeIndex;
+                return true;
+            }
+            if (currentKey == "meshIndices")
+            {
+                nodeFields.flags |= kNodeHasMeshIndices;
+                nodeFields.meshIndices.clear();
+                pushFrame(FrameKind::MeshIndices, "." + currentKey);
+                return true;
+            }
+            if (currentKey == "prefab_overrides")
+            {
+                nodeFields.flags |= kNodeHasPrefabOverrides;
+                nodeFields.prefabOverrides.clear();
+                pushFrame(FrameKind::PrefabOverrides, "." + currentKey);
+                return true;
+            }
+            float   *target = nullptr;
+            size_t   expectedCount = 0;
+            uint32_t flag = 0;
+            if (currentKey == "position")
+            {
+                target = nodeFields.position;
+                expectedCount = 3;
+                flag = kNodeHasPosition;
+            }
+            else if (currentKey == "rotation")
+            {
+                target = nodeFields.rotation;
+                expectedCount = 4;
+                flag = kNodeHasRotation;
+            }
+            else if (currentKey == "scale")
+            {
+                target = nodeFields.scale;
+                expectedCount = 3;
+                flag = kNodeHasScale;
+            }
+            if (!target)
+            {
+                return unexpectedContainer(kind);
+            }
+            nodeFields.flags |= flag;
+            pushFrame(FrameKind::FloatArray, "." + currentKey);
+            frames.back().floatTarget = target;
+            frames.back().expectedCount = expectedCount;
+            return true;
+        }
+        case FrameKind::PrefabOverride:
+        {
+            PrefabOverrideFields &entry = fields().prefabOverrides.back();
+            float                *target = nullptr;
+            size_t                expectedCount = 3;
+            if (currentKey == "position")
+            {
+                target = entry.position;
+            }
+            else if (currentKey == "rotation")
+            {
+                target = entry.rotation;
+                expectedCount = 4;
+            }
+            else if (currentKey == "scale")
+            {
+                target = entry.scale;
+            }
+            if (!target)
+            {
+                return unexpectedContainer(kind);
+            }
+            pushFrame(FrameKind::FloatArray, "." + currentKey);
+            frames.back().floatTarget = target;
+            frames.back().expectedCount = expectedCount;
+            return true;
+        }
+        case FrameKind::PrefabOverrides:
+        {
+            const std::string elementPath = path + "[" + std::to_string(frames.back().elementCount++) + "]";
+            if (!reportError(elementPath, "Expected an object."))
+            {
+                return false;
+            }
+            pushFrame(FrameKind::Skip, "");
+            return true;
+        }
+        case FrameKind::AssetRef:
+        case FrameKind::Animation:
+            return unexpectedContainer(kind);
+        case FrameKind::FloatArray:
+        case FrameKind::MeshIndices:
+            return unexpectedArrayElement();
+        }
+        return true;
+    }
+
+    bool end_array() override
+    {
+        const Frame frame = frames.back();
+        if (frame.kind == FrameKind::FloatArray && frame.elementCount != frame.expectedCount)
+        {
+            if (!reportError(path, "Expected an array of " + std::to_string(frame.expectedCount) + " numbers."))
+            {
+                return false;
+            }
+        }
+        popFrame();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex) override
+    {
+        reportError("$", std::string("Invalid JSON: ") + ex.what());
+        return false;
+    }
+
+  private:
+    NodeFields &fields()
+    {
+        return fieldStack[nodeDepth - 1];
+    }
+
+    void pushFrame(FrameKind kind, const std::string &segment)
+    {
+        Frame frame{};
+        frame.kind = kind;
+        frame.pathLength = path.size();
+        path += segment;
+        frames.push_back(frame);
+    }
+
+    void popFrame()
+    {
+        path.resize(frames.back().pathLength);
+        frames.pop_back();
+    }
+
+    bool reportError(const std::string &fieldPath, const std::string &message)
+    {
+        ++errorCount;
+        handler.onError(fieldPath, message);
+        return continueAfterErrors;
+    }
+
+    bool beginNode(int32_t parentIndex, const std::string &segment)
+    {
+        const uint32_t index = nextNodeIndex++;
+        if (fieldStack.size() <= nodeDepth)
+        {
+            fieldStack.emplace_back();
+        }
+        fieldStack[nodeDepth].reset();
+        pushFrame(FrameKind::Node, segment);
+        frames.back().nodeIndex = index;
+        frames.back().fieldsDepth = nodeDepth;
+        ++nodeDepth;
+        sawRootNode = true;
+        return handler.beginNode(index, parentIndex);
+    }
+
+    // Object or array where the schema does not allow one: report it and skip the whole value.
+    bool unexpectedContainer(FrameKind kind)
+    {
+        const std::string fieldPath = path + "." + currentKey;
+        if (const char *expected = expectedTypeMessage(kind, currentKey))
+        {
+            if (!reportError(fieldPath, expected))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            handler.onUnknownField(fieldPath);
+        }
+        pushFrame(FrameKind::Skip, "");
+        return true;
+    }
+
+    bool unexpectedArrayElement()
+    {
+        Frame            &frame = frames.back();
+        const std::string elementPath = path + "[" + std::to_string(frame.elementCount++) + "]";
+        const char       *message = frame.kind == FrameKind::MeshIndices ? "Expected an integer." : "Expected a number.";
+        if (!reportError(elementPath, message))
+        {
+            return false;
+        }
+        pushFrame(FrameKind::Skip, "");
+        return true;
+    }
+
+    bool scalar(const Scalar &value)
+    {
+        if (frames.empty())
+        {
+            return reportError("$", "Scene file must be a JSON object.");
+        }
+
+        Frame &frame = frames.back();
+        switch (frame.kind)
+        {
+        case FrameKind::Skip:
+            return true;
+        case FrameKind::Children:
+            return reportError(path + "[" + std::to_string(frame.elementCount++) + "]", "Scene node must be an object.");
+        case FrameKind::FloatArray:
+        {
+            const size_t elementIndex = frame.elementCount++;
+            if (!value.isNumber())
+            {
+                return reportError(path + "[" + std::to_string(elementIndex) + "]", "Expected a number.");
+            }
+            if (elementIndex < frame.expectedCount)
+            {
+                frame.floatTarget[elementIndex] = value.asFloat();
+            }
+            return true;
+        }
+        case FrameKind::MeshIndices:
+        {
+            const size_t elementIndex = frame.elementCount++;
+            if (value.type != Scalar::Type::Integer)
+            {
+                return reportError(path + "[" + std::to_string(elementIndex) + "]", "Expected an integer.");
+            }
+            fields().meshIndices.push_back(static_cast<int32_t>(value.intValue));
+            return true;
+        }
+        case FrameKind::PrefabOverrides:
+            return reportError(path + "[" + std::to_string(frame.elementCount++) + "]", "Expected an object.");
+        case FrameKind::Node:
+            return nodeScalar(value);
+        case FrameKind::AssetRef:
+            return assetRefScalar(value);
+        case FrameKind::Animation:
+            return animationScalar(value);
+        case FrameKind::PrefabOverride:
+            return prefabOverrideScalar(value);
+        }
+        return true;
+    }
+
+    bool typedField(FrameKind kind, bool typeMatches)
+    {
+        const std::string fieldPath = path + "." + currentKey;
+        const char       *expected = expectedTypeMessage(kind, currentKey);
+        if (!expected)
+        {
+            handler.onUnknownField(fieldPath);
+            return true;
+        }
+        return typeMatches || reportError(fieldPath, expected);
+    }
+
+    bool nodeScalar(const Scalar &value)
+    {
+        NodeFields &nodeFields = fields();
+        const bool  isString = value.type == Scalar::Type::String;
+        if (currentKey == "id" && isString)
+        {
+            nodeFields.id = *value.stringValue;
+            nodeFields.flags |= kNodeHasId;
+            return true;
+        }
+        if (currentKey == "name" && isString)
+        {
+            nodeFields.name = *value.stringValue;
+            nodeFields.flags |= kNodeHasName;
+            return true;
+        }
+        if (currentKey == "modelPath" && isString)
+        {
+            nodeFields.modelPath = *value.stringValue;
+            nodeFields.flags |= kNodeHasModelPath;
+            return true;
+        }
+        if (currentKey == "asset_node_index" && value.type == Scalar::Type::Integer)
+        {
+            nodeFields.assetNodeIndex = static_cast<int32_t>(value.intValue);
+            nodeFields.flags |= kNodeHasAssetNodeIndex;
+            return true;
+        }
+        if (currentKey == "prefab_instance" && value.type == Scalar::Type::Boolean)
+        {
+            nodeFields.flags |= kNodeHasPrefabInstance;
+            nodeFields.flags = value.boolValue ? (nodeFields.flags | kNodePrefabInstance) : (nodeFields.flags & ~kNodePrefabInstance);
+            return true;
+        }
+        return typedField(FrameKind::Node, false);
+    }
+
+    bool assetRefScalar(const Scalar &value)
+    {
+        NodeFields &nodeFields = fields();
+        if (value.type == Scalar::Type::String && currentKey == "path")
+        {
+            nodeFields.assetPath = *value.stringValue;
+            nodeFields.flags |= kNodeHasAssetRefPath;
+            return true;
+        }
+        if (value.type == Scalar::Type::String && currentKey == "variant")
+        {
+            nodeFields.assetVariant = *value.stringValue;
+            nodeFields.flags |= kNodeHasAssetRefVariant;
+            return true;
+        }
+        return typedField(FrameKind::AssetRef, false);
+    }
+
+    bool animationScalar(const Scalar &value)
+    {
+        AnimationFields &anim = fields().animation;
+        if (currentKey == "clip_id" && value.type == Scalar::Type::String)
+        {
+            anim.clipId = *value.stringValue;
+            anim.flags |= kAnimationHasClipId;
+            return true;
+        }
+        if (currentKey == "time_seconds" && value.isNumber())
+        {
+            anim.timeSeconds = value.asFloat();
+            anim.flags |= kAnimationHasTime;
+            return true;
+        }
+        if (currentKey == "speed" && value.isNumber())
+        {
+            anim.speed = value.asFloat();
+            anim.flags |= kAnimationHasSpeed;
+            return true;
+        }
+        if (value.type == Scalar::Type::Boolean)
+        {
+            const auto setBool = [&](uint32_t presentFlag, uint32_t valueFlag) {
+                anim.flags |= presentFlag;
+                anim.flags = value.boolValue ? (anim.flags | valueFlag) : (anim.flags & ~valueFlag);
+                return true;
+            };
+            if (currentKey == "loop")
+                return setBool(kAnimationHasLoop, kAnimationLoop);
+            if (currentKey == "autoplay")
+                return setBool(kAnimationHasAutoplay, kAnimationAutoplay);
+            if (currentKey == "playing")
+                return setBool(kAnimationHasPlaying, kAnimationPlaying);
+        }
+        return typedField(FrameKind::Animation, false);
+    }
+
+    bool prefabOverrideScalar(const Scalar &value)
+    {
+        if (currentKey == "node" && value.type == Scalar::Type::Integer && value.intValue > 0 &&
+            value.intValue <= std::numeric_limits<uint32_t>::max())
+        {
+            fields().prefabOverrides.back().templateIndex = static_cast<uint32_t>(value.intValue);
+            return true;
+        }
+        return typedField(FrameKind::PrefabOverride, false);
+    }
+
+    SceneReadHandler       &handler;
+    bool                    continueAfterErrors = false;
+    std::vector<Frame>      frames;
+    std::vector<NodeFields> fieldStack;        // one slot per open node, reused across siblings
+    size_t                  nodeDepth = 0;
+    uint32_t                nextNodeIndex = 0;
+    std::string             currentKey;
+    std::string             path;
+    size_t                  errorCount = 0;
+    bool                    sawRootNode = false;
+};
+
+class BinarySceneBuildHandler final : public SceneReadHandler
+{
+  public:
+    BinarySceneBuildHandler(BinarySceneBuilder &builder, std::vector<std::string> &droppedKeys, std::string &error) :
+        builder(builder), droppedKeys(droppedKeys), error(error)
+    {
+    }
+
+    bool beginNode(uint32_t, int32_t parentIndex) override
+    {
+        builder.addNode(parentIndex);
+        return true;
+    }
+
+    bool endNode(uint32_t index, const NodeFields &fields) override
+    {
+        storeNodeFields(builder, index, fields);
+        return true;
+    }
+
+    void onError(const std::string &fieldPath, const std::string &message) override
+    {
+        if (error.empty())
+        {
+            error = fieldPath + ": " + message;
+        }
+    }
+
+    void onUnknownField(const std::string &fieldPath) override
+    {
+        droppedKeys.push_back(fieldPath);
+    }
+
+  private:
+    BinarySceneBuilder       &builder;
+    std::vector<std::string> &droppedKeys;
+    std::string              &error;
+};
+}        // namespace
+
+void NodeFields::reset()
+{
+    *this = NodeFields{};
+}
+
+void nodeFieldsFromRecord(const BinarySceneView &view, const NodeRecord &record, NodeFields &fields)
+{
+    fields.reset();
+    fields.flags = record.flags;
+    fields.id = view.string(record.id);
+    fields.name = view.string(record.name);
+    std::copy_n(record.position, 3, fields.position);
+    std::copy_n(record.rotation, 4, fields.rotation);
+    std::copy_n(record.scale, 3, fields.scale);
+    fields.modelPath = view.string(record.modelPath);
+    fields.assetPath = view.string(record.assetPath);
+    fields.assetVariant = view.string(record.assetVariant);
+    const auto meshIndices = view.meshIndices(record);
+    fields.meshIndices.assign(meshIndices.begin(), meshIndices.end());
+    fields.assetNodeIndex = record.assetNodeIndex;
+    if (const AnimationRecord *anim = view.animation(record))
+    {
+        fields.hasAnimation = true;
+        fields.animation.clipId = view.string(anim->clipId);
+        fields.animation.timeSeconds = anim->timeSeconds;
+        fields.animation.speed = anim->speed;
+        fields.animation.flags = anim->flags;
+    }
+    for (const PrefabOverrideRecord &overrideRecord : view.prefabOverrides(record))
+    {
+        PrefabOverrideFields &entry = fields.prefabOverrides.emplace_back();
+        entry.templateIndex = overrideRecord.templateIndex;
+        std::copy_n(overrideRecord.position, 3, entry.position);
+        std::copy_n(overrideRecord.rotation, 4, entry.rotation);
+        std::copy_n(overrideRecord.scale, 3, entry.scale);
+    }
+}
+
+void storeNodeFields(BinarySceneBuilder &builder, uint32_t index, const NodeFields &fields)
+{
+    NodeRecord record = builder.node(index);
+    record.flags = fields.flags & ~kNodeHasMeshIndices;        // set by setMeshIndices below
+    record.id = builder.addString(fields.id);
+    record.name = builder.addString(fields.name);
+    std::copy_n(fields.position, 3, record.position);
+    std::copy_n(fields.rotation, 4, record.rotation);
+    std::copy_n(fields.scale, 3, record.scale);
+    record.modelPath = builder.addString(fields.modelPath);
+    record.assetPath = builder.addString(fields.assetPath);
+    record.assetVariant = builder.addString(fields.assetVariant);
+    record.assetNodeIndex = fields.assetNodeIndex;
+    builder.node(index) = record;
+    if (fields.flags & kNodeHasMeshIndices)
+    {
+        builder.setMeshIndices(index, fields.meshIndices);
+    }
+    if (fields.hasAnimation)
+    {
+        AnimationRecord anim{};
+        anim.clipId = builder.addString(fields.animation.clipId);
+        anim.timeSeconds = fields.animation.timeSeconds;
+        anim.speed = fields.animation.speed;
+        anim.flags = fields.animation.flags;
+        builder.setAnimation(index, anim);
+    }
+    for (const PrefabOverrideFields &entry : fields.prefabOverrides)
+    {
+        PrefabOverrideRecord overrideRecord{};
+        overrideRecord.templateIndex = entry.templateIndex;
+        std::copy_n(entry.position, 3, overrideRecord.position);
+        std::copy_n(entry.rotation, 4, overrideRecord.rotation);
+        std::copy_n(entry.scale, 3, overrideRecord.scale);
+        builder.addPrefabOverride(index, overrideRecord);
+    }
+}
+
+bool readScene(std::istream &input, SceneReadHandler &handler, bool continueAfterErrors)
+{
+    SceneSaxReader reader(handler, continueAfterErrors);
+    const bool     parsed = json::sax_parse(input, &reader);
+    return parsed && reader.succeeded();
+}
+
+SceneJsonWriter::SceneJsonWriter(std::ostream &output, bool pretty) :
+    out(output), pretty(pretty)
+{
+}
+
+void SceneJsonWriter::newline(size_t depth)
+{
+    if (pretty)
+    {
+        out << '\n'
+            << std::string(depth * 4, ' ');
+    }
+}
+
+void SceneJsonWriter::writeKey(const char *key, size_t depth, bool &first)
+{
+    if (!first)
+    {
+        out << ',';
+    }
+    first = false;
+    newline(depth);
+    out << '"' << key << (pretty ? "\": " : "\":");
+}
+
+void SceneJsonWriter::writeString(const std::string &value)
+{
+    out << '"';
+    for (const char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\b':
+            out << "\\b";
+            break;
+        case '\f':
+            out << "\\f";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\r':
+            out << "\\r";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                constexpr char hex[] = "0123456789abcdef";
+                out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+            }
+            else
+            {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+void SceneJsonWriter::writeFloat(float value)
+{
+    if (!std::isfinite(value))
+    {
+        out << "null";        // same as nlohmann's dump for non-finite numbers
+        return;
+    }
+    // Shortest round-trip text of the widened value, matching nlohmann's output for float-backed numbers.
+    char       buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(value));
+    const std::string_view text(buffer, static_cast<size_t>(result.ptr - buffer));
+    out << text;
+    if (text.find_first_of(".e") == std::string_view::npos)
+    {
+        out << ".0";
+    }
+}
+
+void SceneJsonWriter::beginNode(const NodeFields &fields)
+{
+    const size_t level = openNodes.size();
+    if (level > 0)
+    {
+        OpenNode &parent = openNodes.back();
+        if (!parent.childrenOpened)
+        {
+            writeKey("children", level * 2 - 1, parent.firstKey);
+            out << '[';
+            parent.childrenOpened = true;
+        }
+        else
+        {
+            out << ',';
+        }
+        newline(level * 2);
+    }
+
+    const size_t depth = level * 2 + 1;
+    bool         first = true;
+    const auto   writeFloats = [&](const char *key, const float *values, size_t count) {
+        writeKey(key, depth, first);
+        out << '[';
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+                out << (pretty ? ", " : ",");
+            writeFloat(values[i]);
+        }
+        out << ']';
+    };
+    const char *separator = pretty ? ", " : ",";
+    const char *colon = pretty ? ": " : ":";
+
+    out << '{';
+    if (fields.flags & kNodeHasId)
+    {
+        writeKey("id", depth, first);
+        writeString(fields.id);
+    }
+    if (fields.flags & kNodeHasName)
+    {
+        writeKey("name", depth, first);
+        writeString(fields.name);
+    }
+    if (fields.flags & kNodeHasPosition)
+        writeFloats("position", fields.position, 3);
+    if (fields.flags & kNodeHasRotation)
+        writeFloats("rotation", fields.rotation, 4);
+    if (fields.flags & kNodeHasScale)
+        writeFloats("scale", fields.scale, 3);
+    if (fields.flags & kNodeHasModelPath)
+    {
+        writeKey("modelPath", depth, first);
+        writeString(fields.modelPath);
+    }
+    if (fields.flags & kNodeHasAssetRef)
+    {
+        writeKey("asset_ref", depth, first);
+        out << '{';
+        bool firstMember = true;
+        if (fields.flags & kNodeHasAssetRefPath)
+        {
+            out << "\"path\"" << colon;
+            writeString(fields.assetPath);
+            firstMember = false;
+        }
+        if (fields.flags & kNodeHasAssetRefVariant)
+        {
+            out << (firstMember ? "" : separator) << "\"variant\"" << colon;
+            writeString(fields.assetVariant);
+        }
+        out << '}';
+    }
+    if (fields.flags & kNodeHasMeshIndices)
+    {
+        writeKey("meshIndices", depth, first);
+        out << '[';
+        for (size_t i = 0; i < fields.meshIndices.size(); ++i)
+        {
+            out << (i > 0 ? separator : "") << fields.meshIndices[i];
+        }
+        out << ']';
+    }
+    if (fields.flags & kNodeHasAssetNodeIndex)
+    {
+        writeKey("asset_node_index", depth, first);
+        out << fields.assetNodeIndex;
+    }
+    if (fields.flags & kNodeHasPrefabInstance)
+    {
+        writeKey("prefab_instance", depth, first);
+        out << ((fields.flags & kNodePrefabInstance) ? "true" : "false");
+    }
+    if (fields.flags & kNodeHasPrefabOverrides)
+    {
+        const auto inlineFloats = [&](const char *key, const float *values, size_t count) {
+            out << separator << '"' << key << '"' << colon << '[';
+            for (size_t i = 0; i < count; ++i)
+            {
+                out << (i > 0 ? separator : "");
+                writeFloat(values[i]);
+            }
+            out << ']';
+        };
+        writeKey("prefab_overrides", depth, first);
+        out << '[';
+        for (size_t i = 0; i < fields.prefabOverrides.size(); ++i)
+        {
+            const PrefabOverrideFields &entry = fields.prefabOverrides[i];
+            out << (i > 0 ? separator : "") << "{\"node\"" << colon << entry.templateIndex;
+            inlineFloats("position", entry.position, 3);
+            inlineFloats("rotation", entry.rotation, 4);
+            inlineFloats("scale", entry.scale, 3);
+            out << '}';
+        }
+        out << ']';
+    }
+    if (fields.hasAnimation)
+    {
+        const AnimationFields &anim = fields.animation;
+        writeKey("animation_component", depth, first);
+        out << '{';
+        const char *memberSeparator = "";
+        const auto  member = [&](const char *key) {
+            out << memberSeparator << '"' << key << '"' << colon;
+            memberSeparator = separator;
+        };
+        if (anim.flags & kAnimationHasClipId)
+        {
+            member("clip_id");
+            writeString(anim.clipId);
+        }
+        if (anim.flags & kAnimationHasTime)
+        {
+            member("time_seconds");
+            writeFloat(anim.timeSeconds);
+        }
+        if (anim.flags & kAnimationHasSpeed)
+        {
+            member("speed");
+            writeFloat(anim.speed);
+        }
+        if (anim.flags & kAnimationHasLoop)
+        {
+            member("loop");
+            out << ((anim.flags & kAnimationLoop) ? "true" : "false");
+        }
+        if (anim.flags & kAnimationHasAutoplay)
+        {
+            member("autoplay");
+            out << ((anim.flags & kAnimationAutoplay) ? "true" : "false");
+        }
+        if (anim.flags & kAnimationHasPlaying)
+        {
+            member("playing");
+            out << ((anim.flags & kAnimationPlaying) ? "true" : "false");
+        }
+        out << '}';
+    }
+
+    openNodes.push_back(OpenNode{.hasChildrenArray = (fields.flags & kNodeHasChildrenArray) != 0, .firstKey = first});
+}
+
+void SceneJsonWriter::endNode()
+{
+    OpenNode     &node = openNodes.back();
+    const size_t level = openNodes.size() - 1;
+    if (node.childrenOpened)
+    {
+        newline(level * 2 + 1);
+        out << ']';
+    }
+    else if (node.hasChildrenArray)
+    {
+        writeKey("children", level * 2 + 1, node.firstKey);
+        out << "[]";
+    }
+    if (!node.firstKey)
+    {
+        newline(level * 2);
+    }
+    out << '}';
+    openNodes.pop_back();
+}
+
+bool SceneJsonWriter::finish()
+{
+    while (!openNodes.empty())
+    {
+        endNode();
+    }
+    out << '\n';
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+bool readSceneIntoBinary(std::istream &input, BinarySceneBuilder &builder, std::vector<std::string> &droppedKeys, std::string &error)
+{
+    BinarySceneBuildHandler handler(builder, droppedKeys, error);
+    if (!readScene(input, handler))
+    {
+        if (error.empty())
+        {
+            error = "Failed to read scene JSON.";
+        }
+        return false;
+    }
+    return true;
+}
+
+bool writeBinarySceneAsJson(const BinarySceneView &view, std::ostream &output, bool pretty)
+{
+    SceneJsonWriter       writer(output, pretty);
+    NodeFields            fields;
+    std::vector<uint32_t> openIndices;
+    const auto            nodes = view.nodes();
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        // Pre-order tables: close finished subtrees until the parent is the innermost open node.
+        while (!openIndices.empty() && static_cast<int32_t>(openIndices.back()) != nodes[i].parentIndex)
+        {
+            writer.endNode();
+            openIndices.pop_back();
+        }
+        nodeFieldsFromRecord(view, nodes[i], fields);
+        writer.beginNode(fields);
+        openIndices.push_back(i);
+    }
+    return writer.finish();
+}
+}        // namespace Laphria::SceneJson
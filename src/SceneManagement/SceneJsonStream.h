@@ -0,0 +1,112 @@
+#ifndef LAPHRIAENGINE_SCENEJSONSTREAM_H
+#define LAPHRIAENGINE_SCENEJSONSTREAM_H
+
+#include "SceneBinaryFormat.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Streaming JSON scene IO. The reader drives nlohmann's SAX parser and reports one node at a time in
+// pre-order; the writer emits nodes as they are visited. Neither materializes the document, and both keep
+// only per-depth state on explicit stacks, so memory and stack use do not grow with the node count.
+namespace Laphria::SceneJson
+{
+struct AnimationFields
+{
+    std::string clipId;
+    float       timeSeconds = 0.0f;
+    float       speed = 1.0f;
+    uint32_t    flags = 0;        // SceneBinary::AnimationFlags
+};
+
+// One "prefab_overrides" entry: the local transform of template node templateIndex on this instance.
+struct PrefabOverrideFields
+{
+    uint32_t templateIndex = 0;
+    float    position[3] = {0.0f, 0.0f, 0.0f};
+    float    rotation[4] = {1.0f, 0.0f, 0.0f, 0.0f};        // w, x, y, z
+    float    scale[3] = {1.0f, 1.0f, 1.0f};
+};
+
+// All per-node fields of the scene schema. Presence is tracked with SceneBinary::NodeFlags so that a
+// round trip through either format keeps absent keys absent.
+struct NodeFields
+{
+    uint32_t                          flags = 0;
+    std::string                       id;
+    std::string                       name;
+    float                             position[3] = {0.0f, 0.0f, 0.0f};
+    float                             rotation[4] = {1.0f, 0.0f, 0.0f, 0.0f};        // w, x, y, z
+    float                             scale[3] = {1.0f, 1.0f, 1.0f};
+    std::string                       modelPath;
+    std::string                       assetPath;
+    std::string                       assetVariant;
+    std::vector<int32_t>              meshIndices;
+    int32_t                           assetNodeIndex = -1;
+    bool                              hasAnimation = false;
+    AnimationFields                   animation;
+    std::vector<PrefabOverrideFields> prefabOverrides;        // kNodeHasPrefabOverrides
+
+    void reset();
+};
+
+// Receives reader events. beginNode is called when a node object opens (so a parent is always announced
+// before its children); endNode once all of its fields have been read, which may be after its children.
+class SceneReadHandler
+{
+  public:
+    virtual ~SceneReadHandler() = default;
+
+    virtual bool beginNode(uint32_t index, int32_t parentIndex) = 0;
+    virtual bool endNode(uint32_t index, const NodeFields &fields) = 0;
+    virtual void onError(const std::string &fieldPath, const std::string &message) = 0;
+    virtual void onUnknownField(const std::string &) {}
+};
+
+// Returns false on malformed JSON, schema errors or when a handler callback returns false. With
+// continueAfterErrors, schema errors are reported and the offending value skipped instead of aborting.
+bool readScene(std::istream &input, SceneReadHandler &handler, bool continueAfterErrors = false);
+
+// Writes nodes in the order they are visited: beginNode(child) calls nest between the parent's beginNode
+// and endNode. Compact by default; pretty output indents objects by four spaces.
+class SceneJsonWriter
+{
+  public:
+    SceneJsonWriter(std::ostream &output, bool pretty = false);
+
+    void beginNode(const NodeFields &fields);
+    void endNode();
+    bool finish();
+
+  private:
+    struct OpenNode
+    {
+        bool hasChildrenArray = false;
+        bool firstKey = true;        // no key written yet
+        bool childrenOpened = false;
+    };
+
+    void newline(size_t depth);
+    void writeKey(const char *key, size_t depth, bool &first);
+    void writeString(const std::string &value);
+    void writeFloat(float value);
+
+    std::ostream         &out;
+    bool                  pretty = false;
+    std::vector<OpenNode> openNodes;
+};
+
+// Per-node conversion between NodeFields and the binary tables. storeNodeFields fills a node already added
+// with BinarySceneBuilder::addNode.
+void nodeFieldsFromRecord(const SceneBinary::BinarySceneView &view, const SceneBinary::NodeRecord &record, NodeFields &fields);
+void storeNodeFields(SceneBinary::BinarySceneBuilder &builder, uint32_t index, const NodeFields &fields);
+
+// Streaming conversions between the two scene formats (used by LaphriaValidationRunner).
+bool readSceneIntoBinary(std::istream &input, SceneBinary::BinarySceneBuilder &builder, std::vector<std::string> &droppedKeys,
+                         std::string &error);
+bool writeBinarySceneAsJson(const SceneBinary::BinarySceneView &view, std::ostream &output, bool pretty = false);
+}        // namespace Laphria::SceneJson
+
+#endif        // LAPHRIAENGINE_SCENEJSONSTREAM_H
@@ -1,31 +1,30 @@
 #include "SceneNode.h"
+#include "../Core/OcclusionCulling.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <algorithm>
 #include <atomic>
-#include <sstream>
 
 namespace
 {
-std::string makeNodeId()
-{
-    static std::atomic<uint64_t> nextId{1};
-    const uint64_t id = nextId.fetch_add(1, std::memory_order_relaxed);
-    std::ostringstream oss;
-    oss << "node_" << id;
-    return oss.str();
-}
+std::atomic<uint64_t> revisionCounter{0};
 } // namespace
 
-SceneNode::SceneNode(const std::string &name) : name(name) {
-    stableId = makeNodeId();
+SceneNode::SceneNode(Laphria::NodeName name) : name(std::move(name)), stableId(Laphria::StableId::generate()) {
     updateLocalTransform();
 }
 
+SceneNode::~SceneNode() {
+    if (transformJournal) {
+        transformJournal->untrack(*this);
+    }
+}
+
 void SceneNode::addChild(const Ptr &child) {
     if (child) {
         child->parent = this;
         child->markWorldTransformDirtyRecursive();
+        child->markModified();
         children.push_back(child);
     }
 }
@@ -35,20 +34,33 @@ void SceneNode::removeChild(const Ptr &child) {
     if (it != children.end()) {
         (*it)->parent = nullptr;
         (*it)->markWorldTransformDirtyRecursive();
+        (*it)->markModified();
         children.erase(it);
     }
 }
 
-void SceneNode::updateLocalTransform() {
+void SceneNode::updateLocalTransform(bool modified) {
     glm::mat4 T = glm::translate(glm::mat4(1.0f), position);
     glm::mat4 R = glm::toMat4(rotation);
     glm::mat4 S = glm::scale(glm::mat4(1.0f), scale);
     localTransform = T * R * S;
     markWorldTransformDirtyRecursive();
+    if (modified) {
+        markModified();
+    }
+}
+
+void SceneNode::markModified() {
+    revision = revisionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+uint64_t SceneNode::latestRevision() {
+    return revisionCounter.load(std::memory_order_relaxed);
 }
 
 void SceneNode::markWorldTransformDirtyRecursive() const {
     worldTransformDirty = true;
+    recordTransformChange();
     for (const auto &child : children) {
         if (child) {
             child->markWorldTransformDirtyRecursive();
@@ -82,7 +94,123 @@ void SceneNode::updateWorldTransformRecursive(const glm::mat4 &parentWorld, bool
     }
 }
 
-SceneNode::Ptr SceneNode::clone() const {
+void SceneNode::setPrefab(std::shared_ptr<const PrefabTemplate> prefabTemplate) {
+    prefab = std::move(prefabTemplate);
+    resolvePrefabOverrides();
+    markModified();
+    recordTransformChange();        // the octree indexes instances by their template bounds
+}
+
+PrefabTemplate::Override SceneNode::getPrefabNodeTransform(uint32_t index) const {
+    const auto it = std::ranges::lower_bound(prefabOverrides, index, {}, &PrefabTemplate::Override::index);
+    if (it != prefabOverrides.end() && it->index == index) {
+        return *it;
+    }
+    PrefabTemplate::Override current{.index = index};
+    if (prefab && index < prefab->getNodes().size()) {
+        const auto &source = prefab->getNodes()[index];
+        current.position = source.position;
+        current.rotation = source.rotation;
+        current.scale = source.scale;
+    }
+    return current;
+}
+
+void SceneNode::setPrefabOverride(const PrefabTemplate::Override &nodeOverride) {
+    const auto it = std::ranges::lower_bound(prefabOverrides, nodeOverride.index, {}, &PrefabTemplate::Override::index);
+    if (it != prefabOverrides.end() && it->index == nodeOverride.index) {
+        *it = nodeOverride;
+    } else {
+        prefabOverrides.insert(it, nodeOverride);
+    }
+    resolvePrefabOverrides();
+    markModified();
+    recordTransformChange();
+}
+
+void SceneNode::clearPrefabOverride(uint32_t index) {
+    const auto it = std::ranges::lower_bound(prefabOverrides, index, {}, &PrefabTemplate::Override::index);
+    if (it == prefabOverrides.end() || it->index != index) {
+        return;
+    }
+    prefabOverrides.erase(it);
+    resolvePrefabOverrides();
+    markModified();
+    recordTransformChange();
+}
+
+void SceneNode::setPrefabOverrides(std::vector<PrefabTemplate::Override> overrides) {
+    std::ranges::sort(overrides, {}, &PrefabTemplate::Override::index);
+    const auto duplicates = std::ranges::unique(overrides, {}, &PrefabTemplate::Override::index);
+    overrides.erase(duplicates.begin(), duplicates.end());
+    prefabOverrides = std::move(overrides);
+    resolvePrefabOverrides();
+    markModified();
+    recordTransformChange();
+}
+
+void SceneNode::resolvePrefabOverrides() {
+    prefabRootFromNode.clear();
+    if (!prefab) {
+        return;        // kept until a template is set, as when a scene file is loaded
+    }
+    const size_t templateSize = prefab->getNodes().size();
+    std::erase_if(prefabOverrides, [&](const PrefabTemplate::Override &entry) {
+        return entry.index == 0 || entry.index >= templateSize;
+    });
+    if (!prefabOverrides.empty()) {
+        prefab->resolve(prefabOverrides, prefabRootFromNode, prefabBoundsMin, prefabBoundsMax);
+    }
+}
+
+void SceneNode::expandPrefab() {
+    if (!prefab) {
+        return;
+    }
+
+    // Template nodes are in pre-order, so every parent has been created before its children.
+    const auto &templateNodes = prefab->getNodes();
+    std::vector<SceneNode *> created(templateNodes.size(), nullptr);
+    created[0] = this;
+    for (size_t i = 1; i < templateNodes.size(); ++i) {
+        const auto &source = templateNodes[i];
+        const PrefabTemplate::Override local = getPrefabNodeTransform(static_cast<uint32_t>(i));
+        auto node = std::make_shared<SceneNode>(source.name);
+        node->position = local.position;
+        node->rotation = local.rotation;
+        node->eulerRotation = glm::degrees(glm::eulerAngles(local.rotation));
+        node->scale = local.scale;
+        node->initialPosition = local.position;
+        node->initialRotation = local.rotation;
+        node->meshIndices = source.meshIndices;
+        node->modelId = modelId;
+        node->sourceNodeIndex = source.sourceNodeIndex;
+        node->assetRef = assetRef;
+        node->updateLocalTransform();
+        created[source.parent]->addChild(node);
+        created[i] = node.get();
+    }
+    prefab.reset();
+    prefabOverrides.clear();
+    prefabRootFromNode.clear();
+    markModified();
+}
+
+bool SceneNode::getPrefabWorldBounds(glm::vec3 &worldMin, glm::vec3 &worldMax) const {
+    glm::vec3 rootMin;
+    glm::vec3 rootMax;
+    if (!prefab || !prefab->getRootBounds(rootMin, rootMax)) {
+        return false;
+    }
+    if (!prefabRootFromNode.empty()) {
+        rootMin = prefabBoundsMin;
+        rootMax = prefabBoundsMax;
+    }
+    Laphria::transformBounds(rootMin, rootMax, getWorldTransform(), worldMin, worldMax);
+    return true;
+}
+
+SceneNode::Ptr SceneNode::cloneNode() const {
     auto newNode = std::make_shared<SceneNode>(name);
     newNode->position = position;
     newNode->rotation = rotation;
@@ -96,8 +224,17 @@ SceneNode::Ptr SceneNode::clone() const {
     newNode->animation = animation;
     newNode->initialPosition = initialPosition;
     newNode->initialRotation = initialRotation;
+    newNode->prefab = prefab;
+    newNode->prefabOverrides = prefabOverrides;
+    newNode->prefabRootFromNode = prefabRootFromNode;
+    newNode->prefabBoundsMin = prefabBoundsMin;
+    newNode->prefabBoundsMax = prefabBoundsMax;
     newNode->updateLocalTransform();
+    return newNode;
+}
 
+SceneNode::Ptr SceneNode::clone() const {
+    auto newNode = cloneNode();
     for (const auto &child: children) {
         newNode->addChild(child->clone());
     }
@@ -1,7 +1,11 @@
 #ifndef LAPHRIAENGINE_SCENENODE_H
 #define LAPHRIAENGINE_SCENENODE_H
+#include "PrefabTemplate.h"
+#include "Symbol.h"
+#include "TransformJournal.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -11,13 +15,16 @@ class SceneNode : public std::enable_shared_from_this<SceneNode>
   public:
 	using Ptr = std::shared_ptr<SceneNode>;
 
-	SceneNode(const std::string &name = "Node");
+	SceneNode(Laphria::NodeName name = "Node");
 
-	virtual ~SceneNode() = default;
+	virtual ~SceneNode();
 
 	// Hierarchy
 	[[nodiscard]] Ptr clone() const;
 
+	// Copies this node's own state, including a prefab reference, without its children.
+	[[nodiscard]] Ptr cloneNode() const;
+
 	void addChild(const Ptr &child);
 
 	void removeChild(const Ptr &child);
@@ -39,6 +46,14 @@ class SceneNode : public std::enable_shared_from_this<SceneNode>
 		updateLocalTransform();
 	}
 
+	// Position written by the physics simulation. Moves the node like setPosition but keeps its revision:
+	// simulated motion is not an edit, so incremental saves skip bodies whose only change is the simulation.
+	void setSimulatedPosition(const glm::vec3 &pos)
+	{
+		position = pos;
+		updateLocalTransform(false);
+	}
+
 	void setRotation(const glm::quat &rot)
 	{
 		rotation      = rot;
@@ -91,6 +106,84 @@ class SceneNode : public std::enable_shared_from_this<SceneNode>
 		return glm::vec3(getWorldTransform()[3]);
 	}
 
+	// Modification tracking for incremental saves: every persisted change moves the node to a new value of a
+	// process-wide counter. Setters do this themselves; code that writes the public fields (name, assetRef,
+	// animation, meshIndices) calls markModified() after the write.
+	void markModified();
+
+	uint64_t getRevision() const
+	{
+		return revision;
+	}
+
+	static uint64_t latestRevision();
+
+	// Prefab instancing (see PrefabTemplate). A collapsed instance has no child nodes of its own.
+	const std::shared_ptr<const PrefabTemplate> &getPrefab() const
+	{
+		return prefab;
+	}
+
+	void setPrefab(std::shared_ptr<const PrefabTemplate> prefabTemplate);
+
+	// Materializes the template below this node as regular children, e.g. before one of them is edited.
+	void expandPrefab();
+
+	// World-space box around everything a collapsed instance draws. False when not an instance or the
+	// template has no mesh bounds.
+	bool getPrefabWorldBounds(glm::vec3 &worldMin, glm::vec3 &worldMax) const;
+
+	// Per-instance edits of template nodes, sorted by template index. Editing one template node of a
+	// collapsed instance keeps it collapsed; expandPrefab carries the overrides onto the created children.
+	const std::vector<PrefabTemplate::Override> &getPrefabOverrides() const
+	{
+		return prefabOverrides;
+	}
+
+	// Local transform template node index has on this instance: its override, else the template's.
+	PrefabTemplate::Override getPrefabNodeTransform(uint32_t index) const;
+
+	// Transform of template node index relative to this instance, with overrides applied. Requires a prefab.
+	const glm::mat4 &getPrefabRootFromNode(size_t index) const
+	{
+		return prefabRootFromNode.empty() ? prefab->getNodes()[index].rootFromNode : prefabRootFromNode[index];
+	}
+
+	void setPrefabOverride(const PrefabTemplate::Override &nodeOverride);
+	void clearPrefabOverride(uint32_t index);
+
+	// Replaces every override, e.g. from a scene file. Entries outside the template are dropped once it is set.
+	void setPrefabOverrides(std::vector<PrefabTemplate::Override> overrides);
+
+	// Calls fn(worldTransform, meshIndices) for this node and, for a collapsed instance, every template node below it.
+	template <typename Fn>
+	void forEachMeshInstance(Fn &&fn) const
+	{
+		const glm::mat4 &world = getWorldTransform();
+		fn(world, meshIndices);
+		if (prefab)
+		{
+			const auto &templateNodes = prefab->getNodes();
+			for (size_t i = 1; i < templateNodes.size(); ++i)
+			{
+				if (!templateNodes[i].meshIndices.empty())
+				{
+					fn(world * getPrefabRootFromNode(i), templateNodes[i].meshIndices);
+				}
+			}
+		}
+	}
+
+	// Records this node in its scene's TransformJournal. Setters do this themselves; code that writes simulation
+	// state directly (physics.velocity) calls it so per-node consumers such as the GPU physics upload see the change.
+	void recordTransformChange() const
+	{
+		if (transformJournal)
+		{
+			transformJournal->record(transformJournalHandle);
+		}
+	}
+
 	// Recomputes cached world transforms in one top-down pass.
 	void updateWorldTransformRecursive(const glm::mat4 &parentWorld, bool parentDirty) const;
 
@@ -98,6 +191,7 @@ class SceneNode : public std::enable_shared_from_this<SceneNode>
 	void addMeshIndex(int meshIndex)
 	{
 		meshIndices.push_back(meshIndex);
+		markModified();
 	}
 
 	const std::vector<int> &getMeshIndices() const
@@ -105,7 +199,7 @@ class SceneNode : public std::enable_shared_from_this<SceneNode>
 		return meshIndices;
 	}
 
-	std::string name;
+	Laphria::NodeName name;
 
 	// For UI Interaction
 	bool isSelected = false;
@@ -144,31 +238,33 @@ class SceneNode : public std::enable_shared_from_this<SceneNode>
 
 	PhysicsProperties physics;
 
+	// Paths, variants and clip IDs are interned: large scenes repeat the same few thousand values.
 	struct AssetReference
 	{
-		std::string path;
-		std::string variant;
+		Laphria::Symbol path;
+		Laphria::Symbol variant;
 	};
 
 	struct AnimationPlayback
 	{
-		bool        enabled = false;
-		std::string clipId;
-		float       timeSeconds = 0.0f;
-		float       speed = 1.0f;
-		bool        loop = true;
-		bool        autoplay = true;
-		bool        playing = true;
+		bool            enabled = false;
+		Laphria::Symbol clipId;
+		float           timeSeconds = 0.0f;
+		float           speed = 1.0f;
+		bool            loop = true;
+		bool            autoplay = true;
+		bool            playing = true;
 	};
 
-	// Stable ID persisted in scene files to support deterministic references.
-	std::string stableId;
+	// Stable ID persisted in scene files to support deterministic references; formatted only when saved.
+	Laphria::StableId stableId;
 	AssetReference assetRef;
 	AnimationPlayback animation;
 
   protected:
-	void updateLocalTransform();
+	void updateLocalTransform(bool modified = true);
 	void markWorldTransformDirtyRecursive() const;
+	void resolvePrefabOverrides();
 
   public:
 	// State Management
@@ -202,6 +298,20 @@ class SceneNode : public std::enable_shared_from_this<SceneNode>
 	glm::mat4 localTransform{1.0f};
 	mutable glm::mat4 worldTransform{1.0f};
 	mutable bool worldTransformDirty{true};
+
+	uint64_t revision{0};
+
+	std::shared_ptr<const PrefabTemplate> prefab;
+	std::vector<PrefabTemplate::Override> prefabOverrides;
+	// Resolved from prefabOverrides; empty when the instance draws the template unchanged.
+	std::vector<glm::mat4> prefabRootFromNode;
+	glm::vec3              prefabBoundsMin{0.0f};
+	glm::vec3              prefabBoundsMax{-1.0f};
+
+	// Set while a Scene tracks this node (see TransformJournal::track).
+	friend class Laphria::TransformJournal;
+	Laphria::TransformJournal *transformJournal{nullptr};
+	uint32_t                   transformJournalHandle{0};
 };
 
 #endif        // LAPHRIAENGINE_SCENENODE_H
@@ -0,0 +1,126 @@
+#include "Symbol.h"
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+constexpr uint32_t kChunkBits = 12;
+constexpr uint32_t kChunkSize = 1u << kChunkBits;
+constexpr uint32_t kMaxChunks = 1u << 16;        // 2^28 symbols
+constexpr std::string_view kGeneratedIdPrefix = "node_";
+
+// Strings live in fixed-size chunks that never move, so a published index can be read without the lock and
+// the lookup keys can view the stored text directly.
+struct SymbolTable
+{
+	std::mutex                                         mutex;
+	std::unordered_map<std::string_view, uint32_t>     lookup;
+	std::array<std::atomic<std::string *>, kMaxChunks> chunks{};
+	uint32_t                                           count = 1;        // 0 is the empty string
+
+	uint32_t intern(std::string_view text)
+	{
+		std::lock_guard lock(mutex);
+		if (const auto it = lookup.find(text); it != lookup.end())
+		{
+			return it->second;
+		}
+
+		const uint32_t id = count;
+		const uint32_t chunkIndex = id >> kChunkBits;
+		if (chunkIndex >= kMaxChunks)
+		{
+			throw std::length_error("Symbol table is full");
+		}
+		std::string *chunk = chunks[chunkIndex].load(std::memory_order_relaxed);
+		if (!chunk)
+		{
+			chunk = new std::string[kChunkSize];
+			chunks[chunkIndex].store(chunk, std::memory_order_release);
+		}
+		std::string &stored = chunk[id & (kChunkSize - 1)];
+		stored.assign(text);
+		lookup.emplace(stored, id);
+		++count;
+		return id;
+	}
+
+	const std::string &text(uint32_t id) const
+	{
+		return chunks[id >> kChunkBits].load(std::memory_order_acquire)[id & (kChunkSize - 1)];
+	}
+};
+
+// Deliberately leaked: nodes destroyed during static destruction may still read their names.
+SymbolTable &symbolTable()
+{
+	static auto *table = new SymbolTable();
+	return *table;
+}
+
+std::atomic<uint64_t> lastGeneratedId{0};
+
+const std::string kEmptyText;
+}        // namespace
+
+namespace Laphria
+{
+Symbol::Symbol(std::string_view text) :
+    id(text.empty() ? 0 : symbolTable().intern(text))
+{}
+
+const std::string &Symbol::str() const
+{
+	return id == 0 ? kEmptyText : symbolTable().text(id);
+}
+
+StableId StableId::generate()
+{
+	return StableId(lastGeneratedId.fetch_add(1, std::memory_order_relaxed) + 1);
+}
+
+StableId StableId::parse(std::string_view text)
+{
+	if (text.empty())
+	{
+		return {};
+	}
+
+	// Only the canonical form round-trips through toString(); "node_007" stays text.
+	if (text.starts_with(kGeneratedIdPrefix))
+	{
+		const std::string_view digits = text.substr(kGeneratedIdPrefix.size());
+		uint64_t number = 0;
+		const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), number);
+		if (ec == std::errc() && end == digits.data() + digits.size() && !digits.empty() && digits.front() != '0' &&
+		    number < kSymbolBit)
+		{
+			uint64_t last = lastGeneratedId.load(std::memory_order_relaxed);
+			while (last < number && !lastGeneratedId.compare_exchange_weak(last, number, std::memory_order_relaxed))
+			{
+			}
+			return StableId(number);
+		}
+	}
+	return StableId(kSymbolBit | Symbol(text).index());
+}
+
+std::string StableId::toString() const
+{
+	if (bits == 0)
+	{
+		return {};
+	}
+	if (bits & kSymbolBit)
+	{
+		return symbolTable().text(static_cast<uint32_t>(bits & ~kSymbolBit));
+	}
+	return std::string(kGeneratedIdPrefix) + std::to_string(bits);
+}
+}        // namespace Laphria
@@ -0,0 +1,195 @@
+#ifndef LAPHRIAENGINE_SYMBOL_H
+#define LAPHRIAENGINE_SYMBOL_H
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Laphria
+{
+// Interned string: a 32-bit index into a process-wide table that stores each distinct text once. Scene nodes
+// keep names, asset paths and clip IDs as symbols, so a path shared by thousands of nodes is stored once and
+// copying or comparing it is an integer operation. Interning locks the table; reading the text does not, so
+// symbols can be created on loader threads and read anywhere. Entries are never freed.
+class Symbol
+{
+  public:
+	Symbol() = default;        // the empty string
+	Symbol(std::string_view text);
+	Symbol(const std::string &text) :
+	    Symbol(std::string_view(text))
+	{}
+	Symbol(const char *text) :
+	    Symbol(std::string_view(text))
+	{}
+
+	[[nodiscard]] const std::string &str() const;
+
+	[[nodiscard]] const char *c_str() const
+	{
+		return str().c_str();
+	}
+
+	[[nodiscard]] bool empty() const
+	{
+		return id == 0;
+	}
+
+	[[nodiscard]] uint32_t index() const
+	{
+		return id;
+	}
+
+	operator const std::string &() const
+	{
+		return str();
+	}
+
+	friend bool operator==(Symbol a, Symbol b)
+	{
+		return a.id == b.id;
+	}
+
+	friend bool operator==(Symbol a, const std::string &b)
+	{
+		return a.str() == b;
+	}
+
+	friend bool operator==(Symbol a, const char *b)
+	{
+		return a.str() == b;
+	}
+
+  private:
+	uint32_t id = 0;
+};
+
+// Scene node name. Imported and loaded names repeat across a scene and are interned; text typed in the editor
+// (renames, duplicate suffixes) is owned by the node instead, so editing a name does not grow the symbol table
+// for the rest of the process. Both forms read the same.
+class NodeName
+{
+  public:
+	NodeName() = default;
+	NodeName(Symbol symbol) :
+	    symbol(symbol)
+	{}
+	NodeName(std::string_view text) :
+	    symbol(text)
+	{}
+	NodeName(const std::string &text) :
+	    symbol(text)
+	{}
+	NodeName(const char *text) :
+	    symbol(text)
+	{}
+
+	// A name that is not interned.
+	static NodeName owned(std::string text)
+	{
+		NodeName name;
+		name.ownedText = std::move(text);
+		return name;
+	}
+
+	[[nodiscard]] const std::string &str() const
+	{
+		return ownedText ? *ownedText : symbol.str();
+	}
+
+	[[nodiscard]] const char *c_str() const
+	{
+		return str().c_str();
+	}
+
+	[[nodiscard]] bool empty() const
+	{
+		return str().empty();
+	}
+
+	[[nodiscard]] bool interned() const
+	{
+		return !ownedText;
+	}
+
+	operator const std::string &() const
+	{
+		return str();
+	}
+
+	friend bool operator==(const NodeName &a, const NodeName &b)
+	{
+		return (a.interned() && b.interned()) ? a.symbol == b.symbol : a.str() == b.str();
+	}
+
+	friend bool operator==(const NodeName &a, const std::string &b)
+	{
+		return a.str() == b;
+	}
+
+	friend bool operator==(const NodeName &a, const char *b)
+	{
+		return a.str() == b;
+	}
+
+  private:
+	Symbol                     symbol;
+	std::optional<std::string> ownedText;
+};
+
+// 64-bit scene node identity. Generated IDs are a process-wide counter and are only formatted ("node_<n>")
+// when a scene is written. IDs read from files keep their number when they use that form, which also moves
+// the counter past them; any other text is kept as a symbol.
+class StableId
+{
+  public:
+	StableId() = default;
+
+	static StableId generate();
+	static StableId parse(std::string_view text);
+
+	[[nodiscard]] std::string toString() const;
+
+	[[nodiscard]] bool empty() const
+	{
+		return bits == 0;
+	}
+
+	[[nodiscard]] uint64_t value() const
+	{
+		return bits;
+	}
+
+	friend bool operator==(StableId a, StableId b) = default;
+
+  private:
+	static constexpr uint64_t kSymbolBit = 1ull << 63;
+
+	explicit StableId(uint64_t value) :
+	    bits(value)
+	{}
+
+	uint64_t bits = 0;
+};
+}        // namespace Laphria
+
+template <>
+struct std::hash<Laphria::Symbol>
+{
+	size_t operator()(Laphria::Symbol symbol) const noexcept
+	{
+		return std::hash<uint32_t>{}(symbol.index());
+	}
+};
+
+template <>
+struct std::hash<Laphria::StableId>
+{
+	size_t operator()(Laphria::StableId id) const noexcept
+	{
+		return std::hash<uint64_t>{}(id.value());
+	}
+};
+
+#endif        // LAPHRIAENGINE_SYMBOL_H
@@ -0,0 +1,65 @@
+#include "TransformJournal.h"
+#include "SceneNode.h"
+
+namespace Laphria
+{
+TransformJournal::~TransformJournal()
+{
+	untrackAll();
+}
+
+void TransformJournal::track(SceneNode &node)
+{
+	if (node.transformJournal == this)
+	{
+		return;
+	}
+	if (node.transformJournal)
+	{
+		node.transformJournal->untrack(node);
+	}
+
+	uint32_t handle = 0;
+	if (!freeHandles.empty())
+	{
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+		nodes[handle] = &node;
+	}
+	else
+	{
+		handle = static_cast<uint32_t>(nodes.size());
+		nodes.push_back(&node);
+		changedBits.resize((nodes.size() + 63) / 64, 0);
+	}
+	node.transformJournal = this;
+	node.transformJournalHandle = handle;
+}
+
+void TransformJournal::untrack(SceneNode &node)
+{
+	if (node.transformJournal != this)
+	{
+		return;
+	}
+	nodes[node.transformJournalHandle] = nullptr;
+	releasedHandles.push_back(node.transformJournalHandle);
+	node.transformJournal = nullptr;
+}
+
+void TransformJournal::untrackAll()
+{
+	for (SceneNode *node : nodes)
+	{
+		if (node)
+		{
+			node->transformJournal = nullptr;
+		}
+	}
+	nodes.clear();
+	changedBits.clear();
+	changed.clear();
+	freeHandles.clear();
+	releasedHandles.clear();
+}
+}        // namespace Laphria
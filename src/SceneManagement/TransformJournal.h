@@ -0,0 +1,82 @@
+#ifndef LAPHRIAENGINE_TRANSFORMJOURNAL_H
+#define LAPHRIAENGINE_TRANSFORMJOURNAL_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SceneNode;
+
+namespace Laphria
+{
+// Records which tracked nodes had their world transform change (SceneNode setters and reparenting record
+// the node and its descendants). A bitset over node handles deduplicates, and a compact list keeps the
+// changed handles in first-change order. The owning Scene drains it once per frame, so consumers such
+// as the octree, the TLAS instance list and the GPU physics upload visit only the changed nodes.
+class TransformJournal
+{
+  public:
+	TransformJournal() = default;
+	~TransformJournal();        // detaches the nodes that are still tracked
+	TransformJournal(const TransformJournal &) = delete;
+	TransformJournal &operator=(const TransformJournal &) = delete;
+
+	void track(SceneNode &node);
+	void untrack(SceneNode &node);
+	void untrackAll();
+
+	void record(uint32_t handle)
+	{
+		uint64_t      &word = changedBits[handle >> 6];
+		const uint64_t bit = 1ull << (handle & 63);
+		if (!(word & bit))
+		{
+			word |= bit;
+			changed.push_back(handle);
+		}
+	}
+
+	// Visits the nodes recorded since the last drain without consuming them.
+	template <typename Fn>
+	void forEachPending(Fn &&fn) const
+	{
+		for (const uint32_t handle : changed)
+		{
+			if (SceneNode *node = nodes[handle])
+			{
+				fn(*node);
+			}
+		}
+	}
+
+	// Visits every node recorded since the last drain once, then starts a new frame.
+	template <typename Fn>
+	void drain(Fn &&fn)
+	{
+		for (const uint32_t handle : changed)
+		{
+			changedBits[handle >> 6] &= ~(1ull << (handle & 63));
+			if (SceneNode *node = nodes[handle])
+			{
+				fn(*node);
+			}
+		}
+		changed.clear();
+		freeHandles.insert(freeHandles.end(), releasedHandles.begin(), releasedHandles.end());
+		releasedHandles.clear();
+	}
+
+	[[nodiscard]] size_t pendingCount() const
+	{
+		return changed.size();
+	}
+
+  private:
+	std::vector<SceneNode *> nodes;                  // by handle; null once untracked
+	std::vector<uint64_t>    changedBits;            // one bit per handle
+	std::vector<uint32_t>    changed;                // handles recorded since the last drain
+	std::vector<uint32_t>    freeHandles;
+	std::vector<uint32_t>    releasedHandles;        // reused only after the next drain, so pending entries never alias
+};
+}        // namespace Laphria
+
+#endif        // LAPHRIAENGINE_TRANSFORMJOURNAL_H
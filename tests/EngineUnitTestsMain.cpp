@@ -1,14 +1,32 @@
+#include "../src/Core/AssetIndexer.h"
+#include "../src/Core/FrameTimeController.h"
+#include "../src/Core/OcclusionCulling.h"
+#include "../src/Core/PunctualLights.h"
+#include "../src/Core/ShaderPermutation.h"
+#include "../src/Core/SkinnedBounds.h"
+#include "../src/Core/WavefrontSchedule.h"
 #include "../src/Physics/Broadphase.h"
 #include "../src/SceneManagement/Frustum.h"
+#include "../src/SceneManagement/NodeRegistry.h"
+#include "../src/SceneManagement/Octree.h"
+#include "../src/SceneManagement/SceneBinaryFormat.h"
+#include "../src/SceneManagement/SceneJournal.h"
+#include "../src/SceneManagement/SceneJsonStream.h"
 #include "../src/SceneManagement/SceneNode.h"
+#include "../src/SceneManagement/Symbol.h"
+#include "../src/SceneManagement/TransformJournal.h"
 
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <unordered_set>
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <nlohmann/json.hpp>
 
 namespace
 {
@@ -68,6 +86,322 @@ bool testWorldTransformCaching()
 	return true;
 }
 
+bool testSymbolInterning()
+{
+	const Laphria::Symbol path("Assets/tree.glb");
+	const Laphria::Symbol samePath(std::string("Assets/") + "tree.glb");
+	if (path != samePath || path.index() != samePath.index() || path.str() != "Assets/tree.glb" || !Laphria::Symbol().empty())
+	{
+		std::cerr << "equal strings did not intern to one symbol\n";
+		return false;
+	}
+	// Names typed in the editor are owned by the node, not interned, and still compare by text.
+	const Laphria::NodeName typed = Laphria::NodeName::owned("Assets/tree.glb");
+	if (typed.interned() || typed != Laphria::NodeName(path) || Laphria::NodeName::owned("Tree_Copy") != "Tree_Copy")
+	{
+		std::cerr << "owned node name does not read like an interned one\n";
+		return false;
+	}
+
+	const Laphria::StableId loaded = Laphria::StableId::parse("node_900000");
+	const Laphria::StableId generated = Laphria::StableId::generate();
+	if (loaded.toString() != "node_900000" || generated.value() <= loaded.value())
+	{
+		std::cerr << "generated stable id collides with a loaded one\n";
+		return false;
+	}
+	for (const char *text : {"root", "node_007", "node_", "node_12x"})
+	{
+		if (Laphria::StableId::parse(text).toString() != text || Laphria::StableId::parse(text) != Laphria::StableId::parse(text))
+		{
+			std::cerr << "stable id '" << text << "' did not round trip\n";
+			return false;
+		}
+	}
+	return true;
+}
+
+using MeshDraw = std::pair<glm::vec3, std::vector<int>>;
+
+void collectHierarchyDraws(const SceneNode &node, std::vector<MeshDraw> &draws)
+{
+	if (!node.getMeshIndices().empty())
+	{
+		draws.emplace_back(node.getWorldPosition(), node.getMeshIndices());
+	}
+	for (const auto &child : node.getChildren())
+	{
+		collectHierarchyDraws(*child, draws);
+	}
+}
+
+bool sameDraws(const std::vector<MeshDraw> &a, const std::vector<MeshDraw> &b)
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		if (!approxEq(a[i].first, b[i].first) || a[i].second != b[i].second)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool testPrefabInstanceMatchesHierarchy()
+{
+	auto prototype = std::make_shared<SceneNode>("model");
+	auto body = std::make_shared<SceneNode>("body");
+	auto wheel = std::make_shared<SceneNode>("wheel");
+	auto light = std::make_shared<SceneNode>("light");
+	prototype->meshIndices = {0};
+	body->meshIndices = {1, 2};
+	wheel->meshIndices = {3};
+	light->meshIndices = {4};
+	body->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+	body->setEulerRotation(glm::vec3(0.0f, 90.0f, 0.0f));
+	wheel->setPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+	light->setPosition(glm::vec3(0.0f, 0.0f, -3.0f));
+	body->addChild(wheel);
+	prototype->addChild(body);
+	prototype->addChild(light);
+
+	const auto prefab = PrefabTemplate::build(*prototype);
+	if (prefab->getNodes().size() != 4 || prefab->getNodes()[2].name != "wheel" || prefab->getNodes()[2].parent != 1)
+	{
+		std::cerr << "prefab template is not a pre-order flattening of the prototype\n";
+		return false;
+	}
+
+	auto full = prototype->clone();
+	auto collapsed = prototype->cloneNode();
+	collapsed->setPrefab(prefab);
+	for (const auto &instance : {full, collapsed})
+	{
+		instance->setPosition(glm::vec3(10.0f, 0.0f, 5.0f));
+		instance->setScale(glm::vec3(2.0f));
+	}
+
+	std::vector<MeshDraw> expected;
+	collectHierarchyDraws(*full, expected);
+	std::vector<MeshDraw> instanced;
+	collapsed->forEachMeshInstance([&](const glm::mat4 &world, const std::vector<int> &meshIndices) {
+		if (!meshIndices.empty())
+		{
+			instanced.emplace_back(glm::vec3(world[3]), meshIndices);
+		}
+	});
+	if (!collapsed->getChildren().empty() || !sameDraws(expected, instanced))
+	{
+		std::cerr << "collapsed prefab instance does not draw like the full hierarchy\n";
+		return false;
+	}
+
+	// Overriding a template node moves its subtree on this instance only, as editing the node itself would.
+	PrefabTemplate::Override bodyOverride = collapsed->getPrefabNodeTransform(1);
+	bodyOverride.position = glm::vec3(0.0f, 3.0f, 1.0f);
+	bodyOverride.scale = glm::vec3(0.5f);
+	collapsed->setPrefabOverride(bodyOverride);
+	full->getChildren()[0]->setPosition(bodyOverride.position);
+	full->getChildren()[0]->setScale(bodyOverride.scale);
+	expected.clear();
+	collectHierarchyDraws(*full, expected);
+	instanced.clear();
+	collapsed->forEachMeshInstance([&](const glm::mat4 &world, const std::vector<int> &meshIndices) {
+		if (!meshIndices.empty())
+		{
+			instanced.emplace_back(glm::vec3(world[3]), meshIndices);
+		}
+	});
+	if (collapsed->getPrefabOverrides().size() != 1 || !collapsed->getChildren().empty() || !sameDraws(expected, instanced))
+	{
+		std::cerr << "prefab override does not draw like the edited hierarchy\n";
+		return false;
+	}
+
+	collapsed->expandPrefab();
+	std::vector<MeshDraw> expanded;
+	collectHierarchyDraws(*collapsed, expanded);
+	if (collapsed->getPrefab() || !sameDraws(expected, expanded))
+	{
+		std::cerr << "expanded prefab instance does not match the full hierarchy\n";
+		return false;
+	}
+	return true;
+}
+
+bool testOctreeIndexesPrefabBounds()
+{
+	// A building whose root sits at the origin while its mesh spans x in [0, 20].
+	auto prototype = std::make_shared<SceneNode>("building");
+	auto wing = std::make_shared<SceneNode>("wing");
+	wing->meshIndices = {0};
+	wing->setPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+	prototype->addChild(wing);
+	const std::vector<PrefabTemplate::MeshBounds> meshBounds = {{glm::vec3(-10.0f, 0.0f, -1.0f), glm::vec3(10.0f, 4.0f, 1.0f)}};
+	const auto prefab = PrefabTemplate::build(*prototype, meshBounds);
+
+	auto inside = prototype->cloneNode();
+	auto straddling = prototype->cloneNode();
+	auto point = std::make_shared<SceneNode>("point");
+	inside->setPrefab(prefab);
+	straddling->setPrefab(prefab);
+	straddling->setPosition(glm::vec3(45.0f, 0.0f, 0.0f));        // box reaches past the +x root boundary
+	point->setPosition(glm::vec3(5.0f, 1.0f, 0.0f));
+
+	Laphria::Octree octree(Laphria::AABB{glm::vec3(-50.0f), glm::vec3(50.0f)}, 1);
+	for (const auto &node : {inside, straddling, point})
+	{
+		octree.insert(node);
+	}
+
+	const auto contains = [](const std::vector<SceneNode::Ptr> &found, const SceneNode::Ptr &node) {
+		return std::ranges::find(found, node) != found.end();
+	};
+	// Origins of both instances are outside the range; only their boxes reach into it.
+	std::vector<SceneNode::Ptr> found;
+	octree.query(Laphria::AABB{glm::vec3(15.0f, 0.0f, -1.0f), glm::vec3(16.0f, 1.0f, 1.0f)}, found);
+	if (!contains(found, inside) || contains(found, straddling) || contains(found, point))
+	{
+		std::cerr << "octree did not return a prefab instance by its template bounds\n";
+		return false;
+	}
+	found.clear();
+	octree.query(Laphria::AABB{glm::vec3(60.0f, 0.0f, -1.0f), glm::vec3(62.0f, 1.0f, 1.0f)}, found);
+	if (found.size() != 1 || found[0] != straddling)
+	{
+		std::cerr << "octree lost a prefab instance whose bounds leave the root boundary\n";
+		return false;
+	}
+
+	inside->setPosition(glm::vec3(-40.0f, 0.0f, 0.0f));
+	octree.insert(inside);
+	found.clear();
+	octree.query(Laphria::AABB{glm::vec3(15.0f, 0.0f, -1.0f), glm::vec3(16.0f, 1.0f, 1.0f)}, found);
+	if (contains(found, inside))
+	{
+		std::cerr << "octree kept a moved prefab instance at its old bounds\n";
+		return false;
+	}
+	return true;
+}
+
+bool testNodeRegistryMembership()
+{
+	Laphria::NodeRegistry registry;
+	std::vector<SceneNode::Ptr> nodes;
+	for (int i = 0; i < 4; ++i)
+	{
+		nodes.push_back(std::make_shared<SceneNode>("body"));
+		registry.update(nodes.back(), true);
+	}
+	registry.update(nodes[0], true);        // already a member
+	registry.update(nodes[1], false);
+	registry.remove(nodes[3].get());
+	registry.update(nodes[1], true);
+
+	const auto &members = registry.getNodes();
+	const std::unordered_set<const SceneNode *> expected{nodes[0].get(), nodes[1].get(), nodes[2].get()};
+	std::unordered_set<const SceneNode *> actual;
+	for (const auto &node : members)
+	{
+		actual.insert(node.get());
+	}
+	if (members.size() != 3 || actual != expected)
+	{
+		std::cerr << "node registry membership is wrong after swap removal\n";
+		return false;
+	}
+
+	// Every slot must still be addressable after the swaps.
+	for (const auto &node : nodes)
+	{
+		registry.update(node, false);
+	}
+	if (!registry.getNodes().empty())
+	{
+		std::cerr << "node registry kept removed nodes\n";
+		return false;
+	}
+	return true;
+}
+
+bool testTransformJournal()
+{
+	Laphria::TransformJournal journal;
+	auto root = std::make_shared<SceneNode>("root");
+	auto arm = std::make_shared<SceneNode>("arm");
+	auto hand = std::make_shared<SceneNode>("hand");
+	root->addChild(arm);
+	arm->addChild(hand);
+	for (const auto &node : {root, arm, hand})
+	{
+		journal.track(*node);
+	}
+
+	// Moving a parent records its subtree once, however often it moves.
+	arm->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+	arm->setPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+	hand->setScale(glm::vec3(2.0f));
+	std::unordered_set<const SceneNode *> drained;
+	size_t visits = 0;
+	journal.drain([&](SceneNode &node) {
+		drained.insert(&node);
+		++visits;
+	});
+	if (visits != 2 || drained != std::unordered_set<const SceneNode *>{arm.get(), hand.get()} || journal.pendingCount() != 0)
+	{
+		std::cerr << "transform journal did not deduplicate a moved subtree\n";
+		return false;
+	}
+
+	// Untracked and destroyed nodes drop out, and their handles are not reused before the next drain.
+	{
+		auto temporary = std::make_shared<SceneNode>("temporary");
+		journal.track(*temporary);
+		temporary->setPosition(glm::vec3(1.0f));
+	}
+	journal.untrack(*hand);
+	hand->setPosition(glm::vec3(3.0f));
+	auto late = std::make_shared<SceneNode>("late");
+	journal.track(*late);
+	late->setPosition(glm::vec3(4.0f));
+	drained.clear();
+	journal.drain([&](SceneNode &node) { drained.insert(&node); });
+	if (drained != std::unordered_set<const SceneNode *>{late.get()})
+	{
+		std::cerr << "transform journal reported an untracked node\n";
+		return false;
+	}
+
+	auto reused = std::make_shared<SceneNode>("reused");
+	journal.track(*reused);
+	reused->setRotation(glm::angleAxis(1.0f, glm::vec3(0.0f, 1.0f, 0.0f)));
+	root->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+	drained.clear();
+	journal.drain([&](SceneNode &node) { drained.insert(&node); });
+	if (drained != std::unordered_set<const SceneNode *>{reused.get(), root.get(), arm.get()})
+	{
+		std::cerr << "transform journal lost a node tracked on a reused handle\n";
+		return false;
+	}
+
+	// Simulated motion reaches the renderer but is not an edit for incremental saves.
+	const uint64_t revision = late->getRevision();
+	late->setSimulatedPosition(glm::vec3(5.0f));
+	drained.clear();
+	journal.drain([&](SceneNode &node) { drained.insert(&node); });
+	if (drained != std::unordered_set<const SceneNode *>{late.get()} || late->getRevision() != revision)
+	{
+		std::cerr << "simulated motion was not tracked as a transform-only change\n";
+		return false;
+	}
+	return true;
+}
+
 bool testFrustumClassification()
 {
 	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 10.0f);
@@ -84,6 +418,15 @@ bool testFrustumClassification()
 		std::cerr << "frustum failed to cull behind-camera point\n";
 		return false;
 	}
+	// A box straddling the far plane is kept; one past it is kept only when the depth planes are skipped.
+	if (!frustum.intersectsBox(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f)) ||
+	    frustum.intersectsBox(glm::vec3(-1.0f, -1.0f, -13.0f), glm::vec3(1.0f, 1.0f, -12.0f)) ||
+	    !frustum.intersectsBox(glm::vec3(-1.0f, -1.0f, -13.0f), glm::vec3(1.0f, 1.0f, -12.0f), 4) ||
+	    frustum.intersectsBox(glm::vec3(20.0f, -1.0f, -3.0f), glm::vec3(22.0f, 1.0f, -2.0f), 4))
+	{
+		std::cerr << "frustum box test classified a box wrongly\n";
+		return false;
+	}
 	return true;
 }
 
@@ -124,12 +467,643 @@ bool testBroadphaseCoverage()
 	}
 	return true;
 }
+
+// Runs the controller against a synthetic GPU whose passes cost exactly what the knobs imply, with the two
+// frames of readback latency the engine has, and returns the knobs it settles on.
+struct SyntheticGpu
+{
+	float fixedMs         = 0.5f;
+	float shadowCascadeMs = 0.0f;
+	float scenePixelMs    = 0.0f;        // per megapixel and path
+	float denoisePixelMs  = 0.0f;        // per megapixel and iteration
+};
+
+Laphria::FrameTimeSample syntheticFrame(const SyntheticGpu &gpu, Laphria::FrameTimeBackend backend, const Laphria::FrameTimeKnobs &knobs,
+                                        float nativePixels, uint32_t frame)
+{
+	Laphria::FrameTimeSample sample;
+	sample.backend      = backend;
+	sample.knobs        = knobs;
+	sample.nativePixels = nativePixels;
+	const float mpx     = nativePixels * knobs.resolutionScale * knobs.resolutionScale * 1e-6f;
+	if (backend == Laphria::FrameTimeBackend::Rasterizer)
+	{
+		sample.shadowCascadesRendered = 1;
+		for (uint32_t c = 1; c < 4; ++c)
+		{
+			sample.shadowCascadesRendered += ((frame + c) % knobs.shadowUpdatePeriod == 0) ? 1 : 0;
+		}
+	}
+	const float paths   = (knobs.sampleBudgetScale > 0.0f) ? 1.0f + knobs.sampleBudgetScale : 1.0f;
+	sample.shadowMs     = gpu.shadowCascadeMs * static_cast<float>(sample.shadowCascadesRendered);
+	sample.sceneMs      = gpu.scenePixelMs * mpx * paths;
+	sample.denoiserMs   = gpu.denoisePixelMs * mpx * static_cast<float>(knobs.denoiserIterations);
+	sample.frameMs      = gpu.fixedMs + sample.shadowMs + sample.sceneMs + sample.denoiserMs;
+	return sample;
+}
+
+bool runFrameTimeController(const SyntheticGpu &gpu, Laphria::FrameTimeBackend backend, Laphria::FrameTimeKnobs knobs,
+                            const Laphria::FrameTimeLimits &limits, float targetMs, Laphria::FrameTimeKnobs &settled, float &settledMs)
+{
+	constexpr float    kNativePixels = 1920.0f * 1080.0f;
+	constexpr uint32_t kFrames       = 400;
+	Laphria::FrameTimeController controller(4);
+	Laphria::FrameTimeKnobs      inFlight[2] = {knobs, knobs};
+	uint32_t                     lastChange  = 0;
+	for (uint32_t frame = 0; frame < kFrames; ++frame)
+	{
+		controller.addSample(syntheticFrame(gpu, backend, inFlight[frame % 2], kNativePixels, frame));
+		const Laphria::FrameTimeKnobs next = controller.update(backend, knobs, limits, kNativePixels, targetMs, Laphria::FrameTimeMode::AutoBalanced);
+		if (next.resolutionScale != knobs.resolutionScale || next.sampleBudgetScale != knobs.sampleBudgetScale ||
+		    next.denoiserIterations != knobs.denoiserIterations || next.shadowUpdatePeriod != knobs.shadowUpdatePeriod ||
+		    next.textureLodBias != knobs.textureLodBias)
+		{
+			lastChange = frame;
+		}
+		knobs               = next;
+		inFlight[frame % 2] = knobs;
+	}
+	settled   = knobs;
+	settledMs = controller.predictMs(backend, knobs, kNativePixels);
+	// Settled well before the end: no oscillation.
+	return lastChange + 100 < kFrames;
+}
+
+bool testFrameTimeController()
+{
+	const float targetMs = 16.6f;
+
+	// Path tracer far over budget: gives up sample budget, then iterations and resolution, and lands just under.
+	SyntheticGpu pathTracer;
+	pathTracer.scenePixelMs   = 3.0f;
+	pathTracer.denoisePixelMs = 0.6f;
+	Laphria::FrameTimeKnobs ptKnobs;
+	ptKnobs.sampleBudgetScale  = 4.0f;
+	ptKnobs.denoiserIterations = 5;
+	Laphria::FrameTimeKnobs settled;
+	float                   settledMs = 0.0f;
+	if (!runFrameTimeController(pathTracer, Laphria::FrameTimeBackend::PathTracer, ptKnobs, Laphria::FrameTimeLimits{}, targetMs, settled, settledMs) ||
+	    settledMs > targetMs || settledMs < 0.8f * targetMs)
+	{
+		std::cerr << "frame-time controller did not settle the path tracer under the target (" << settledMs << " ms)\n";
+		return false;
+	}
+
+	// Rasterizer over budget with pinned LOD bias: only the shadow update period may move.
+	SyntheticGpu raster;
+	raster.shadowCascadeMs = 2.0f;
+	raster.scenePixelMs    = 2.0f;
+	Laphria::FrameTimeLimits rasterLimits;
+	rasterLimits.minSampleBudgetScale  = rasterLimits.maxSampleBudgetScale = 0.0f;
+	rasterLimits.minDenoiserIterations = rasterLimits.maxDenoiserIterations = 0;
+	rasterLimits.maxTextureLodBias     = 0.0f;
+	rasterLimits.minResolutionScale    = 1.0f;
+	if (!runFrameTimeController(raster, Laphria::FrameTimeBackend::Rasterizer, Laphria::FrameTimeKnobs{}, rasterLimits, 12.0f, settled, settledMs) ||
+	    settled.shadowUpdatePeriod < 2 || settled.textureLodBias != 0.0f || settled.resolutionScale != 1.0f || settledMs > 12.0f)
+	{
+		std::cerr << "frame-time controller did not trade shadow updates for rasterizer frame time\n";
+		return false;
+	}
+
+	// Well under budget: wins quality back up to the limits.
+	Laphria::FrameTimeKnobs cheap;
+	cheap.resolutionScale    = 0.5f;
+	cheap.denoiserIterations = 1;
+	cheap.sampleBudgetScale  = 0.25f;
+	SyntheticGpu fast;
+	fast.scenePixelMs   = 0.2f;
+	fast.denoisePixelMs = 0.1f;
+	if (!runFrameTimeController(fast, Laphria::FrameTimeBackend::PathTracer, cheap, Laphria::FrameTimeLimits{}, targetMs, settled, settledMs) ||
+	    settled.resolutionScale != 1.0f || settled.denoiserIterations != 5 || settled.sampleBudgetScale != 8.0f)
+	{
+		std::cerr << "frame-time controller did not restore quality with headroom to spare\n";
+		return false;
+	}
+	return true;
+}
+
+bool testLightAliasTable()
+{
+	const std::vector<float> weights = {1.0f, 0.0f, 6.0f, 2.0f, 0.5f, 0.5f};
+	std::vector<Laphria::PunctualLightData> lights(weights.size());
+	Laphria::buildLightAliasTable(weights, lights);
+
+	// Probability of drawing each light from the table: its own slot share plus every slot aliased to it.
+	std::vector<double> drawn(lights.size(), 0.0);
+	for (size_t i = 0; i < lights.size(); ++i)
+	{
+		if (lights[i].aliasIndex >= lights.size())
+		{
+			std::cerr << "light alias index out of range\n";
+			return false;
+		}
+		drawn[i] += lights[i].aliasProbability / static_cast<double>(lights.size());
+		drawn[lights[i].aliasIndex] += (1.0 - lights[i].aliasProbability) / static_cast<double>(lights.size());
+	}
+	for (size_t i = 0; i < lights.size(); ++i)
+	{
+		const double expected = weights[i] / 10.0;
+		if (std::abs(drawn[i] - expected) > 1e-5 || std::abs(lights[i].selectionPdf - expected) > 1e-5)
+		{
+			std::cerr << "light alias table does not reproduce the light weights\n";
+			return false;
+		}
+	}
+
+	Laphria::PunctualLight spot;
+	spot.type           = Laphria::PunctualLightType::Spot;
+	spot.innerConeAngle = 0.2f;
+	spot.outerConeAngle = 0.4f;
+	const glm::mat4 worldFromLight = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+	const Laphria::PunctualLightData spotData = Laphria::makePunctualLightData(spot, worldFromLight);
+	const float innerFalloff = std::cos(0.2f) * spotData.spotScale + spotData.spotOffset;
+	const float outerFalloff = std::cos(0.4f) * spotData.spotScale + spotData.spotOffset;
+	if (glm::distance(spotData.position, glm::vec3(1.0f, 2.0f, 3.0f)) > 1e-5f || std::abs(innerFalloff - 1.0f) > 1e-4f ||
+	    std::abs(outerFalloff) > 1e-4f)
+	{
+		std::cerr << "spot light placement or cone falloff is wrong\n";
+		return false;
+	}
+	return true;
+}
+
+bool testWavefrontSchedule()
+{
+	using Laphria::WavefrontKernel;
+
+	// 2.5 chunks, 2 paths per pixel, 3 bounces: every chunk runs Primary, then per path Generate and
+	// Bin/Scatter/Shade/Shadow for each bounce with an Extend in front of every bounce after the first.
+	Laphria::WavefrontScheduleParams params;
+	params.pixelCount       = 250;
+	params.chunkCapacity    = 100;
+	params.maxPathsPerPixel = 2;
+	params.maxBounces       = 3;
+	const std::vector<Laphria::WavefrontDispatch> schedule = Laphria::buildWavefrontSchedule(params);
+	const size_t perChunk = 1 + 2 * (1 + 3 * 4 + 2) + 1;
+	if (Laphria::wavefrontChunkCount(250, 100) != 3 || schedule.size() != 3 * perChunk ||
+	    Laphria::wavefrontScheduleLength(params) != schedule.size())
+	{
+		std::cerr << "wavefront schedule has the wrong number of dispatches (" << schedule.size() << ")\n";
+		return false;
+	}
+	if (schedule.front().kernel != WavefrontKernel::Primary || schedule[1].kernel != WavefrontKernel::Generate ||
+	    schedule[2].kernel != WavefrontKernel::Bin || schedule[perChunk - 1].kernel != WavefrontKernel::Resolve ||
+	    schedule[perChunk].chunk != 1 || schedule.back().chunk != 2)
+	{
+		std::cerr << "wavefront schedule is out of pipeline order\n";
+		return false;
+	}
+	for (size_t i = 1; i < schedule.size(); ++i)
+	{
+		// Shading always follows its bin, and every bounce after the first starts with a trace.
+		if (schedule[i].kernel == WavefrontKernel::Shade && schedule[i - 1].kernel != WavefrontKernel::Scatter)
+		{
+			std::cerr << "wavefront shading is not preceded by the material sort\n";
+			return false;
+		}
+		if (schedule[i].kernel == WavefrontKernel::Extend && schedule[i].bounce == 0)
+		{
+			std::cerr << "wavefront schedule traces the primary hit again\n";
+			return false;
+		}
+	}
+
+	// Unsorted and single-bounce: no Scatter and no Extend at all.
+	params.sortHits   = false;
+	params.maxBounces = 1;
+	const std::vector<Laphria::WavefrontDispatch> unsorted = Laphria::buildWavefrontSchedule(params);
+	if (Laphria::wavefrontScheduleLength(params) != unsorted.size())
+	{
+		std::cerr << "wavefront schedule length disagrees with the schedule (" << unsorted.size() << ")\n";
+		return false;
+	}
+	for (const Laphria::WavefrontDispatch &dispatch : unsorted)
+	{
+		if (dispatch.kernel == WavefrontKernel::Scatter || dispatch.kernel == WavefrontKernel::Extend)
+		{
+			std::cerr << "wavefront schedule records kernels that cannot run\n";
+			return false;
+		}
+	}
+
+	// Each span is charged to the dispatch that ends it; an unavailable timestamp ends the breakdown.
+	const std::vector<Laphria::WavefrontDispatch> timedSchedule = {
+	    {WavefrontKernel::Primary, 0, 0, 0},
+	    {WavefrontKernel::Shade, 0, 0, 0},
+	    {WavefrontKernel::Shade, 0, 0, 1},
+	    {WavefrontKernel::Resolve, 0, 0, 0}};
+	const auto ticks = Laphria::sumWavefrontKernelTicks(timedSchedule, {100, 110, 140, 200, 0});
+	if (ticks[static_cast<uint32_t>(WavefrontKernel::Primary)] != 10 || ticks[static_cast<uint32_t>(WavefrontKernel::Shade)] != 90 ||
+	    ticks[static_cast<uint32_t>(WavefrontKernel::Resolve)] != 0)
+	{
+		std::cerr << "wavefront kernel timings are attributed to the wrong kernels\n";
+		return false;
+	}
+	return true;
+}
+
+bool testShaderPermutation()
+{
+	using Laphria::SpecializationConstant;
+
+	// Out-of-range values are clamped to what the shaders are written for, and every entry is one uint.
+	Laphria::ShaderPermutation permutation;
+	permutation.ptMaxBounces           = 7;
+	permutation.textureColorSpaceModel = 1;
+	permutation.shadowCascadeCount     = 0;
+	permutation.ptReprojection         = false;
+	const Laphria::SpecializationBlock block = Laphria::buildSpecializationBlock(permutation);
+	if (block.values[static_cast<uint32_t>(SpecializationConstant::PtMaxBounces)] != 3 ||
+	    block.values[static_cast<uint32_t>(SpecializationConstant::TextureColorSpaceModel)] != 1 ||
+	    block.values[static_cast<uint32_t>(SpecializationConstant::ShadowCascadeCount)] != 1 ||
+	    block.values[static_cast<uint32_t>(SpecializationConstant::PtReprojection)] != 0)
+	{
+		std::cerr << "specialization values were not clamped\n";
+		return false;
+	}
+	for (uint32_t id = 0; id < Laphria::kSpecializationConstantCount; ++id)
+	{
+		if (block.entries[id].constantId != id || block.entries[id].offset != id * sizeof(uint32_t) ||
+		    block.entries[id].size != sizeof(uint32_t))
+		{
+			std::cerr << "specialization map entries do not describe the value block\n";
+			return false;
+		}
+	}
+
+	// Only the groups that read a changed constant are rebuilt; a change lost to clamping rebuilds nothing.
+	const Laphria::ShaderPermutation base;
+	Laphria::ShaderPermutation bounces = base;
+	bounces.ptMaxBounces               = 2;
+	Laphria::ShaderPermutation colorSpace = base;
+	colorSpace.textureColorSpaceModel     = 1;
+	Laphria::ShaderPermutation reprojection = base;
+	reprojection.ptReprojection             = false;
+	Laphria::ShaderPermutation clamped = base;
+	clamped.ptMaxBounces               = 9;
+	if (Laphria::permutedPipelinesToRebuild(base, base) != 0 ||
+	    Laphria::permutedPipelinesToRebuild(base, bounces) != (Laphria::kPermutedPathTracer | Laphria::kPermutedWavefront) ||
+	    (Laphria::permutedPipelinesToRebuild(base, colorSpace) & Laphria::kPermutedDenoiser) != 0 ||
+	    (Laphria::permutedPipelinesToRebuild(base, colorSpace) & Laphria::kPermutedRaster) == 0 ||
+	    Laphria::permutedPipelinesToRebuild(base, reprojection) != Laphria::kPermutedDenoiser ||
+	    Laphria::permutedPipelinesToRebuild(base, clamped) != 0)
+	{
+		std::cerr << "shader permutation change rebuilds the wrong pipelines\n";
+		return false;
+	}
+	return true;
+}
+
+bool testOcclusionCulling()
+{
+	// Mip 0 is the power of two at most each side, and the chain runs down to a single texel.
+	const Laphria::HiZPyramidLayout layout = Laphria::computeHiZPyramidLayout(1280, 720);
+	const Laphria::HiZPyramidLayout square = Laphria::computeHiZPyramidLayout(1024, 1024);
+	const Laphria::HiZPyramidLayout empty  = Laphria::computeHiZPyramidLayout(0, 0);
+	if (layout.width != 1024 || layout.height != 512 || layout.mipCount != 11 || square.width != 1024 ||
+	    square.mipCount != 11 || empty.width != 1 || empty.height != 1 || empty.mipCount != 1)
+	{
+		std::cerr << "depth pyramid layout is wrong\n";
+		return false;
+	}
+
+	// The world box of a rotated, scaled and translated box holds all eight transformed corners, tightly.
+	const glm::vec3 localMin(-1.0f, -2.0f, -0.5f);
+	const glm::vec3 localMax(1.0f, 2.0f, 0.5f);
+	const glm::mat4 transform = glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, -3.0f)),
+	                                                   glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)),
+	                                       glm::vec3(2.0f));
+	glm::vec3 worldMin;
+	glm::vec3 worldMax;
+	Laphria::transformBounds(localMin, localMax, transform, worldMin, worldMax);
+	if (!approxEq(worldMin, glm::vec3(1.0f, -2.0f, -4.0f)) || !approxEq(worldMax, glm::vec3(9.0f, 2.0f, -2.0f)))
+	{
+		std::cerr << "transformed bounds are not the box of the transformed corners\n";
+		return false;
+	}
+
+	// Each read-back frame replaces the set; distinct instances and meshes of a node have distinct keys.
+	int nodeA = 0;
+	int nodeB = 0;
+	const uint64_t keys[3] = {Laphria::occlusionCandidateKey(&nodeA, 0, 0), Laphria::occlusionCandidateKey(&nodeA, 1, 0),
+	                          Laphria::occlusionCandidateKey(&nodeB, 0, 1)};
+	if (keys[0] == keys[1] || keys[0] == keys[2] || keys[1] == keys[2] ||
+	    keys[0] != Laphria::occlusionCandidateKey(&nodeA, 0, 0))
+	{
+		std::cerr << "occlusion candidate keys are not distinct and stable\n";
+		return false;
+	}
+	Laphria::OcclusionHistory history;
+	const uint32_t firstFrame[3] = {1, 0, 1};
+	history.update(keys, firstFrame);
+	if (!history.wasVisible(keys[0]) || history.wasVisible(keys[1]) || !history.wasVisible(keys[2]) ||
+	    history.visibleCount() != 2)
+	{
+		std::cerr << "occlusion history did not take the frame's visibility\n";
+		return false;
+	}
+	const uint32_t secondFrame[2] = {0, 1};
+	history.update(std::span<const uint64_t>(keys, 2), secondFrame);
+	if (history.wasVisible(keys[0]) || !history.wasVisible(keys[1]) || history.wasVisible(keys[2]))
+	{
+		std::cerr << "occlusion history kept instances the latest frame did not report\n";
+		return false;
+	}
+	history.clear();
+	if (history.visibleCount() != 0)
+	{
+		std::cerr << "occlusion history clear left entries\n";
+		return false;
+	}
+	return true;
+}
+
+bool testSkinnedBounds()
+{
+	Laphria::SkinnedBounds bounds;
+	bounds.reset(2);
+	glm::vec3 posedMin;
+	glm::vec3 posedMax;
+	if (!bounds.empty() || bounds.posedBounds({}, posedMin, posedMax))
+	{
+		std::cerr << "skinned bounds without vertices report a box\n";
+		return false;
+	}
+
+	// Two joints, one vertex on each and one blended half and half.
+	const glm::vec3  positions[3] = {glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.5f, 1.0f, 0.0f)};
+	const glm::uvec4 joints[3]    = {glm::uvec4(0, 1, 0, 0), glm::uvec4(1, 0, 0, 0), glm::uvec4(0, 1, 0, 0)};
+	const glm::vec4  weights[3]   = {glm::vec4(1.0f, 0.0f, 0.0f, 0.0f), glm::vec4(1.0f, 0.0f, 0.0f, 0.0f),
+	                                 glm::vec4(0.5f, 0.5f, 0.0f, 0.0f)};
+	for (int i = 0; i < 3; ++i)
+	{
+		bounds.addVertex(positions[i], joints[i], weights[i]);
+	}
+
+	// Posed by a translation, the box is the union of the two joint boxes, each moved by its own matrix.
+	const glm::mat4 translated[2] = {glm::mat4(1.0f), glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f))};
+	if (!bounds.posedBounds(translated, posedMin, posedMax) || !approxEq(posedMin, glm::vec3(0.0f)) ||
+	    !approxEq(posedMax, glm::vec3(11.0f, 1.0f, 0.0f)))
+	{
+		std::cerr << "skinned bounds are not the union of the posed joint boxes\n";
+		return false;
+	}
+
+	// Under any pose every skinned vertex, the weighted mean of its posed positions, stays inside.
+	const glm::mat4 rotated[2] = {glm::rotate(glm::mat4(1.0f), glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f)),
+	                              glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.0f, 0.0f)),
+	                                          glm::radians(120.0f), glm::vec3(0.0f, 0.0f, 1.0f))};
+	bounds.posedBounds(rotated, posedMin, posedMax);
+	for (int i = 0; i < 3; ++i)
+	{
+		glm::vec3 skinned(0.0f);
+		for (int k = 0; k < 4; ++k)
+		{
+			skinned += weights[i][k] * glm::vec3(rotated[joints[i][k]] * glm::vec4(positions[i], 1.0f));
+		}
+		if (glm::any(glm::lessThan(skinned, posedMin - 1e-4f)) || glm::any(glm::greaterThan(skinned, posedMax + 1e-4f)))
+		{
+			std::cerr << "skinned vertex " << i << " falls outside the posed bounds\n";
+			return false;
+		}
+	}
+
+	// A vertex without weight stays in place; weight on a joint past the palette pulls toward the origin.
+	bounds.addVertex(glm::vec3(-3.0f, 4.0f, 5.0f), glm::uvec4(0), glm::vec4(0.0f));
+	bounds.addVertex(glm::vec3(1.0f, 1.0f, 1.0f), glm::uvec4(7, 0, 0, 0), glm::vec4(1.0f, 0.0f, 0.0f, 0.0f));
+	const glm::mat4 distant[2] = {glm::translate(glm::mat4(1.0f), glm::vec3(20.0f)), glm::translate(glm::mat4(1.0f), glm::vec3(20.0f))};
+	if (!bounds.posedBounds(distant, posedMin, posedMax) || !approxEq(posedMin, glm::vec3(-3.0f, 0.0f, 0.0f)) ||
+	    !approxEq(posedMax, glm::vec3(21.0f, 21.0f, 20.0f)))
+	{
+		std::cerr << "skinned bounds miss unweighted vertices or dropped influences\n";
+		return false;
+	}
+	return true;
+}
+
+bool testBinarySceneRoundTrip()
+{
+	const nlohmann::json scene = {
+	    {"id", "root"},
+	    {"name", "Root"},
+	    {"position", {0.0f, 0.0f, 0.0f}},
+	    {"rotation", {1.0f, 0.0f, 0.0f, 0.0f}},
+	    {"scale", {1.0f, 1.0f, 1.0f}},
+	    {"meshIndices", nlohmann::json::array()},
+	    {"children",
+	     {{{"id", "a"},
+	       {"name", "A"},
+	       {"position", {1.5f, -2.0f, 0.25f}},
+	       {"modelPath", "Assets/a.glb"},
+	       {"asset_ref", {{"path", "Assets/a.glb"}, {"variant", "default"}}},
+	       {"meshIndices", {0, 2, 3}},
+	       {"asset_node_index", 4},
+	       {"animation_component", {{"clip_id", "Walk"}, {"time_seconds", 0.5f}, {"loop", false}}},
+	       {"children", {{{"id", "a0"}, {"name", "A0"}}}}},
+	      {{"id", "b"},
+	       {"name", "B"},
+	       {"modelPath", "Assets/a.glb"},
+	       {"prefab_instance", true},
+	       {"prefab_overrides", nlohmann::json::array({{{"node", 2}, {"position", {0.5f, 1.0f, 0.0f}}, {"rotation", {0.0f, 0.0f, 1.0f, 0.0f}}, {"scale", {2.0f, 2.0f, 2.0f}}},
+	                                                   {{"node", 5}, {"position", {0.0f, 0.0f, -3.0f}}, {"rotation", {1.0f, 0.0f, 0.0f, 0.0f}}, {"scale", {1.0f, 1.0f, 1.0f}}}})},
+	       {"children", nlohmann::json::array()}}}}};
+
+	Laphria::SceneBinary::BinarySceneBuilder builder;
+	std::vector<std::string> droppedKeys;
+	std::string error;
+	std::istringstream input(scene.dump());
+	if (!Laphria::SceneJson::readSceneIntoBinary(input, builder, droppedKeys, error) || !droppedKeys.empty())
+	{
+		std::cerr << "binary scene conversion failed: " << error << "\n";
+		return false;
+	}
+
+	const std::vector<uint8_t> bytes = builder.serialize();
+	Laphria::SceneBinary::BinarySceneView view;
+	if (!view.openMemory(bytes.data(), bytes.size(), error) || view.nodeCount() != 4)
+	{
+		std::cerr << "binary scene view rejected serialized tables: " << error << "\n";
+		return false;
+	}
+	if (view.nodes()[1].modelPath.offset != view.nodes()[3].modelPath.offset)
+	{
+		std::cerr << "binary scene string table did not de-duplicate\n";
+		return false;
+	}
+	if (view.prefabOverrides(view.nodes()[3]).size() != 2 || !view.prefabOverrides(view.nodes()[1]).empty())
+	{
+		std::cerr << "binary scene prefab overrides are not attached to their node\n";
+		return false;
+	}
+	std::ostringstream output;
+	if (!Laphria::SceneJson::writeBinarySceneAsJson(view, output) || nlohmann::json::parse(output.str()) != scene)
+	{
+		std::cerr << "binary scene round trip changed the scene\n";
+		return false;
+	}
+
+	std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 1);
+	if (view.openMemory(truncated.data(), truncated.size(), error))
+	{
+		std::cerr << "binary scene view accepted a truncated file\n";
+		return false;
+	}
+	return true;
+}
+Laphria::SceneJournal::NodeChange journalNode(const std::string &parentId, const std::string &id, const std::string &name)
+{
+	Laphria::SceneJournal::NodeChange change;
+	change.parentId = parentId;
+	change.fields.flags = Laphria::SceneBinary::kNodeHasId | Laphria::SceneBinary::kNodeHasName | Laphria::SceneBinary::kNodeHasChildrenArray;
+	change.fields.id = id;
+	change.fields.name = name;
+	return change;
+}
+
+bool testSceneJournalReplay()
+{
+	namespace fs = std::filesystem;
+	using namespace Laphria::SceneJournal;
+
+	const fs::path directory = fs::temp_directory_path() / "laphria_scene_journal_test";
+	fs::remove_all(directory);
+	fs::create_directories(directory);
+	const std::string scenePath = (directory / "scene.json").string();
+
+	{
+		AsyncSceneWriter writer(1u << 20);
+		ChangeSet        snapshot;
+		snapshot.upserts = {journalNode("", "root", "Root"), journalNode("root", "a", "A"), journalNode("root", "b", "B")};
+		writer.submitSnapshot(scenePath, snapshot, false);
+
+		// "a" is renamed, "c" is added under it and "b" is deleted.
+		ChangeSet changes;
+		changes.upserts = {journalNode("root", "a", "A renamed"), journalNode("a", "c", "C")};
+		changes.removedIds = {"b"};
+		writer.submitChanges(scenePath, changes, false);
+		writer.waitIdle();
+		if (const auto errors = writer.takeErrors(); !errors.empty())
+		{
+			std::cerr << "scene journal write failed: " << errors.front() << "\n";
+			return false;
+		}
+	}
+
+	// An interrupted append must not hide the complete entries before it.
+	std::ofstream(journalPathFor(scenePath), std::ios::app) << "{\"removed\":[";
+	std::vector<ChangeSet> entries;
+	std::string            error;
+	if (!readJournal(scenePath, entries, error) || entries.size() != 1)
+	{
+		std::cerr << "scene journal did not read back one entry: " << error << "\n";
+		return false;
+	}
+
+	// The next append cuts a torn line longer than one scan block and starts on a fresh line.
+	std::ofstream(journalPathFor(scenePath), std::ios::app) << std::string(10000, ' ');
+	ChangeSet repeated;
+	repeated.upserts = {journalNode("a", "c", "C")};
+	entries.clear();
+	if (!appendChangeSet(scenePath, repeated, error) || !readJournal(scenePath, entries, error) || entries.size() != 2)
+	{
+		std::cerr << "scene journal append did not drop the torn tail: " << error << "\n";
+		return false;
+	}
+
+	if (!compact(scenePath, false, error) || fs::exists(journalPathFor(scenePath)))
+	{
+		std::cerr << "scene journal compaction failed: " << error << "\n";
+		return false;
+	}
+	std::ifstream        compacted(scenePath);
+	const nlohmann::json scene = nlohmann::json::parse(compacted, nullptr, false);
+	const bool ok = scene.is_object() && scene["children"].size() == 1 && scene["children"][0]["name"] == "A renamed" &&
+	                scene["children"][0]["children"].size() == 1 && scene["children"][0]["children"][0]["id"] == "c";
+	if (!ok)
+	{
+		std::cerr << "scene journal replay produced the wrong hierarchy\n";
+	}
+	compacted.close();
+	fs::remove_all(directory);
+	return ok;
+}
+bool testAssetIndexRecords()
+{
+	namespace fs = std::filesystem;
+	using LaphriaEditor::AssetIndexer;
+	using LaphriaEditor::AssetRecord;
+
+	const fs::path directory = fs::temp_directory_path() / "laphria_asset_index_test";
+	fs::remove_all(directory);
+	fs::create_directories(directory);
+	const fs::path gltfPath = directory / "crate.gltf";
+	{
+		std::ofstream(gltfPath) << R"({"asset":{"version":"2.0"},"meshes":[{},{}],"textures":[{}],"animations":[{},{},{}]})";
+	}
+
+	bool ok = true;
+	const auto record = AssetIndexer::describeFile(gltfPath);
+	if (!record || !record->summaryValid || record->meshCount != 2 || record->textureCount != 1 || record->animationCount != 3)
+	{
+		std::cerr << "asset index summarized the glTF counts incorrectly\n";
+		ok = false;
+	}
+
+	// An unchanged size and modification time reuse the recorded hash and summary without reading the file.
+	AssetRecord stale = record.value_or(AssetRecord{});
+	stale.contentHash = 42;
+	const auto reused = AssetIndexer::describeFile(gltfPath, &stale);
+	if (ok && (!reused || reused->contentHash != 42))
+	{
+		std::cerr << "asset index re-read an unchanged file\n";
+		ok = false;
+	}
+
+	std::vector<AssetRecord> loaded;
+	const fs::path indexPath = directory / "asset_index.json";
+	if (ok && (!AssetIndexer::writeIndexFile(indexPath, {*record}) || !AssetIndexer::readIndexFile(indexPath, loaded) || loaded.size() != 1 ||
+	           loaded.front() != *record))
+	{
+		std::cerr << "asset index file did not round-trip\n";
+		ok = false;
+	}
+
+	// A .glb whose JSON chunk claims more bytes than the file holds is indexed without a summary.
+	const fs::path truncatedPath = directory / "truncated.glb";
+	{
+		const uint32_t header[5] = {0x46546C67u, 2u, 64u, 0xFFFFFFF0u, 0x4E4F534Au};
+		std::ofstream(truncatedPath, std::ios::binary).write(reinterpret_cast<const char *>(header), sizeof(header));
+	}
+	const auto truncated = AssetIndexer::describeFile(truncatedPath);
+	if (!truncated || truncated->summaryValid)
+	{
+		std::cerr << "asset index trusted the chunk length of a truncated .glb\n";
+		ok = false;
+	}
+	fs::remove_all(directory);
+	return ok;
+}
 } // namespace
 
 int main()
 {
 	const bool okTransform = testWorldTransformCaching();
+	const bool okSymbols = testSymbolInterning();
+	const bool okPrefab = testPrefabInstanceMatchesHierarchy();
+	const bool okOctree = testOctreeIndexesPrefabBounds();
+	const bool okRegistry = testNodeRegistryMembership();
+	const bool okTransformJournal = testTransformJournal();
 	const bool okFrustum = testFrustumClassification();
 	const bool okBroadphase = testBroadphaseCoverage();
-	return (okTransform && okFrustum && okBroadphase) ? 0 : 1;
+	const bool okLightAlias = testLightAliasTable();
+	const bool okFrameTime = testFrameTimeController();
+	const bool okWavefront = testWavefrontSchedule();
+	const bool okPermutation = testShaderPermutation();
+	const bool okOcclusion = testOcclusionCulling();
+	const bool okSkinnedBounds = testSkinnedBounds();
+	const bool okBinaryScene = testBinarySceneRoundTrip();
+	const bool okSceneJournal = testSceneJournalReplay();
+	const bool okAssetIndex = testAssetIndexRecords();
+	return (okTransform && okSymbols && okPrefab && okOctree && okRegistry && okTransformJournal && okFrustum && okBroadphase && okLightAlias && okFrameTime && okWavefront && okPermutation && okOcclusion && okSkinnedBounds && okBinaryScene && okSceneJournal &&
+	        okAssetIndex) ? 0 : 1;
 }